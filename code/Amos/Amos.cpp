@@ -31,15 +31,26 @@
 #include <RayPlatform/core/master_modes.h>
 #include <RayPlatform/core/slave_modes.h>
 
+#include <sstream>
+using namespace std;
+
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <errno.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 __CreatePlugin(Amos);
 
 __CreateMasterModeAdapter(Amos,RAY_MASTER_MODE_AMOS);
 __CreateSlaveModeAdapter(Amos,RAY_SLAVE_MODE_AMOS);
+__CreateMessageTagAdapter(Amos,RAY_MPI_TAG_WRITE_AMOS_REPLY);
+__CreateMessageTagAdapter(Amos,RAY_MPI_TAG_COPY_AMOS_SPOOL);
+__CreateMessageTagAdapter(Amos,RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY);
 
 void Amos::constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*outbox,
 	FusionData*fusionData,ExtensionData*extensionData,int*masterMode,int*slaveMode,Scaffolder*scaffolder,
@@ -57,29 +68,230 @@ void Amos::constructor(Parameters*parameters,RingAllocator*outboxAllocator,Stati
 	m_workerId=0;
 }
 
+/*
+ * MachineHelper announces the same number of contigs to the master
+ * with RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY.
+ */
+bool Amos::isWrittenContig(int contig){
+	if(m_fusionData->m_FUSION_eliminated.count(m_ed->m_EXTENSION_identifiers[contig])>0)
+		return false;
+
+	return m_ed->m_EXTENSION_contigs[contig].size()>0;
+}
+
+string Amos::getSpoolFile(){
+	ostringstream file;
+	file<<m_parameters->getPrefix()<<"Rank"<<m_parameters->getRank()<<".AMOS.afg.spool";
+	return file.str();
+}
+
+/*
+ * 1. every rank spools its contigs, the identifiers of a rank
+ *    start after the contigs of the previous ranks
+ * 2. the master places the spools one after the other in the AMOS file
+ * 3. every rank copies its spool at its offset
+ */
 void Amos::call_RAY_MASTER_MODE_AMOS(){
 	if(!m_ed->m_EXTENSION_currentRankIsStarted){
-		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
-		message[0]=m_ed->m_EXTENSION_currentPosition;
-		Message aMessage(message,1,m_ed->m_EXTENSION_rank,RAY_MPI_TAG_WRITE_AMOS,m_parameters->getRank());
-		m_outbox->push_back(&aMessage);
-		m_ed->m_EXTENSION_rank++;
-		m_ed->m_EXTENSION_currentRankIsDone=false;
+
+		m_spooledBytes.resize(m_parameters->getSize());
+
+		uint64_t firstIdentifier=0;
+
+		for(Rank rank=0;rank<m_parameters->getSize();rank++){
+			m_spooledBytes[rank]=0;
+
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+			message[0]=firstIdentifier;
+			Message aMessage(message,1,rank,RAY_MPI_TAG_WRITE_AMOS,m_parameters->getRank());
+			m_outbox->push_back(&aMessage);
+
+			firstIdentifier+=m_ed->m_EXTENSION_contigsPerRank[rank];
+		}
+
+		m_ranksThatSpooled=0;
+		m_ranksThatCopied=0;
+		m_copyStarted=false;
+		m_amosFileIsComplete=true;
 		m_ed->m_EXTENSION_currentRankIsStarted=true;
-	}else if(m_ed->m_EXTENSION_currentRankIsDone){
-		if(m_ed->m_EXTENSION_rank<m_parameters->getSize()){
-			m_ed->m_EXTENSION_currentRankIsStarted=false;
-		}else{
-			*m_master_mode=RAY_MASTER_MODE_SCAFFOLDER;
-			m_scaffolder->m_numberOfRanksFinished=0;
+
+	}else if(!m_copyStarted && m_ranksThatSpooled==m_parameters->getSize()){
+
+/*
+ * The reads were already written by the master in SequencesLoader.
+ */
+		uint64_t offset=0;
+		struct stat information;
+		if(stat(m_parameters->getAmosFile().c_str(),&information)==0){
+			offset=information.st_size;
+		}
+
+		for(Rank rank=0;rank<m_parameters->getSize();rank++){
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+			message[0]=offset;
+			Message aMessage(message,1,rank,RAY_MPI_TAG_COPY_AMOS_SPOOL,m_parameters->getRank());
+			m_outbox->push_back(&aMessage);
+
+			offset+=m_spooledBytes[rank];
+		}
+
+		m_copyStarted=true;
+
+	}else if(m_copyStarted && m_ranksThatCopied==m_parameters->getSize()){
+		if(!m_amosFileIsComplete){
+			cout<<"Error: "<<m_parameters->getAmosFile()<<" is incomplete."<<endl;
+		}
+
+		*m_master_mode=RAY_MASTER_MODE_SCAFFOLDER;
+		m_scaffolder->m_numberOfRanksFinished=0;
+	}
+}
+
+void Amos::call_RAY_MPI_TAG_WRITE_AMOS_REPLY(Message*message){
+	MessageUnit*buffer=message->getBuffer();
+	Rank source=message->getSource();
+
+	m_spooledBytes[source]=buffer[0];
+
+/*
+ * The identifiers of the next ranks were computed from the number of
+ * contigs announced by this rank, they must match what it spooled.
+ */
+	if(buffer[1]!=m_ed->m_EXTENSION_contigsPerRank[source]){
+		cout<<"Error: Rank "<<source<<" spooled "<<buffer[1]<<" contigs but announced ";
+		cout<<m_ed->m_EXTENSION_contigsPerRank[source]<<", the identifiers in "<<m_parameters->getAmosFile()<<" are not contiguous."<<endl;
+		m_amosFileIsComplete=false;
+	}
+
+	if(buffer[2]==1){
+		cout<<"Error: Rank "<<source<<" could not spool its AMOS records"<<endl;
+		m_amosFileIsComplete=false;
+	}
+
+	m_ranksThatSpooled++;
+}
+
+/*
+ * Copy the spool in the AMOS file at the given offset.
+ * The ranges of the ranks are disjoint.
+ */
+void Amos::call_RAY_MPI_TAG_COPY_AMOS_SPOOL(Message*message){
+	MessageUnit*buffer=message->getBuffer();
+	uint64_t offset=buffer[0];
+
+	string spool=getSpoolFile();
+
+/*
+ * A spool that could not be written completely is not copied.
+ */
+	bool failed=m_spoolFailed;
+	int input=-1;
+	int output=-1;
+
+	if(!failed){
+		input=open(spool.c_str(),O_RDONLY);
+		output=open(m_parameters->getAmosFile().c_str(),O_WRONLY|O_CREAT,S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
+	}
+
+	if(!failed && (input<0 || output<0)){
+		cout<<"Error: Rank "<<m_parameters->getRank()<<" can not copy "<<spool<<" to "<<m_parameters->getAmosFile()<<endl;
+		failed=true;
+	}
+
+	char*data=(char*)__Malloc(CONFIG_FILE_IO_BUFFER_SIZE,"RAY_MALLOC_TYPE_AMOS",m_parameters->showMemoryAllocations());
+
+	uint64_t copiedBytes=0;
+
+	while(!failed){
+		ssize_t bytes=read(input,data,CONFIG_FILE_IO_BUFFER_SIZE);
+
+		if(bytes<0 && errno==EINTR)
+			continue;
+
+		if(bytes<0){
+			cout<<"Error: Rank "<<m_parameters->getRank()<<" could not read "<<spool<<endl;
+			failed=true;
+			break;
+		}
+
+		if(bytes==0)
+			break;
+
+		ssize_t written=0;
+		while(written<bytes){
+			ssize_t returnValue=pwrite(output,data+written,bytes-written,offset+written);
+
+			if(returnValue<0 && errno==EINTR)
+				continue;
+
+/*
+ * pwrite returns 0 when nothing can be written, retrying would never end.
+ */
+			if(returnValue<=0){
+				cout<<"Error: Rank "<<m_parameters->getRank()<<" could not write to "<<m_parameters->getAmosFile()<<endl;
+				failed=true;
+				break;
+			}
+
+			written+=returnValue;
 		}
+
+		offset+=written;
+		copiedBytes+=written;
 	}
+
+	__Free(data,"RAY_MALLOC_TYPE_AMOS",m_parameters->showMemoryAllocations());
+
+	if(input>=0)
+		close(input);
+	if(output>=0)
+		close(output);
+
+	if(!failed && copiedBytes!=m_spoolBytes){
+		cout<<"Error: Rank "<<m_parameters->getRank()<<" copied "<<copiedBytes<<" bytes from "<<spool;
+		cout<<" but spooled "<<m_spoolBytes<<" bytes"<<endl;
+		failed=true;
+	}
+
+/*
+ * The spool is kept when the copy failed so that the records are not lost.
+ */
+	if(!failed)
+		unlink(spool.c_str());
+
+	MessageUnit*reply=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+	reply[0]=failed;
+
+	Message aMessage(reply,1,message->getSource(),RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY,m_parameters->getRank());
+	m_outbox->push_back(&aMessage);
+}
+
+void Amos::call_RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY(Message*message){
+	MessageUnit*buffer=message->getBuffer();
+
+	if(buffer[0]==1){
+		cout<<"Error: Rank "<<message->getSource()<<" could not copy its AMOS records to "<<m_parameters->getAmosFile();
+		cout<<", the file is incomplete. The records are kept in "<<m_parameters->getPrefix()<<"Rank"<<message->getSource();
+		cout<<".AMOS.afg.spool"<<endl;
+		m_amosFileIsComplete=false;
+	}
+
+	m_ranksThatCopied++;
 }
 
 void Amos::call_RAY_SLAVE_MODE_AMOS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_AMOS);
+
 	if(!m_ed->m_EXTENSION_initiated){
-		cout<<"Rank "<<m_parameters->getRank()<<" is appending positions to "<<m_parameters->getAmosFile()<<endl;
-		m_amosFile=fopen(m_parameters->getAmosFile().c_str(),"a+");
+		cout<<"Rank "<<m_parameters->getRank()<<" is spooling positions to "<<getSpoolFile()<<endl;
+		m_amosFile=fopen(getSpoolFile().c_str(),"w");
+		m_spoolFailed=false;
+
+		if(m_amosFile==NULL){
+			cout<<"Error: Rank "<<m_parameters->getRank()<<" can not open "<<getSpoolFile()<<endl;
+			m_spoolFailed=true;
+		}
+
 		m_contigId=0;
 		m_mode_send_vertices_sequence_id_position=0;
 		m_ed->m_EXTENSION_initiated=true;
@@ -99,15 +311,32 @@ void Amos::call_RAY_SLAVE_MODE_AMOS(){
 	*            m_mode_send_vertices_sequence_id_position: for the current position in the current contig.
 	*/
 
-	if(m_contigId==(int)m_ed->m_EXTENSION_contigs.size()){// all contigs are processed
-		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
-		message[0]=m_ed->m_EXTENSION_currentPosition;
-		Message aMessage(message,1,MASTER_RANK,RAY_MPI_TAG_WRITE_AMOS_REPLY,m_parameters->getRank());
+	if(m_spoolFailed || m_contigId==(int)m_ed->m_EXTENSION_contigs.size()){// all contigs are processed
+		m_spoolBytes=0;
+
+		if(m_amosFile!=NULL){
+			m_spoolBytes=ftell(m_amosFile);
+
+			bool error=ferror(m_amosFile)!=0;
+
+			if(fclose(m_amosFile)!=0)
+				error=true;
+
+			if(error){
+				cout<<"Error: Rank "<<m_parameters->getRank()<<" could not write "<<getSpoolFile()<<endl;
+				m_spoolFailed=true;
+			}
+		}
+
+		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(3*sizeof(MessageUnit));
+		message[0]=m_spoolBytes;
+		message[1]=m_sequence_id;
+		message[2]=m_spoolFailed;
+		Message aMessage(message,3,MASTER_RANK,RAY_MPI_TAG_WRITE_AMOS_REPLY,m_parameters->getRank());
 		m_outbox->push_back(&aMessage);
-		fclose(m_amosFile);
 		*m_slave_mode=RAY_SLAVE_MODE_DO_NOTHING;
 	// iterate over the next one
-	}else if(m_fusionData->m_FUSION_eliminated.count(m_ed->m_EXTENSION_identifiers[m_contigId])>0){
+	}else if(!isWrittenContig(m_contigId)){
 		m_contigId++;
 		m_mode_send_vertices_sequence_id_position=0;
 		m_ed->m_EXTENSION_reads_requested=false;
@@ -240,10 +469,16 @@ void Amos::registerPlugin(ComputeCore*core){
 	__ConfigureMasterModeHandler(Amos, RAY_MASTER_MODE_AMOS);
 	__ConfigureSlaveModeHandler(Amos, RAY_SLAVE_MODE_AMOS);
 
+	__ConfigureMessageTagHandler(Amos, RAY_MPI_TAG_WRITE_AMOS_REPLY);
+	__ConfigureMessageTagHandler(Amos, RAY_MPI_TAG_COPY_AMOS_SPOOL);
+	__ConfigureMessageTagHandler(Amos, RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY);
+
 	__BindPlugin(Amos);
 }
 
 void Amos::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_AMOS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_AMOS");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
@@ -252,6 +487,5 @@ void Amos::resolveSymbols(ComputeCore*core){
 
 	RAY_MPI_TAG_ASK_READ_LENGTH=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_READ_LENGTH");
 	RAY_MPI_TAG_WRITE_AMOS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_AMOS");
-	RAY_MPI_TAG_WRITE_AMOS_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_AMOS_REPLY");
 	RAY_MPI_TAG_REQUEST_VERTEX_READS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_READS");
 }
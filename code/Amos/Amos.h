@@ -26,6 +26,7 @@
 #include <code/Scaffolder/Scaffolder.h>
 #include <code/SeedExtender/ExtensionData.h>
 #include <code/SeedExtender/ReadFetcher.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/structures/StaticVector.h>
 #include <RayPlatform/memory/RingAllocator.h>
@@ -34,6 +35,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string>
 #include <vector>
 using namespace std;
 
@@ -41,21 +43,34 @@ __DeclarePlugin(Amos);
 
 __DeclareMasterModeAdapter(Amos,RAY_MASTER_MODE_AMOS);
 __DeclareSlaveModeAdapter(Amos,RAY_SLAVE_MODE_AMOS);
+__DeclareMessageTagAdapter(Amos,RAY_MPI_TAG_WRITE_AMOS_REPLY);
+__DeclareMessageTagAdapter(Amos,RAY_MPI_TAG_COPY_AMOS_SPOOL);
+__DeclareMessageTagAdapter(Amos,RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY);
 
 /**
  * AMOS specification is available : http://sourceforge.net/apps/mediawiki/amos/index.php?title=AMOS
  * \see http://sourceforge.net/apps/mediawiki/amos/index.php?title=Message_Types
+ *
+ * All the ranks spool their records at the same time in a private file.
+ * Then, the master gives an offset to each rank in the AMOS file and
+ * ranks copy their spool there with positioned writes.
+ *
  * \author Sébastien Boisvert
  */
 class Amos :  public CorePlugin{
 
 	__AddAdapter(Amos,RAY_MASTER_MODE_AMOS);
 	__AddAdapter(Amos,RAY_SLAVE_MODE_AMOS);
+	__AddAdapter(Amos,RAY_MPI_TAG_WRITE_AMOS_REPLY);
+	__AddAdapter(Amos,RAY_MPI_TAG_COPY_AMOS_SPOOL);
+	__AddAdapter(Amos,RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY);
 
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS;
 	MessageTag RAY_MPI_TAG_ASK_READ_LENGTH;
 	MessageTag RAY_MPI_TAG_WRITE_AMOS;
 	MessageTag RAY_MPI_TAG_WRITE_AMOS_REPLY;
+	MessageTag RAY_MPI_TAG_COPY_AMOS_SPOOL;
+	MessageTag RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY;
 
 	MasterMode RAY_MASTER_MODE_AMOS;
 	MasterMode RAY_MASTER_MODE_SCAFFOLDER;
@@ -81,9 +96,28 @@ class Amos :  public CorePlugin{
 	ExtensionData*m_ed;
 	int m_mode_send_vertices_sequence_id_position;
 	vector<WorkerHandle> m_activeWorkers;
+	uint64_t m_spoolBytes;
+	bool m_spoolFailed;
+
+/*
+ * State of the master.
+ */
+	vector<uint64_t> m_spooledBytes;
+	int m_ranksThatSpooled;
+	int m_ranksThatCopied;
+	bool m_copyStarted;
+	bool m_amosFileIsComplete;
+
+	string getSpoolFile();
+	bool isWrittenContig(int contig);
+	Instrumentation*m_instrumentation;
+
 public:
 	void call_RAY_MASTER_MODE_AMOS();
 	void call_RAY_SLAVE_MODE_AMOS();
+	void call_RAY_MPI_TAG_WRITE_AMOS_REPLY(Message*message);
+	void call_RAY_MPI_TAG_COPY_AMOS_SPOOL(Message*message);
+	void call_RAY_MPI_TAG_COPY_AMOS_SPOOL_REPLY(Message*message);
 	void constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*outbox,
 		FusionData*fusionData,ExtensionData*extensionData,int*masterMode,int*slaveMode,Scaffolder*scaffolder,
 StaticVector*inbox,VirtualCommunicator*virtualCommunicator);
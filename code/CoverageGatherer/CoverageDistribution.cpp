@@ -84,6 +84,16 @@ CoverageDistribution::CoverageDistribution(map<CoverageDepth,LargeCount>*distrib
 			votes[largestPosition]++;
 	}
 
+	/** without votes (small distributions), use the largest frequency */
+	if(votes.size()==0){
+		int largestPosition=0;
+		for(int i=0;i<(int)y.size();i++){
+			if(y[i]>y[largestPosition])
+				largestPosition=i;
+		}
+		votes[largestPosition]++;
+	}
+
 	/** check votes */
 	int largestPosition=votes.begin()->first;
 	for(map<int,int>::iterator i=votes.begin();i!=votes.end();i++){
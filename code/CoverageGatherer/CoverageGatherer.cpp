@@ -30,12 +30,17 @@
 #include <RayPlatform/core/slave_modes.h>
 #include <RayPlatform/communication/Message.h>
 #include <RayPlatform/communication/mpi_tags.h>
+#include <RayPlatform/structures/MyHashTableIterator.h>
 
 #include <sstream>
 #include <stdio.h>
 #include <stdint.h>
 using namespace std;
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #ifdef CONFIG_ASSERT
 #include <assert.h>
 #endif
@@ -43,186 +48,271 @@ using namespace std;
 __CreatePlugin(CoverageGatherer);
 
 __CreateSlaveModeAdapter(CoverageGatherer,RAY_SLAVE_MODE_SEND_DISTRIBUTION);
+__CreateMessageTagAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_DATA);
+__CreateMessageTagAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_END);
+
+/*
+ * One line per k-mer: sequence;coverage;parents;children
+ */
+void CoverageGatherer::writeKmer(ostringstream*buffer,Vertex*node,Kmer*key){
+	int wordSize=m_parameters->getWordSize();
+	bool colorSpace=m_parameters->getColorSpaceMode();
+
+	CoverageDepth coverage=m_subgraph->getCoverage(node);
+	string kmerSequence=key->idToWord(wordSize,colorSpace);
+	vector<Kmer> parents=node->getIngoingEdges(key,wordSize);
+	vector<Kmer> children=node->getOutgoingEdges(key,wordSize);
+
+	(*buffer) << kmerSequence << ";" << coverage << ";";
+	for(int i=0;i<(int)parents.size();i++){
+		string printableVersion=parents[i].idToWord(wordSize,colorSpace);
+		if(i!=0)
+			(*buffer) << " ";
+
+		(*buffer) << printableVersion[0];
+	}
+	(*buffer) << ";";
+	for(int i=0;i<(int)children.size();i++){
+		string printableVersion=children[i].idToWord(wordSize,colorSpace);
+		if(i!=0)
+			(*buffer) << " ";
+
+		(*buffer) << printableVersion[wordSize-1];
+	}
+	(*buffer) << endl;
+}
+
+/*
+ * The lines are formatted a first time to count their bytes, so that
+ * the master can give each rank its offset in kmers.txt.
+ */
+uint64_t CoverageGatherer::computeRequiredSpaceForKmers(){
+	ostringstream testBuffer;
+	uint64_t requiredBytes=0;
+	int threshold=1024*1024*1; // 1 MiB
+
+	if(m_parameters->getRank()==MASTER_RANK)
+		writeHeader(&testBuffer);
+
+	GridTableIterator iterator;
+	iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
+
+	while(iterator.hasNext()){
+		Vertex*node=iterator.next();
+		Kmer key=*(iterator.getKey());
+
+		writeKmer(&testBuffer,node,&key);
+
+		if(testBuffer.tellp()>=threshold){
+			requiredBytes+=testBuffer.tellp();
+			testBuffer.str("");
+		}
+	}
+
+	requiredBytes+=testBuffer.tellp();
 
-void CoverageGatherer::writeKmers(){
+	return requiredBytes;
+}
+
+/*
+ * All the ranks write at the same time with positioned writes (pwrite),
+ * each one in its own range of kmers.txt.
+ */
+bool CoverageGatherer::writeKmers(uint64_t offset){
 	#ifdef CONFIG_ASSERT
 	LargeCount n=0;
 	#endif
 
-	if(m_subgraph->size()==0){
-		(*m_slaveMode)=RAY_SLAVE_MODE_DO_NOTHING;
-		Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_COVERAGE_END,
-			m_parameters->getRank());
-		m_outbox->push_back(&aMessage);
-		return;
+	ostringstream name;
+	name<<m_parameters->getPrefix()<<"/kmers.txt";
+
+/*
+ * O_TRUNC must not be used because other ranks may already be writing.
+ */
+	int kmerFile=open(name.str().c_str(),O_WRONLY|O_CREAT,S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
+
+	if(kmerFile<0){
+		cout<<"Error: Rank "<<m_parameters->getRank()<<" can not open "<<name.str()<<endl;
+		return false;
 	}
+
 	GridTableIterator iterator;
 	iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
-	FILE* kmerFile=NULL;
 	ostringstream buffer;
-	ostringstream name;
-	name<<m_parameters->getPrefix()<<"/kmers.txt";
-	if(m_parameters->getRank()==0)
-		kmerFile=fopen(name.str().c_str(),"w"); // create empty file
-	else
-		kmerFile=fopen(name.str().c_str(),"a"); // append to file
+	bool failed=false;
 
 	if(m_parameters->getRank()==MASTER_RANK)
-		writeHeader(kmerFile);
+		writeHeader(&buffer);
 
-	while(iterator.hasNext()){
+	while(!failed && iterator.hasNext()){
 		Vertex*node=iterator.next();
 		Kmer key=*(iterator.getKey());
-		CoverageDepth coverage=node->getCoverage(&key);
-		m_distributionOfCoverage[coverage]++;
 		#ifdef CONFIG_ASSERT
 		n++;
 		#endif
-		string kmerSequence=key.idToWord(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-		vector<Kmer> parents=node->getIngoingEdges(&key,m_parameters->getWordSize());
-		vector<Kmer> children=node->getOutgoingEdges(&key,m_parameters->getWordSize());
-
-		//fprintf(kmerFile,"%s;%i;",kmerSequence.c_str(),coverage);
-		buffer << kmerSequence << ";" << coverage << ";";
-		for(int i=0;i<(int)parents.size();i++){
-			string printableVersion=parents[i].idToWord(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-			if(i!=0)
-				buffer << " ";
-				//fprintf(kmerFile," ");
-
-			//fprintf(kmerFile,"%c",printableVersion[0]);
-			buffer << printableVersion[0];
-		}
-		//fprintf(kmerFile,";");
-		buffer << ";";
-		for(int i=0;i<(int)children.size();i++){
-			string printableVersion=children[i].idToWord(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-			if(i!=0)
-				buffer << " ";
-				//fprintf(kmerFile," ");
-
-			//fprintf(kmerFile,"%c",printableVersion[m_parameters->getWordSize()-1]);
-			buffer << printableVersion[m_parameters->getWordSize()-1];
-		}
-		//fprintf("\n");
-		buffer << endl;
-		flushFileOperationBuffer_FILE(false, &buffer, kmerFile, CONFIG_FILE_IO_BUFFER_SIZE);
+
+		writeKmer(&buffer,node,&key);
+		flushFileOperationBuffer_pwrite(false,&buffer,kmerFile,&offset,CONFIG_FILE_IO_BUFFER_SIZE,&failed);
 	}
-	flushFileOperationBuffer_FILE(true, &buffer, kmerFile, CONFIG_FILE_IO_BUFFER_SIZE);
-	fclose(kmerFile);
+
+	if(!failed)
+		flushFileOperationBuffer_pwrite(true,&buffer,kmerFile,&offset,CONFIG_FILE_IO_BUFFER_SIZE,&failed);
+
+	close(kmerFile);
 
 	#ifdef CONFIG_ASSERT
-	if(n!=m_subgraph->size()){
+	if(!failed && n!=m_subgraph->size()){
 		cout<<"n="<<n<<" size="<<m_subgraph->size()<<endl;
 	}
-	assert(n==m_subgraph->size());
+	assert(failed || n==m_subgraph->size());
 	#endif
-	m_waiting=false;
-	m_coverageIterator=m_distributionOfCoverage.begin();
+
+	return !failed;
 }
 
-void CoverageGatherer::call_RAY_SLAVE_MODE_SEND_DISTRIBUTION(){
+/*
+ * One pass over the hash table. Each entry holds a pair of
+ * reverse-complement k-mers with the same coverage.
+ */
+void CoverageGatherer::buildHistogram(){
+	#ifdef CONFIG_ASSERT
+	LargeCount n=0;
+	#endif
 
-	if(m_distributionOfCoverage.size()==0){
-		#ifdef CONFIG_ASSERT
-		LargeCount n=0;
-		#endif
+	for(int shard=0;shard<m_subgraph->getNumberOfShards();shard++){
+		MyHashTableIterator<Kmer,Vertex> iterator;
+		iterator.constructor(m_subgraph->getHashTable(shard));
 
-		if(m_subgraph->size()==0){
-			(*m_slaveMode)=RAY_SLAVE_MODE_DO_NOTHING;
-			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_COVERAGE_END,
-				m_parameters->getRank());
-			m_outbox->push_back(&aMessage);
-			return;
-		}
-		GridTableIterator iterator;
-		iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
 		while(iterator.hasNext()){
 			Vertex*node=iterator.next();
-			Kmer key=*(iterator.getKey());
-			CoverageDepth coverage=node->getCoverage(&key);
-			m_distributionOfCoverage[coverage]++;
+			Kmer key=node->getKey();
+			m_histogram.add(m_subgraph->getCoverage(node),2);
 
 			#ifdef CONFIG_ASSERT
-			n++;
+			n+=2;
 			#endif
 		}
+	}
+
+	#ifdef CONFIG_ASSERT
+	if(n!=m_subgraph->size()){
+		cout<<"Expected (from iterator)="<<n<<" Actual (->size())="<<m_subgraph->size()<<endl;
+	}
+	assert(n==m_subgraph->size());
+	#endif
+
+	Rank rank=m_parameters->getRank();
+	m_children=0;
+
+	if(2*rank+1<m_parameters->getSize())
+		m_children++;
+	if(2*rank+2<m_parameters->getSize())
+		m_children++;
+
+	m_coverageIterator=0;
+	m_waiting=false;
+	m_histogramIsReady=true;
+}
+
+void CoverageGatherer::call_RAY_SLAVE_MODE_SEND_DISTRIBUTION(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_SEND_DISTRIBUTION);
+
+	if(!m_histogramIsReady){
+		buildHistogram();
+	}else if(m_childrenDone<m_children){
+		/* the histograms of the subtree are not all there */
+	}else if(m_parameters->getRank()==MASTER_RANK){
+
+		m_histogram.getDistribution(m_coverageDistribution);
+		m_histogram.clear();
+
+		(*m_slaveMode)=RAY_SLAVE_MODE_DO_NOTHING;
+		m_core->getSwitchMan()->closeMasterMode();
 
-		#ifdef CONFIG_ASSERT
-		if(n!=m_subgraph->size()){
-			cout<<"Expected (from iterator)="<<n<<" Actual (->size())="<<m_subgraph->size()<<endl;
-		}
-		assert(n==m_subgraph->size());
-		#endif
-		m_waiting=false;
-		m_coverageIterator=m_distributionOfCoverage.begin();
 	}else if(m_waiting){
 		if((*m_inbox).size()>0&&(*m_inbox)[0]->getTag()==RAY_MPI_TAG_COVERAGE_DATA_REPLY){
 			m_waiting=false;
 		}
 	}else{
+		Rank parent=(m_parameters->getRank()-1)/2;
 		MessageUnit*messageContent=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
-		int count=0;
 		int maximumElements=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
-		while(count<maximumElements && m_coverageIterator!=m_distributionOfCoverage.end()){
-			CoverageDepth coverage=m_coverageIterator->first;
-			LargeCount numberOfVertices=m_coverageIterator->second;
-			messageContent[count]=coverage;
-			messageContent[count+1]=numberOfVertices;
-			count+=2;
-			m_coverageIterator++;
-		}
+		int count=m_histogram.pack(messageContent,maximumElements,&m_coverageIterator);
 
 		if(count!=0){
-			Message aMessage(messageContent,count,MASTER_RANK,RAY_MPI_TAG_COVERAGE_DATA,
+			Message aMessage(messageContent,count,parent,RAY_MPI_TAG_COVERAGE_DATA,
 				m_parameters->getRank());
 
 			m_outbox->push_back(&aMessage);
 			m_waiting=true;
 		}else{
-			m_distributionOfCoverage.clear();
+			m_histogram.clear();
 			(*m_slaveMode)=RAY_SLAVE_MODE_DO_NOTHING;
-			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_COVERAGE_END,
+			Message aMessage(NULL,0,parent,RAY_MPI_TAG_COVERAGE_END,
 				m_parameters->getRank());
 			m_outbox->push_back(&aMessage);
 		}
 	}
 }
 
+/*
+ * Pairs from a child in the reduction tree.
+ */
+void CoverageGatherer::call_RAY_MPI_TAG_COVERAGE_DATA(Message*message){
+	m_histogram.unpack(message->getBuffer(),message->getCount());
+
+	Message aMessage(NULL,0,message->getSource(),RAY_MPI_TAG_COVERAGE_DATA_REPLY,
+		m_parameters->getRank());
+	m_outbox->push_back(&aMessage);
+}
+
+void CoverageGatherer::call_RAY_MPI_TAG_COVERAGE_END(Message*message){
+	m_childrenDone++;
+}
+
 void CoverageGatherer::constructor(Parameters*parameters,StaticVector*inbox,StaticVector*outbox,int*slaveMode,
-	GridTable*subgraph,RingAllocator*outboxAllocator){
+	GridTable*subgraph,RingAllocator*outboxAllocator,map<CoverageDepth,LargeCount>*coverageDistribution){
 	m_parameters=parameters;
 	m_slaveMode=slaveMode;
 	m_outboxAllocator=outboxAllocator;
 	m_inbox=inbox;
 	m_outbox=outbox;
 	m_subgraph=subgraph;
+	m_coverageDistribution=coverageDistribution;
+
+	/* children may send their pairs before this rank starts */
+	m_histogram.constructor();
+	m_histogramIsReady=false;
+	m_children=0;
+	m_childrenDone=0;
+	m_coverageIterator=0;
+	m_waiting=false;
 }
 
-void CoverageGatherer::writeHeader(FILE*kmerFile){
+void CoverageGatherer::writeHeader(ostringstream*buffer){
 
-	fprintf(kmerFile,"# Generated by Ray %s\n",CONFIG_RAY_VERSION);
-	fprintf(kmerFile,"# The length of k-mers is %i\n",m_parameters->getWordSize());
+	(*buffer)<<"# Generated by Ray "<<CONFIG_RAY_VERSION<<"\n";
+	(*buffer)<<"# The length of k-mers is "<<m_parameters->getWordSize()<<"\n";
 	if(m_parameters->getColorSpaceMode())
-		fprintf(kmerFile,"# This file contains the k-mer graph (subgraph of the de Bruijn graph for alphabet={0,1,2,3})\n");
+		(*buffer)<<"# This file contains the k-mer graph (subgraph of the de Bruijn graph for alphabet={0,1,2,3})\n";
 	else
-		fprintf(kmerFile,"# This file contains the k-mer graph (subgraph of the de Bruijn graph for alphabet={A,C,G,T})\n");
-	fprintf(kmerFile,"# The genome sequence you are looking for is a path in this maze\n");
-	fprintf(kmerFile,"# You can kickstart your assembly algorithm development by loading this file\n");
-	fprintf(kmerFile,"# Note that vertices with a coverage of 1 are not considered.\n");
-	fprintf(kmerFile,"# Format:\n");
+		(*buffer)<<"# This file contains the k-mer graph (subgraph of the de Bruijn graph for alphabet={A,C,G,T})\n";
+	(*buffer)<<"# The genome sequence you are looking for is a path in this maze\n";
+	(*buffer)<<"# You can kickstart your assembly algorithm development by loading this file\n";
+	(*buffer)<<"# Note that vertices with a coverage of 1 are not considered.\n";
+	(*buffer)<<"# Format:\n";
 	if(m_parameters->getColorSpaceMode())
-		fprintf(kmerFile,"# k-mer color sequence; coverage value; first color of parents; last color of children\n");
+		(*buffer)<<"# k-mer color sequence; coverage value; first color of parents; last color of children\n";
 	else
-		fprintf(kmerFile,"# k-mer nucleotide sequence; coverage value; first nucleotide of parents; last nucleotide of children\n");
+		(*buffer)<<"# k-mer nucleotide sequence; coverage value; first nucleotide of parents; last nucleotide of children\n";
 	if(m_parameters->getColorSpaceMode()){
-		fprintf(kmerFile,"# Example in color space:\n# 0312;10;3 2;1 0\n#  0312 has a coverage value of 10\n");
-		fprintf(kmerFile,"#  Ingoing arcs: 3031 -> 0312 and 2031 -> 0312\n");
-		fprintf(kmerFile,"#  Outgoing arcs: 0312 -> 3121 and 0312 -> 3120\n");
+		(*buffer)<<"# Example in color space:\n# 0312;10;3 2;1 0\n#  0312 has a coverage value of 10\n";
+		(*buffer)<<"#  Ingoing arcs: 3031 -> 0312 and 2031 -> 0312\n";
+		(*buffer)<<"#  Outgoing arcs: 0312 -> 3121 and 0312 -> 3120\n";
 	}else{
-		fprintf(kmerFile,"# Example in nucleotide space:\n# ATCG;10;T G;C A\n#  ATCG has a coverage value of 10\n");
-		fprintf(kmerFile,"#  Ingoing arcs: TATC -> ATCG and GATC -> ATCG\n");
-		fprintf(kmerFile,"#  Outgoing arcs: ATCG -> TCGC and ATCG -> TCGA\n");
+		(*buffer)<<"# Example in nucleotide space:\n# ATCG;10;T G;C A\n#  ATCG has a coverage value of 10\n";
+		(*buffer)<<"#  Ingoing arcs: TATC -> ATCG and GATC -> ATCG\n";
+		(*buffer)<<"#  Outgoing arcs: ATCG -> TCGC and ATCG -> TCGA\n";
 	}
 
 }
@@ -239,6 +329,9 @@ void CoverageGatherer::registerPlugin(ComputeCore*core){
 
 	__ConfigureSlaveModeHandler(CoverageGatherer, RAY_SLAVE_MODE_SEND_DISTRIBUTION);
 
+	__ConfigureMessageTagHandler(CoverageGatherer, RAY_MPI_TAG_COVERAGE_DATA);
+	__ConfigureMessageTagHandler(CoverageGatherer, RAY_MPI_TAG_COVERAGE_END);
+
 	RAY_MPI_TAG_COVERAGE_DATA_REPLY=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_COVERAGE_DATA_REPLY,"RAY_MPI_TAG_COVERAGE_DATA_REPLY");
 
@@ -255,13 +348,11 @@ void CoverageGatherer::registerPlugin(ComputeCore*core){
 }
 
 void CoverageGatherer::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_SEND_DISTRIBUTION=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_SEND_DISTRIBUTION");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
-	RAY_MPI_TAG_COVERAGE_DATA=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COVERAGE_DATA");
-	RAY_MPI_TAG_COVERAGE_DATA_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COVERAGE_DATA_REPLY");
-	RAY_MPI_TAG_COVERAGE_END=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COVERAGE_END");
-
 	RAY_MPI_TAG_COVERAGE_DATA_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COVERAGE_DATA_REPLY");
 	RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION_REPLY");
 	RAY_MPI_TAG_GET_COVERAGE_AND_MARK_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_COVERAGE_AND_MARK_REPLY");
@@ -22,8 +22,11 @@
 #ifndef _CoverageGatherer_H
 #define _CoverageGatherer_H
 
+#include "CoverageHistogram.h"
+
 #include <code/Mock/Parameters.h>
 #include <code/VerticesExtractor/GridTable.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/memory/RingAllocator.h>
 #include <RayPlatform/structures/StaticVector.h>
@@ -31,18 +34,28 @@
 
 #include <stdint.h>
 #include <map>
+#include <sstream>
 using namespace std;
 
 __DeclarePlugin(CoverageGatherer);
 
 __DeclareSlaveModeAdapter(CoverageGatherer,RAY_SLAVE_MODE_SEND_DISTRIBUTION);
+__DeclareMessageTagAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_DATA);
+__DeclareMessageTagAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_END);
 
 /**
+ * The coverage distribution is reduced along a binary tree:
+ * rank r merges the histograms of ranks 2r+1 and 2r+2 in its own
+ * and then sends it to rank (r-1)/2. Rank 0 gets the distribution
+ * after log2(ranks) steps instead of receiving the pairs of every rank.
+ *
  * \author Sébastien Boisvert
  */
 class CoverageGatherer : public CorePlugin{
 
 	__AddAdapter(CoverageGatherer,RAY_SLAVE_MODE_SEND_DISTRIBUTION);
+	__AddAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_DATA);
+	__AddAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_END);
 
 	MessageTag RAY_MPI_TAG_COVERAGE_DATA_REPLY;
 	MessageTag RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION_REPLY;
@@ -56,8 +69,13 @@ class CoverageGatherer : public CorePlugin{
 	SlaveMode RAY_SLAVE_MODE_SEND_DISTRIBUTION;
 
 
-	map<CoverageDepth,LargeCount> m_distributionOfCoverage;
-	map<CoverageDepth,LargeCount>::iterator m_coverageIterator;
+	CoverageHistogram m_histogram;
+	bool m_histogramIsReady;
+	int m_children;
+	int m_childrenDone;
+	uint64_t m_coverageIterator;
+	map<CoverageDepth,LargeCount>*m_coverageDistribution;
+
 	bool m_waiting;
 	Parameters*m_parameters;
 	StaticVector*m_inbox;
@@ -66,13 +84,24 @@ class CoverageGatherer : public CorePlugin{
 	GridTable*m_subgraph;
 	RingAllocator*m_outboxAllocator;
 
-	void writeHeader(FILE*kmerFile);
+	void writeHeader(ostringstream*buffer);
+	void writeKmer(ostringstream*buffer,Vertex*node,Kmer*key);
+	void buildHistogram();
+
+	Instrumentation*m_instrumentation;
 
 public:
 	void constructor(Parameters*parameters,StaticVector*inbox,StaticVector*outbox,int*slaveMode,
-		GridTable*subgraph,RingAllocator*outboxAllocator);
+		GridTable*subgraph,RingAllocator*outboxAllocator,map<CoverageDepth,LargeCount>*coverageDistribution);
 	void call_RAY_SLAVE_MODE_SEND_DISTRIBUTION();
-	void writeKmers();
+	void call_RAY_MPI_TAG_COVERAGE_DATA(Message*message);
+	void call_RAY_MPI_TAG_COVERAGE_END(Message*message);
+
+	/** the number of bytes of the lines of this rank in kmers.txt */
+	uint64_t computeRequiredSpaceForKmers();
+
+	/** writes the lines of this rank at offset in kmers.txt, returns false on error */
+	bool writeKmers(uint64_t offset);
 
 	void registerPlugin(ComputeCore*core);
 
@@ -0,0 +1,79 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "CoverageHistogram.h"
+
+#include <string.h>
+
+void CoverageHistogram::constructor(){
+	clear();
+}
+
+void CoverageHistogram::clear(){
+	memset(m_bins,0,COVERAGE_HISTOGRAM_DENSE_VALUES*sizeof(LargeCount));
+	m_tail.clear();
+}
+
+void CoverageHistogram::add(CoverageDepth coverage,LargeCount count){
+	if(coverage<COVERAGE_HISTOGRAM_DENSE_VALUES)
+		m_bins[coverage]+=count;
+	else
+		m_tail[coverage]+=count;
+}
+
+int CoverageHistogram::pack(MessageUnit*buffer,int maximumUnits,uint64_t*coverage){
+	int units=0;
+
+	while(units+2<=maximumUnits && *coverage<COVERAGE_HISTOGRAM_DENSE_VALUES){
+		if(m_bins[*coverage]>0){
+			buffer[units++]=*coverage;
+			buffer[units++]=m_bins[*coverage];
+		}
+		(*coverage)++;
+	}
+
+	map<CoverageDepth,LargeCount>::iterator i=m_tail.lower_bound(*coverage);
+
+	while(units+2<=maximumUnits && i!=m_tail.end()){
+		buffer[units++]=i->first;
+		buffer[units++]=i->second;
+		*coverage=(uint64_t)i->first+1;
+		i++;
+	}
+
+	return units;
+}
+
+void CoverageHistogram::unpack(MessageUnit*buffer,int units){
+	for(int i=0;i+1<units;i+=2)
+		add(buffer[i],buffer[i+1]);
+}
+
+void CoverageHistogram::getDistribution(map<CoverageDepth,LargeCount>*distribution){
+	distribution->clear();
+
+	for(int i=0;i<COVERAGE_HISTOGRAM_DENSE_VALUES;i++){
+		if(m_bins[i]>0)
+			(*distribution)[i]=m_bins[i];
+	}
+
+	for(map<CoverageDepth,LargeCount>::iterator i=m_tail.begin();i!=m_tail.end();i++)
+		(*distribution)[i->first]=i->second;
+}
@@ -0,0 +1,70 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _CoverageHistogram_H
+#define _CoverageHistogram_H
+
+#include <code/Mock/constants.h>
+
+#include <RayPlatform/communication/Message.h>
+
+#include <stdint.h>
+#include <map>
+using namespace std;
+
+/* coverage values below this one have a dense bin */
+#define COVERAGE_HISTOGRAM_DENSE_VALUES 4096
+
+/**
+ * Frequencies of coverage depths.
+ *
+ * Coverage depths below COVERAGE_HISTOGRAM_DENSE_VALUES are counted
+ * in an array, the others (repeats, organelles) in a small sorted tail.
+ * Adding a value does not allocate memory for the usual k-mers and
+ * non-empty bins are packed in messages in increasing order of coverage.
+ *
+ * \author agent
+ */
+class CoverageHistogram{
+
+	LargeCount m_bins[COVERAGE_HISTOGRAM_DENSE_VALUES];
+	map<CoverageDepth,LargeCount> m_tail;
+
+public:
+
+	void constructor();
+	void clear();
+
+	void add(CoverageDepth coverage,LargeCount count);
+
+	/**
+	 * Packs (coverage, frequency) pairs with a coverage of at least
+	 * *coverage and updates *coverage for the next call.
+	 * Returns the number of message units written, 0 when done.
+	 */
+	int pack(MessageUnit*buffer,int maximumUnits,uint64_t*coverage);
+
+	/** adds the pairs packed by another rank */
+	void unpack(MessageUnit*buffer,int units);
+
+	void getDistribution(map<CoverageDepth,LargeCount>*distribution);
+};
+
+#endif
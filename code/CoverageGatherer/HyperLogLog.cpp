@@ -0,0 +1,69 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "HyperLogLog.h"
+
+#include <math.h>
+
+void HyperLogLog::constructor(){
+	for(int i=0;i<(1<<HYPER_LOG_LOG_PRECISION);i++)
+		m_registers[i]=0;
+}
+
+/*
+ * The first bits select the register, the register keeps the largest
+ * position of the first set bit in the other bits.
+ */
+void HyperLogLog::add(uint64_t hashValue){
+	int index=hashValue>>(64-HYPER_LOG_LOG_PRECISION);
+	uint64_t bits=hashValue<<HYPER_LOG_LOG_PRECISION;
+
+	uint8_t rank=1;
+	while(rank<=64-HYPER_LOG_LOG_PRECISION && !(bits&(((uint64_t)1)<<63))){
+		bits<<=1;
+		rank++;
+	}
+
+	if(rank>m_registers[index])
+		m_registers[index]=rank;
+}
+
+uint64_t HyperLogLog::getEstimate()const{
+	int registers=1<<HYPER_LOG_LOG_PRECISION;
+	double alpha=0.7213/(1.0+1.079/registers);
+
+	double sum=0;
+	int emptyRegisters=0;
+
+	for(int i=0;i<registers;i++){
+		sum+=ldexp(1.0,-m_registers[i]);
+
+		if(m_registers[i]==0)
+			emptyRegisters++;
+	}
+
+	double estimate=alpha*registers*registers/sum;
+
+	// small cardinalities are better estimated with linear counting
+	if(estimate<=2.5*registers && emptyRegisters>0)
+		estimate=registers*log((double)registers/emptyRegisters);
+
+	return (uint64_t)estimate;
+}
@@ -0,0 +1,51 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _HyperLogLog_h
+#define _HyperLogLog_h
+
+#include <stdint.h>
+
+/** 2^14 registers, the standard error is 1.04/sqrt(2^14) = 0.8% */
+#define HYPER_LOG_LOG_PRECISION 14
+
+/**
+ * Estimates the number of distinct values with a fixed amount
+ * of memory (one byte per register).
+ * Values are given as 64-bit hash values.
+ *
+ * \see http://en.wikipedia.org/wiki/HyperLogLog
+ * \author agent
+ */
+class HyperLogLog{
+
+	uint8_t m_registers[1<<HYPER_LOG_LOG_PRECISION];
+
+public:
+
+	void constructor();
+
+	void add(uint64_t hashValue);
+
+	/** estimated number of distinct hash values added */
+	uint64_t getEstimate()const;
+};
+
+#endif
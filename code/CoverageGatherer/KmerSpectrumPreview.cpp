@@ -0,0 +1,404 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "KmerSpectrumPreview.h"
+#include "CoverageDistribution.h"
+
+#include <code/Mock/common_functions.h>
+#include <code/SequencesLoader/FastaLoaderForReads.h>
+#include <code/SequencesLoader/FastqLoader.h>
+#include <code/SequencesLoader/Loader.h>
+#include <code/VerticesExtractor/Vertex.h>
+
+#include <ctype.h>
+#include <math.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+void KmerSpectrumPreview::constructor(Parameters*parameters){
+	m_parameters=parameters;
+	m_kmerLength=m_parameters->getWordSize();
+
+	m_distinctKmers.constructor();
+	m_sampledKmers.clear();
+	m_samplingBits=0;
+
+	m_reads=0;
+	m_kmers=0;
+	m_inputBytes=0;
+	m_sampledBytes=0;
+}
+
+void KmerSpectrumPreview::addSequence(const char*sequence){
+
+	char memory[CONFIG_MAXKMERLENGTH+1];
+	bool colorSpace=m_parameters->getColorSpaceMode();
+	int length=strlen(sequence);
+
+	for(int position=0;position+m_kmerLength<=length;position++){
+		for(int i=0;i<m_kmerLength;i++)
+			memory[i]=toupper(sequence[position+i]);
+		memory[m_kmerLength]='\0';
+
+		if(!isValidDNA(memory))
+			continue;
+
+		Kmer kmer=wordId(memory);
+		Kmer reverseKmer=kmer.complementVertex(m_kmerLength,colorSpace);
+
+		if(reverseKmer<kmer)
+			kmer=reverseKmer;
+
+		addKmer(&kmer);
+	}
+}
+
+/*
+ * Only the lower k-mer of a k-mer and its reverse complement is counted,
+ * like in KmerAcademyBuilder.
+ */
+void KmerSpectrumPreview::addKmer(Kmer*kmer){
+
+	m_kmers++;
+	m_distinctKmers.add(kmer->hash_function_1());
+
+	uint64_t mask=(((uint64_t)1)<<m_samplingBits)-1;
+
+	if((kmer->hash_function_2()&mask)!=0)
+		return;
+
+	m_sampledKmers[*kmer]++;
+
+	if(m_sampledKmers.size()>CONFIG_SPECTRUM_PREVIEW_SAMPLED_KMERS)
+		increaseSamplingRate();
+}
+
+void KmerSpectrumPreview::increaseSamplingRate(){
+
+	m_samplingBits++;
+	uint64_t mask=(((uint64_t)1)<<m_samplingBits)-1;
+
+	map<Kmer,int>::iterator i=m_sampledKmers.begin();
+
+	while(i!=m_sampledKmers.end()){
+		if((i->first.hash_function_2()&mask)!=0)
+			m_sampledKmers.erase(i++);
+		else
+			i++;
+	}
+}
+
+/*
+ * Loader reads the whole file, so this is only for the files that
+ * readWindows can not read. The reads are taken at regular intervals.
+ */
+bool KmerSpectrumPreview::readFile(string file,double fraction){
+
+	FastqLoader fastq;
+	FastaLoaderForReads fasta;
+
+	if(fastq.checkFileType(file.c_str()))
+		return readWindows(file,fraction,4,'@');
+
+	if(fasta.checkFileType(file.c_str()))
+		return readWindows(file,fraction,2,'>');
+
+	struct stat information;
+	if(stat(file.c_str(),&information)!=0)
+		return false;
+
+	Loader loader;
+	loader.constructor(m_parameters->getMemoryPrefix().c_str(),m_parameters->showMemoryAllocations(),
+		m_parameters->getRank());
+
+	if(loader.load(file,false)==EXIT_FAILURE)
+		return false;
+
+	LargeCount reads=(LargeCount)ceil(fraction*loader.size());
+	if(reads>loader.size())
+		reads=loader.size();
+
+	char sequence[RAY_MAXIMUM_READ_LENGTH+1];
+	bool colorSpace=m_parameters->getColorSpaceMode();
+	LargeCount sampled=0;
+
+	// the reads are loaded in order, so they are all visited
+	for(LargeIndex i=0;i<loader.size() && sampled<reads;i++){
+		Read*read=loader.at(i);
+
+		if((i*reads)/loader.size()<sampled)
+			continue;
+
+		read->getSeq(sequence,colorSpace,false);
+		addSequence(sequence);
+		sampled++;
+	}
+
+	m_reads+=sampled;
+	m_inputBytes+=information.st_size;
+
+	if(loader.size()>0)
+		m_sampledBytes+=(uint64_t)((double)information.st_size*sampled/loader.size());
+
+	cout<<"Rank "<<m_parameters->getRank()<<" sampled "<<sampled<<" of "<<loader.size();
+	cout<<" sequences in "<<file<<endl;
+
+	loader.reset();
+	loader.clear();
+
+	return true;
+}
+
+/*
+ * A record starts with the header character, and a FASTQ record has
+ * a '+' line after its sequence. This finds the first record after
+ * a seek in the middle of a file.
+ */
+bool KmerSpectrumPreview::isRecord(deque<string>*lines,int period,char header){
+
+	if(lines->at(0).length()==0 || lines->at(0)[0]!=header)
+		return false;
+
+	if(period==4 && (lines->at(2).length()==0 || lines->at(2)[0]!='+'))
+		return false;
+
+	return true;
+}
+
+/*
+ * Each window gets the records that start in its first fraction of
+ * bytes, the other bytes of the window are not read.
+ */
+bool KmerSpectrumPreview::readWindows(string file,double fraction,int period,char header){
+
+	struct stat information;
+	if(stat(file.c_str(),&information)!=0)
+		return false;
+
+	ifstream f(file.c_str());
+	if(!f.is_open())
+		return false;
+
+	uint64_t size=information.st_size;
+	uint64_t windows=CONFIG_SPECTRUM_PREVIEW_WINDOWS;
+	if(size<windows)
+		windows=1;
+
+	uint64_t windowBytes=size/windows;
+	uint64_t budget=(uint64_t)ceil(fraction*windowBytes);
+
+	LargeCount reads=0;
+	uint64_t sampledBytes=0;
+
+	for(uint64_t window=0;window<windows;window++){
+		uint64_t position=window*windowBytes;
+
+		f.clear();
+		f.seekg(position);
+
+		string line;
+
+		// the first line is probably not complete
+		if(position>0 && getline(f,line))
+			position+=line.length()+1;
+
+		uint64_t windowEnd=window*windowBytes+budget;
+		deque<string> lines;
+
+		while(position<windowEnd){
+			while((int)lines.size()<period && getline(f,line))
+				lines.push_back(line);
+
+			if((int)lines.size()<period)
+				break;
+
+			if(!isRecord(&lines,period,header)){
+				position+=lines.front().length()+1;
+				lines.pop_front();
+				continue;
+			}
+
+			addSequence(lines[1].c_str());
+			reads++;
+
+			for(int i=0;i<period;i++){
+				position+=lines[i].length()+1;
+				sampledBytes+=lines[i].length()+1;
+			}
+
+			lines.clear();
+		}
+	}
+
+	f.close();
+
+	m_reads+=reads;
+	m_inputBytes+=size;
+	m_sampledBytes+=sampledBytes;
+
+	cout<<"Rank "<<m_parameters->getRank()<<" sampled "<<reads<<" sequences ("<<sampledBytes<<" of "<<size;
+	cout<<" bytes) in "<<windows<<" windows of "<<file<<endl;
+
+	return true;
+}
+
+bool KmerSpectrumPreview::run(){
+
+	double fraction=0;
+
+	if(m_parameters->hasConfigurationOption("-spectrum-preview",1))
+		fraction=m_parameters->getConfigurationDouble("-spectrum-preview",0);
+
+	if(!(fraction>0 && fraction<=1)){
+		cout<<"Error: -spectrum-preview needs a fraction of the reads, for example 0.01"<<endl;
+		return false;
+	}
+
+	vector<string> files=m_parameters->getAllFiles();
+
+	for(int i=0;i<(int)files.size();i++){
+		if(!readFile(files[i],fraction)){
+			cout<<"Error: "<<files[i]<<" can not be sampled"<<endl;
+			return false;
+		}
+	}
+
+	if(m_sampledKmers.size()==0 || m_sampledBytes==0){
+		cout<<"Error: no k-mers found in the sampled reads (change -k)."<<endl;
+		return false;
+	}
+
+/*
+ * The windows do not give exactly the requested fraction, so the
+ * fraction of bytes that were read is used.
+ */
+	double requestedFraction=fraction;
+	fraction=(double)m_sampledBytes/m_inputBytes;
+
+	LargeCount samplingRate=((LargeCount)1)<<m_samplingBits;
+
+	// the spectrum of the sample, each frequency counts a k-mer and its reverse complement
+	map<CoverageDepth,LargeCount> sampleDistribution;
+
+	for(map<Kmer,int>::iterator i=m_sampledKmers.begin();i!=m_sampledKmers.end();i++){
+		int coverage=i->second;
+
+		if(coverage>CONFIG_MAXIMUM_COVERAGE)
+			coverage=CONFIG_MAXIMUM_COVERAGE;
+
+		sampleDistribution[coverage]+=2*samplingRate;
+	}
+
+	CoverageDistribution sampleCoverageDistribution(&sampleDistribution,NULL);
+
+	int sampleMinimumCoverage=sampleCoverageDistribution.getMinimumCoverage();
+	int samplePeakCoverage=sampleCoverageDistribution.getPeakCoverage();
+
+	// the coverage axis is scaled, not the counts
+	int minimumCoverage=(int)(sampleMinimumCoverage/fraction+0.5);
+	int peakCoverage=(int)(samplePeakCoverage/fraction+0.5);
+
+	string file=m_parameters->getCoverageDistributionFile();
+	ofstream distributionFile(file.c_str());
+
+	distributionFile<<"# KmerCoverage	Frequency"<<endl;
+	distributionFile<<"# Spectrum of "<<fraction<<" of the input, the coverage is divided by this fraction"<<endl;
+
+	for(map<CoverageDepth,LargeCount>::iterator i=sampleDistribution.begin();i!=sampleDistribution.end();i++){
+		distributionFile<<(LargeCount)(i->first/fraction+0.5)<<" "<<i->second<<endl;
+	}
+
+	distributionFile.close();
+
+	LargeCount errorKmers=0;
+	LargeCount errorKmersSeenTwice=0;
+	LargeCount genomicKmers=0;
+
+	for(map<Kmer,int>::iterator i=m_sampledKmers.begin();i!=m_sampledKmers.end();i++){
+		if(i->second<sampleMinimumCoverage){
+			errorKmers+=samplingRate;
+
+			if(i->second>=2)
+				errorKmersSeenTwice+=samplingRate;
+		}else{
+			genomicKmers+=samplingRate;
+		}
+	}
+
+/*
+ * Errors are new k-mers, so they grow with the number of reads.
+ * Genomic k-mers are already sampled, except those that were not seen
+ * at all with a Poisson coverage of samplePeakCoverage.
+ */
+	double seen=1-exp(-(double)samplePeakCoverage);
+	LargeCount projectedGenomicKmers=(LargeCount)(genomicKmers/seen);
+	LargeCount projectedErrorKmers=(LargeCount)(errorKmers/fraction);
+	LargeCount projectedKmers=projectedGenomicKmers+projectedErrorKmers;
+
+/*
+ * The Bloom filter keeps k-mers seen once out of the distributed graph.
+ */
+	LargeCount storedKmers=projectedGenomicKmers+(LargeCount)(errorKmersSeenTwice/fraction);
+	LargeCount kmersPerRank=storedKmers/m_parameters->getSize();
+
+	uint64_t buckets=m_parameters->getNumberOfBuckets();
+	while(kmersPerRank>buckets*m_parameters->getLoadFactorThreshold())
+		buckets*=2;
+
+	uint64_t bytesPerRank=buckets*sizeof(Vertex);
+
+	ostringstream summary;
+	summary<<"K-mer length: "<<m_kmerLength<<endl;
+	summary<<"Requested fraction of the reads: "<<requestedFraction<<endl;
+	summary<<"Sampled fraction of the input bytes: "<<fraction<<endl;
+	summary<<"Sampled reads: "<<m_reads<<endl;
+	summary<<"Sampled k-mers: "<<m_kmers<<endl;
+	summary<<"Distinct k-mers in the sampled reads (HyperLogLog): "<<m_distinctKmers.getEstimate()<<endl;
+	summary<<"Sampling rate of distinct k-mers for the spectrum: 1/"<<samplingRate<<endl;
+	summary<<endl;
+	summary<<"Minimum coverage in the sample: "<<sampleMinimumCoverage<<endl;
+	summary<<"Peak coverage in the sample: "<<samplePeakCoverage<<endl;
+	summary<<"Projected minimum coverage: "<<minimumCoverage<<endl;
+	summary<<"Projected peak coverage: "<<peakCoverage<<endl;
+	summary<<"Projected distinct k-mers: "<<projectedKmers<<endl;
+	summary<<"Projected genomic k-mers: "<<projectedGenomicKmers<<endl;
+	summary<<"Projected error k-mers: "<<projectedErrorKmers<<endl;
+	summary<<"Projected error k-mer fraction: "<<(double)projectedErrorKmers/projectedKmers<<endl;
+	summary<<"Projected k-mers stored per rank: "<<kmersPerRank<<" (with "<<m_parameters->getSize()<<" ranks)"<<endl;
+	summary<<"Projected GridTable memory per rank: "<<bytesPerRank/(1024*1024)<<" MiB"<<endl;
+
+	ostringstream summaryFile;
+	summaryFile<<m_parameters->getPrefix()<<"SpectrumPreview.txt";
+	ofstream f(summaryFile.str().c_str());
+	f<<summary.str();
+	f.close();
+
+	cout<<endl;
+	cout<<summary.str();
+	cout<<endl;
+	cout<<"Rank "<<m_parameters->getRank()<<" wrote "<<file<<endl;
+	cout<<"Rank "<<m_parameters->getRank()<<" wrote "<<summaryFile.str()<<endl;
+
+	return true;
+}
@@ -0,0 +1,100 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _KmerSpectrumPreview_h
+#define _KmerSpectrumPreview_h
+
+#include "HyperLogLog.h"
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/Mock/Parameters.h>
+
+#include <RayPlatform/core/types.h>
+
+#include <deque>
+#include <map>
+#include <string>
+using namespace std;
+
+/** the number of sampled k-mers with an exact count */
+#define CONFIG_SPECTRUM_PREVIEW_SAMPLED_KMERS 1048576
+
+/** the number of places where reads are taken in a file */
+#define CONFIG_SPECTRUM_PREVIEW_WINDOWS 256
+
+/**
+ * Estimates the k-mer spectrum of the input from a fraction of the reads
+ * of each file, before running the assembly (Ray -spectrum-preview fraction).
+ *
+ * The reads of a FASTA or FASTQ file are taken in CONFIG_SPECTRUM_PREVIEW_WINDOWS
+ * windows spread over the file: the sampler seeks to the start of each window
+ * and reads the fraction of its bytes, so the file is not read completely.
+ * Compressed and other files are read with Loader, and reads are taken at
+ * regular intervals.
+ *
+ * The number of distinct k-mers is estimated with a HyperLogLog sketch.
+ * The spectrum is computed exactly on a subset of the k-mers selected with
+ * their hash value: when the subset is too large, the sampling rate is
+ * doubled and the k-mers that are not selected anymore are removed.
+ *
+ * The minimum and peak coverages are found on the spectrum of the sample,
+ * then the coverage axis is divided by the fraction to project them on the
+ * whole input. K-mers below the minimum coverage are counted as errors
+ * (they grow with the number of reads) and the others as genomic k-mers
+ * (they do not).
+ *
+ * \author agent
+ */
+class KmerSpectrumPreview{
+
+	Parameters*m_parameters;
+	int m_kmerLength;
+
+	HyperLogLog m_distinctKmers;
+
+	/** k-mers whose hash value has its m_samplingBits lowest bits set to 0 */
+	map<Kmer,int> m_sampledKmers;
+	int m_samplingBits;
+
+	LargeCount m_reads;
+	LargeCount m_kmers;
+
+	/** bytes of the input and bytes of the sampled reads */
+	uint64_t m_inputBytes;
+	uint64_t m_sampledBytes;
+
+	void addSequence(const char*sequence);
+	void addKmer(Kmer*kmer);
+	void increaseSamplingRate();
+	bool readFile(string file,double fraction);
+
+	/** reads spread over a FASTA (period 2) or FASTQ (period 4) file */
+	bool readWindows(string file,double fraction,int period,char header);
+	bool isRecord(deque<string>*lines,int period,char header);
+
+public:
+
+	void constructor(Parameters*parameters);
+
+	/** returns false if the input can not be read */
+	bool run();
+};
+
+#endif
@@ -61,6 +61,7 @@ void EdgePurger::constructor(StaticVector*outbox,StaticVector*inbox,RingAllocato
 }
 
 void EdgePurger::call_RAY_SLAVE_MODE_PURGE_NULL_EDGES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_PURGE_NULL_EDGES);
 
 	MACRO_COLLECT_PROFILING_INFORMATION();
 
@@ -96,7 +97,8 @@ void EdgePurger::call_RAY_SLAVE_MODE_PURGE_NULL_EDGES(){
 	MACRO_COLLECT_PROFILING_INFORMATION();
 
 	if(!m_checkedCheckpoint){
-		if(m_parameters->hasCheckpoint("GenomeGraph")){
+		/* new edges may point to k-mers that were not kept */
+		if(m_parameters->hasCheckpoint("GenomeGraph") && !m_parameters->isIncrementalAssembly()){
 			
 			MessageUnit*messageBuffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
 			int bufferSize=0;
@@ -274,6 +276,8 @@ void EdgePurger::registerPlugin(ComputeCore*core){
 }
 
 void EdgePurger::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_PURGE_NULL_EDGES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_PURGE_NULL_EDGES");
 	RAY_MASTER_MODE_WRITE_KMERS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_WRITE_KMERS");
 
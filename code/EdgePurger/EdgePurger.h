@@ -27,6 +27,7 @@
 #include <code/Mock/Parameters.h>
 #include <code/VerticesExtractor/GridTable.h>
 #include <code/VerticesExtractor/GridTableIterator.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/memory/RingAllocator.h>
 #include <RayPlatform/structures/StaticVector.h>
@@ -91,6 +92,8 @@ class EdgePurger : public TaskCreator, public CorePlugin {
 	
 	void writeGraphPartition();
 
+	Instrumentation*m_instrumentation;
+
 public:
 	void constructor(StaticVector*outbox,StaticVector*inbox,RingAllocator*outboxAllocator,Parameters*parameters,
 		int*slaveMode,int*masterMode,VirtualCommunicator*vc,GridTable*graph,VirtualProcessor*virtualProcessor);
@@ -74,18 +74,23 @@ void Example::call_RAY_MASTER_MODE_STEP_C(){
 }
 
 void Example::call_RAY_SLAVE_MODE_STEP_A(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_STEP_A);
+
 	cout<<"I am "<<m_core->getRank()<<" doing call_RAY_SLAVE_MODE_STEP_A"<<endl;
 
 	m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getRank());
 }
 
 void Example::call_RAY_SLAVE_MODE_STEP_B(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_STEP_B);
+
 	cout<<"I am "<<m_core->getRank()<<" doing call_RAY_SLAVE_MODE_STEP_B"<<endl;
 
 	m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getRank());
 }
 
 void Example::call_RAY_SLAVE_MODE_STEP_C(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_STEP_C);
 
 	cout<<"I am "<<m_core->getRank()<<" doing call_RAY_SLAVE_MODE_STEP_C, now I die"<<endl;
 	cout<<"This is over "<<endl;
@@ -242,6 +247,7 @@ void Example::registerPlugin(ComputeCore*core){
 }
 
 void Example::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
 
 	// here, we resolve symbols owned by other m_plugins
 	// but needed by the current m_plugin
@@ -24,6 +24,7 @@
 #ifndef _Example_h
 #define _Example_h
 
+#include <code/Instrumentation/Instrumentation.h>
 #include <RayPlatform/core/ComputeCore.h>
 
 __DeclarePlugin(Example);
@@ -88,6 +89,8 @@ class Example:  public CorePlugin{
 
 /** Example state **/
 	bool m_example;
+	Instrumentation*m_instrumentation;
+
 public:
 
 	Example();
@@ -84,6 +84,7 @@ void FusionData::processCheckpoints(){
 }
 
 void FusionData::call_RAY_SLAVE_MODE_DISTRIBUTE_FUSIONS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_DISTRIBUTE_FUSIONS);
 
 	processCheckpoints();
 
@@ -687,6 +688,8 @@ void FusionData::registerPlugin(ComputeCore*core){
 }
 
 void FusionData::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_DISTRIBUTE_FUSIONS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DISTRIBUTE_FUSIONS");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
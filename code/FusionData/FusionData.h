@@ -26,6 +26,7 @@
 #include <code/SeedingData/SeedingData.h>
 #include <code/SeedExtender/Direction.h>
 #include <code/SeedExtender/ExtensionData.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/structures/StaticVector.h>
 #include <RayPlatform/memory/RingAllocator.h>
@@ -101,6 +102,8 @@ class FusionData : public CorePlugin {
 
 	void processCheckpoints();
 
+	Instrumentation*m_instrumentation;
+
 public:
 
 	bool m_FINISH_vertex_received;
@@ -29,6 +29,7 @@ __CreatePlugin(FusionTaskCreator);
 __CreateSlaveModeAdapter(FusionTaskCreator,RAY_SLAVE_MODE_FUSION); /**/
 
 void FusionTaskCreator::call_RAY_SLAVE_MODE_FUSION(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_FUSION);
 
 	mainLoop();
 }
@@ -143,7 +144,8 @@ Worker*FusionTaskCreator::assignNextTask(){
 
 	RAY_MPI_TAG_ASK_VERTEX_PATH,
 	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
-	RAY_MPI_TAG_GET_PATH_LENGTH
+	RAY_MPI_TAG_GET_PATH_LENGTH,
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 );
 
 
@@ -211,12 +213,15 @@ void FusionTaskCreator::registerPlugin(ComputeCore*core){
 }
 
 void FusionTaskCreator::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_FUSION=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_FUSION");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
 	RAY_MPI_TAG_ASK_VERTEX_PATH=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATH");
 	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE");
 	RAY_MPI_TAG_GET_PATH_LENGTH=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_PATH_LENGTH");
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY");
 	RAY_MPI_TAG_FUSION_DONE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_FUSION_DONE");
 	RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED_REPLY_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED_REPLY_REPLY");
 
@@ -25,6 +25,7 @@
 #include <code/Mock/Parameters.h>
 #include <code/KmerAcademyBuilder/Kmer.h>
 #include <code/SeedingData/GraphPath.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/scheduling/Worker.h>
 #include <RayPlatform/scheduling/TaskCreator.h>
@@ -60,6 +61,7 @@ class FusionTaskCreator: public TaskCreator, public CorePlugin {
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH;
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY;
 	MessageTag RAY_MPI_TAG_FUSION_DONE;
 
 	SlaveMode RAY_SLAVE_MODE_FUSION;
@@ -85,6 +87,8 @@ class FusionTaskCreator: public TaskCreator, public CorePlugin {
 
 	bool m_fastRun;
 
+	Instrumentation*m_instrumentation;
+
 public:
 	void constructor( VirtualProcessor*virtualProcessor,StaticVector*outbox,
 		RingAllocator*outboxAllocator,int*mode,Parameters*parameters,vector<GraphPath>*paths,vector<PathHandle >*pathIdentifiers,
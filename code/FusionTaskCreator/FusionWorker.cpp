@@ -44,7 +44,7 @@ void FusionWorker::work(){
 
 TODO: does the code pay attention when the coverage indicates a repeated k-mer ? repeats slow things down...
 
-	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 	RAY_MPI_TAG_ASK_VERTEX_PATH
 	RAY_MPI_TAG_GET_PATH_LENGTH
 */
@@ -69,19 +69,20 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 
 			Rank destination=kmer.vertexRank(m_parameters->getSize(),
 				m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-			int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
-			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
+			int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY);
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery*sizeof(MessageUnit));
 			int outputPosition=0;
 			kmer.pack(message,&outputPosition);
+			message[outputPosition++]=m_identifier.getValue();
 			Message aMessage(message,elementsPerQuery,destination,
-				RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,m_parameters->getRank());
+				RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY,m_parameters->getRank());
 			m_virtualCommunicator->pushMessage(m_workerIdentifier,&aMessage);
 
 			m_requestedNumberOfPaths=true;
 			m_receivedNumberOfPaths=false;
 
 			if(m_parameters->hasOption("-debug-fusions2")){
-				cout<<"worker "<<m_workerIdentifier<<" send RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
+				cout<<"worker "<<m_workerIdentifier<<" send RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY"<<endl;
 			}
 
 		/* receive the number of paths */
@@ -89,6 +90,7 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 			vector<MessageUnit> response;
 			m_virtualCommunicator->getMessageResponseElements(m_workerIdentifier,&response);
 			m_numberOfPaths=response[0];
+			int otherPaths=response[1];
 		
 			if(m_parameters->hasOption("-debug-fusions2"))
 				cout<<"worker "<<m_workerIdentifier<<" Got "<<m_numberOfPaths<<endl;
@@ -102,9 +104,19 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 			int maximumNumberOfPathsToProcess=32;
 
 			/* don't process repeated stuff */
-			if(m_numberOfPaths> maximumNumberOfPathsToProcess)
+			if(m_numberOfPaths> maximumNumberOfPathsToProcess){
 				m_numberOfPaths=0;
 
+			/* the summary already carries the only other path, if any */
+			}else if(otherPaths<=1){
+				if(otherPaths==1){
+					PathHandle otherPathIdentifier=response[2];
+					m_hits[otherPathIdentifier]++;
+				}
+
+				m_numberOfPaths=0;
+			}
+
 		}else if(m_receivedNumberOfPaths && m_pathIndex < m_numberOfPaths){
 			/* request a path */
 			if(!m_requestedPath){
@@ -278,8 +290,10 @@ void FusionWorker::constructor(WorkerHandle number,GraphPath*path,PathHandle ide
 
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
-	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH
+	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH,
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 ){
+	this->RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY=RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY;
 	this->RAY_MPI_TAG_GET_PATH_LENGTH=RAY_MPI_TAG_GET_PATH_LENGTH;
 	this->RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE=RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	this->RAY_MPI_TAG_ASK_VERTEX_PATH=RAY_MPI_TAG_ASK_VERTEX_PATH;
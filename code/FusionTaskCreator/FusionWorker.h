@@ -42,6 +42,7 @@ class FusionWorker: public Worker{
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH;
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY;
 
 	bool m_requestedNumberOfPaths;
 	WorkerHandle m_workerIdentifier;
@@ -75,9 +76,8 @@ public:
 VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
-	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH
-
-
+	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH,
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 );
 
 	/* a method for Worker interface */
@@ -304,6 +304,7 @@ void GeneOntology::loadAnnotations(){
 }
 
 void GeneOntology::call_RAY_SLAVE_MODE_ONTOLOGY_MAIN(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_ONTOLOGY_MAIN);
 
 	if(!m_slaveStarted){
 
@@ -1320,7 +1321,7 @@ void GeneOntology::countOntologyTermsInGraph(){
 		VirtualKmerColorHandle color=node->getVirtualColor();
 		set<PhysicalKmerColor>*physicalColors=m_colorSet->getPhysicalColors(color);
 
-		int kmerCoverage=node->getCoverage(&key);
+		int kmerCoverage=m_subgraph->getCoverage(node);
 
 		// this is the set of gene ontology terms that 
 		// the current k-mer contributes to
@@ -1488,6 +1489,7 @@ void GeneOntology::registerPlugin(ComputeCore*core){
 }
 
 void GeneOntology::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
 
 	RAY_MASTER_MODE_ONTOLOGY_MAIN=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_ONTOLOGY_MAIN");
 	RAY_MASTER_MODE_KILL_RANKS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_KILL_RANKS");
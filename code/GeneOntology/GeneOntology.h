@@ -27,6 +27,7 @@
 #include <code/Searcher/ColorSet.h>
 #include <code/Mock/Parameters.h>
 #include <code/VerticesExtractor/GridTable.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/core/ComputeCore.h>
 #include <RayPlatform/plugins/CorePlugin.h>
@@ -201,6 +202,8 @@ class GeneOntology: public CorePlugin{
 	bool m_synchronizedTotal;
 	int m_ranksSynchronized;
 
+	Instrumentation*m_instrumentation;
+
 public:
 
 	void call_RAY_MASTER_MODE_ONTOLOGY_MAIN();
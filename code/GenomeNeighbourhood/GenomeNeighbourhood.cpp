@@ -19,10 +19,7 @@
 
 */
 
-//#define DEBUG_NEIGHBOURHOOD_COMMUNICATION
-//#define DEBUG_NEIGHBOURHOOD_PATHS
 //#define DEBUG_NEIGHBOUR_LISTING
-//#define DEBUG_SIDE
 //#define DEBUG_LEFT_PATHS
 
 #include "GenomeNeighbourhood.h"
@@ -39,9 +36,6 @@ __CreateSlaveModeAdapter(GenomeNeighbourhood,RAY_SLAVE_MODE_NEIGHBOURHOOD);
 __CreateMessageTagAdapter(GenomeNeighbourhood,RAY_MPI_TAG_NEIGHBOURHOOD_DATA);
 
 
-#define FETCH_PARENTS 	0x00345678
-#define FETCH_CHILDREN 	0x01810230
-
 void GenomeNeighbourhood::call_RAY_MPI_TAG_NEIGHBOURHOOD_DATA(Message*message){
 	
 	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
@@ -103,441 +97,102 @@ void GenomeNeighbourhood::call_RAY_MPI_TAG_NEIGHBOURHOOD_DATA(Message*message){
 	m_core->getOutbox()->push_back(&aMessage);
 }
 
-void GenomeNeighbourhood::fetchPaths(int mode){
-
-/** stop the search when something is found **/
-/** this will speed things up, but will report less hits because of repeated k-mers **/
-
-	bool stopWhenSomethingIsFound=true;
-
-	Kmer currentKmer=m_stackOfVertices.top();
-	int depth=m_stackOfDepths.top();
-
-	Kmer kmer=currentKmer;
-
-	if(m_reverseStrand){
-		kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-	}
-
-	if(!m_numberOfPathsRequested){
-
-		#ifdef DEBUG_SIDE
-		if(mode==FETCH_PARENTS){
-			cout<<"[DEBUG_SIDE] FETCH_PARENTS RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		}else if(mode==FETCH_CHILDREN){
-			cout<<"[DEBUG_SIDE] FETCH_CHILDREN RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		}
-		#endif
-
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Sending RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		#endif
-
-		// send a message to request the links of the current vertex
-		MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(Kmer));
-		int bufferPosition=0;
-		kmer.pack(buffer,&bufferPosition);
-	
-		Rank destination=m_parameters->vertexRank(&kmer);
-
-		Message aMessage(buffer,m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE),
-			destination,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,m_rank);
-
-		m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-
-		m_numberOfPathsReceived=false;
-
-		// keep up the good work for now
-		m_linksRequested=false;
-		m_linksReceived=false;
-
-		m_numberOfPathsRequested=true;
-
-	}else if(!m_numberOfPathsReceived && m_virtualCommunicator->isMessageProcessed(m_workerId)){
-
-		vector<MessageUnit> elements;
-		m_virtualCommunicator->getMessageResponseElements(m_workerId,&elements);
-
-		m_paths=elements[0];
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Received reply for RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		#endif
-
-		#ifdef DEBUG_NEIGHBOURHOOD_PATHS
-		cout<<"Number of paths: "<<m_paths<<" depth: "<<depth<<" useReverse= "<<m_reverseStrand<<endl;
-		#endif
-
-		m_numberOfPathsReceived=true;
-		m_pathIndex=0;
-
-		m_requestedPath=false;
-		m_receivedPath=false;
-
-	}else if(m_numberOfPathsReceived && m_pathIndex == m_paths){
-
-		#ifdef DEBUG_NEIGHBOURHOOD_PATHS
-		cout<<"Index completed."<<endl;
-		#endif
-
-		m_fetchedPaths=true;
-
-	
-		#ifdef DEBUG_SIDE
-		if(mode==FETCH_PARENTS){
-			cout<<"[DEBUG_SIDE] FETCH_PARENTS finished fetching n="<<m_paths<<endl;
-		}else if(mode==FETCH_CHILDREN){
-			cout<<"[DEBUG_SIDE] FETCH_CHILDREN finished fetching n="<<m_paths<<endl;
-		}
-		#endif
-
-
-	}else if(m_numberOfPathsReceived && !m_requestedPath){
-
-		Rank destination=kmer.vertexRank(m_parameters->getSize(),
-			m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-
-		int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATH);
-
-		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
-
-		int outputPosition=0;
-		kmer.pack(message,&outputPosition);
-		message[outputPosition++]=m_pathIndex;
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Sending RAY_MPI_TAG_ASK_VERTEX_PATH"<<endl;
-		#endif
-
-		Message aMessage(message,elementsPerQuery,destination,
-			RAY_MPI_TAG_ASK_VERTEX_PATH,m_parameters->getRank());
-
-		m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-
-		m_requestedPath=true;
-		m_receivedPath=false;
-
-	}else if(m_numberOfPathsReceived && !m_receivedPath && m_virtualCommunicator->isMessageProcessed(m_workerId)){
-		vector<MessageUnit> response;
-		m_virtualCommunicator->getMessageResponseElements(m_workerId,&response);
-
-		int bufferPosition=0;
-
-		/* skip the k-mer because we don't need it */
-		bufferPosition+=KMER_U64_ARRAY_SIZE;
-		PathHandle pathIdentifier=response[bufferPosition++];
-		int progression=response[bufferPosition++];
-
-		
-		int minimumDepth=1;
-
-		#ifdef DEBUG_NEIGHBOURHOOD_PATHS
-		cout<<"Received path mode=";
-		if(mode==FETCH_PARENTS){
-			cout<<"FETCH_PARENTS";
-		}else{
-			cout<<"FETCH_CHILDREN";
-		}
-		cout<<" path is "<<pathIdentifier<<endl;
-		#endif
-
-		/** add the path **/
-
-		if(pathIdentifier != (*m_contigNames)[m_contigIndex]
-			//&& m_foundContigs.count(pathIdentifier)==0
-			&& depth >= minimumDepth){
-
-			char strand='F';
-			if(m_reverseStrand){
-				strand='R';
-			}
-
-			Neighbour friendlyNeighbour(strand,depth,pathIdentifier,progression);
-		
-			if(stopWhenSomethingIsFound){
-				m_foundPathsForThisVertex=true;
-			}
-
-			if(mode==FETCH_PARENTS){
-				m_leftNeighbours.push_back(friendlyNeighbour);
-
-			}else if(mode == FETCH_CHILDREN){
-
-				m_rightNeighbours.push_back(friendlyNeighbour);
-			}
-
-			m_foundContigs.insert(pathIdentifier);
-		}
-
-		m_pathIndex++;
-
-		m_receivedPath=true;
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Received reply for RAY_MPI_TAG_ASK_VERTEX_PATH"<<endl;
-		#endif
-
-		m_requestedPath=false;
-		m_receivedPath=false;
-	}
-}
-
-void GenomeNeighbourhood::processLinks(int mode){
-
-	#ifdef CONFIG_ASSERT
-	assert(!m_stackOfVertices.empty());
-	assert(m_stackOfVertices.size() == m_stackOfDepths.size());
-	#endif
-
-	Kmer currentKmer=m_stackOfVertices.top();
-	int depth=m_stackOfDepths.top();
-
-	if(!m_directDone){
-		if(!m_fetchedPaths){
-
-			fetchPaths(mode);
-		}else{
-		
-			#ifdef DEBUG_SIDE
-			if(mode==FETCH_PARENTS){
-				cout<<"[DEBUG_SIDE] Fetched direct paths for mode FETCH_PARENTS, n="<<m_paths<<endl;
-			}else if(mode==FETCH_CHILDREN){
-				cout<<"[DEBUG_SIDE] Fetched direct paths for mode FETCH_CHILDREN, n="<<m_paths<<endl;
-			}
-			#endif
-
-
-			#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-			cout<<"m_directDone= True"<<endl;
-			#endif
-
-			m_directDone=true;
-			m_fetchedPaths=false;
-			m_numberOfPathsRequested=false;
-			m_numberOfPathsReceived=false;
-
-			m_reverseDone=false;
-
-			m_reverseStrand=true;
-
-		}
-/**/
-	}else if(!m_reverseDone){
-		if(!m_fetchedPaths){
-
-			fetchPaths(mode);
-
-		}else{
-			
-			#ifdef DEBUG_SIDE
-			if(mode==FETCH_PARENTS){
-				cout<<"[DEBUG_SIDE] Fetched reverse paths for mode FETCH_PARENTS, n="<<m_paths<<endl;
-			}else if(mode==FETCH_CHILDREN){
-				cout<<"[DEBUG_SIDE] Fetched reverse paths for mode FETCH_CHILDREN, n="<<m_paths<<endl;
-			}
-			#endif
-
-		
-			#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-			cout<<"m_reverseDone= True"<<endl;
-			#endif
-	
-			m_reverseDone=true;
-		}
-/**/
-
-	}else if(m_fetchedPaths && !m_linksRequested){
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Sending message RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT to "<<endl;
-		#endif
-
-		// send a message to request the links of the current vertex
-		MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(Kmer));
-		int bufferPosition=0;
-		currentKmer.pack(buffer,&bufferPosition);
-	
-		Rank destination=m_parameters->vertexRank(&currentKmer);
-
-		Message aMessage(buffer,m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT),
-			destination,RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,m_rank);
-
-		m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-
-		m_linksRequested=true;
-		m_linksReceived=false;
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Message sent, RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT, will wait for a reply "<<endl;
-		#endif
-
-	}else if(m_fetchedPaths &&
-		!m_linksReceived && m_virtualCommunicator->isMessageProcessed(m_workerId)){
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Message received, RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT"<<endl;
-		#endif
-
-		vector<MessageUnit> elements;
-		m_virtualCommunicator->getMessageResponseElements(m_workerId,&elements);
-
-		#ifdef CONFIG_ASSERT
-		assert((int)elements.size()>=2);
-		#endif
+/**
+ * Each contig has 2 sources: its first k-mer for the parents
+ * and its last k-mer for the children.
+ */
+void GenomeNeighbourhood::startBatch(){
 
-		uint8_t edges=elements[0];
+	m_engine.clear();
+	m_neighbours.clear();
 
-		#ifdef CONFIG_ASSERT
-		int coverage=elements[1];
-		assert(coverage>0);
-		#endif
+	m_firstContigOfBatch=m_contigIndex;
+	m_lastContigOfBatch=m_contigIndex;
 
-		vector<Kmer> parents=currentKmer.getIngoingEdges(edges,m_parameters->getWordSize());
-		vector<Kmer> children=currentKmer.getOutgoingEdges(edges,m_parameters->getWordSize());
+/* the maximum depth
+ * values are 1024, 2048 or 4096 */
+	m_maximumDepth=1024;
 
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"information: "<<parents.size()<<" parents, "<<children.size()<<" children"<<endl;
-		#endif
+	int maximumSources=NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_BATCH/NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_SOURCE;
 
-		int nextDepth=depth+1;
+	if(maximumSources>GRAPH_SEARCH_SOURCES_PER_BATCH)
+		maximumSources=GRAPH_SEARCH_SOURCES_PER_BATCH;
 
-		// remove the current vertex from the stack
-		m_stackOfVertices.pop();
-		m_stackOfDepths.pop();
+	while(m_lastContigOfBatch<(int)m_contigs->size()
+		&& 2*(m_lastContigOfBatch-m_firstContigOfBatch)<maximumSources){
 
-		m_visited.insert(currentKmer);
+		cout<<"Rank "<<m_rank<<" is fetching contig path neighbours ["<<m_lastContigOfBatch<<"/"<<m_contigs->size()<<"]"<<endl;
 
-		// add new links
-		
-		vector<Kmer>*links=&parents;
+		GraphPath*contig=&(m_contigs->at(m_lastContigOfBatch));
+		int contigLength=contig->size();
 
 		#ifdef CONFIG_ASSERT
-		assert(mode==FETCH_CHILDREN || mode==FETCH_PARENTS);
-		#endif
-
-		if(mode==FETCH_CHILDREN){
-			links=&children;
-
-		}else if(mode==FETCH_PARENTS){
-			links=&parents;
-		}
-
-		#ifdef CONFIG_ASSERT
-		assert(m_stackOfDepths.size()==m_stackOfVertices.size());
+		assert(contigLength>=1);
 		#endif
 
-		/** we don't continue if we found something interesting... **/
-
-		for(int i=0;i<(int)links->size();i++){
-
-			#ifdef CONFIG_ASSERT
-			assert(i<(int) links->size());
-			#endif
-
-			Kmer newKmer=links->at(i);
-
-			if(nextDepth<= m_maximumDepth && m_visited.count(newKmer)==0
+		Kmer first;
+		contig->at(0,&first);
 
-				&& !m_foundPathsForThisVertex){ /* avoid exploring too much when something is already on the table **/
-		
-				m_stackOfVertices.push(newKmer);
-				m_stackOfDepths.push(nextDepth);
-			}
-		}
+		Kmer last;
+		contig->at(contigLength-1,&last);
 
-		m_linksReceived=true;
-
-	}else if(m_fetchedPaths && m_linksRequested && m_linksReceived){
-		
-		// restart the adventure
-
-		resetKmerStates();
+		m_engine.addSource(&first,GRAPH_SEARCH_PARENTS,GRAPH_SEARCH_BREADTH_FIRST,m_maximumDepth,
+			NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_SOURCE);
+		m_engine.addSource(&last,GRAPH_SEARCH_CHILDREN,GRAPH_SEARCH_BREADTH_FIRST,m_maximumDepth,
+			NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_SOURCE);
 
+		m_lastContigOfBatch++;
 	}
-}
 
-void GenomeNeighbourhood::processSide(int mode){
-
-	#ifdef CONFIG_ASSERT
-	assert(mode==FETCH_CHILDREN || mode==FETCH_PARENTS);
-	#endif
+	m_neighbours.resize(m_engine.getNumberOfSources());
 
-	if(!m_startedSide){
+	m_engine.start(this);
 
-		#ifdef CONFIG_ASSERT
-		assert(m_contigIndex < (int)m_contigs->size());
-		#endif
-
-		int contigLength=m_contigs->at(m_contigIndex).size();
-
-		#ifdef CONFIG_ASSERT
-		assert(contigLength>=1);
-		#endif
-
-		Kmer kmer;
-
-		if(mode==FETCH_CHILDREN){
-			m_contigs->at(m_contigIndex).at(contigLength-1,&kmer);
+	m_batchIsStarted=true;
+	m_searchIsDone=false;
+}
 
-		}else if(mode==FETCH_PARENTS){
+bool GenomeNeighbourhood::addNeighbours(int source,vector<Direction>*directions,Strand strand,int depth){
 
-			m_contigs->at(m_contigIndex).at(0,&kmer);
-		}
+	PathHandle contigName=(*m_contigNames)[m_firstContigOfBatch+source/2];
 
-		createStacks(kmer);
+	int minimumDepth=1;
 
-		resetKmerStates();
+	bool found=false;
 
-		m_visited.clear();
-		m_foundContigs.clear();
+	for(int i=0;i<(int)directions->size();i++){
 
-/* the maximum depth
- * values are 1024, 2048 or 4096 */
-		m_maximumDepth=1024;
+		PathHandle pathIdentifier=directions->at(i).getPathHandle();
+		int progression=directions->at(i).getPosition();
 
-		m_startedSide=true;
+		if(pathIdentifier == contigName || depth < minimumDepth)
+			continue;
 
-		#ifdef DEBUG_SIDE
-		if(mode==FETCH_PARENTS){
-			cout<<"Starting mode FETCH_PARENTS"<<endl;
-		}else if(mode==FETCH_CHILDREN){
-			cout<<"Starting mode FETCH_CHILDREN"<<endl;
-		}
-		#endif
+		Neighbour friendlyNeighbour(strand,depth,pathIdentifier,progression);
 
-	}else if(!m_stackOfVertices.empty()){
-		
-		processLinks(mode);
+		m_neighbours[source].push_back(friendlyNeighbour);
 
-	}else{
-		m_doneSide=true;
+		found=true;
 	}
 
+	return found;
 }
 
-void GenomeNeighbourhood::resetKmerStates(){
-	m_numberOfPathsRequested=false;
-	m_numberOfPathsReceived=false;
-	m_fetchedPaths=false;
-	m_directDone=false;
-	m_reverseDone=false;
-
-	m_reverseStrand=false;
+/**
+ * The parents of a first k-mer are on the left side and the
+ * children of a last k-mer are on the right side.
+ */
+bool GenomeNeighbourhood::visitVertex(int source,Kmer*vertex,int depth,CoverageDepth coverage,
+		vector<Direction>*directions,vector<Direction>*reverseDirections,
+		vector<Kmer>*links){
 
-	m_foundPathsForThisVertex=false;
-}
+	bool foundDirect=addNeighbours(source,directions,'F',depth);
+	bool foundReverse=addNeighbours(source,reverseDirections,'R',depth);
 
-void GenomeNeighbourhood::createStacks(Kmer a){
-	while(!m_stackOfVertices.empty()){
-		m_stackOfVertices.pop();
-	}
-	while(!m_stackOfDepths.empty()){
-		m_stackOfDepths.pop();
-	}
+/** stop the search when something is found **/
+/** this will speed things up, but will report less hits because of repeated k-mers **/
 
-	m_stackOfVertices.push(a);
-	m_stackOfDepths.push(0);
+	return !foundDirect && !foundReverse;
 }
 
 void GenomeNeighbourhood::processFinalList(){
@@ -766,7 +421,8 @@ void GenomeNeighbourhood::selectHits(){
  *
  * each item is (leftContig	strand	rightContig	strand	verticesInGap)
  *
- * to do so, do a depth first search with a maximum depth
+ * to do so, do a breadth first search with a maximum depth, from
+ * the ends of many contigs at the same time (GraphSearchEngine)
  *
  *
  * message used and what is needed:
@@ -796,6 +452,7 @@ void GenomeNeighbourhood::selectHits(){
  *              like scaffolding.
  */
 void GenomeNeighbourhood::call_RAY_SLAVE_MODE_NEIGHBOURHOOD(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_NEIGHBOURHOOD);
 
 	if(!m_pluginIsEnabled){
 
@@ -807,71 +464,46 @@ void GenomeNeighbourhood::call_RAY_SLAVE_MODE_NEIGHBOURHOOD(){
 	}
 
 	/* force flush everything ! */
+	m_activeWorkers.clear();
 	m_virtualCommunicator->forceFlush();
 	m_virtualCommunicator->processInbox(&m_activeWorkers);
-	m_activeWorkers.clear();
 
 
 	if(!m_slaveStarted){
 
 		m_contigIndex=0;
 
-		m_doneLeftSide=false;
-		m_startedLeft=false;
-		m_doneRightSide=false;
-		m_startedRight=false;
+		m_batchIsStarted=false;
 	
 		m_slaveStarted=true;
 
 		m_virtualCommunicator->resetCounters();
 
-	}else if(m_contigIndex<(int)m_contigs->size()){ /* there is still work to do */
-
-/*
-		PathHandle contigName=m_contigNames->at(m_contigIndex);
-		Strand contigStrand='F';
-		int contigLength=m_contigs->at(m_contigIndex).size();
-*/
-
-		// left side
-		if(!m_doneLeftSide){
-	
-			if(!m_startedLeft){
-
-				cout<<"Rank "<<m_rank<<" is fetching contig path neighbours ["<<m_contigIndex<<"/"<<m_contigs->size()<<"]"<<endl;
+		m_engine.initialize(m_parameters,m_virtualCommunicator,m_outboxAllocator,
+			RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
+			RAY_MPI_TAG_ASK_VERTEX_PATH);
 
-				m_startedLeft=true;
-				m_startedSide=false;
-				m_doneSide=false;
+	}else if(m_contigIndex<(int)m_contigs->size()){ /* there is still work to do */
 
+		// both sides of the contigs of the batch
+		if(!m_batchIsStarted){
 
-				m_leftNeighbours.clear();
-				m_rightNeighbours.clear();
+			startBatch();
 
-			}else if(!m_doneSide){
-				processSide(FETCH_PARENTS);
-			}else{
-				m_doneLeftSide=true;
-			}
+		}else if(!m_searchIsDone){
 
-		// right side
-		}else if(!m_doneRightSide){
-		
-			if(!m_startedRight){
-				m_startedRight=true;
-				m_startedSide=false;
-				m_doneSide=false;
-			}else if(!m_doneSide){
-
-				processSide(FETCH_CHILDREN);
-			}else{
-				m_doneRightSide=true;
+			if(m_engine.work(&m_activeWorkers)){
+				m_searchIsDone=true;
 				m_selectedHits=false;
 			}
 
-
 		}else if(!m_selectedHits){
 
+			int source=2*(m_contigIndex-m_firstContigOfBatch);
+
+			m_leftNeighbours.swap(m_neighbours[source]);
+			m_rightNeighbours.swap(m_neighbours[source+1]);
+
 			selectHits();
 
 			m_selectedHits=true;
@@ -893,10 +525,10 @@ void GenomeNeighbourhood::call_RAY_SLAVE_MODE_NEIGHBOURHOOD(){
 			/* continue the work */
 			m_contigIndex++;
 
-			m_doneLeftSide=false;
-			m_startedLeft=false;
-			m_doneRightSide=false;
-			m_startedRight=false;
+			m_selectedHits=false;
+
+			if(m_contigIndex==m_lastContigOfBatch)
+				m_batchIsStarted=false;
 		}
 	}else{
 
@@ -1081,6 +713,7 @@ void GenomeNeighbourhood::registerPlugin(ComputeCore*core){
  * resolve symbols
  */
 void GenomeNeighbourhood::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
 
 	RAY_MASTER_MODE_KILL_RANKS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_KILL_RANKS");
 	RAY_MASTER_MODE_NEIGHBOURHOOD=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_NEIGHBOURHOOD");
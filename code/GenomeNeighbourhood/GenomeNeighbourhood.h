@@ -30,6 +30,9 @@
 
 #include <code/KmerAcademyBuilder/Kmer.h>
 #include <code/Mock/Parameters.h>
+#include <code/SpuriousSeedAnnihilator/GraphSearchConsumer.h>
+#include <code/SpuriousSeedAnnihilator/GraphSearchEngine.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/communication/VirtualCommunicator.h>
 #include <RayPlatform/profiling/TimePrinter.h>
@@ -39,9 +42,14 @@
 #include <vector>
 #include <string>
 #include <stdint.h> /* for uint64_t */
-#include <stack>
 using namespace std;
 
+/* the vertices queued at most by the search of a contig end */
+#define NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_SOURCE 4096
+
+/* the vertices queued at most by all the contig ends of a batch */
+#define NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_BATCH 262144
+
 __DeclarePlugin(GenomeNeighbourhood);
 
 __DeclareMasterModeAdapter(GenomeNeighbourhood,RAY_MASTER_MODE_NEIGHBOURHOOD);
@@ -55,9 +63,24 @@ __DeclareMessageTagAdapter(GenomeNeighbourhood,RAY_MPI_TAG_NEIGHBOURHOOD_DATA);
  * This is useful to know where is located a drug-resistance gene,
  * amongst other things.
  *
+ * The ends of a batch of contigs are searched at the same time
+ * with a GraphSearchEngine.
+ *
+ * The search is breadth-first: the depth of a neighbour is the
+ * shortest depth at which it is found. The older depth-first search
+ * reported the depth of the first path that reached it, which can be
+ * larger, and its visited set could hide a neighbour behind a longer
+ * path. The neighbours and their depths can then differ from older
+ * versions.
+ *
+ * A contig end queues at most NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_SOURCE
+ * vertices, and a batch has as many contig ends as fit in
+ * NEIGHBOURHOOD_MAXIMUM_VERTICES_PER_BATCH, so that the memory of a
+ * batch does not grow with the depth of 1024.
+ *
  * \author Sébastien Boisvert
  */
-class GenomeNeighbourhood: public CorePlugin{
+class GenomeNeighbourhood: public CorePlugin, public GraphSearchConsumer{
 
 	__AddAdapter(GenomeNeighbourhood,RAY_MASTER_MODE_NEIGHBOURHOOD);
 	__AddAdapter(GenomeNeighbourhood,RAY_SLAVE_MODE_NEIGHBOURHOOD);
@@ -66,39 +89,21 @@ class GenomeNeighbourhood: public CorePlugin{
 	bool m_pluginIsEnabled;
 	Parameters*m_parameters;
 
-	stack<Kmer> m_stackOfVertices;
-	stack<int> m_stackOfDepths;
-
 /** states of the state machine */
 	int m_contigIndex;
 	bool m_started;
 	bool m_slaveStarted;
-	bool m_doneLeftSide;
-	bool m_doneRightSide;
-	bool m_startedLeft;
-	bool m_startedRight;
-
-	bool m_doneSide;
-	bool m_startedSide;
+	bool m_batchIsStarted;
+	bool m_searchIsDone;
 
 	/* graph surfing */
-	set<Kmer> m_visited;
-	set<PathHandle > m_foundContigs;
+	GraphSearchEngine m_engine;
+	int m_firstContigOfBatch;
+	int m_lastContigOfBatch;
 	int m_maximumDepth;
-	bool m_linksRequested;
-	bool m_linksReceived;
-	int m_paths;
-	bool m_foundPathsForThisVertex;
-	int m_pathIndex;
-	bool m_numberOfPathsRequested;
-	bool m_numberOfPathsReceived;
-	bool m_fetchedPaths;
-	bool m_receivedPath;
-	bool m_requestedPath;
-	bool m_reverseStrand;
-	
-	bool m_directDone;
-	bool m_reverseDone;
+
+	/* the neighbours found by each source of the batch */
+	vector<vector<Neighbour> > m_neighbours;
 
 	/* virtual communication */
 	VirtualCommunicator*m_virtualCommunicator;
@@ -146,16 +151,15 @@ class GenomeNeighbourhood: public CorePlugin{
 
 /** private parts **/
 
-	void createStacks(Kmer a);
-	void processSide(int mode);
-	void processLinks(int mode);
-	void resetKmerStates();
-	void fetchPaths(int mode);
+	void startBatch();
+	bool addNeighbours(int source,vector<Direction>*directions,Strand strand,int depth);
 	void selectHits();
 	void sendLeftNeighbours();
 	void sendRightNeighbours();
 	void processFinalList();
 
+	Instrumentation*m_instrumentation;
+
 public:
 
 	void registerPlugin(ComputeCore*core);
@@ -164,6 +168,10 @@ public:
 	void call_RAY_SLAVE_MODE_NEIGHBOURHOOD();
 	void call_RAY_MASTER_MODE_NEIGHBOURHOOD();
 	void call_RAY_MPI_TAG_NEIGHBOURHOOD_DATA(Message*message);
+
+	bool visitVertex(int source,Kmer*vertex,int depth,CoverageDepth coverage,
+		vector<Direction>*directions,vector<Direction>*reverseDirections,
+		vector<Kmer>*links);
 };
 
 #endif
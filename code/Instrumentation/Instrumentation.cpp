@@ -0,0 +1,595 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "Instrumentation.h"
+
+#include <code/Mock/constants.h>
+
+#include <RayPlatform/core/OperatingSystem.h>
+#include <RayPlatform/core/slave_modes.h>
+#include <RayPlatform/communication/mpi_tags.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+using namespace std;
+
+#include <stdio.h>
+
+#ifdef __unix__
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+/*
+ * The resident size is read from /proc at most this often
+ * by the probes of the slave modes.
+ */
+#define RESIDENT_SIZE_SAMPLING_PERIOD_IN_MICROSECONDS 100000
+
+/* kind, handle and up to 5 counters */
+#define PROFILE_ENTRY_SIZE 7
+#define PROFILE_ENTRY_SLAVE_MODE 0
+#define PROFILE_ENTRY_MESSAGE_TAG 1
+
+__CreatePlugin(Instrumentation);
+
+__CreateMessageTagAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_SAMPLE);
+__CreateMessageTagAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_COUNTERS);
+__CreateMessageTagAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_PROFILE);
+
+Instrumentation::Instrumentation(){
+	m_enabled=false;
+	m_subgraph=NULL;
+	m_lastWallTime=0;
+	m_lastUserTime=0;
+	m_lastSystemTime=0;
+	m_lastProcessUserTime=0;
+	m_lastProcessSystemTime=0;
+	m_lastHashTableFinds=0;
+	m_lastPhaseTime=0;
+	m_slaveModeTime=0;
+	m_peakResidentKiBytes=0;
+	m_peakAllocatorBytes=0;
+	m_lastResidentSample=0;
+	m_slaveModeDepth=0;
+	m_slaveModeStartWallTime=0;
+	m_slaveModeStartThreadTime=0;
+	m_slaveModeStartOutboxSize=0;
+	m_slaveModeStartInboxIsEmpty=true;
+}
+
+void Instrumentation::addAllocator(MyAllocator*allocator){
+	m_allocators.push_back(allocator);
+}
+
+/*
+ * RUSAGE_SELF counts all the threads of the process, so the times of the
+ * main thread come from RUSAGE_THREAD when it is available.
+ */
+void Instrumentation::getCPUTimes(uint64_t*user,uint64_t*system,uint64_t*processUser,uint64_t*processSystem,
+		uint64_t*maximumResidentKiBytes){
+	(*user)=0;
+	(*system)=0;
+	(*processUser)=0;
+	(*processSystem)=0;
+	(*maximumResidentKiBytes)=0;
+
+#ifdef __unix__
+	struct rusage usage;
+
+	if(getrusage(RUSAGE_SELF,&usage)!=0)
+		return;
+
+	(*processUser)=usage.ru_utime.tv_sec*1000000ULL+usage.ru_utime.tv_usec;
+	(*processSystem)=usage.ru_stime.tv_sec*1000000ULL+usage.ru_stime.tv_usec;
+	(*maximumResidentKiBytes)=usage.ru_maxrss;
+
+#ifdef RUSAGE_THREAD
+	if(getrusage(RUSAGE_THREAD,&usage)!=0)
+		return;
+#endif
+
+	(*user)=usage.ru_utime.tv_sec*1000000ULL+usage.ru_utime.tv_usec;
+	(*system)=usage.ru_stime.tv_sec*1000000ULL+usage.ru_stime.tv_usec;
+#endif
+}
+
+uint64_t Instrumentation::getThreadTime(){
+#if defined(__unix__) && defined(RUSAGE_THREAD)
+	struct rusage usage;
+
+	if(getrusage(RUSAGE_THREAD,&usage)!=0)
+		return 0;
+
+	return usage.ru_utime.tv_sec*1000000ULL+usage.ru_utime.tv_usec
+		+usage.ru_stime.tv_sec*1000000ULL+usage.ru_stime.tv_usec;
+#else
+	return 0;
+#endif
+}
+
+/*
+ * The second field of /proc/self/statm is the resident size in pages.
+ */
+uint64_t Instrumentation::getResidentKiBytes(){
+	uint64_t residentKiBytes=0;
+
+#ifdef __linux__
+	FILE*file=fopen("/proc/self/statm","r");
+
+	if(file==NULL)
+		return 0;
+
+	unsigned long size=0;
+	unsigned long resident=0;
+
+	if(fscanf(file,"%lu %lu",&size,&resident)==2)
+		residentKiBytes=(uint64_t)resident*(sysconf(_SC_PAGESIZE)/1024);
+
+	fclose(file);
+#endif
+
+	return residentKiBytes;
+}
+
+uint64_t Instrumentation::getAllocatorBytes(){
+	uint64_t allocatorBytes=0;
+
+	for(int i=0;i<(int)m_allocators.size();i++){
+		MyAllocator*allocator=m_allocators[i];
+		allocatorBytes+=(uint64_t)allocator->getChunkSize()*allocator->getNumberOfChunks();
+	}
+
+	return allocatorBytes;
+}
+
+void Instrumentation::sampleMemory(uint64_t now,bool force){
+	uint64_t allocatorBytes=getAllocatorBytes();
+
+	if(allocatorBytes>m_peakAllocatorBytes)
+		m_peakAllocatorBytes=allocatorBytes;
+
+	if(!force && now<m_lastResidentSample+RESIDENT_SIZE_SAMPLING_PERIOD_IN_MICROSECONDS)
+		return;
+
+	m_lastResidentSample=now;
+
+	uint64_t residentKiBytes=getResidentKiBytes();
+
+	if(residentKiBytes>m_peakResidentKiBytes)
+		m_peakResidentKiBytes=residentKiBytes;
+}
+
+/**
+ * The inbox holds the messages received in this iteration of the
+ * RayPlatform loop.
+ */
+void Instrumentation::startSlaveMode(SlaveMode mode){
+	if(!m_enabled)
+		return;
+
+	m_slaveModeDepth++;
+
+	if(m_slaveModeDepth>1)
+		return;
+
+	for(int i=0;i<(int)m_inbox->size();i++){
+		Message*message=m_inbox->at(i);
+		m_messageTags[message->getTag()].addReceivedMessage(message);
+	}
+
+	m_slaveModeStartInboxIsEmpty=m_inbox->size()==0;
+	m_slaveModeStartOutboxSize=m_outbox->size();
+	m_slaveModeStartThreadTime=getThreadTime();
+	m_slaveModeStartWallTime=getMicroseconds();
+}
+
+/**
+ * The outbox holds the messages queued in this iteration of the
+ * RayPlatform loop; it is sent and emptied after the slave mode returns.
+ */
+void Instrumentation::endSlaveMode(SlaveMode mode){
+	if(!m_enabled)
+		return;
+
+	m_slaveModeDepth--;
+
+	if(m_slaveModeDepth>0)
+		return;
+
+	uint64_t now=getMicroseconds();
+	uint64_t wall=now-m_slaveModeStartWallTime;
+	uint64_t thread=getThreadTime()-m_slaveModeStartThreadTime;
+
+	bool idle=m_slaveModeStartInboxIsEmpty && (int)m_outbox->size()==m_slaveModeStartOutboxSize;
+
+	m_slaveModes[mode].addCall(wall,thread,idle);
+	m_slaveModeTime+=wall;
+
+	for(int i=0;i<(int)m_outbox->size();i++){
+		Message*message=m_outbox->at(i);
+		m_messageTags[message->getTag()].addSentMessage(message);
+	}
+
+	sampleMemory(now,false);
+}
+
+/**
+ * Only the master can end a phase. The sample request starts at
+ * the master and each rank forwards it to its children.
+ */
+void Instrumentation::endPhase(const char*name){
+	if(!m_enabled)
+		return;
+
+	uint64_t now=getMicroseconds();
+
+	m_phaseNames.push_back(name);
+	m_phaseWallTimes.push_back(now-m_lastPhaseTime);
+	m_phaseCounters.push_back(vector<PhaseCounters>(m_size));
+	m_phaseHasCounters.push_back(vector<bool>(m_size,false));
+	m_phaseMissingEntries.push_back(vector<int>(m_size,0));
+	m_phaseSlaveModes.push_back(map<SlaveMode,SlaveModeCounters>());
+	m_phaseMessageTags.push_back(map<MessageTag,MessageTagCounters>());
+	m_phaseReplies.push_back(0);
+
+	m_lastPhaseTime=now;
+
+	sendSample(m_phaseNames.size()-1,MASTER_RANK);
+}
+
+/**
+ * Called once before the ranks are killed, so that the time after
+ * the last phase is in the file too.
+ */
+void Instrumentation::endLastPhase(){
+	endPhase("Finalization");
+}
+
+bool Instrumentation::isFlushed(){
+	if(!m_enabled)
+		return true;
+
+	for(int phase=0;phase<(int)m_phaseReplies.size();phase++){
+		if(m_phaseReplies[phase]!=m_size)
+			return false;
+	}
+
+	return true;
+}
+
+void Instrumentation::sendSample(int phase,Rank destination){
+	MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(sizeof(MessageUnit));
+	buffer[0]=phase;
+
+	Message aMessage(buffer,1,destination,RAY_MPI_TAG_INSTRUMENTATION_SAMPLE,m_rank);
+	m_outbox->push_back(&aMessage);
+}
+
+void Instrumentation::call_RAY_MPI_TAG_INSTRUMENTATION_SAMPLE(Message*message){
+	int phase=message->getBuffer()[0];
+
+	Rank child=2*m_rank+1;
+
+	if(child<m_size)
+		sendSample(phase,child);
+
+	child++;
+
+	if(child<m_size)
+		sendSample(phase,child);
+
+	uint64_t now=getMicroseconds();
+	uint64_t user=0;
+	uint64_t system=0;
+	uint64_t processUser=0;
+	uint64_t processSystem=0;
+	uint64_t maximumResidentKiBytes=0;
+
+	getCPUTimes(&user,&system,&processUser,&processSystem,&maximumResidentKiBytes);
+
+	sampleMemory(now,true);
+
+	uint64_t finds=0;
+	uint64_t entries=0;
+
+	if(m_subgraph!=NULL){
+		finds=m_subgraph->getFindOperations();
+		entries=m_subgraph->size();
+	}
+
+	PhaseCounters counters;
+	counters.setTimes(now-m_lastWallTime,user-m_lastUserTime,system-m_lastSystemTime);
+	counters.setProcessTimes(processUser-m_lastProcessUserTime,processSystem-m_lastProcessSystemTime);
+	counters.setSlaveModeTime(m_slaveModeTime);
+	counters.setMemory(m_peakResidentKiBytes,maximumResidentKiBytes,m_peakAllocatorBytes,getAllocatorBytes());
+	counters.setHashTable(finds-m_lastHashTableFinds,entries);
+
+	m_lastWallTime=now;
+	m_lastUserTime=user;
+	m_lastSystemTime=system;
+	m_lastProcessUserTime=processUser;
+	m_lastProcessSystemTime=processSystem;
+	m_lastHashTableFinds=finds;
+
+	MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+	int position=0;
+	buffer[position++]=phase;
+	buffer[position++]=m_slaveModes.size()+m_messageTags.size();
+	counters.pack(buffer,&position);
+
+	Message aMessage(buffer,position,MASTER_RANK,RAY_MPI_TAG_INSTRUMENTATION_COUNTERS,m_rank);
+	m_outbox->push_back(&aMessage);
+
+	sendProfile(phase);
+
+/*
+ * The peaks of the next phase start at the current levels.
+ */
+	m_slaveModes.clear();
+	m_messageTags.clear();
+	m_slaveModeTime=0;
+	m_peakAllocatorBytes=getAllocatorBytes();
+	m_peakResidentKiBytes=getResidentKiBytes();
+	m_lastResidentSample=now;
+}
+
+/**
+ * The counters of the slave modes and of the message tags are packed
+ * PROFILE_ENTRY_SIZE units per entry, as many entries per message as fit.
+ */
+void Instrumentation::sendProfile(int phase){
+	int entriesPerMessage=(MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit)-2)/PROFILE_ENTRY_SIZE;
+
+	map<SlaveMode,SlaveModeCounters>::iterator slaveMode=m_slaveModes.begin();
+	map<MessageTag,MessageTagCounters>::iterator messageTag=m_messageTags.begin();
+
+	while(slaveMode!=m_slaveModes.end() || messageTag!=m_messageTags.end()){
+		MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+		int position=0;
+		buffer[position++]=phase;
+		buffer[position++]=0;
+
+		int entries=0;
+
+		while(entries<entriesPerMessage && (slaveMode!=m_slaveModes.end() || messageTag!=m_messageTags.end())){
+			int start=position;
+
+			if(slaveMode!=m_slaveModes.end()){
+				buffer[position++]=PROFILE_ENTRY_SLAVE_MODE;
+				buffer[position++]=slaveMode->first;
+				slaveMode->second.pack(buffer,&position);
+				slaveMode++;
+			}else{
+				buffer[position++]=PROFILE_ENTRY_MESSAGE_TAG;
+				buffer[position++]=messageTag->first;
+				messageTag->second.pack(buffer,&position);
+				messageTag++;
+			}
+
+			while(position<start+PROFILE_ENTRY_SIZE)
+				buffer[position++]=0;
+
+			entries++;
+		}
+
+		buffer[1]=entries;
+
+		Message aMessage(buffer,position,MASTER_RANK,RAY_MPI_TAG_INSTRUMENTATION_PROFILE,m_rank);
+		m_outbox->push_back(&aMessage);
+	}
+}
+
+/**
+ * A rank has reported a phase when its counters and all the entries
+ * they announce are received. The two tags may arrive in any order.
+ */
+void Instrumentation::addEntries(int phase,Rank source,int entries){
+	m_phaseMissingEntries[phase][source]-=entries;
+
+	if(!m_phaseHasCounters[phase][source] || m_phaseMissingEntries[phase][source]!=0)
+		return;
+
+	m_phaseReplies[phase]++;
+
+	if(m_phaseReplies[phase]==m_size)
+		writeData();
+}
+
+void Instrumentation::call_RAY_MPI_TAG_INSTRUMENTATION_COUNTERS(Message*message){
+	MessageUnit*buffer=message->getBuffer();
+	int position=0;
+	int phase=buffer[position++];
+	int entries=buffer[position++];
+	Rank source=message->getSource();
+
+	m_phaseCounters[phase][source].unpack(buffer,&position);
+	m_phaseHasCounters[phase][source]=true;
+
+	addEntries(phase,source,-entries);
+}
+
+void Instrumentation::call_RAY_MPI_TAG_INSTRUMENTATION_PROFILE(Message*message){
+	MessageUnit*buffer=message->getBuffer();
+	int position=0;
+	int phase=buffer[position++];
+	int entries=buffer[position++];
+
+	for(int i=0;i<entries;i++){
+		int start=position;
+		int kind=buffer[position++];
+		int handle=buffer[position++];
+
+		if(kind==PROFILE_ENTRY_SLAVE_MODE){
+			SlaveModeCounters counters;
+			counters.unpack(buffer,&position);
+			m_phaseSlaveModes[phase][handle].merge(&counters);
+		}else{
+			MessageTagCounters counters;
+			counters.unpack(buffer,&position);
+			m_phaseMessageTags[phase][handle].merge(&counters);
+		}
+
+		position=start+PROFILE_ENTRY_SIZE;
+	}
+
+	addEntries(phase,message->getSource(),entries);
+}
+
+/**
+ * The file is rewritten after each phase so that it is
+ * available even if the job does not terminate.
+ */
+void Instrumentation::writeData(){
+	ostringstream file;
+	file<<m_parameters->getPrefix()<<"Instrumentation.json";
+
+	ofstream f(file.str().c_str());
+
+	f<<"{"<<endl;
+	f<<"  \"ray\": \""<<CONFIG_RAY_VERSION<<"\","<<endl;
+	f<<"  \"ranks\": "<<m_size<<","<<endl;
+	f<<"  \"wordSize\": "<<m_parameters->getWordSize()<<","<<endl;
+	f<<"  \"phases\": ["<<endl;
+
+	bool first=true;
+
+	for(int phase=0;phase<(int)m_phaseNames.size();phase++){
+		if(m_phaseReplies[phase]!=m_size)
+			continue;
+
+		if(!first)
+			f<<","<<endl;
+
+		first=false;
+
+		PhaseCounters total;
+
+		f<<"    {"<<endl;
+		f<<"      \"name\": \""<<m_phaseNames[phase]<<"\","<<endl;
+		f<<"      \"wallMicroseconds\": "<<m_phaseWallTimes[phase]<<","<<endl;
+		f<<"      \"ranks\": ["<<endl;
+
+		for(Rank rank=0;rank<m_size;rank++){
+			PhaseCounters*counters=&(m_phaseCounters[phase][rank]);
+			total.merge(counters);
+
+			f<<"        { \"rank\": "<<rank<<", ";
+			counters->writeJSON(&f);
+			f<<" }";
+
+			if(rank!=m_size-1)
+				f<<",";
+			f<<endl;
+		}
+
+		f<<"      ],"<<endl;
+		f<<"      \"total\": { ";
+		total.writeJSON(&f);
+		f<<" },"<<endl;
+
+		f<<"      \"slaveModes\": ["<<endl;
+
+		for(map<SlaveMode,SlaveModeCounters>::iterator i=m_phaseSlaveModes[phase].begin();
+				i!=m_phaseSlaveModes[phase].end();i++){
+
+			if(i!=m_phaseSlaveModes[phase].begin())
+				f<<","<<endl;
+
+			f<<"        { \"slaveMode\": \""<<SLAVE_MODES[i->first]<<"\", ";
+			i->second.writeJSON(&f);
+			f<<" }";
+		}
+
+		f<<endl;
+		f<<"      ],"<<endl;
+		f<<"      \"messageTags\": ["<<endl;
+
+		for(map<MessageTag,MessageTagCounters>::iterator i=m_phaseMessageTags[phase].begin();
+				i!=m_phaseMessageTags[phase].end();i++){
+
+			if(i!=m_phaseMessageTags[phase].begin())
+				f<<","<<endl;
+
+			f<<"        { \"messageTag\": \""<<MESSAGE_TAGS[i->first]<<"\", ";
+			i->second.writeJSON(&f);
+			f<<" }";
+		}
+
+		f<<endl;
+		f<<"      ]"<<endl;
+		f<<"    }";
+	}
+
+	f<<endl;
+	f<<"  ]"<<endl;
+	f<<"}"<<endl;
+
+	f.close();
+}
+
+void Instrumentation::registerPlugin(ComputeCore*core){
+
+	m_core=core;
+	PluginHandle plugin=core->allocatePluginHandle();
+	m_plugin=plugin;
+
+	core->setPluginName(plugin,"Instrumentation");
+	core->setPluginDescription(plugin,"Phase-aligned counters for the ranks.");
+	core->setPluginAuthors(plugin,"agent");
+	core->setPluginLicense(plugin,"GNU General Public License version 3");
+
+	__ConfigureMessageTagHandler(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_SAMPLE);
+	__ConfigureMessageTagHandler(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_COUNTERS);
+	__ConfigureMessageTagHandler(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_PROFILE);
+
+	m_inbox=core->getInbox();
+	m_outbox=core->getOutbox();
+	m_outboxAllocator=core->getOutboxAllocator();
+	m_rank=core->getRank();
+	m_size=core->getSize();
+
+	core->setObjectSymbol(m_plugin,this,"/RayAssembler/ObjectStore/Instrumentation.ray");
+}
+
+void Instrumentation::resolveSymbols(ComputeCore*core){
+
+	m_parameters=(Parameters*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Parameters.ray");
+	m_subgraph=(GridTable*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/deBruijnGraph_part.ray");
+
+	addAllocator((MyAllocator*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/directionMemoryPool.ray"));
+
+	m_enabled=m_parameters->hasOption("-write-instrumentation-data");
+
+	uint64_t maximumResidentKiBytes=0;
+	getCPUTimes(&m_lastUserTime,&m_lastSystemTime,&m_lastProcessUserTime,&m_lastProcessSystemTime,
+		&maximumResidentKiBytes);
+
+	m_lastWallTime=getMicroseconds();
+	m_lastPhaseTime=m_lastWallTime;
+
+	m_peakAllocatorBytes=getAllocatorBytes();
+	m_peakResidentKiBytes=getResidentKiBytes();
+	m_lastResidentSample=m_lastWallTime;
+
+	__BindPlugin(Instrumentation);
+}
@@ -0,0 +1,180 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _Instrumentation_h
+#define _Instrumentation_h
+
+#include "PhaseCounters.h"
+#include "SlaveModeCounters.h"
+#include "MessageTagCounters.h"
+#include "SlaveModeProbe.h"
+
+#include <code/Mock/Parameters.h>
+#include <code/VerticesExtractor/GridTable.h>
+
+#include <RayPlatform/core/ComputeCore.h>
+#include <RayPlatform/memory/MyAllocator.h>
+#include <RayPlatform/memory/RingAllocator.h>
+#include <RayPlatform/structures/StaticVector.h>
+
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+__DeclarePlugin(Instrumentation);
+
+__DeclareMessageTagAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_SAMPLE);
+__DeclareMessageTagAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_COUNTERS);
+__DeclareMessageTagAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_PROFILE);
+
+/**
+ * Phase-aligned accounting written as one JSON file per run
+ * (-write-instrumentation-data).
+ *
+ * When a phase ends, the master calls endPhase(). A sample request
+ * travels down a binary tree of ranks (rank r forwards it to 2r+1
+ * and 2r+2) and every rank sends its counters for the phase to the
+ * master. The master rewrites Instrumentation.json whenever all the
+ * ranks have reported a phase.
+ *
+ * Counters: wall time, user and system CPU time of the main thread and
+ * of the process, peak resident size, peak bytes held by the registered
+ * MyAllocator objects and lookups in the GridTable (see PhaseCounters).
+ *
+ * The handler of every Ray slave mode declares a SlaveModeProbe. For each
+ * slave mode, the probes count the calls, the idle calls (busy wait) and
+ * the wall and CPU time (SlaveModeCounters). A probe also counts, for each
+ * message tag, the messages of the inbox when the handler starts and the
+ * messages of the outbox when it returns (MessageTagCounters). The outbox
+ * is emptied once per iteration of the RayPlatform loop, so this counts
+ * every message queued before the slave mode runs, including replies of
+ * message tag handlers. Messages received and sent while a rank is in
+ * RAY_SLAVE_MODE_DO_NOTHING, which belongs to RayPlatform, are not seen;
+ * that time is reported as the part of the phase outside slave modes.
+ *
+ * The slave mode and message tag counters of a rank are sent to the
+ * master in RAY_MPI_TAG_INSTRUMENTATION_PROFILE messages after its phase
+ * counters. The master keeps their sum over all the ranks.
+ *
+ * Before the ranks are killed, the master closes the last phase with
+ * endLastPhase() and waits for all the counters with isFlushed().
+ *
+ * \author agent
+ */
+class Instrumentation: public CorePlugin{
+
+	__AddAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_SAMPLE);
+	__AddAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_COUNTERS);
+	__AddAdapter(Instrumentation,RAY_MPI_TAG_INSTRUMENTATION_PROFILE);
+
+	MessageTag RAY_MPI_TAG_INSTRUMENTATION_SAMPLE;
+	MessageTag RAY_MPI_TAG_INSTRUMENTATION_COUNTERS;
+	MessageTag RAY_MPI_TAG_INSTRUMENTATION_PROFILE;
+
+	ComputeCore*m_core;
+	Parameters*m_parameters;
+	GridTable*m_subgraph;
+
+	StaticVector*m_inbox;
+	StaticVector*m_outbox;
+	RingAllocator*m_outboxAllocator;
+
+	Rank m_rank;
+	int m_size;
+
+	bool m_enabled;
+
+	vector<MyAllocator*> m_allocators;
+
+	/** values at the previous sample on this rank */
+	uint64_t m_lastWallTime;
+	uint64_t m_lastUserTime;
+	uint64_t m_lastSystemTime;
+	uint64_t m_lastProcessUserTime;
+	uint64_t m_lastProcessSystemTime;
+	uint64_t m_lastHashTableFinds;
+
+	/** counters of this rank since the previous sample */
+	map<SlaveMode,SlaveModeCounters> m_slaveModes;
+	map<MessageTag,MessageTagCounters> m_messageTags;
+	uint64_t m_slaveModeTime;
+	uint64_t m_peakResidentKiBytes;
+	uint64_t m_peakAllocatorBytes;
+	uint64_t m_lastResidentSample;
+
+	/** state of the slave mode call in progress */
+	int m_slaveModeDepth;
+	uint64_t m_slaveModeStartWallTime;
+	uint64_t m_slaveModeStartThreadTime;
+	int m_slaveModeStartOutboxSize;
+	bool m_slaveModeStartInboxIsEmpty;
+
+	/** master only */
+	vector<string> m_phaseNames;
+	vector<uint64_t> m_phaseWallTimes;
+	vector<vector<PhaseCounters> > m_phaseCounters;
+	vector<vector<bool> > m_phaseHasCounters;
+	vector<vector<int> > m_phaseMissingEntries;
+	vector<map<SlaveMode,SlaveModeCounters> > m_phaseSlaveModes;
+	vector<map<MessageTag,MessageTagCounters> > m_phaseMessageTags;
+	vector<int> m_phaseReplies;
+	uint64_t m_lastPhaseTime;
+
+	void sendSample(int phase,Rank destination);
+	void sendProfile(int phase);
+	void addEntries(int phase,Rank source,int entries);
+	void getCPUTimes(uint64_t*user,uint64_t*system,uint64_t*processUser,uint64_t*processSystem,
+		uint64_t*maximumResidentKiBytes);
+	uint64_t getThreadTime();
+	uint64_t getResidentKiBytes();
+	uint64_t getAllocatorBytes();
+	void sampleMemory(uint64_t now,bool force);
+	void writeData();
+
+public:
+
+	Instrumentation();
+
+	/** count the chunks of this allocator in the samples */
+	void addAllocator(MyAllocator*allocator);
+
+	/** the master closes the current phase */
+	void endPhase(const char*name);
+
+	/** the master closes the phase after the last call to endPhase */
+	void endLastPhase();
+
+	/** all the ranks reported all the phases */
+	bool isFlushed();
+
+	/** called by SlaveModeProbe */
+	void startSlaveMode(SlaveMode mode);
+	void endSlaveMode(SlaveMode mode);
+
+	void call_RAY_MPI_TAG_INSTRUMENTATION_SAMPLE(Message*message);
+	void call_RAY_MPI_TAG_INSTRUMENTATION_COUNTERS(Message*message);
+	void call_RAY_MPI_TAG_INSTRUMENTATION_PROFILE(Message*message);
+
+	void registerPlugin(ComputeCore*core);
+	void resolveSymbols(ComputeCore*core);
+};
+
+#endif
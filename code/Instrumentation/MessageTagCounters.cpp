@@ -0,0 +1,67 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+
+#include "MessageTagCounters.h"
+
+MessageTagCounters::MessageTagCounters(){
+	m_sentMessages=0;
+	m_sentBytes=0;
+	m_receivedMessages=0;
+	m_receivedBytes=0;
+}
+
+void MessageTagCounters::addSentMessage(Message*message){
+	m_sentMessages++;
+	m_sentBytes+=message->getCount()*sizeof(MessageUnit);
+}
+
+void MessageTagCounters::addReceivedMessage(Message*message){
+	m_receivedMessages++;
+	m_receivedBytes+=message->getCount()*sizeof(MessageUnit);
+}
+
+void MessageTagCounters::merge(MessageTagCounters*other){
+	m_sentMessages+=other->m_sentMessages;
+	m_sentBytes+=other->m_sentBytes;
+	m_receivedMessages+=other->m_receivedMessages;
+	m_receivedBytes+=other->m_receivedBytes;
+}
+
+void MessageTagCounters::pack(MessageUnit*buffer,int*position){
+	buffer[(*position)++]=m_sentMessages;
+	buffer[(*position)++]=m_sentBytes;
+	buffer[(*position)++]=m_receivedMessages;
+	buffer[(*position)++]=m_receivedBytes;
+}
+
+void MessageTagCounters::unpack(MessageUnit*buffer,int*position){
+	m_sentMessages=buffer[(*position)++];
+	m_sentBytes=buffer[(*position)++];
+	m_receivedMessages=buffer[(*position)++];
+	m_receivedBytes=buffer[(*position)++];
+}
+
+void MessageTagCounters::writeJSON(ostream*stream){
+	(*stream)<<"\"sentMessages\": "<<m_sentMessages;
+	(*stream)<<", \"sentBytes\": "<<m_sentBytes;
+	(*stream)<<", \"receivedMessages\": "<<m_receivedMessages;
+	(*stream)<<", \"receivedBytes\": "<<m_receivedBytes;
+}
@@ -0,0 +1,58 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+
+#ifndef _MessageTagCounters_h
+#define _MessageTagCounters_h
+
+#include <RayPlatform/communication/Message.h>
+
+#include <ostream>
+using namespace std;
+
+/**
+ * Messages of one tag sent and received by a rank during a phase.
+ * Bytes are the payloads (getCount() message units).
+ *
+ * \author agent
+ */
+class MessageTagCounters{
+
+	uint64_t m_sentMessages;
+	uint64_t m_sentBytes;
+	uint64_t m_receivedMessages;
+	uint64_t m_receivedBytes;
+
+public:
+
+	MessageTagCounters();
+
+	void addSentMessage(Message*message);
+	void addReceivedMessage(Message*message);
+
+	void merge(MessageTagCounters*other);
+
+	void pack(MessageUnit*buffer,int*position);
+	void unpack(MessageUnit*buffer,int*position);
+
+	void writeJSON(ostream*stream);
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "PhaseCounters.h"
+
+PhaseCounters::PhaseCounters(){
+	m_wallMicroseconds=0;
+	m_userMicroseconds=0;
+	m_systemMicroseconds=0;
+	m_processUserMicroseconds=0;
+	m_processSystemMicroseconds=0;
+	m_slaveModeMicroseconds=0;
+	m_peakResidentKiBytes=0;
+	m_processMaximumResidentKiBytes=0;
+	m_peakAllocatorBytes=0;
+	m_allocatorBytes=0;
+	m_hashTableFinds=0;
+	m_hashTableEntries=0;
+}
+
+void PhaseCounters::setTimes(uint64_t wall,uint64_t user,uint64_t system){
+	m_wallMicroseconds=wall;
+	m_userMicroseconds=user;
+	m_systemMicroseconds=system;
+}
+
+void PhaseCounters::setProcessTimes(uint64_t user,uint64_t system){
+	m_processUserMicroseconds=user;
+	m_processSystemMicroseconds=system;
+}
+
+void PhaseCounters::setSlaveModeTime(uint64_t microseconds){
+	m_slaveModeMicroseconds=microseconds;
+}
+
+void PhaseCounters::setMemory(uint64_t peakResidentKiBytes,uint64_t processMaximumResidentKiBytes,
+		uint64_t peakAllocatorBytes,uint64_t allocatorBytes){
+	m_peakResidentKiBytes=peakResidentKiBytes;
+	m_processMaximumResidentKiBytes=processMaximumResidentKiBytes;
+	m_peakAllocatorBytes=peakAllocatorBytes;
+	m_allocatorBytes=allocatorBytes;
+}
+
+void PhaseCounters::setHashTable(uint64_t finds,uint64_t entries){
+	m_hashTableFinds=finds;
+	m_hashTableEntries=entries;
+}
+
+void PhaseCounters::merge(PhaseCounters*other){
+	m_wallMicroseconds+=other->m_wallMicroseconds;
+	m_userMicroseconds+=other->m_userMicroseconds;
+	m_systemMicroseconds+=other->m_systemMicroseconds;
+	m_processUserMicroseconds+=other->m_processUserMicroseconds;
+	m_processSystemMicroseconds+=other->m_processSystemMicroseconds;
+	m_slaveModeMicroseconds+=other->m_slaveModeMicroseconds;
+	m_hashTableFinds+=other->m_hashTableFinds;
+	m_hashTableEntries+=other->m_hashTableEntries;
+
+	if(other->m_peakResidentKiBytes>m_peakResidentKiBytes)
+		m_peakResidentKiBytes=other->m_peakResidentKiBytes;
+
+	if(other->m_processMaximumResidentKiBytes>m_processMaximumResidentKiBytes)
+		m_processMaximumResidentKiBytes=other->m_processMaximumResidentKiBytes;
+
+	if(other->m_peakAllocatorBytes>m_peakAllocatorBytes)
+		m_peakAllocatorBytes=other->m_peakAllocatorBytes;
+
+	if(other->m_allocatorBytes>m_allocatorBytes)
+		m_allocatorBytes=other->m_allocatorBytes;
+}
+
+void PhaseCounters::pack(MessageUnit*buffer,int*position){
+	buffer[(*position)++]=m_wallMicroseconds;
+	buffer[(*position)++]=m_userMicroseconds;
+	buffer[(*position)++]=m_systemMicroseconds;
+	buffer[(*position)++]=m_processUserMicroseconds;
+	buffer[(*position)++]=m_processSystemMicroseconds;
+	buffer[(*position)++]=m_slaveModeMicroseconds;
+	buffer[(*position)++]=m_peakResidentKiBytes;
+	buffer[(*position)++]=m_processMaximumResidentKiBytes;
+	buffer[(*position)++]=m_peakAllocatorBytes;
+	buffer[(*position)++]=m_allocatorBytes;
+	buffer[(*position)++]=m_hashTableFinds;
+	buffer[(*position)++]=m_hashTableEntries;
+}
+
+void PhaseCounters::unpack(MessageUnit*buffer,int*position){
+	m_wallMicroseconds=buffer[(*position)++];
+	m_userMicroseconds=buffer[(*position)++];
+	m_systemMicroseconds=buffer[(*position)++];
+	m_processUserMicroseconds=buffer[(*position)++];
+	m_processSystemMicroseconds=buffer[(*position)++];
+	m_slaveModeMicroseconds=buffer[(*position)++];
+	m_peakResidentKiBytes=buffer[(*position)++];
+	m_processMaximumResidentKiBytes=buffer[(*position)++];
+	m_peakAllocatorBytes=buffer[(*position)++];
+	m_allocatorBytes=buffer[(*position)++];
+	m_hashTableFinds=buffer[(*position)++];
+	m_hashTableEntries=buffer[(*position)++];
+}
+
+void PhaseCounters::writeJSON(ostream*stream){
+	(*stream)<<"\"wallMicroseconds\": "<<m_wallMicroseconds;
+	(*stream)<<", \"threadUserMicroseconds\": "<<m_userMicroseconds;
+	(*stream)<<", \"threadSystemMicroseconds\": "<<m_systemMicroseconds;
+	(*stream)<<", \"processUserMicroseconds\": "<<m_processUserMicroseconds;
+	(*stream)<<", \"processSystemMicroseconds\": "<<m_processSystemMicroseconds;
+	(*stream)<<", \"slaveModeMicroseconds\": "<<m_slaveModeMicroseconds;
+	(*stream)<<", \"peakResidentKiBytes\": "<<m_peakResidentKiBytes;
+	(*stream)<<", \"processMaximumResidentKiBytes\": "<<m_processMaximumResidentKiBytes;
+	(*stream)<<", \"peakAllocatorBytes\": "<<m_peakAllocatorBytes;
+	(*stream)<<", \"allocatorBytes\": "<<m_allocatorBytes;
+	(*stream)<<", \"hashTableFinds\": "<<m_hashTableFinds;
+	(*stream)<<", \"hashTableEntries\": "<<m_hashTableEntries;
+}
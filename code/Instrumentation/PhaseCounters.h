@@ -0,0 +1,86 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _PhaseCounters_h
+#define _PhaseCounters_h
+
+#include <RayPlatform/communication/Message.h>
+
+#include <ostream>
+using namespace std;
+
+/**
+ * Counters of one rank for one phase of the workflow.
+ *
+ * Times and hash table lookups are deltas since the previous phase.
+ *
+ * The peaks are the largest values seen during the phase: the bytes of
+ * the registered MyAllocator objects are sampled after each call of a
+ * slave mode, the resident size at most every 100 ms (Linux only,
+ * otherwise 0). processMaximumResidentKiBytes is ru_maxrss, the maximum
+ * since the start of the process. allocatorBytes and hashTableEntries
+ * are levels at the end of the phase.
+ *
+ * slaveModeMicroseconds is the time spent in the handlers of the Ray
+ * slave modes (see SlaveModeProbe); the rest of the phase is spent in
+ * RAY_SLAVE_MODE_DO_NOTHING and in the message passing of RayPlatform.
+ *
+ * The thread times are for the main thread of the rank (RUSAGE_THREAD).
+ * The process times also include the threads of -threads-per-rank.
+ * Without RUSAGE_THREAD, the thread times are the process times.
+ *
+ * \author agent
+ */
+class PhaseCounters{
+
+	uint64_t m_wallMicroseconds;
+	uint64_t m_userMicroseconds;
+	uint64_t m_systemMicroseconds;
+	uint64_t m_processUserMicroseconds;
+	uint64_t m_processSystemMicroseconds;
+	uint64_t m_slaveModeMicroseconds;
+	uint64_t m_peakResidentKiBytes;
+	uint64_t m_processMaximumResidentKiBytes;
+	uint64_t m_peakAllocatorBytes;
+	uint64_t m_allocatorBytes;
+	uint64_t m_hashTableFinds;
+	uint64_t m_hashTableEntries;
+
+public:
+
+	PhaseCounters();
+
+	void setTimes(uint64_t wall,uint64_t user,uint64_t system);
+	void setProcessTimes(uint64_t user,uint64_t system);
+	void setSlaveModeTime(uint64_t microseconds);
+	void setMemory(uint64_t peakResidentKiBytes,uint64_t processMaximumResidentKiBytes,
+		uint64_t peakAllocatorBytes,uint64_t allocatorBytes);
+	void setHashTable(uint64_t finds,uint64_t entries);
+
+	/** sums times and lookups, keeps the maximum of the levels */
+	void merge(PhaseCounters*other);
+
+	void pack(MessageUnit*buffer,int*position);
+	void unpack(MessageUnit*buffer,int*position);
+
+	void writeJSON(ostream*stream);
+};
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+
+#include "SlaveModeCounters.h"
+
+SlaveModeCounters::SlaveModeCounters(){
+	m_calls=0;
+	m_idleCalls=0;
+	m_wallMicroseconds=0;
+	m_idleMicroseconds=0;
+	m_threadMicroseconds=0;
+	m_maximumRankWallMicroseconds=0;
+}
+
+void SlaveModeCounters::addCall(uint64_t wall,uint64_t thread,bool idle){
+	m_calls++;
+	m_wallMicroseconds+=wall;
+	m_threadMicroseconds+=thread;
+
+	if(idle){
+		m_idleCalls++;
+		m_idleMicroseconds+=wall;
+	}
+
+	m_maximumRankWallMicroseconds=m_wallMicroseconds;
+}
+
+void SlaveModeCounters::merge(SlaveModeCounters*other){
+	m_calls+=other->m_calls;
+	m_idleCalls+=other->m_idleCalls;
+	m_wallMicroseconds+=other->m_wallMicroseconds;
+	m_idleMicroseconds+=other->m_idleMicroseconds;
+	m_threadMicroseconds+=other->m_threadMicroseconds;
+
+	if(other->m_maximumRankWallMicroseconds>m_maximumRankWallMicroseconds)
+		m_maximumRankWallMicroseconds=other->m_maximumRankWallMicroseconds;
+}
+
+void SlaveModeCounters::pack(MessageUnit*buffer,int*position){
+	buffer[(*position)++]=m_calls;
+	buffer[(*position)++]=m_idleCalls;
+	buffer[(*position)++]=m_wallMicroseconds;
+	buffer[(*position)++]=m_idleMicroseconds;
+	buffer[(*position)++]=m_threadMicroseconds;
+}
+
+void SlaveModeCounters::unpack(MessageUnit*buffer,int*position){
+	m_calls=buffer[(*position)++];
+	m_idleCalls=buffer[(*position)++];
+	m_wallMicroseconds=buffer[(*position)++];
+	m_idleMicroseconds=buffer[(*position)++];
+	m_threadMicroseconds=buffer[(*position)++];
+	m_maximumRankWallMicroseconds=m_wallMicroseconds;
+}
+
+void SlaveModeCounters::writeJSON(ostream*stream){
+	(*stream)<<"\"calls\": "<<m_calls;
+	(*stream)<<", \"idleCalls\": "<<m_idleCalls;
+	(*stream)<<", \"wallMicroseconds\": "<<m_wallMicroseconds;
+	(*stream)<<", \"idleMicroseconds\": "<<m_idleMicroseconds;
+	(*stream)<<", \"threadMicroseconds\": "<<m_threadMicroseconds;
+	(*stream)<<", \"maximumRankWallMicroseconds\": "<<m_maximumRankWallMicroseconds;
+}
@@ -0,0 +1,64 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+
+#ifndef _SlaveModeCounters_h
+#define _SlaveModeCounters_h
+
+#include <RayPlatform/communication/Message.h>
+
+#include <ostream>
+using namespace std;
+
+/**
+ * Time spent by a rank in the handler of one slave mode during a phase.
+ *
+ * A call is idle when the inbox was empty and the handler queued no
+ * message, that is the handler was polling for replies (busy wait).
+ *
+ * When counters of several ranks are merged, the maximum wall time of
+ * a single rank is kept to show the imbalance.
+ *
+ * \author agent
+ */
+class SlaveModeCounters{
+
+	uint64_t m_calls;
+	uint64_t m_idleCalls;
+	uint64_t m_wallMicroseconds;
+	uint64_t m_idleMicroseconds;
+	uint64_t m_threadMicroseconds;
+	uint64_t m_maximumRankWallMicroseconds;
+
+public:
+
+	SlaveModeCounters();
+
+	void addCall(uint64_t wall,uint64_t thread,bool idle);
+
+	void merge(SlaveModeCounters*other);
+
+	void pack(MessageUnit*buffer,int*position);
+	void unpack(MessageUnit*buffer,int*position);
+
+	void writeJSON(ostream*stream);
+};
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+
+#include "SlaveModeProbe.h"
+#include "Instrumentation.h"
+
+SlaveModeProbe::SlaveModeProbe(Instrumentation*instrumentation,SlaveMode mode){
+	m_instrumentation=instrumentation;
+	m_mode=mode;
+
+	m_instrumentation->startSlaveMode(m_mode);
+}
+
+SlaveModeProbe::~SlaveModeProbe(){
+	m_instrumentation->endSlaveMode(m_mode);
+}
@@ -0,0 +1,52 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+
+#ifndef _SlaveModeProbe_h
+#define _SlaveModeProbe_h
+
+#include <RayPlatform/core/types.h>
+
+class Instrumentation;
+
+/**
+ * Declared at the top of the handler of a slave mode so that
+ * Instrumentation sees every call of the handler, including the
+ * ones that return early:
+ *
+ * 	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_EXTENSION);
+ *
+ * The probe does nothing when -write-instrumentation-data is not
+ * provided.
+ *
+ * \author agent
+ */
+class SlaveModeProbe{
+
+	Instrumentation*m_instrumentation;
+	SlaveMode m_mode;
+
+public:
+
+	SlaveModeProbe(Instrumentation*instrumentation,SlaveMode mode);
+	~SlaveModeProbe();
+};
+
+#endif
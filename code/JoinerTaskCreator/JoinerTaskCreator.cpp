@@ -32,6 +32,8 @@ __CreateSlaveModeAdapter(JoinerTaskCreator,RAY_SLAVE_MODE_FINISH_FUSIONS);
  * mainLoop() is provided by TaskCreator
  */
 void JoinerTaskCreator::call_RAY_SLAVE_MODE_FINISH_FUSIONS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_FINISH_FUSIONS);
+
 	mainLoop();
 }
 
@@ -149,7 +151,8 @@ Worker*JoinerTaskCreator::assignNextTask(){
 	RAY_MPI_TAG_ASK_VERTEX_PATH,
 	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
 	RAY_MPI_TAG_GET_PATH_LENGTH,
-	RAY_MPI_TAG_GET_PATH_VERTEX
+	RAY_MPI_TAG_GET_PATH_VERTEX,
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 );
 
 
@@ -212,6 +215,8 @@ void JoinerTaskCreator::registerPlugin(ComputeCore*core){
 }
 
 void JoinerTaskCreator::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_FINISH_FUSIONS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_FINISH_FUSIONS");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
@@ -219,6 +224,7 @@ void JoinerTaskCreator::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE");
 	RAY_MPI_TAG_GET_PATH_LENGTH=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_PATH_LENGTH");
 	RAY_MPI_TAG_GET_PATH_VERTEX=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_PATH_VERTEX");
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY");
 	RAY_MPI_TAG_FINISH_FUSIONS_FINISHED=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_FINISH_FUSIONS_FINISHED");
 
 	__BindPlugin(JoinerTaskCreator);
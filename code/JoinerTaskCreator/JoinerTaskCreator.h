@@ -25,6 +25,7 @@
 #include <code/Mock/Parameters.h>
 #include <code/KmerAcademyBuilder/Kmer.h>
 #include <code/SeedingData/GraphPath.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/scheduling/Worker.h>
 #include <RayPlatform/scheduling/TaskCreator.h>
@@ -56,6 +57,7 @@ class JoinerTaskCreator: public TaskCreator,  public CorePlugin{
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH;
 	MessageTag RAY_MPI_TAG_GET_PATH_VERTEX;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY;
 	MessageTag RAY_MPI_TAG_FINISH_FUSIONS_FINISHED;
 
 	SlaveMode RAY_SLAVE_MODE_FINISH_FUSIONS;
@@ -82,6 +84,8 @@ class JoinerTaskCreator: public TaskCreator,  public CorePlugin{
 	bool m_previouslyDone;
 	bool m_fastRun;
 
+	Instrumentation*m_instrumentation;
+
 public:
 	void constructor( VirtualProcessor*virtualProcessor,StaticVector*outbox,
 		RingAllocator*outboxAllocator,int*mode,Parameters*parameters,vector<GraphPath>*paths,vector<PathHandle>*pathIdentifiers,
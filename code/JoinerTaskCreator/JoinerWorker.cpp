@@ -56,7 +56,7 @@ void JoinerWorker::work(){
 /*
   used tags:
 
-	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 	RAY_MPI_TAG_ASK_VERTEX_PATH
 	RAY_MPI_TAG_GET_PATH_LENGTH
 */
@@ -91,28 +91,28 @@ void JoinerWorker::work(){
 			assert(destination < m_parameters->getSize() && destination >= 0);
 			#endif
 
-			int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
-			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
+			int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY);
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery*sizeof(MessageUnit));
 			int outputPosition=0;
 			kmer.pack(message,&outputPosition);
-
-			//cout<<"Comm"<<m_parameters->getRank()<<" sends to "<<destination<<" tag "<<MESSAGE_TAGS[RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE]<<endl;
+			message[outputPosition++]=m_identifier.getValue();
 
 			Message aMessage(message,elementsPerQuery,destination,
-				RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,m_parameters->getRank());
+				RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY,m_parameters->getRank());
 			m_virtualCommunicator->pushMessage(m_workerIdentifier,&aMessage);
 
 			m_requestedNumberOfPaths=true;
 			m_receivedNumberOfPaths=false;
 
 			if(m_parameters->hasOption("-debug-fusions2"))
-				cout<<"worker "<<m_workerIdentifier<<" send RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
+				cout<<"worker "<<m_workerIdentifier<<" send RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY"<<endl;
 
 		/* receive the number of paths */
 		}else if(m_requestedNumberOfPaths && !m_receivedNumberOfPaths && m_virtualCommunicator->isMessageProcessed(m_workerIdentifier)){
 			vector<MessageUnit> response;
 			m_virtualCommunicator->getMessageResponseElements(m_workerIdentifier,&response);
 			m_numberOfPaths=response[0];
+			int otherPaths=response[1];
 
 			if(m_parameters->hasOption("-debug-fusions2"))
 				cout<<"worker "<<m_workerIdentifier<<" Got "<<m_numberOfPaths<<endl;
@@ -126,9 +126,24 @@ void JoinerWorker::work(){
 			int maximumNumberOfPathsToProcess=32;
 
 			/* don't process repeated stuff */
-			if(m_numberOfPaths> maximumNumberOfPathsToProcess)
+			if(m_numberOfPaths> maximumNumberOfPathsToProcess){
 				m_numberOfPaths=0;
 
+			/*
+			 * The summary already carries the only other path, if any.
+			 * Only k-mers shared by several other paths need to be
+			 * enumerated with RAY_MPI_TAG_ASK_VERTEX_PATH.
+			 */
+			}else if(otherPaths<=1){
+				if(otherPaths==1){
+					PathHandle otherPathIdentifier=response[2];
+					int progression=response[3];
+					addHit(otherPathIdentifier,progression);
+				}
+
+				m_numberOfPaths=0;
+			}
+
 		}else if(m_receivedNumberOfPaths && m_pathIndex < m_numberOfPaths){
 			/* request a path */
 			if(!m_requestedPath){
@@ -173,25 +188,7 @@ void JoinerWorker::work(){
 				}
 
 				if(otherPathIdentifier != m_identifier){
-					m_hits[otherPathIdentifier]++;
-
-					int positionOnSelf=m_position;
-
-					if(m_reverseStrand){
-						positionOnSelf=m_path->size()-m_position-1;
-					}
-
-					// maybe it would be better not to store everything ?
-					// an algorithm would be needed for that however.
-
-					// just store everything and check them later...
-					m_selfPositions[otherPathIdentifier].push_back(positionOnSelf);
-					m_hitPositions[otherPathIdentifier].push_back(progression);
-
-					if(m_parameters->hasOption("-debug-fusions")){
-						cout<<"SelfLength= "<<m_path->size()<<" SelfStrand= "<<m_reverseStrand<<" MatchPair "<<" Self= "<<positionOnSelf<<" Other= "<<progression<<endl;
-					}
-
+					addHit(otherPathIdentifier,progression);
 				}
 				m_receivedPath=true;
 
@@ -781,6 +778,31 @@ Also, don't do it if the matching ratios are below 10%.
 	}
 }
 
+/**
+ * Record that the k-mer at m_position is also at position
+ * progression on another path.
+ */
+void JoinerWorker::addHit(PathHandle otherPathIdentifier,int progression){
+	m_hits[otherPathIdentifier]++;
+
+	int positionOnSelf=m_position;
+
+	if(m_reverseStrand){
+		positionOnSelf=m_path->size()-m_position-1;
+	}
+
+	// maybe it would be better not to store everything ?
+	// an algorithm would be needed for that however.
+
+	// just store everything and check them later...
+	m_selfPositions[otherPathIdentifier].push_back(positionOnSelf);
+	m_hitPositions[otherPathIdentifier].push_back(progression);
+
+	if(m_parameters->hasOption("-debug-fusions")){
+		cout<<"SelfLength= "<<m_path->size()<<" SelfStrand= "<<m_reverseStrand<<" MatchPair "<<" Self= "<<positionOnSelf<<" Other= "<<progression<<endl;
+	}
+}
+
 WorkerHandle JoinerWorker::getWorkerIdentifier(){
 	return m_workerIdentifier;
 }
@@ -792,9 +814,11 @@ vector<GraphPath>*newPaths,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH,
-	MessageTag RAY_MPI_TAG_GET_PATH_VERTEX
+	MessageTag RAY_MPI_TAG_GET_PATH_VERTEX,
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 ){
 
+	this->RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY=RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY;
 	this->RAY_MPI_TAG_ASK_VERTEX_PATH=RAY_MPI_TAG_ASK_VERTEX_PATH;
 	this->RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE=RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	this->RAY_MPI_TAG_GET_PATH_LENGTH=RAY_MPI_TAG_GET_PATH_LENGTH;
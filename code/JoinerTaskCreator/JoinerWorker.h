@@ -43,6 +43,7 @@ class JoinerWorker: public Worker{
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH;
 	MessageTag RAY_MPI_TAG_GET_PATH_VERTEX;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY;
 
 	bool m_requestedNumberOfPaths;
 	WorkerHandle m_workerIdentifier;
@@ -85,6 +86,8 @@ class JoinerWorker: public Worker{
 	int m_pathIndex;
 	bool m_receivedPath;
 	bool m_requestedPath;
+
+	void addHit(PathHandle otherPath,int progression);
 public:
 	void constructor(WorkerHandle i,GraphPath*path,PathHandle identifier,bool reverseStrand,
 VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
@@ -93,7 +96,8 @@ vector<GraphPath>*newPaths,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH,
-	MessageTag RAY_MPI_TAG_GET_PATH_VERTEX
+	MessageTag RAY_MPI_TAG_GET_PATH_VERTEX,
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY
 );
 
 	/* a method for Worker interface */
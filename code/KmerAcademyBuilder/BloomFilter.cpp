@@ -164,20 +164,19 @@ void BloomFilter::insertValue(Kmer*kmer){
 		uint64_t chunk=bit/64;
 		uint64_t bitInChunk=bit%64;
 
-		int oldBitValue=(m_bitmap[chunk] << (63-bitInChunk)) >> 63;
-
-/*
- * The bit is already set to 1. We don't need to do anything else.
- */
-		if(oldBitValue==1)
-			continue;
-
-
 		uint64_t filter=1;
 
 		filter <<= bitInChunk;
 
-		m_bitmap[chunk] |= filter;
+/*
+ * The threads of the k-mer extraction pool insert in the
+ * filter at the same time, so the bit is set atomically.
+ * The bit was already set to 1 if the old chunk has it.
+ */
+		uint64_t oldChunk=__sync_fetch_and_or(m_bitmap+chunk,filter);
+
+		if(oldChunk & filter)
+			continue;
 
 		#ifdef CONFIG_ASSERT
 		int bitValue=(m_bitmap[chunk] << (63-bitInChunk)) >> 63;
@@ -189,14 +188,14 @@ void BloomFilter::insertValue(Kmer*kmer){
 /*
  * We increased the number of set bits by 1.
  */
-		m_numberOfSetBits++;
+		__sync_fetch_and_add(&m_numberOfSetBits,1);
 	}
 
 	#ifdef CONFIG_ASSERT
 	assert(hasValue(kmer));
 	#endif
 
-	m_numberOfInsertions++;
+	__sync_fetch_and_add(&m_numberOfInsertions,1);
 }
 
 void BloomFilter::destructor(){
@@ -176,36 +176,32 @@ int Kmer::vertexRank(int _size,int w,bool color)const{
 vector<Kmer> Kmer::getOutgoingEdges(uint8_t edges,int k)const{
 	vector<Kmer> b;
 	Kmer aTemplate;
-	aTemplate=*this;
 
-	for(int i=0;i<aTemplate.getNumberOfU64();i++){
-		uint64_t word=aTemplate.getU64(i)>>2;
-		if(i!=aTemplate.getNumberOfU64()-1){
-			uint64_t next=aTemplate.getU64(i+1);
 /*
+ * Shift all the symbols by one position, whole words at a time.
+ *
  *		abcd	efgh
  *		00ab	00ef
  *		00ab	cdef
  */
-			next=(next<<62);
-			word=word|next;
-		}
-		aTemplate.setU64(i,word);
+	for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+		uint64_t word=m_u64[i]>>2;
+
+		if(i!=KMER_U64_ARRAY_SIZE-1)
+			word|=(m_u64[i+1]<<62);
+
+		aTemplate.m_u64[i]=word;
 	}
 
-	int positionToUpdate=2*k;
+	/* the new symbol is the last one of the k-mer */
+	int positionToUpdate=2*(k-1);
 	int chunkIdToUpdate=positionToUpdate/64;
 	positionToUpdate=positionToUpdate%64;
 
-	for(int i=0;i<4;i++){
-		int j=((((uint64_t)edges)<<(sizeof(uint64_t)*8-5-i))>>(sizeof(uint64_t)*8-1));
-		if(j==1){
+	for(uint64_t i=0;i<4;i++){
+		if((edges>>(4+i))&1){
 			Kmer newKmer=aTemplate;
-			uint64_t last=newKmer.getU64(chunkIdToUpdate);
-			uint64_t filter=i;
-			filter=filter<<(positionToUpdate-2);
-			last=last|filter;
-			newKmer.setU64(chunkIdToUpdate,last);
+			newKmer.m_u64[chunkIdToUpdate]|=(i<<positionToUpdate);
 			b.push_back(newKmer);
 		}
 	}
@@ -220,13 +216,6 @@ vector<Kmer> Kmer::getOutgoingEdges(uint8_t edges,int k)const{
 vector<Kmer> Kmer::getIngoingEdges(uint8_t edges,int k)const{
 	vector<Kmer> b;
 	Kmer aTemplate;
-	aTemplate=*this;
-	
-	int posToClear=2*k;
-
-	for(int i=0;i<aTemplate.getNumberOfU64();i++){
-		uint64_t element=aTemplate.getU64(i);
-		element=element<<2;
 
 //	1		0
 //
@@ -237,44 +226,29 @@ vector<Kmer> Kmer::getIngoingEdges(uint8_t edges,int k)const{
 //	abcdefghij  klmnopqr00		// copy the last to the first
 //	00cdefghij  klmnopqr00		// reset the 2 last
 
-/**
- * Now, we need to copy 2 bits from 
- */
-		if(i!=0){
-			// the 2 last of the previous will be the 2 first of this one
-			uint64_t last=getU64(i-1);
-			last=(last>>62);
-			element=element|last;
-		}
+	for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+		uint64_t word=m_u64[i]<<2;
 
-		/**
- *	The two last bits that shifted must be cleared
- *	Otherwise, it will change the hash value of the Kmer...
- *	The chunk number i contains bits from i to i*64-1
- *	Therefore, if posToClear is inside these boundaries,
- *	then it is obvious that these awful bits must be changed 
- *	to 0
- */
-		if(i*64<=posToClear&&posToClear<i*64+64){
-			int position=posToClear%64;
+		// the 2 last of the previous will be the 2 first of this one
+		if(i!=0)
+			word|=(m_u64[i-1]>>62);
 
-			uint64_t filter=3;// 11 or 1*2^1+1*2^0
-			filter=filter<<(position);
-			filter=~filter;
-			element=element&filter;
-		}
-		aTemplate.setU64(i,element);
+		aTemplate.m_u64[i]=word;
 	}
 
-	for(int i=0;i<4;i++){
-		int j=((((uint64_t)edges)<<((sizeof(uint64_t)*8-1)-i))>>(sizeof(uint64_t)*8-1));
-		if(j==1){
+	/*
+	 * The symbol that was shifted out of the k-mer must be cleared,
+	 * otherwise it will change the hash value of the Kmer.
+	 */
+	int posToClear=2*k;
+
+	if(posToClear<64*KMER_U64_ARRAY_SIZE)
+		aTemplate.m_u64[posToClear/64]&=~(((uint64_t)3)<<(posToClear%64));
+
+	for(uint64_t i=0;i<4;i++){
+		if((edges>>i)&1){
 			Kmer newKmer=aTemplate;
-			int id=0;
-			uint64_t last=newKmer.getU64(id);
-			uint64_t filter=i;
-			last=last|filter;
-			newKmer.setU64(id,last);
+			newKmer.m_u64[0]|=i;
 			b.push_back(newKmer);
 		}
 	}
@@ -395,27 +369,88 @@ uint64_t Kmer::getU64(int i)const{
 	return m_u64[i];
 }
 
+/*
+ * Reverse the order of the 32 symbols (2 bits each) of a word.
+ * Pairs of symbols are swapped, then nibbles, then bytes.
+ */
+static inline uint64_t reverseSymbols(uint64_t word){
+	word=((word>>2)&0x3333333333333333ULL)|((word&0x3333333333333333ULL)<<2);
+	word=((word>>4)&0x0f0f0f0f0f0f0f0fULL)|((word&0x0f0f0f0f0f0f0f0fULL)<<4);
+
+	#ifdef __GNUC__
+	return __builtin_bswap64(word);
+	#else
+	word=((word>>8)&0x00ff00ff00ff00ffULL)|((word&0x00ff00ff00ff00ffULL)<<8);
+	word=((word>>16)&0x0000ffff0000ffffULL)|((word&0x0000ffff0000ffffULL)<<16);
+	return (word>>32)|(word<<32);
+	#endif
+}
+
+/*
+ * The reverse complement is computed with whole words:
+ * the symbols of the array are reversed, the array is shifted so
+ * that the first symbol is at position 0 and the symbols are
+ * complemented with a XOR.
+ */
 Kmer Kmer::complementVertex(int wordSize,bool colorSpace)const{
 	Kmer output;
-	int bitPositionInOutput=0;
-	uint64_t mask=3;
-	/* the order is inverted and nucleotides are complemented */
-	/* this is costly  */
-	for(int positionInMer=wordSize-1;positionInMer>=0;positionInMer--){
-		int u64_id=positionInMer/32;
-		int bitPositionInChunk=(2*positionInMer)%64;
-		uint64_t chunk=getU64(u64_id);
-		uint64_t j=(chunk<<(62-bitPositionInChunk))>>62;
-		
-		if(!colorSpace) /* in color space, reverse complement is just reverse */
-			j=~j&mask;
-
-		int outputChunk=bitPositionInOutput/64;
-		uint64_t oldValue=output.getU64(outputChunk);
-		oldValue=(oldValue|(j<<(bitPositionInOutput%64)));
-		output.setU64(outputChunk,oldValue);
-		bitPositionInOutput+=2;
+
+	#if KMER_U64_ARRAY_SIZE == 1
+
+	uint64_t word=reverseSymbols(m_u64[0])>>(64-2*wordSize);
+
+	/* in color space, reverse complement is just reverse */
+	if(!colorSpace){
+		if(wordSize==32)
+			word=~word;
+		else
+			word^=(((uint64_t)1)<<(2*wordSize))-1;
 	}
+
+	output.m_u64[0]=word;
+
+	#else
+
+	/* symbol p goes to 32*KMER_U64_ARRAY_SIZE-1-p */
+	uint64_t reversed[KMER_U64_ARRAY_SIZE];
+
+	for(int i=0;i<KMER_U64_ARRAY_SIZE;i++)
+		reversed[KMER_U64_ARRAY_SIZE-1-i]=reverseSymbols(m_u64[i]);
+
+	/* symbol p goes to wordSize-1-p */
+	int shift=64*KMER_U64_ARRAY_SIZE-2*wordSize;
+	int wordShift=shift/64;
+	int bitShift=shift%64;
+
+	for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+		uint64_t word=0;
+
+		if(i+wordShift<KMER_U64_ARRAY_SIZE){
+			word=reversed[i+wordShift]>>bitShift;
+
+			if(bitShift!=0 && i+wordShift+1<KMER_U64_ARRAY_SIZE)
+				word|=reversed[i+wordShift+1]<<(64-bitShift);
+		}
+
+		output.m_u64[i]=word;
+	}
+
+	/* in color space, reverse complement is just reverse */
+	if(!colorSpace){
+		int bits=2*wordSize;
+
+		for(int i=0;i<KMER_U64_ARRAY_SIZE && bits>0;i++){
+			if(bits>=64)
+				output.m_u64[i]=~output.m_u64[i];
+			else
+				output.m_u64[i]^=(((uint64_t)1)<<bits)-1;
+
+			bits-=64;
+		}
+	}
+
+	#endif
+
 	return output;
 }
 
@@ -41,6 +41,8 @@ __CreateSlaveModeAdapter(KmerAcademyBuilder,RAY_SLAVE_MODE_ADD_VERTICES);
 using namespace std;
 
 void KmerAcademyBuilder::call_RAY_SLAVE_MODE_ADD_VERTICES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_ADD_VERTICES);
+
 	
 	if(!m_initialised){
 		m_initialised=true;
@@ -54,13 +56,25 @@ void KmerAcademyBuilder::call_RAY_SLAVE_MODE_ADD_VERTICES(){
 
 	if(!m_checkedCheckpoint){
 		m_checkedCheckpoint=true;
-		if(m_parameters->hasCheckpoint("GenomeGraph")){
+		if(m_parameters->isIncrementalAssembly()){
+			m_mode_send_vertices_sequence_id=m_parameters->getFirstNewSequence();
+
+			if(m_mode_send_vertices_sequence_id>(int)m_myReads->size())
+				m_mode_send_vertices_sequence_id=m_myReads->size();
+
+			cout<<"Rank "<<m_parameters->getRank()<<": checkpoint GenomeGraph exists, counting k-mers in sequence reads [";
+			cout<<m_mode_send_vertices_sequence_id+1<<"/"<<m_myReads->size()<<"] and after."<<endl;
+
+		}else if(m_parameters->hasCheckpoint("GenomeGraph")){
 			cout<<"Rank "<<m_parameters->getRank()<<": checkpoint GenomeGraph exists, not counting k-mers."<<endl;
 			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_KMER_ACADEMY_DISTRIBUTED,m_parameters->getRank());
 			m_outbox->push_back(&aMessage);
 			m_finished=true;
 			return;
 		}
+
+		if(m_extractionPool->isEnabled())
+			m_extractionPool->startExtraction(KMER_EXTRACTION_VERTICES,m_mode_send_vertices_sequence_id);
 	}
 
 	#ifdef CONFIG_ASSERT
@@ -80,21 +94,17 @@ void KmerAcademyBuilder::call_RAY_SLAVE_MODE_ADD_VERTICES(){
 	}
 
 	if(m_mode_send_vertices_sequence_id%100000==0 &&m_mode_send_vertices_sequence_id_position==0
-		&&m_mode_send_vertices_sequence_id<(int)m_myReads->size()){
+		&&m_mode_send_vertices_sequence_id<(int)m_myReads->size() && !m_extractionPool->isEnabled()){
 
-		string reverse="";
-		if(m_reverseComplementVertex==true){
-			reverse="(reverse complement) ";
-		}
-		printf("Rank %i is counting k-mers in sequence reads %s[%i/%i]\n",m_parameters->getRank(),
-			reverse.c_str(),(int)m_mode_send_vertices_sequence_id+1,(int)m_myReads->size());
-
-		m_derivative.addX(m_mode_send_vertices_sequence_id);
-		m_derivative.printStatus(SLAVE_MODES[RAY_SLAVE_MODE_ADD_VERTICES],RAY_SLAVE_MODE_ADD_VERTICES);
-		m_derivative.printEstimatedTime(m_myReads->size());
+		printProgress(m_mode_send_vertices_sequence_id);
 	}
 
-	if(m_mode_send_vertices_sequence_id>(int)m_myReads->size()-1){
+	bool completed=m_mode_send_vertices_sequence_id>(int)m_myReads->size()-1;
+
+	if(m_extractionPool->isEnabled())
+		completed=m_extractionPool->isFinished();
+
+	if(completed){
 		// flush data
 		flushAll(m_outboxAllocator,m_outbox,m_parameters->getRank());
 		if(m_pendingMessages==0){
@@ -114,6 +124,35 @@ void KmerAcademyBuilder::call_RAY_SLAVE_MODE_ADD_VERTICES(){
 
 		}
 		MACRO_COLLECT_PROFILING_INFORMATION();
+	}else if(m_extractionPool->isEnabled()){
+
+		// the k-mers of the next reads are computed by the threads
+		if(!m_extractionPool->hasMessage()){
+			if(m_extractionPool->nextBatch()){
+				LargeIndex first=m_extractionPool->getFirstRead();
+				LargeIndex last=first+m_extractionPool->getNumberOfReads();
+
+				// the first multiple of 100000 in the batch
+				LargeIndex read=(first+99999)/100000*100000;
+
+				if(read<last)
+					printProgress(read);
+
+				m_mode_send_vertices_sequence_id=last;
+			}
+			return;
+		}
+
+		MessageTag tags[1];
+		tags[0]=RAY_MPI_TAG_VERTICES_DATA;
+
+		// the replies are counted in the same way as for m_bufferedData
+		int maximum=CONFIG_KMER_EXTRACTION_MESSAGES;
+
+		if(maximum>m_parameters->getSize())
+			maximum=m_parameters->getSize();
+
+		m_pendingMessages+=m_extractionPool->sendMessages(maximum,tags,m_outboxAllocator,m_outbox);
 	}else{
 		if(m_mode_send_vertices_sequence_id_position==0){
 			(*m_myReads)[(m_mode_send_vertices_sequence_id)]->getSeq(m_readSequence,m_parameters->getColorSpaceMode(),false);
@@ -181,19 +220,7 @@ void KmerAcademyBuilder::call_RAY_SLAVE_MODE_ADD_VERTICES(){
  * only one of them.
  */
 
-			Rank rankToFlush=kmerToSend.vertexRank(m_parameters->getSize(),m_parameters->getWordSize(),
-				m_parameters->getColorSpaceMode());
-
-			for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-				m_bufferedData.addAt(rankToFlush,kmerToSend.getU64(i));
-			}
-
-			if(m_bufferedData.flush(rankToFlush,KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_VERTICES_DATA,
-				m_outboxAllocator,m_outbox,
-				m_parameters->getRank(),false)){
-
-				m_pendingMessages++;
-			}
+			sendKmer(&kmerToSend);
 
 			MACRO_COLLECT_PROFILING_INFORMATION();
 		}
@@ -210,10 +237,45 @@ void KmerAcademyBuilder::call_RAY_SLAVE_MODE_ADD_VERTICES(){
 	MACRO_COLLECT_PROFILING_INFORMATION();
 }
 
+void KmerAcademyBuilder::printProgress(int read){
+
+	string reverse="";
+	if(m_reverseComplementVertex==true){
+		reverse="(reverse complement) ";
+	}
+	printf("Rank %i is counting k-mers in sequence reads %s[%i/%i]\n",m_parameters->getRank(),
+		reverse.c_str(),(int)read+1,(int)m_myReads->size());
+
+	m_derivative.addX(read);
+	m_derivative.printStatus(SLAVE_MODES[RAY_SLAVE_MODE_ADD_VERTICES],RAY_SLAVE_MODE_ADD_VERTICES);
+	m_derivative.printEstimatedTime(m_myReads->size());
+}
+
+void KmerAcademyBuilder::sendKmer(Kmer*kmerToSend){
+
+	Rank rankToFlush=kmerToSend->vertexRank(m_parameters->getSize(),m_parameters->getWordSize(),
+		m_parameters->getColorSpaceMode());
+
+	for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+		m_bufferedData.addAt(rankToFlush,kmerToSend->getU64(i));
+	}
+
+	if(m_bufferedData.flush(rankToFlush,KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_VERTICES_DATA,
+		m_outboxAllocator,m_outbox,
+		m_parameters->getRank(),false)){
+
+		m_pendingMessages++;
+	}
+}
+
 void KmerAcademyBuilder::setProfiler(Profiler*profiler){
 	m_profiler = profiler;
 }
 
+void KmerAcademyBuilder::setExtractionPool(KmerExtractionPool*pool){
+	m_extractionPool=pool;
+}
+
 void KmerAcademyBuilder::constructor(int size,Parameters*parameters,GridTable*graph,
 	ArrayOfReads*myReads,StaticVector*inbox,StaticVector*outbox,
 SlaveMode*mode,RingAllocator*outboxAllocator){
@@ -305,6 +367,8 @@ void KmerAcademyBuilder::registerPlugin(ComputeCore*core){
 }
 
 void KmerAcademyBuilder::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_ADD_VERTICES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_ADD_VERTICES");
 
 	RAY_MPI_TAG_KMER_ACADEMY_DISTRIBUTED=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_KMER_ACADEMY_DISTRIBUTED");
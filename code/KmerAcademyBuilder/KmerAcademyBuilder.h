@@ -22,11 +22,14 @@
 #ifndef _KmerAcademyBuilder
 #define _KmerAcademyBuilder
 
+#include "KmerExtractionPool.h"
+
 #include <code/VerticesExtractor/GridTable.h>
 #include <code/Mock/Parameters.h>
 #include <code/Mock/common_functions.h>
 #include <code/SequencesLoader/ArrayOfReads.h>
 #include <code/SequencesLoader/Read.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/structures/StaticVector.h>
 #include <RayPlatform/communication/BufferedData.h>
@@ -95,6 +98,16 @@ class KmerAcademyBuilder : public CorePlugin{
 
 	bool m_finished;
 	GridTable*m_subgraph;
+
+	KmerExtractionPool*m_extractionPool;
+
+	/** prints the progress when a multiple of 100000 reads is reached */
+	void printProgress(int read);
+
+	/** buffers a lower k-mer for its owner */
+	void sendKmer(Kmer*kmerToSend);
+	Instrumentation*m_instrumentation;
+
 public:
 
 	BufferedData m_buffersForIngoingEdgesToDelete;
@@ -106,6 +119,7 @@ SlaveMode*mode,RingAllocator*outboxAllocator
 );
 
 	void setProfiler(Profiler*profiler);
+	void setExtractionPool(KmerExtractionPool*pool);
 
 	void call_RAY_SLAVE_MODE_ADD_VERTICES();
 
@@ -0,0 +1,209 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "KmerBenchmark.h"
+
+#include <RayPlatform/core/OperatingSystem.h>
+
+#include <iostream>
+using namespace std;
+
+#include <stdlib.h>
+
+#define KMER_BENCHMARK_KMERS 1000000
+
+/*
+ * The reference implementations process one symbol at a time.
+ */
+static Kmer complementVertexReference(const Kmer*kmer,int wordSize,bool colorSpace){
+	Kmer output;
+	int bitPositionInOutput=0;
+	uint64_t mask=3;
+
+	for(int positionInMer=wordSize-1;positionInMer>=0;positionInMer--){
+		int u64_id=positionInMer/32;
+		int bitPositionInChunk=(2*positionInMer)%64;
+		uint64_t chunk=kmer->getU64(u64_id);
+		uint64_t j=(chunk<<(62-bitPositionInChunk))>>62;
+
+		if(!colorSpace)
+			j=~j&mask;
+
+		int outputChunk=bitPositionInOutput/64;
+		uint64_t oldValue=output.getU64(outputChunk);
+		oldValue=(oldValue|(j<<(bitPositionInOutput%64)));
+		output.setU64(outputChunk,oldValue);
+		bitPositionInOutput+=2;
+	}
+	return output;
+}
+
+static vector<Kmer> getOutgoingEdgesReference(const Kmer*kmer,int k){
+	vector<Kmer> edges;
+	Kmer aTemplate;
+
+	for(int i=0;i<kmer->getNumberOfU64();i++){
+		uint64_t word=kmer->getU64(i)>>2;
+		if(i!=kmer->getNumberOfU64()-1){
+			uint64_t next=kmer->getU64(i+1);
+			word=word|(next<<62);
+		}
+		aTemplate.setU64(i,word);
+	}
+
+	int positionToUpdate=2*k-2;
+	int chunkIdToUpdate=positionToUpdate/64;
+	positionToUpdate=positionToUpdate%64;
+
+	for(int i=0;i<4;i++){
+		Kmer newKmer=aTemplate;
+		uint64_t last=newKmer.getU64(chunkIdToUpdate);
+		uint64_t filter=i;
+		last=last|(filter<<positionToUpdate);
+		newKmer.setU64(chunkIdToUpdate,last);
+		edges.push_back(newKmer);
+	}
+	return edges;
+}
+
+static vector<Kmer> getIngoingEdgesReference(const Kmer*kmer,int k){
+	vector<Kmer> edges;
+	Kmer aTemplate;
+	int posToClear=2*k;
+
+	for(int i=0;i<kmer->getNumberOfU64();i++){
+		uint64_t element=kmer->getU64(i)<<2;
+
+		if(i!=0)
+			element=element|(kmer->getU64(i-1)>>62);
+
+		if(i*64<=posToClear&&posToClear<i*64+64){
+			uint64_t filter=3;
+			filter=filter<<(posToClear%64);
+			element=element&(~filter);
+		}
+		aTemplate.setU64(i,element);
+	}
+
+	for(int i=0;i<4;i++){
+		Kmer newKmer=aTemplate;
+		uint64_t last=newKmer.getU64(0);
+		last=last|i;
+		newKmer.setU64(0,last);
+		edges.push_back(newKmer);
+	}
+	return edges;
+}
+
+void KmerBenchmark::generateKmers(int kmerLength,int count){
+	m_kmers.clear();
+
+	srand(kmerLength);
+
+	for(int i=0;i<count;i++){
+		Kmer kmer;
+		for(int position=0;position<kmerLength;position++){
+			uint64_t symbol=rand()%4;
+			int chunk=position/32;
+			kmer.setU64(chunk,kmer.getU64(chunk)|(symbol<<(2*(position%32))));
+		}
+		m_kmers.push_back(kmer);
+	}
+}
+
+bool KmerBenchmark::runKmerLength(int kmerLength){
+	generateKmers(kmerLength,KMER_BENCHMARK_KMERS);
+
+	int count=m_kmers.size();
+	bool identical=true;
+
+	for(int colorSpace=0;colorSpace<2;colorSpace++){
+		for(int i=0;i<count;i++){
+			Kmer expected=complementVertexReference(&(m_kmers[i]),kmerLength,colorSpace);
+			Kmer actual=m_kmers[i].complementVertex(kmerLength,colorSpace);
+			if(expected!=actual)
+				identical=false;
+		}
+	}
+
+	for(int i=0;i<count && identical;i++){
+		if(m_kmers[i].getOutgoingEdges(0xf0,kmerLength)!=getOutgoingEdgesReference(&(m_kmers[i]),kmerLength))
+			identical=false;
+
+		if(m_kmers[i].getIngoingEdges(0x0f,kmerLength)!=getIngoingEdgesReference(&(m_kmers[i]),kmerLength))
+			identical=false;
+	}
+
+	/* timings, the checksum keeps the compiler from removing the loops */
+	uint64_t checksum=0;
+
+	uint64_t start=getMicroseconds();
+	for(int i=0;i<count;i++)
+		checksum+=complementVertexReference(&(m_kmers[i]),kmerLength,false).getU64(0);
+	uint64_t referenceComplement=getMicroseconds()-start;
+
+	start=getMicroseconds();
+	for(int i=0;i<count;i++)
+		checksum+=m_kmers[i].complementVertex(kmerLength,false).getU64(0);
+	uint64_t complement=getMicroseconds()-start;
+
+	start=getMicroseconds();
+	for(int i=0;i<count;i++){
+		checksum+=getOutgoingEdgesReference(&(m_kmers[i]),kmerLength)[0].getU64(0);
+		checksum+=getIngoingEdgesReference(&(m_kmers[i]),kmerLength)[0].getU64(0);
+	}
+	uint64_t referenceEdges=getMicroseconds()-start;
+
+	start=getMicroseconds();
+	for(int i=0;i<count;i++){
+		checksum+=m_kmers[i].getOutgoingEdges(0xf0,kmerLength)[0].getU64(0);
+		checksum+=m_kmers[i].getIngoingEdges(0x0f,kmerLength)[0].getU64(0);
+	}
+	uint64_t edges=getMicroseconds()-start;
+
+	cout<<"k= "<<kmerLength<<" k-mers= "<<count;
+	cout<<" complementVertex: "<<referenceComplement<<" us -> "<<complement<<" us";
+	cout<<" edges: "<<referenceEdges<<" us -> "<<edges<<" us";
+	cout<<" results: "<<(identical?"identical":"DIFFERENT");
+	cout<<" checksum: "<<checksum<<endl;
+
+	return identical;
+}
+
+bool KmerBenchmark::run(){
+	int lengths[]={21,31,63,95};
+	int numberOfLengths=sizeof(lengths)/sizeof(int);
+	bool identical=true;
+
+	cout<<"KmerBenchmark: KMER_U64_ARRAY_SIZE= "<<KMER_U64_ARRAY_SIZE;
+	cout<<" CONFIG_MAXKMERLENGTH= "<<CONFIG_MAXKMERLENGTH<<endl;
+
+	for(int i=0;i<numberOfLengths;i++){
+		if(lengths[i]>CONFIG_MAXKMERLENGTH){
+			cout<<"k= "<<lengths[i]<<" skipped, needs MAXKMERLENGTH="<<lengths[i]<<endl;
+			continue;
+		}
+
+		if(!runKmerLength(lengths[i]))
+			identical=false;
+	}
+
+	return identical;
+}
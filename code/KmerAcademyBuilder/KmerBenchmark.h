@@ -0,0 +1,52 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _KmerBenchmark_h
+#define _KmerBenchmark_h
+
+#include "Kmer.h"
+
+#include <vector>
+using namespace std;
+
+/**
+ * Micro-benchmark for the word-parallel kernels of Kmer
+ * (reverse complement and neighbour k-mers).
+ *
+ * The kernels are compared bit for bit with the original
+ * implementations that process one symbol at a time.
+ * It is started with Ray -kmer-benchmark.
+ *
+ * \author agent
+ */
+class KmerBenchmark{
+
+	vector<Kmer> m_kmers;
+
+	void generateKmers(int kmerLength,int count);
+	bool runKmerLength(int kmerLength);
+
+public:
+
+	/** returns true if all the kernels gave the same results */
+	bool run();
+};
+
+#endif
@@ -0,0 +1,528 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "KmerExtractionPool.h"
+
+#include <code/Mock/common_functions.h>
+
+#include <string.h>
+#include <iostream>
+using namespace std;
+
+#ifdef CONFIG_ASSERT
+#include <assert.h>
+#endif
+
+KmerExtractionPool::KmerExtractionPool(){
+	m_parameters=NULL;
+	m_reads=NULL;
+	m_threads=1;
+	m_ranks=1;
+	m_runningThreads=0;
+	m_started=false;
+	m_stop=false;
+	m_current=-1;
+	m_next=0;
+	m_inserter=NULL;
+	m_runningInsertions=0;
+
+	pthread_mutex_init(&m_lock,NULL);
+	pthread_cond_init(&m_workIsAvailable,NULL);
+	pthread_cond_init(&m_insertionsAreDone,NULL);
+}
+
+KmerExtractionPool::~KmerExtractionPool(){
+	destructor();
+
+	pthread_mutex_destroy(&m_lock);
+	pthread_cond_destroy(&m_workIsAvailable);
+	pthread_cond_destroy(&m_insertionsAreDone);
+}
+
+void KmerExtractionPool::constructor(Parameters*parameters,ArrayOfReads*reads){
+	m_parameters=parameters;
+	m_reads=reads;
+	m_threads=m_parameters->getNumberOfThreadsPerRank();
+	m_ranks=m_parameters->getSize();
+
+	m_workers.resize(m_threads);
+
+	for(int i=0;i<m_threads;i++){
+		m_workers[i].m_pool=this;
+		m_workers[i].m_thread=i;
+		m_workers[i].m_started=false;
+	}
+
+	for(int i=0;i<2;i++){
+		m_batches[i].m_submitted=false;
+		m_batches[i].m_remainingThreads=0;
+	}
+}
+
+bool KmerExtractionPool::isEnabled(){
+	return m_threads>1;
+}
+
+void*KmerExtractionPool::startThread(void*argument){
+	KmerExtractionThread*worker=(KmerExtractionThread*)argument;
+	worker->m_pool->work(worker->m_thread);
+	return NULL;
+}
+
+void KmerExtractionPool::startThreads(){
+	if(m_started)
+		return;
+
+	m_started=true;
+	m_stop=false;
+	m_runningThreads=0;
+
+	for(int i=0;i<m_threads;i++){
+		m_workers[i].m_started=(pthread_create(&(m_workers[i].m_handle),NULL,startThread,&(m_workers[i]))==0);
+
+		// the main thread does the work of this thread
+		if(!m_workers[i].m_started)
+			cout<<"Error: can not start thread "<<i<<" on rank "<<m_parameters->getRank()<<endl;
+		else
+			m_runningThreads++;
+	}
+}
+
+void KmerExtractionPool::destructor(){
+	if(!m_started)
+		return;
+
+	pthread_mutex_lock(&m_lock);
+	m_stop=true;
+	pthread_cond_broadcast(&m_workIsAvailable);
+	pthread_mutex_unlock(&m_lock);
+
+	for(int i=0;i<m_threads;i++){
+		if(m_workers[i].m_started)
+			pthread_join(m_workers[i].m_handle,NULL);
+		m_workers[i].m_started=false;
+	}
+
+	m_started=false;
+	m_runningThreads=0;
+}
+
+/*
+ * The threads take the queued insertions first, so that the queue
+ * stays short, then their part of the oldest batch.
+ */
+void KmerExtractionPool::work(int thread){
+
+	pthread_mutex_lock(&m_lock);
+
+	while(1){
+
+		if(!m_insertions.empty()){
+			vector<MessageUnit> kmers;
+			kmers.swap(m_insertions.front());
+			m_insertions.pop_front();
+			m_runningInsertions++;
+
+			pthread_mutex_unlock(&m_lock);
+			m_inserter->insertKmers(&(kmers[0]),kmers.size());
+			pthread_mutex_lock(&m_lock);
+
+			m_runningInsertions--;
+
+			if(m_insertions.empty() && m_runningInsertions==0)
+				pthread_cond_broadcast(&m_insertionsAreDone);
+
+			continue;
+		}
+
+		int batch=-1;
+
+		for(int i=0;i<2;i++){
+			KmerExtractionBatch*candidate=m_batches+i;
+
+			if(!candidate->m_submitted || !candidate->m_pending[thread])
+				continue;
+
+			if(batch<0 || candidate->m_first<m_batches[batch].m_first)
+				batch=i;
+		}
+
+		if(batch>=0){
+			m_batches[batch].m_pending[thread]=false;
+
+			pthread_mutex_unlock(&m_lock);
+			extract(batch,thread);
+			pthread_mutex_lock(&m_lock);
+
+			m_batches[batch].m_remainingThreads--;
+			continue;
+		}
+
+		if(m_stop)
+			break;
+
+		pthread_cond_wait(&m_workIsAvailable,&m_lock);
+	}
+
+	pthread_mutex_unlock(&m_lock);
+}
+
+void KmerExtractionPool::startExtraction(int kind,LargeIndex first){
+
+	startThreads();
+
+	m_kind=kind;
+	m_streams=1;
+
+	if(m_kind==KMER_EXTRACTION_EDGES)
+		m_streams=2;
+
+	// an edge is 2 k-mers
+	m_recordWords=m_streams*KMER_U64_ARRAY_SIZE;
+
+	int capacity=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
+	m_maximumWords=capacity-capacity%m_recordWords;
+
+	m_nextRead=first;
+	m_current=-1;
+	m_next=0;
+	m_group=0;
+	m_thread=0;
+	m_offset=0;
+
+	submit(0);
+	submit(1);
+}
+
+void KmerExtractionPool::submit(int batch){
+
+	KmerExtractionBatch*work=m_batches+batch;
+
+	LargeCount count=0;
+
+	if(m_nextRead<m_reads->size()){
+		count=CONFIG_KMER_EXTRACTION_BATCH;
+
+		if(m_nextRead+count>m_reads->size())
+			count=m_reads->size()-m_nextRead;
+	}
+
+	// no thread uses the batch when it is given back
+	work->m_first=m_nextRead;
+	work->m_count=count;
+	m_nextRead+=count;
+
+	work->m_words.resize(m_threads);
+
+	for(int i=0;i<m_threads;i++)
+		work->m_words[i].resize(m_streams*m_ranks);
+
+	pthread_mutex_lock(&m_lock);
+
+	work->m_submitted=(count>0);
+	work->m_pending.assign(m_threads,false);
+	work->m_remainingThreads=0;
+
+	if(work->m_submitted){
+		for(int i=0;i<m_threads;i++){
+			if(!m_workers[i].m_started)
+				continue;
+
+			work->m_pending[i]=true;
+			work->m_remainingThreads++;
+		}
+
+		pthread_cond_broadcast(&m_workIsAvailable);
+	}
+
+	pthread_mutex_unlock(&m_lock);
+
+	if(!work->m_submitted)
+		return;
+
+	for(int i=0;i<m_threads;i++){
+		if(!m_workers[i].m_started)
+			extract(batch,i);
+	}
+}
+
+bool KmerExtractionPool::nextBatch(){
+
+	KmerExtractionBatch*batch=m_batches+m_next;
+
+	pthread_mutex_lock(&m_lock);
+	bool ready=batch->m_submitted && batch->m_remainingThreads==0;
+	pthread_mutex_unlock(&m_lock);
+
+	if(!ready)
+		return false;
+
+	// the messages of the current batch were sent, it gets the next reads
+	if(m_current>=0)
+		submit(m_current);
+
+	m_current=m_next;
+	m_next=1-m_next;
+
+	m_group=0;
+	m_thread=0;
+	m_offset=0;
+
+	return true;
+}
+
+bool KmerExtractionPool::isFinished(){
+
+	if(hasMessage())
+		return false;
+
+	pthread_mutex_lock(&m_lock);
+	bool submitted=m_batches[m_next].m_submitted;
+	pthread_mutex_unlock(&m_lock);
+
+	return !submitted;
+}
+
+LargeIndex KmerExtractionPool::getFirstRead(){
+	return m_batches[m_current].m_first;
+}
+
+LargeCount KmerExtractionPool::getNumberOfReads(){
+	return m_batches[m_current].m_count;
+}
+
+bool KmerExtractionPool::hasMessage(){
+
+	if(m_current<0)
+		return false;
+
+	KmerExtractionBatch*batch=m_batches+m_current;
+	int groups=m_streams*m_ranks;
+
+	while(m_group<groups){
+		if(m_thread==m_threads){
+			m_group++;
+			m_thread=0;
+			m_offset=0;
+		}else if(m_offset==(int)batch->m_words[m_thread][m_group].size()){
+			m_thread++;
+			m_offset=0;
+		}else{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * The words of the threads are concatenated in the order of the threads,
+ * so the messages contain the k-mers in the order of the reads.
+ * The records are never split because m_maximumWords is a multiple
+ * of their size.
+ */
+int KmerExtractionPool::fillMessage(MessageUnit*buffer,int*stream,Rank*destination){
+
+	KmerExtractionBatch*batch=m_batches+m_current;
+	int group=m_group;
+
+	*stream=group/m_ranks;
+	*destination=group%m_ranks;
+
+	int words=0;
+
+	while(words<m_maximumWords && hasMessage() && m_group==group){
+		vector<MessageUnit>*source=&(batch->m_words[m_thread][m_group]);
+
+		int available=source->size()-m_offset;
+		int copied=m_maximumWords-words;
+
+		if(available<copied)
+			copied=available;
+
+		memcpy(buffer+words,&((*source)[m_offset]),copied*sizeof(MessageUnit));
+
+		words+=copied;
+		m_offset+=copied;
+	}
+
+	#ifdef CONFIG_ASSERT
+	assert(words%m_recordWords==0);
+	#endif
+
+	return words;
+}
+
+int KmerExtractionPool::sendMessages(int maximum,MessageTag*tags,RingAllocator*outboxAllocator,StaticVector*outbox){
+
+	int messages=0;
+
+	while(messages<maximum && hasMessage()){
+		MessageUnit*buffer=(MessageUnit*)outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+
+		int stream=0;
+		Rank destination=0;
+		int words=fillMessage(buffer,&stream,&destination);
+
+		Message aMessage(buffer,words,destination,tags[stream],m_parameters->getRank());
+		outbox->push_back(&aMessage);
+
+		messages++;
+	}
+
+	return messages;
+}
+
+Rank KmerExtractionPool::getRank(Kmer*forward,Kmer*reverse){
+
+	// same as Kmer::vertexRank, the owner of the lower k-mer
+	if(forward->isLower(reverse))
+		return forward->hash_function_1()%m_ranks;
+
+	return reverse->hash_function_1()%m_ranks;
+}
+
+void KmerExtractionPool::addKmer(vector<MessageUnit>*words,Kmer*kmer){
+	for(int i=0;i<KMER_U64_ARRAY_SIZE;i++)
+		words->push_back(kmer->getU64(i));
+}
+
+/*
+ *                   previousForward   ->   forward
+ *                   previousReverse   <-   reverse
+ *
+ * The edges are written in the same order as VerticesExtractor::addEdges.
+ */
+void KmerExtractionPool::extract(int batch,int thread){
+
+	KmerExtractionBatch*work=m_batches+batch;
+	vector<vector<MessageUnit> >*words=&(work->m_words[thread]);
+
+	for(int i=0;i<(int)words->size();i++)
+		(*words)[i].clear();
+
+	LargeCount readsPerThread=(work->m_count+m_threads-1)/m_threads;
+	LargeIndex first=work->m_first+thread*readsPerThread;
+	LargeIndex last=first+readsPerThread;
+
+	if(last>work->m_first+work->m_count)
+		last=work->m_first+work->m_count;
+
+	int kmerLength=m_parameters->getWordSize();
+	bool colorSpace=m_parameters->getColorSpaceMode();
+
+	int outgoing=KMER_EXTRACTION_OUTGOING_EDGES*m_ranks;
+	int ingoing=KMER_EXTRACTION_INGOING_EDGES*m_ranks;
+
+	char sequence[RAY_MAXIMUM_READ_LENGTH];
+	char memory[CONFIG_MAXKMERLENGTH+1];
+
+	for(LargeIndex read=first;read<last;read++){
+
+		m_reads->at(read)->getSeq(sequence,colorSpace,false);
+
+		int length=strlen(sequence);
+
+		bool hasPrevious=false;
+		Kmer previousForward;
+		Kmer previousReverse;
+		Rank previousRank=0;
+
+		for(int position=0;position+kmerLength<=length;position++){
+			memcpy(memory,sequence+position,kmerLength);
+			memory[kmerLength]='\0';
+
+			if(!isValidDNA(memory)){
+				hasPrevious=false;
+				continue;
+			}
+
+			Kmer forward=wordId(memory);
+			Kmer reverse=forward.complementVertex(kmerLength,colorSpace);
+			Rank rank=getRank(&forward,&reverse);
+
+			if(m_kind==KMER_EXTRACTION_VERTICES){
+				if(reverse<forward)
+					addKmer(&((*words)[rank]),&reverse);
+				else
+					addKmer(&((*words)[rank]),&forward);
+
+				continue;
+			}
+
+			if(hasPrevious){
+				addKmer(&((*words)[outgoing+previousRank]),&previousForward);
+				addKmer(&((*words)[outgoing+previousRank]),&forward);
+
+				addKmer(&((*words)[ingoing+rank]),&previousForward);
+				addKmer(&((*words)[ingoing+rank]),&forward);
+
+				addKmer(&((*words)[outgoing+rank]),&reverse);
+				addKmer(&((*words)[outgoing+rank]),&previousReverse);
+
+				addKmer(&((*words)[ingoing+previousRank]),&reverse);
+				addKmer(&((*words)[ingoing+previousRank]),&previousReverse);
+			}
+
+			hasPrevious=true;
+			previousForward=forward;
+			previousReverse=reverse;
+			previousRank=rank;
+		}
+	}
+}
+
+void KmerExtractionPool::setInserter(KmerInserter*inserter){
+	m_inserter=inserter;
+}
+
+bool KmerExtractionPool::queueInsertion(MessageUnit*kmers,int count){
+
+	// the messages of other ranks can arrive before the extraction starts here
+	startThreads();
+
+	if(m_inserter==NULL || count==0)
+		return false;
+
+	pthread_mutex_lock(&m_lock);
+
+	bool queued=(m_runningThreads>0 && (int)m_insertions.size()<CONFIG_KMER_INSERTION_QUEUE);
+
+	if(queued){
+		m_insertions.push_back(vector<MessageUnit>(kmers,kmers+count));
+		pthread_cond_signal(&m_workIsAvailable);
+	}
+
+	pthread_mutex_unlock(&m_lock);
+
+	return queued;
+}
+
+void KmerExtractionPool::waitForInsertions(){
+	if(!m_started)
+		return;
+
+	pthread_mutex_lock(&m_lock);
+
+	while(!m_insertions.empty() || m_runningInsertions>0)
+		pthread_cond_wait(&m_insertionsAreDone,&m_lock);
+
+	pthread_mutex_unlock(&m_lock);
+}
@@ -0,0 +1,224 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _KmerExtractionPool_h
+#define _KmerExtractionPool_h
+
+#include "Kmer.h"
+
+#include <code/Mock/Parameters.h>
+#include <code/SequencesLoader/ArrayOfReads.h>
+
+#include <RayPlatform/communication/Message.h>
+#include <RayPlatform/memory/RingAllocator.h>
+#include <RayPlatform/structures/StaticVector.h>
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+using namespace std;
+
+/** reads per batch given to the threads */
+#define CONFIG_KMER_EXTRACTION_BATCH 4000
+
+/** messages sent by a plugin at each call of its slave mode */
+#define CONFIG_KMER_EXTRACTION_MESSAGES 4
+
+/** received messages waiting for the threads, the main thread inserts the others itself */
+#define CONFIG_KMER_INSERTION_QUEUE 64
+
+/** the lower k-mers of the reads, for RAY_MPI_TAG_VERTICES_DATA */
+#define KMER_EXTRACTION_VERTICES 0
+
+/** the edges of the reads, for RAY_MPI_TAG_OUT_EDGES_DATA and RAY_MPI_TAG_IN_EDGES_DATA */
+#define KMER_EXTRACTION_EDGES 1
+
+/** stream of the edges for RAY_MPI_TAG_OUT_EDGES_DATA */
+#define KMER_EXTRACTION_OUTGOING_EDGES 0
+
+/** stream of the edges for RAY_MPI_TAG_IN_EDGES_DATA */
+#define KMER_EXTRACTION_INGOING_EDGES 1
+
+/**
+ * Inserts the k-mers of a RAY_MPI_TAG_VERTICES_DATA message.
+ * The threads of the pool call it at the same time.
+ */
+class KmerInserter{
+public:
+	virtual void insertKmers(MessageUnit*kmers,int count)=0;
+	virtual ~KmerInserter(){}
+};
+
+class KmerExtractionPool;
+
+class KmerExtractionThread{
+public:
+	KmerExtractionPool*m_pool;
+	int m_thread;
+	pthread_t m_handle;
+	bool m_started;
+};
+
+/**
+ * The reads of a batch, and the message payloads computed from them.
+ */
+class KmerExtractionBatch{
+public:
+	LargeIndex m_first;
+	LargeCount m_count;
+
+	/** the batch was given to the threads */
+	bool m_submitted;
+
+	/** threads that did not take their part of the batch yet */
+	vector<bool> m_pending;
+
+	/** threads that did not complete their part of the batch yet */
+	int m_remainingThreads;
+
+	/** for each thread, the words for each stream and destination (stream*ranks+rank) */
+	vector<vector<vector<MessageUnit> > > m_words;
+};
+
+/**
+ * A pool of threads for the k-mers of a rank (Ray -threads-per-rank N).
+ *
+ * The threads are started once and wait for work until the end of
+ * RAY_SLAVE_MODE_ADD_EDGES.
+ *
+ * Extraction: the reads of a batch are partitioned between the threads,
+ * each thread decodes its reads, computes the k-mers and writes the
+ * message payloads for each destination rank. There are 2 batches, the
+ * threads compute the next batch while the main thread sends the
+ * messages of the current one, so the main thread never waits for
+ * them. The messages contain the k-mers in the order of the reads.
+ *
+ * Insertion: the payloads of RAY_MPI_TAG_VERTICES_DATA are queued and
+ * inserted in the GridTable by the threads, with the lock of the shard
+ * of each k-mer.
+ *
+ * With only 1 thread, the pool is disabled and the plugins process
+ * one k-mer at a time like before.
+ *
+ * \author agent
+ */
+class KmerExtractionPool{
+
+	Parameters*m_parameters;
+	ArrayOfReads*m_reads;
+	int m_threads;
+	int m_ranks;
+
+	/** threads that were started, the main thread does the work of the others */
+	int m_runningThreads;
+
+	bool m_started;
+	bool m_stop;
+
+	pthread_mutex_t m_lock;
+	pthread_cond_t m_workIsAvailable;
+	pthread_cond_t m_insertionsAreDone;
+
+	vector<KmerExtractionThread> m_workers;
+
+	int m_kind;
+	int m_streams;
+	int m_recordWords;
+	int m_maximumWords;
+
+	/** the first read of the next batch to give to the threads */
+	LargeIndex m_nextRead;
+
+	KmerExtractionBatch m_batches[2];
+
+	/** the batch with the messages to send, -1 if none */
+	int m_current;
+
+	/** the batch that will be the current one */
+	int m_next;
+
+	/** position in the current batch */
+	int m_group;
+	int m_thread;
+	int m_offset;
+
+	KmerInserter*m_inserter;
+	deque<vector<MessageUnit> > m_insertions;
+	int m_runningInsertions;
+
+	static void*startThread(void*argument);
+
+	void startThreads();
+	void work(int thread);
+	void submit(int batch);
+
+	/** extracts the k-mers of the reads given to a thread */
+	void extract(int batch,int thread);
+
+	Rank getRank(Kmer*forward,Kmer*reverse);
+	void addKmer(vector<MessageUnit>*words,Kmer*kmer);
+
+	/** fills a message with the words of one stream for one destination */
+	int fillMessage(MessageUnit*buffer,int*stream,Rank*destination);
+
+public:
+
+	KmerExtractionPool();
+	~KmerExtractionPool();
+
+	void constructor(Parameters*parameters,ArrayOfReads*reads);
+
+	bool isEnabled();
+
+	/** starts the extraction of KMER_EXTRACTION_VERTICES or KMER_EXTRACTION_EDGES */
+	void startExtraction(int kind,LargeIndex first);
+
+	/** makes the next batch the current one if the threads are done with it */
+	bool nextBatch();
+
+	/** the current batch has messages to send */
+	bool hasMessage();
+
+	/** all the batches were sent */
+	bool isFinished();
+
+	/** the reads of the current batch */
+	LargeIndex getFirstRead();
+	LargeCount getNumberOfReads();
+
+	/**
+	 * sends at most maximum messages of the current batch, with the
+	 * tag of each stream, returns the number of messages
+	 */
+	int sendMessages(int maximum,MessageTag*tags,RingAllocator*outboxAllocator,StaticVector*outbox);
+
+	void setInserter(KmerInserter*inserter);
+
+	/** queues a message for the insertion threads, returns false if the queue is full */
+	bool queueInsertion(MessageUnit*kmers,int count);
+
+	/** waits for the queued insertions */
+	void waitForInsertions();
+
+	/** stops the threads */
+	void destructor();
+};
+
+#endif
@@ -77,6 +77,7 @@ void Library::call_RAY_MASTER_MODE_UPDATE_DISTANCES(){
 	/** basically, we updated all libraries */
 	}else{
 		m_timePrinter->printElapsedTime("Estimation of outer distances for paired reads");
+		m_instrumentation->endPhase("Estimation of outer distances for paired reads");
 		cout<<endl;
 
 		(*m_master_mode)=RAY_MASTER_MODE_TRIGGER_EXTENSIONS;
@@ -142,6 +143,8 @@ void Library::readLibraryCheckpoint(){
 }
 
 void Library::call_RAY_SLAVE_MODE_AUTOMATIC_DISTANCE_DETECTION(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_AUTOMATIC_DISTANCE_DETECTION);
+
 	if(!m_initiatedIterator){
 		m_SEEDING_i=0;
 
@@ -293,7 +296,7 @@ void Library::call_RAY_SLAVE_MODE_AUTOMATIC_DISTANCE_DETECTION(){
 				#endif
 
 				// create a worker
-				m_aliveWorkers[m_SEEDING_i].constructor(m_SEEDING_i,m_seedingData,m_virtualCommunicator,m_outboxAllocator,m_parameters,m_inbox,m_outbox,&m_libraryDistances,&m_detectedDistances,&m_allocator,
+				m_aliveWorkers[m_SEEDING_i].constructor(m_SEEDING_i,m_seedingData,m_virtualCommunicator,m_outboxAllocator,m_parameters,m_inbox,m_outbox,&m_libraryDistances,&m_detectedDistances,&m_allocator,&m_mateTable,
 					RAY_MPI_TAG_GET_READ_MATE, RAY_MPI_TAG_REQUEST_VERTEX_READS
 					);
 
@@ -441,6 +444,7 @@ Parameters*m_parameters,SeedingData*m_seedingData,StaticVector*inbox,VirtualComm
 	this->m_master_mode=m_master_mode;
 	this->m_parameters=m_parameters;
 	this->m_seedingData=m_seedingData;
+	m_mateTable.constructor(m_parameters);
 	m_ready=0;
 	m_virtualCommunicator=vc;
 	m_inbox=inbox;
@@ -483,6 +487,8 @@ void Library::allocateBuffers(){
 }
 
 void Library::call_RAY_SLAVE_MODE_SEND_LIBRARY_DISTANCES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_SEND_LIBRARY_DISTANCES);
+
 	if(m_ready!=0){
 		return;
 	}
@@ -604,6 +610,8 @@ void Library::registerPlugin(ComputeCore*core){
 }
 
 void Library::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_SEND_LIBRARY_DISTANCES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_SEND_LIBRARY_DISTANCES");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 	RAY_SLAVE_MODE_AUTOMATIC_DISTANCE_DETECTION=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_AUTOMATIC_DISTANCE_DETECTION");
@@ -29,6 +29,7 @@
 #include <code/Mock/common_functions.h>
 #include <code/Mock/Parameters.h>
 #include <code/SeedingData/SeedingData.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/structures/StaticVector.h>
 #include <RayPlatform/profiling/TimePrinter.h>
@@ -96,9 +97,11 @@ class Library :  public CorePlugin{
 	RingAllocator*m_outboxAllocator;
 	int m_size;
 	TimePrinter*m_timePrinter;
+	Instrumentation*m_instrumentation;
 	int*m_mode;
 	int*m_master_mode;
 	Parameters*m_parameters;
+	MateTable m_mateTable;
 	SeedingData*m_seedingData;
 	int m_libraryIterator;
 	map<int,map<int,int> > m_libraryDistances;
@@ -36,7 +36,7 @@ bool LibraryWorker::isDone(){
 }
 
 void LibraryWorker::constructor(WorkerHandle id,SeedingData*seedingData,VirtualCommunicator*virtualCommunicator,RingAllocator*outboxAllocator,Parameters*parameters,
-StaticVector*inbox,StaticVector*outbox,	map<int,map<int,int> >*libraryDistances,int*detectedDistances,MyAllocator*allocator,
+StaticVector*inbox,StaticVector*outbox,	map<int,map<int,int> >*libraryDistances,int*detectedDistances,MyAllocator*allocator,MateTable*mateTable,
 MessageTag RAY_MPI_TAG_GET_READ_MATE,
 MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS
 ){
@@ -58,6 +58,7 @@ MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS
 	m_outbox=outbox;
 	m_libraryDistances=libraryDistances;
 	m_detectedDistances=detectedDistances;
+	m_mateTable=mateTable;
 
 	m_allocator=allocator;
 	m_database.constructor();
@@ -102,7 +103,23 @@ void LibraryWorker::work(){
 			if(m_EXTENSION_edgeIterator<(int)m_readFetcher.getResult()->size()){
 				ReadAnnotation annotation=m_readFetcher.getResult()->at(m_EXTENSION_edgeIterator);
 				int rightRead=annotation.getReadIndex();
+
 				if(!m_EXTENSION_hasPairedReadRequested){
+					/*
+					 * The mate is resolved locally. The read length is only
+					 * needed when the mate was seen earlier on the seed, so
+					 * the other reads need no message at all.
+					 */
+					PairedRead mate;
+					bool isUseful=m_mateTable->getMate(annotation.getRank(),rightRead,&mate)
+						&& m_parameters->isAutomatic(mate.getLibrary())
+						&& m_database.find(mate.getUniqueId(),false)!=NULL;
+
+					if(!isUseful){
+						m_EXTENSION_edgeIterator++;
+						return;
+					}
+
 					MessageUnit*message=(MessageUnit*)(m_outboxAllocator)->allocate(1*sizeof(MessageUnit));
 					message[0]=rightRead;
 					#ifdef CONFIG_ASSERT
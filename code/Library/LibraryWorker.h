@@ -26,6 +26,7 @@
 #include <code/SeedingData/PathHandle.h>
 #include <code/SeedingData/SeedingData.h>
 #include <code/SeedExtender/ExtensionData.h>
+#include <code/SequencesIndexer/MateTable.h>
 
 #include <RayPlatform/communication/VirtualCommunicator.h>
 #include <RayPlatform/memory/RingAllocator.h>
@@ -71,12 +72,13 @@ class LibraryWorker : public Worker {
 	StaticVector*m_outbox;
 	bool m_EXTENSION_hasPairedReadRequested;
 	int*m_detectedDistances;
+	MateTable*m_mateTable;
 	
 public:
 
 	void constructor(WorkerHandle id,SeedingData*seedingData,VirtualCommunicator*virtualCommunicator,RingAllocator*outboxAllocator,
 	Parameters*parameters,StaticVector*inbox,StaticVector*outbox,map<int,map<int,int> >*libraryDistances,int*detectedDistances,
-		MyAllocator*allocator,
+		MyAllocator*allocator,MateTable*mateTable,
 MessageTag RAY_MPI_TAG_GET_READ_MATE,
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS
 );
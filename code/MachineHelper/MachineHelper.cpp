@@ -22,17 +22,24 @@
 #include "MachineHelper.h"
 
 #include <code/CoverageGatherer/CoverageDistribution.h>
+#include <code/CoverageGatherer/KmerSpectrumPreview.h>
 #include <code/SeedExtender/Chooser.h>
 #include <code/SeedingData/GraphPath.h>
+#include <code/VerticesExtractor/GenomeGraphCheckpoint.h>
 
 #include <RayPlatform/communication/Message.h>
 #include <RayPlatform/communication/mpi_tags.h>
+#include <RayPlatform/core/OperatingSystem.h>
 #include <RayPlatform/profiling/Profiler.h>
 
 #include <map>
 #include <sstream>
 using namespace std;
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #ifdef CONFIG_ASSERT
 #include <assert.h>
 #endif
@@ -73,9 +80,22 @@ __CreateMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_E
 __CreateMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY);
 __CreateMessageTagAdapter(MachineHelper,RAY_MPI_TAG_ASK_EXTENSION_DATA);
 __CreateMessageTagAdapter(MachineHelper,RAY_MPI_TAG_EXTENSION_DATA_END);
+__CreateMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS);
+__CreateMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY);
+__CreateMessageTagAdapter(MachineHelper,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET);
 
+/*
+ * The first element is 1 if the rank could not write all its contigs.
+ */
 void MachineHelper::call_RAY_MPI_TAG_EXTENSION_DATA_END(Message*message){
 	m_ranksThatWroteContigs++;
+
+	MessageUnit*buffer=message->getBuffer();
+
+	if(message->getCount()>0 && buffer[0]==1){
+		cout<<"Error: Rank "<<message->getSource()<<" could not write its contigs to "<<m_parameters->getOutputFile();
+		cout<<", the file is incomplete."<<endl;
+	}
 }
 
 /*
@@ -111,6 +131,18 @@ void MachineHelper::call_RAY_MASTER_MODE_LOAD_CONFIG(){
 		return;
 	}
 
+	// estimate the spectrum with a fraction of the reads, and exit
+	if(m_parameters->hasOption("-spectrum-preview")){
+		KmerSpectrumPreview preview;
+		preview.constructor(m_parameters);
+
+		if(!preview.run())
+			(*m_aborted)=true;
+
+		m_switchMan->setMasterMode(RAY_MASTER_MODE_KILL_ALL_MPI_RANKS);
+		return;
+	}
+
 	MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(2*sizeof(MessageUnit));
 	message[0]=m_parameters->getWordSize();
 	message[1]=m_parameters->getColorSpaceMode();
@@ -219,11 +251,12 @@ SequencesLoader*sl,time_t*lastTime,bool*writeKmerInitialised,Partitioner*partiti
 	m_numberOfRanksWithCoverageData=numberOfRanksWithCoverageData;
 
 	m_initialisedKiller=false;
+	m_flushedInstrumentation=false;
 
 }
 
 void MachineHelper::call_RAY_MASTER_MODE_SEND_COVERAGE_VALUES (){
-	if(m_parameters->hasCheckpoint("GenomeGraph")){
+	if(m_parameters->hasCheckpoint("GenomeGraph") && !m_parameters->isIncrementalAssembly()){
 		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint CoverageDistribution"<<endl;
 		m_coverageDistribution->clear();
 		ifstream f(m_parameters->getCheckpointFile("CoverageDistribution").c_str());
@@ -365,6 +398,7 @@ void MachineHelper::call_RAY_MASTER_MODE_LOAD_SEQUENCES(){
 	if(!m_startedToSendCounts){
 
 		m_timePrinter->printElapsedTime("Counting sequences to assemble");
+		m_instrumentation->endPhase("Counting sequences to assemble");
 		cout<<endl;
 
 		bool result=true;
@@ -439,6 +473,7 @@ void MachineHelper::call_RAY_MASTER_MODE_LOAD_SEQUENCES(){
 
 void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_VERTICE_DISTRIBUTION(){
 	m_timePrinter->printElapsedTime("Sequence loading");
+	m_instrumentation->endPhase("Sequence loading");
 	cout<<endl;
 
 	for(int i=0;i<getSize();i++){
@@ -451,6 +486,7 @@ void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_VERTICE_DISTRIBUTION(){
 void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_GRAPH_BUILDING(){
 	(*m_numberOfMachinesDoneSendingVertices)=0;
 	m_timePrinter->printElapsedTime("Coverage distribution analysis");
+	m_instrumentation->endPhase("Coverage distribution analysis");
 	cout<<endl;
 
 	cout<<endl;
@@ -464,6 +500,7 @@ void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_GRAPH_BUILDING(){
 void MachineHelper::call_RAY_MASTER_MODE_PURGE_NULL_EDGES(){
 	m_switchMan->setMasterMode(RAY_MASTER_MODE_DO_NOTHING);
 	m_timePrinter->printElapsedTime("Graph construction");
+	m_instrumentation->endPhase("Graph construction");
 	cout<<endl;
 	for(int i=0;i<getSize();i++){
 		Message aMessage(NULL,0,i,RAY_MPI_TAG_PURGE_NULL_EDGES,getRank());
@@ -474,9 +511,34 @@ void MachineHelper::call_RAY_MASTER_MODE_PURGE_NULL_EDGES(){
 void MachineHelper::call_RAY_MASTER_MODE_WRITE_KMERS(){
 	if(!(*m_writeKmerInitialised)){
 		(*m_writeKmerInitialised)=true;
-		m_coverageRank=0;
 		m_numberOfRanksDone=0;
+		m_kmersFileIsComplete=true;
+
+		if(m_parameters->writeGraph()){
+			m_graphRecords.resize(m_parameters->getSize());
+			m_graphWritten.resize(m_parameters->getSize());
+
+			ostringstream directory;
+			directory<<m_parameters->getPrefix()<<"Graph";
+
+			if(!fileExists(directory.str().c_str()))
+				createDirectory(directory.str().c_str());
+		}
+
+		/*
+		 * all the ranks write at the same time, for kmers.txt each rank
+		 * first needs its offset in the file
+		 */
+		if(m_parameters->writeKmers()){
+			m_ranksThatComputedKmerStorage=0;
+			m_kmerStorage.resize(m_parameters->getSize());
+			m_switchMan->sendToAll(m_outbox,getRank(),RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS);
+		}else{
+			m_switchMan->sendToAll(m_outbox,getRank(),RAY_MPI_TAG_WRITE_KMERS);
+		}
+
 	}else if(m_inbox->size()>0 && m_inbox->at(0)->getTag()==RAY_MPI_TAG_WRITE_KMERS_REPLY){
+		Rank source=m_inbox->at(0)->getSource();
 		MessageUnit*buffer=(MessageUnit*)m_inbox->at(0)->getBuffer();
 		int bufferPosition=0;
 		for(int i=0;i<=4;i++){
@@ -484,18 +546,35 @@ void MachineHelper::call_RAY_MASTER_MODE_WRITE_KMERS(){
 				m_edgeDistribution[i][j]+=buffer[bufferPosition++];
 			}
 		}
+
+		if(m_parameters->writeKmers() && buffer[bufferPosition++]==1){
+			m_kmersFileIsComplete=false;
+
+			cout<<"Error: Rank "<<source<<" could not write its k-mers to "<<m_parameters->getPrefix();
+			cout<<"kmers.txt, the file is incomplete."<<endl;
+		}
+
+		if(m_parameters->writeGraph()){
+			m_graphRecords[source]=buffer[bufferPosition++];
+			m_graphWritten[source]=(buffer[bufferPosition++]==1);
+		}
+
 		m_numberOfRanksDone++;
 
 	}else if(m_numberOfRanksDone==m_parameters->getSize()){
 
-		if(m_parameters->writeKmers()){
+		if(m_parameters->writeKmers() && m_kmersFileIsComplete){
 			cout<<endl;
 			cout<<"Rank "<<getRank()<<" wrote "<<m_parameters->getPrefix()<<"kmers.txt"<<endl;
 		}
 
+		if(m_parameters->writeGraph()){
+			writeGraphManifest();
+		}
+
 		m_switchMan->closeMasterMode();
 
-		if(m_parameters->hasCheckpoint("GenomeGraph"))
+		if(m_parameters->hasCheckpoint("GenomeGraph") && !m_parameters->isIncrementalAssembly())
 			return;
 
 		ostringstream edgeFile;
@@ -529,25 +608,125 @@ void MachineHelper::call_RAY_MASTER_MODE_WRITE_KMERS(){
 			m_switchMan->setMasterMode(RAY_MASTER_MODE_KILL_ALL_MPI_RANKS);
 			return;
 		}
+	}
+}
 
+void MachineHelper::call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS(Message*message){
 
-	}else if(m_coverageRank==m_numberOfRanksDone){
+	MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+	buffer[0]=m_coverageGatherer->computeRequiredSpaceForKmers();
 
-		if(m_parameters->writeKmers()){
-			// do it in serial mode because we need to write a parallel file
-			m_switchMan->sendEmptyMessage(m_outbox,getRank(),m_coverageRank,RAY_MPI_TAG_WRITE_KMERS);
-			m_coverageRank ++ ;
+	Message aMessage(buffer,1,message->getSource(),
+		RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY,getRank());
+
+	m_outbox->push_back(&aMessage);
+}
+
+/*
+ * The lines of rank r are after the lines of the ranks before it,
+ * like for the contigs.
+ */
+void MachineHelper::call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY(Message*message){
+
+	MessageUnit*buffer=message->getBuffer();
+	m_kmerStorage[message->getSource()]=buffer[0];
+
+	m_ranksThatComputedKmerStorage++;
+
+	if(m_ranksThatComputedKmerStorage==getSize()){
+
+		uint64_t offset=0;
+
+		for(int rank=0;rank<getSize();rank++){
+
+			MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+			buffer[0]=offset;
+
+			Message aMessage(buffer,1,rank,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET,getRank());
+			m_outbox->push_back(&aMessage);
+
+			offset+=m_kmerStorage[rank];
+		}
+
+		m_kmerStorage.clear();
+	}
+}
+
+void MachineHelper::call_RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET(Message*message){
+	MessageUnit*buffer=message->getBuffer();
+
+	m_offsetForKmers=buffer[0];
+}
+
+/*
+ * The graph files are listed with their number of records, the records
+ * are in the format of the GenomeGraph checkpoint (lower k-mer,
+ * coverage, edge bitmap).
+ */
+void MachineHelper::writeGraphManifest(){
+
+	ostringstream fileName;
+	fileName<<m_parameters->getPrefix()<<"Graph/Manifest.txt";
+
+	int files=0;
+
+	for(Rank rank=0;rank<m_parameters->getSize();rank++){
+		if(m_graphWritten[rank]){
+			files++;
 		}else{
-			// do it in parallel
-			m_switchMan->sendToAll(m_outbox,getRank(),RAY_MPI_TAG_WRITE_KMERS);
-			m_coverageRank+=m_parameters->getSize();
+			cout<<"Error: Rank "<<rank<<" could not write its graph file, it is not in ";
+			cout<<fileName.str()<<" and the graph is incomplete."<<endl;
 		}
 	}
+
+	ofstream f(fileName.str().c_str());
+
+	f<<GRAPH_MANIFEST_HEADER<<endl;
+	f<<"# Written with -write-graph, can be read with -read-sample-graph"<<endl;
+	f<<"KmerLength\t"<<m_parameters->getWordSize()<<endl;
+	f<<"Files\t"<<files<<endl;
+	f<<"# File\tRecords"<<endl;
+
+	/* the files that could not be written are not listed */
+	for(Rank rank=0;rank<m_parameters->getSize();rank++){
+		if(m_graphWritten[rank])
+			f<<"Rank"<<rank<<".graph\t"<<m_graphRecords[rank]<<endl;
+	}
+
+	f.close();
+
+	m_graphRecords.clear();
+	m_graphWritten.clear();
+
+	cout<<"Rank "<<getRank()<<" wrote "<<fileName.str()<<endl;
 }
 
+/*
+ * All the ranks write at the same time: kmers.txt at the offset given
+ * with RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET, and their own graph file.
+ */
 void MachineHelper::call_RAY_SLAVE_MODE_WRITE_KMERS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_WRITE_KMERS);
+
+	bool kmersFailed=false;
+
 	if(m_parameters->writeKmers()){
-		m_coverageGatherer->writeKmers();
+		kmersFailed=!m_coverageGatherer->writeKmers(m_offsetForKmers);
+	}
+
+	bool graphWritten=false;
+
+	if(m_parameters->writeGraph()){
+		ostringstream fileName;
+		fileName<<m_parameters->getPrefix()<<"Graph/Rank"<<getRank()<<".graph";
+
+		GenomeGraphCheckpoint graph;
+		graph.constructor(m_parameters,m_subgraph);
+
+		graphWritten=graph.write(fileName.str().c_str());
+
+		if(graphWritten)
+			cout<<"Rank "<<getRank()<<" wrote "<<fileName.str()<<endl;
 	}
 
 	/* send edge distribution */
@@ -572,6 +751,15 @@ void MachineHelper::call_RAY_SLAVE_MODE_WRITE_KMERS(){
 		}
 	}
 
+	if(m_parameters->writeKmers())
+		buffer[outputPosition++]=kmersFailed;
+
+	/* one record per entry, each entry holds 2 k-mers */
+	if(m_parameters->writeGraph()){
+		buffer[outputPosition++]=m_subgraph->size()/2;
+		buffer[outputPosition++]=graphWritten;
+	}
+
 	Message aMessage(buffer,outputPosition,MASTER_RANK,RAY_MPI_TAG_WRITE_KMERS_REPLY,getRank());
 	m_outbox->push_back(&aMessage);
 	m_switchMan->setSlaveMode(RAY_SLAVE_MODE_DO_NOTHING);
@@ -581,6 +769,7 @@ void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_INDEXING(){
 	m_switchMan->setMasterMode(RAY_MASTER_MODE_DO_NOTHING);
 
 	m_timePrinter->printElapsedTime("Null edge purging");
+	m_instrumentation->endPhase("Null edge purging");
 	cout<<endl;
 
 	for(int i=0;i<getSize();i++){
@@ -603,6 +792,7 @@ void MachineHelper::call_RAY_MASTER_MODE_PREPARE_DISTRIBUTIONS_WITH_ANSWERS(){
 
 	if(!m_coverageInitialised){
 		m_timePrinter->printElapsedTime("K-mer counting");
+		m_instrumentation->endPhase("K-mer counting");
 		cout<<endl;
 		m_coverageInitialised=true;
 		m_coverageRank=0;
@@ -625,6 +815,8 @@ void MachineHelper::call_RAY_MASTER_MODE_PREPARE_SEEDING(){
 }
 
 void MachineHelper::call_RAY_SLAVE_MODE_ASSEMBLE_WAVES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_ASSEMBLE_WAVES);
+
 	// take each seed, and extend it in both direction using previously obtained information.
 	if(m_seedingData->m_SEEDING_i==(LargeCount)m_seedingData->m_SEEDING_seeds.size()){
 		Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_ASSEMBLE_WAVES_DONE,getRank());
@@ -635,6 +827,7 @@ void MachineHelper::call_RAY_SLAVE_MODE_ASSEMBLE_WAVES(){
 
 void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_SEEDING(){
 	m_timePrinter->printElapsedTime("Selection of optimal read markers");
+	m_instrumentation->endPhase("Selection of optimal read markers");
 	cout<<endl;
 	(*m_readyToSeed)=-1;
 	(*m_numberOfRanksDoneSeeding)=0;
@@ -650,6 +843,7 @@ void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_SEEDING(){
 
 void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_DETECTION(){
 	m_timePrinter->printElapsedTime("Detection of assembly seeds");
+	m_instrumentation->endPhase("Detection of assembly seeds");
 	cout<<endl;
 	(*m_numberOfRanksDoneSeeding)=-1;
 	for(int i=0;i<getSize();i++){
@@ -739,10 +933,25 @@ void MachineHelper::call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS(Messa
 	cout<<"[DEBUG] Rank "<<m_parameters->getRank()<<" requires "<<requiredBytes<<" bytes for storage."<<endl;
 #endif
 
+	m_requiredSpaceForContigs=requiredBytes;
+
 	MessageUnit*messageBuffer=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
 	int bufferPosition=0;
 	messageBuffer[bufferPosition++]=requiredBytes;
 
+/*
+ * The AMOS writer numbers the contigs of a rank after the contigs of the
+ * previous ranks. Eliminated paths were removed above; empty paths have
+ * no CTG record either (see Amos::isWrittenContig).
+ */
+	uint64_t writtenContigs=0;
+	for(int i=0;i<(int)m_ed->m_EXTENSION_contigs.size();i++){
+		if(m_ed->m_EXTENSION_contigs[i].size()>0)
+			writtenContigs++;
+	}
+
+	messageBuffer[bufferPosition++]=writtenContigs;
+
 	Message aMessage(messageBuffer,bufferPosition,message->getSource(),
 		RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY,getRank());
 
@@ -750,33 +959,18 @@ void MachineHelper::call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS(Messa
 }
 
 /**
- * the equivalent of
- *
- * fopen with "r+"
- *
- * is
+ * Every MPI rank writes its contigs at the offset computed by the master
+ * with RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS, so all the ranks write
+ * at the same time.
  *
- * fstream::open with std::ios::in and std::ios::out
+ * With MPI I/O, a file view is used. Otherwise, positioned writes (pwrite)
+ * are done on a POSIX file descriptor. The ranges are disjoint so no
+ * synchronization is needed between ranks.
  *
- * \see http://www.c-jump.com/CIS60/lecture09_1.htm
- * \see http://bytes.com/topic/c/answers/127391-iostreams-equivalent-cs-fopen-r
+ * \see http://pubs.opengroup.org/onlinepubs/9699919799/functions/pwrite.html
  */
 void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
-
-#ifndef CONFIG_MPI_IO
-/*
- * Only allow one MPI rank to write at any time.
- */
-	if(m_parameters->getRank()==0){
-		m_authorized=true;
-	}else if(m_inbox->hasMessage(RAY_MPI_TAG_SEND_AUTHORIZATION)){
-		m_authorized=true;
-	}
-
-	if(!m_authorized)
-		return;
-
-#endif
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_SEND_EXTENSION_DATA);
 
 	string output=m_parameters->getOutputFile();
 	const char*fileNameValue=output.c_str();
@@ -810,8 +1004,21 @@ void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
 
 #else
 
-	ofstream fp;
-	fp.open(fileName, std::ios::app);
+/*
+ * O_TRUNC must not be used because other ranks may already be writing.
+ */
+	int fp=open(fileName,O_WRONLY|O_CREAT,S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
+
+	uint64_t offset=m_offsetForContigs;
+#endif
+
+	bool failed=false;
+
+#ifndef CONFIG_MPI_IO
+	if(fp<0){
+		cout<<"Error: Rank "<<getRank()<<" can not open "<<fileName<<endl;
+		failed=true;
+	}
 #endif
 
 	int total=0;
@@ -820,7 +1027,7 @@ void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
 
 	bool force=false;
 
-	for(int i=0;i<(int)m_ed->m_EXTENSION_contigs.size();i++){
+	for(int i=0;!failed && i<(int)m_ed->m_EXTENSION_contigs.size();i++){
 		PathHandle uniqueId=m_ed->m_EXTENSION_identifiers[i];
 
 		total++;
@@ -833,7 +1040,7 @@ void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
 #ifdef CONFIG_MPI_IO
 		flushFileOperationBuffer_MPI_IO(force,&operationBuffer,fp,CONFIG_FILE_IO_BUFFER_SIZE);
 #else
-		flushFileOperationBuffer(force,&operationBuffer,&fp,CONFIG_FILE_IO_BUFFER_SIZE);
+		flushFileOperationBuffer_pwrite(force,&operationBuffer,fp,&offset,CONFIG_FILE_IO_BUFFER_SIZE,&failed);
 #endif
 	}
 
@@ -845,25 +1052,30 @@ void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
 	flushFileOperationBuffer_MPI_IO(force,&operationBuffer,fp,CONFIG_FILE_IO_BUFFER_SIZE);
 	MPI_File_close(&fp);
 #else
-	flushFileOperationBuffer(force,&operationBuffer,&fp,CONFIG_FILE_IO_BUFFER_SIZE);
-	fp.close();
+	if(!failed){
+		flushFileOperationBuffer_pwrite(force,&operationBuffer,fp,&offset,CONFIG_FILE_IO_BUFFER_SIZE,&failed);
+
+		#ifdef CONFIG_ASSERT
+		assert(offset==m_offsetForContigs+m_requiredSpaceForContigs);
+		#endif
+	}
+
+	if(fp>=0)
+		close(fp);
 #endif
 
 	m_switchMan->setSlaveMode(RAY_SLAVE_MODE_DO_NOTHING);
-	Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_EXTENSION_DATA_END,getRank());
-	m_outbox->push_back(&aMessage);
 
-/*
- * Send the authorization code to the next MPI rank.
- */
-	if(getRank()!=getSize()-1){
-		Message aMessage(NULL,0,getRank()+1,RAY_MPI_TAG_SEND_AUTHORIZATION,getRank());
-		m_outbox->push_back(&aMessage);
-	}
+	MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+	buffer[0]=failed;
+
+	Message aMessage(buffer,1,MASTER_RANK,RAY_MPI_TAG_EXTENSION_DATA_END,getRank());
+	m_outbox->push_back(&aMessage);
 }
 
 void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_FUSIONS(){
 	m_timePrinter->printElapsedTime("Bidirectional extension of seeds");
+	m_instrumentation->endPhase("Bidirectional extension of seeds");
 	cout<<endl;
 
 	m_cycleNumber=0;
@@ -990,6 +1202,7 @@ void MachineHelper::call_RAY_MASTER_MODE_START_FUSION_CYCLE(){
 		if(m_mustStop || m_parameters->hasCheckpoint("ContigPaths")){
 			cout<<"Rank "<<m_parameters->getRank()<<" cycleNumber= "<<m_cycleNumber<<endl;
 			m_timePrinter->printElapsedTime("Merging of redundant paths");
+			m_instrumentation->endPhase("Merging of redundant paths");
 			cout<<endl;
 
 			m_switchMan->closeMasterMode();
@@ -1041,6 +1254,12 @@ void MachineHelper::call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY
 
 	m_rankStorage[source]=bytes;
 
+/*
+ * The AMOS writer numbers the contigs of each rank starting after
+ * the contigs of the previous ranks.
+ */
+	m_ed->m_EXTENSION_contigsPerRank[source]=buffer[1];
+
 #ifdef CONFIG_DEBUG_OFFSETS
 	cout << "[DEBUG] Rank " << getRank() << " rank " << source << " needs " << bytes << " bytes" << endl;
 #endif
@@ -1078,9 +1297,11 @@ void MachineHelper::call_RAY_MASTER_MODE_ASK_EXTENSIONS(){
 		m_switchMan->sendToAll(m_outbox,getRank(),RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS);
 
 		m_rankStorage.resize(getSize());
+		m_ed->m_EXTENSION_contigsPerRank.resize(getSize());
 
 		for(int i = 0; i < getSize() ; i++) {
 			m_rankStorage[i] = 0;
+			m_ed->m_EXTENSION_contigsPerRank[i] = 0;
 		}
 
 		m_seedExtender->closePathFile();
@@ -1090,13 +1311,13 @@ void MachineHelper::call_RAY_MASTER_MODE_ASK_EXTENSIONS(){
 	}else if(m_ranksThatWroteContigs==getSize()){
 
 		m_timePrinter->printElapsedTime("Generation of contigs");
+		m_instrumentation->endPhase("Generation of contigs");
 
 		if(m_parameters->useAmos()){
 			m_switchMan->setMasterMode(RAY_MASTER_MODE_AMOS);
 
 			m_ed->m_EXTENSION_currentRankIsStarted=false;
 			m_ed->m_EXTENSION_currentPosition=0;
-			m_ed->m_EXTENSION_rank=0;
 			m_seedingData->m_SEEDING_i=0;
 			m_ed->m_EXTENSION_reads_requested=false;
 			cout<<endl;
@@ -1136,6 +1357,7 @@ void MachineHelper::call_RAY_MASTER_MODE_KILL_RANKS(){
 
 /** make the message-passing interface rank die */
 void MachineHelper::call_RAY_SLAVE_MODE_DIE(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_DIE);
 
 	/* write the network test data if not already written */
 	m_networkTest->writeData();
@@ -1161,6 +1383,17 @@ void MachineHelper::call_RAY_SLAVE_MODE_DIE(){
  * here we kill everyone because the computation is terminated.
  */
 void MachineHelper::call_RAY_MASTER_MODE_KILL_ALL_MPI_RANKS(){
+
+	// the counters of the last phase must arrive before the ranks die
+	if(!m_flushedInstrumentation){
+		m_instrumentation->endLastPhase();
+		m_flushedInstrumentation=true;
+		return;
+	}
+
+	if(!m_instrumentation->isFlushed())
+		return;
+
 	if(!m_initialisedKiller){
 		m_initialisedKiller=true;
 		m_machineRank=m_parameters->getSize()-1;
@@ -1227,7 +1460,7 @@ void MachineHelper::performAssemblyWorkflow(ComputeCore*core) {
 	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_SEND_COVERAGE_VALUES,RAY_MASTER_MODE_TRIGGER_GRAPH_BUILDING);
 	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_TRIGGER_GRAPH_BUILDING,RAY_MASTER_MODE_PURGE_NULL_EDGES);
 	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_PURGE_NULL_EDGES,RAY_MASTER_MODE_WRITE_KMERS);
-	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_WRITE_KMERS,RAY_MASTER_MODE_TRIGGER_INDEXING);
+	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_WRITE_KMERS,RAY_MASTER_MODE_MARK_UNITIG_STARTS);
 	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_TRIGGER_INDEXING,RAY_MASTER_MODE_PREPARE_SEEDING);
 
 	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_START_UPDATING_DISTANCES,RAY_MASTER_MODE_UPDATE_DISTANCES);
@@ -1374,8 +1607,6 @@ void MachineHelper::registerPlugin(ComputeCore*core){
 	core->setMessageTagObjectHandler(m_plugin,RAY_MPI_TAG_NOTIFY_ERROR,__GetAdapter(MachineHelper,RAY_MPI_TAG_NOTIFY_ERROR));
 	core->setMessageTagSymbol(m_plugin,RAY_MPI_TAG_NOTIFY_ERROR,"RAY_MPI_TAG_NOTIFY_ERROR");
 
-	RAY_MPI_TAG_SEND_AUTHORIZATION=core->allocateMessageTagHandle(m_plugin);
-	core->setMessageTagSymbol(m_plugin,RAY_MPI_TAG_SEND_AUTHORIZATION,"RAY_MPI_TAG_SEND_AUTHORIZATION");
 
 	RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS=core->allocateMessageTagHandle(m_plugin);
 	core->setMessageTagObjectHandler(m_plugin,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS,
@@ -1398,11 +1629,30 @@ void MachineHelper::registerPlugin(ComputeCore*core){
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_ASK_EXTENSION_DATA, __GetAdapter(MachineHelper,RAY_MPI_TAG_ASK_EXTENSION_DATA));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_ASK_EXTENSION_DATA,"RAY_MPI_TAG_ASK_EXTENSION_DATA");
 
+	RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS=core->allocateMessageTagHandle(m_plugin);
+	core->setMessageTagObjectHandler(m_plugin,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS,
+		__GetAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS));
+	core->setMessageTagSymbol(m_plugin,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS,
+		"RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS");
+
+	RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY=core->allocateMessageTagHandle(m_plugin);
+	core->setMessageTagObjectHandler(m_plugin,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY,
+		__GetAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY));
+	core->setMessageTagSymbol(m_plugin,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY,
+		"RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY");
+
+	RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET=core->allocateMessageTagHandle(m_plugin);
+	core->setMessageTagObjectHandler(m_plugin,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET,
+		__GetAdapter(MachineHelper,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET));
+	core->setMessageTagSymbol(m_plugin,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET,"RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET");
+
 	void*address=&(m_fusionData->m_FUSION_identifier_map);
 	core->setObjectSymbol(m_plugin,address,"/RayAssembler/ObjectStore/ContigNameIndex.ray");
 }
 
 void MachineHelper::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_ADD_COLORS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_ADD_COLORS");
 	RAY_SLAVE_MODE_AMOS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_AMOS");
 	RAY_SLAVE_MODE_ASSEMBLE_WAVES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_ASSEMBLE_WAVES");
@@ -1465,6 +1715,7 @@ void MachineHelper::resolveSymbols(ComputeCore*core){
 	RAY_MASTER_MODE_WRITE_SCAFFOLDS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_WRITE_SCAFFOLDS");
 	RAY_MASTER_MODE_STEP_A=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_STEP_A");
 	RAY_MASTER_MODE_EVALUATE_PATHS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_EVALUATE_PATHS");
+	RAY_MASTER_MODE_MARK_UNITIG_STARTS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_MARK_UNITIG_STARTS");
 
 	RAY_MPI_TAG_FINISH_FUSIONS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_FINISH_FUSIONS");
 	RAY_MPI_TAG_GET_CONTIG_CHUNK=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_CONTIG_CHUNK");
@@ -1572,6 +1823,8 @@ void MachineHelper::resolveSymbols(ComputeCore*core){
 
 	core->setMessageTagToSlaveModeSwitch(m_plugin,RAY_MPI_TAG_ASK_EXTENSION_DATA, RAY_SLAVE_MODE_SEND_EXTENSION_DATA);
 
+	core->setMessageTagToSlaveModeSwitch(m_plugin,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET, RAY_SLAVE_MODE_WRITE_KMERS);
+
 	__BindPlugin(MachineHelper);
 
 	__BindAdapter(MachineHelper,RAY_MASTER_MODE_LOAD_CONFIG);
@@ -1607,9 +1860,13 @@ void MachineHelper::resolveSymbols(ComputeCore*core){
 	__BindAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY);
 	__BindAdapter(MachineHelper,RAY_MPI_TAG_ASK_EXTENSION_DATA);
 	__BindAdapter(MachineHelper,RAY_MPI_TAG_EXTENSION_DATA_END);
+	__BindAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS);
+	__BindAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY);
+	__BindAdapter(MachineHelper,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET);
 
 	m_startedToSendCounts=false;
-	m_authorized=false;
+	m_requiredSpaceForContigs=0;
+	m_offsetForKmers=0;
 }
 
 
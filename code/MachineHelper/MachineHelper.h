@@ -42,6 +42,7 @@
 #include <code/KmerAcademyBuilder/KmerAcademyBuilder.h>
 #include <code/CoverageGatherer/CoverageGatherer.h>
 #include <code/SequencesIndexer/SequencesIndexer.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/core/ComputeCore.h>
 #include <RayPlatform/communication/VirtualCommunicator.h>
@@ -54,6 +55,7 @@
 #include <RayPlatform/profiling/Profiler.h>
 
 #include <stdint.h>
+#include <vector>
 #include <map>
 using namespace std;
 
@@ -93,6 +95,9 @@ __DeclareMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_
 __DeclareMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY);
 __DeclareMessageTagAdapter(MachineHelper,RAY_MPI_TAG_ASK_EXTENSION_DATA);
 __DeclareMessageTagAdapter(MachineHelper,RAY_MPI_TAG_EXTENSION_DATA_END);
+__DeclareMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS);
+__DeclareMessageTagAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY);
+__DeclareMessageTagAdapter(MachineHelper,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET);
 
 /** 
  * This file contains __legacy code__
@@ -135,6 +140,9 @@ class MachineHelper: public CorePlugin{
 	__AddAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY);
 	__AddAdapter(MachineHelper,RAY_MPI_TAG_ASK_EXTENSION_DATA);
 	__AddAdapter(MachineHelper,RAY_MPI_TAG_EXTENSION_DATA_END);
+	__AddAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS);
+	__AddAdapter(MachineHelper,RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY);
+	__AddAdapter(MachineHelper,RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET);
 
 	MessageTag RAY_MPI_TAG_NOTIFY_ERROR;
 	MessageTag RAY_MPI_TAG_FINISH_FUSIONS;
@@ -226,8 +234,18 @@ class MachineHelper: public CorePlugin{
 	int m_ranksThatComputedStorage;
 	vector<uint64_t> m_rankStorage;
 	uint64_t m_offsetForContigs;
+	uint64_t m_requiredSpaceForContigs;
 	int m_ranksThatWroteContigs;
-	bool m_authorized;
+
+	MessageTag RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS;
+	MessageTag RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY;
+	MessageTag RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET;
+
+	/* bytes of each rank in kmers.txt (-write-kmers) */
+	int m_ranksThatComputedKmerStorage;
+	vector<uint64_t> m_kmerStorage;
+	uint64_t m_offsetForKmers;
+	bool m_kmersFileIsComplete;
 
 /*
  * Stuff for sending entries in files.
@@ -239,7 +257,6 @@ class MachineHelper: public CorePlugin{
 	bool m_startedToSendCounts;
 	MessageTag RAY_MPI_TAG_SET_FILE_ENTRIES;
 	MessageTag RAY_MPI_TAG_SET_FILE_ENTRIES_REPLY;
-	MessageTag RAY_MPI_TAG_SEND_AUTHORIZATION;
 
 	MasterMode RAY_MASTER_MODE_ADD_COLORS;
 	MasterMode RAY_MASTER_MODE_AMOS;
@@ -276,6 +293,7 @@ class MachineHelper: public CorePlugin{
 	MasterMode RAY_MASTER_MODE_WRITE_SCAFFOLDS;
 	MasterMode RAY_MASTER_MODE_STEP_A;
 	MasterMode RAY_MASTER_MODE_EVALUATE_PATHS;
+	MasterMode RAY_MASTER_MODE_MARK_UNITIG_STARTS;
 
 	SlaveMode RAY_SLAVE_MODE_EXTENSION;
 	SlaveMode RAY_SLAVE_MODE_ADD_COLORS;
@@ -311,6 +329,10 @@ class MachineHelper: public CorePlugin{
 	bool*m_writeKmerInitialised;
 	Partitioner*m_partitioner;
 	map<int,map<int,LargeCount> > m_edgeDistribution;
+	/** records in the file of each rank, for -write-graph */
+	vector<LargeCount> m_graphRecords;
+	/** the file of each rank was written, the others are not in the manifest */
+	vector<bool> m_graphWritten;
 
 	VirtualCommunicator*m_virtualCommunicator;
 	KmerAcademyBuilder*m_kmerAcademyBuilder;
@@ -342,6 +364,7 @@ class MachineHelper: public CorePlugin{
 	BubbleData*m_bubbleData;
 	bool*m_alive;
 	TimePrinter*m_timePrinter;
+	Instrumentation*m_instrumentation;
 	SeedExtender*m_seedExtender;
 	Scaffolder*m_scaffolder;
 
@@ -358,6 +381,7 @@ class MachineHelper: public CorePlugin{
 	bool*m_reductionOccured;
 	/** indicator of the killer initialization */
 	bool m_initialisedKiller;
+	bool m_flushedInstrumentation;
 
 	int m_machineRank;
 	int m_numberOfRanksDone;
@@ -385,6 +409,7 @@ class MachineHelper: public CorePlugin{
 	int getRank();
 	int getSize();
 	void performAssemblyWorkflow(ComputeCore*core);
+	void writeGraphManifest();
 
 public:
 	void constructor(int argc,char**argv,Parameters*parameters,
@@ -443,6 +468,9 @@ SequencesLoader*sl,time_t*lastTime,bool*writeKmerInitialised,Partitioner*partiti
 	void call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_EXTENSIONS_REPLY(Message*message);
 	void call_RAY_MPI_TAG_ASK_EXTENSION_DATA(Message*message);
 	void call_RAY_MPI_TAG_EXTENSION_DATA_END(Message*message);
+	void call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS(Message*message);
+	void call_RAY_MPI_TAG_COMPUTE_REQUIRED_SPACE_FOR_KMERS_REPLY(Message*message);
+	void call_RAY_MPI_TAG_WRITE_KMERS_AT_OFFSET(Message*message);
 
 	void notifyThatOldDirectoryExists();
 
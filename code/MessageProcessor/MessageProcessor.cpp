@@ -30,6 +30,7 @@
 #include <code/SequencesLoader/Read.h>
 #include <code/SequencesIndexer/ReadAnnotation.h>
 #include <code/SeedExtender/Direction.h>
+#include <code/VerticesExtractor/GenomeGraphCheckpoint.h>
 
 #include <RayPlatform/core/ComputeCore.h>
 #include <RayPlatform/core/OperatingSystem.h>
@@ -40,6 +41,7 @@
 
 #include <assert.h>
 #include <string.h>
+#include <stdlib.h>
 
 __CreatePlugin(MessageProcessor);
 
@@ -66,8 +68,6 @@ __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_IN_EDGES_DATA); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_QUESTION);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_ANSWER);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION);
-__CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_DATA);
-__CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_END);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_SEND_COVERAGE_VALUES);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_READY_TO_SEED);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_START_SEEDING);
@@ -106,6 +106,7 @@ __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_START_FUSION);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_FUSION_DONE);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY);
+__CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH_REPLY);
@@ -130,7 +131,6 @@ __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ELIMINATE_PATH);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX_REPLY);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS);
-__CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS_REPLY);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION_IS_DONE);
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_LIBRARY_DISTANCE_REPLY);
@@ -497,7 +497,7 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTEX_INFO(Message*message){
 	m_subgraph->find(&vertex)->assemble(origin);
 
 	MessageUnit*outgoingMessage=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
-	outgoingMessage[0]=node->getCoverage(&vertex);
+	outgoingMessage[0]=m_subgraph->getCoverage(node);
 	outgoingMessage[1]=node->getEdges(&vertex);
 	outgoingMessage[2]=n;
 	int pos=5;
@@ -539,7 +539,7 @@ void MessageProcessor::call_RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT(Message*message
 			outgoingMessage[i+1]=1;
 		}else{
 			outgoingMessage[i]=node->getEdges(&vertex);
-			outgoingMessage[i+1]=node->getCoverage(&vertex);
+			outgoingMessage[i+1]=m_subgraph->getCoverage(node);
 		}
 	}
 
@@ -592,89 +592,25 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTEX_READS_FROM_LIST(Message*message){
 
 void MessageProcessor::call_RAY_MPI_TAG_START_INDEXING_SEQUENCES(Message*message){
 
+	GenomeGraphCheckpoint checkpoint;
+	checkpoint.constructor(m_parameters,m_subgraph);
+
 	/* read the Graph checkpoint here */
-	if(m_parameters->hasCheckpoint("GenomeGraph")){
+	if(m_parameters->hasCheckpoint("GenomeGraph") && !m_incrementalAssembly){
 		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint GenomeGraph"<<endl;
-		ifstream f(m_parameters->getCheckpointFile("GenomeGraph").c_str());
-		LargeCount n=0;
-		f.read((char*)&n,sizeof(LargeCount));
-
-		for(LargeIndex i=0;i<n;i++){
-			if(i%100000==0){
-				cout<<"Rank "<<m_parameters->getRank()<<" loading checkpoint GenomeGraph ["<<i<<"/"<<n<<"]"<<endl;
-			}
-			Kmer kmer;
-			kmer.read(&f);
-			int coverage=0;
-			f.read((char*)&coverage,sizeof(int));
-			Vertex*tmp=m_subgraph->insert(&kmer);
-
-			/* we only want to construct it once. */
-			if(m_subgraph->inserted()){
-				tmp->constructor();
-				tmp->setCoverage(&kmer,coverage);
-			}
-			int parents=0;
-			f.read((char*)&parents,sizeof(int));
-			for(int j=0;j<parents;j++){
-				Kmer parent;
-				parent.read(&f);
-				tmp->addIngoingEdge(&kmer,&parent,m_parameters->getWordSize());
-			}
-			int children=0;
-			f.read((char*)&children,sizeof(int));
-
-			for(int j=0;j<children;j++){
-				Kmer child;
-				child.read(&f);
-				tmp->addOutgoingEdge(&kmer,&child,m_parameters->getWordSize());
-			}
 
-			#ifdef CONFIG_ASSERT
-			vector<Kmer> parentKmers=tmp->getIngoingEdges(&kmer,m_parameters->getWordSize());
-			vector<Kmer> childKmers=tmp->getOutgoingEdges(&kmer,m_parameters->getWordSize());
-			if((int)parentKmers.size()!=parents){
-				cout<<"Expected: "<<parents<<" Actual: "<<parentKmers.size()<<endl;
-			}
-			assert((int)parentKmers.size()==parents);
-			assert((int)childKmers.size()==children);
-			#endif
+		if(!checkpoint.load(m_parameters->getCheckpointFile("GenomeGraph").c_str())){
+			cout<<"Error: Rank "<<m_parameters->getRank()<<" can not use checkpoint GenomeGraph"<<endl;
+			exit(1);
 		}
-		f.close();
-
-		/* complete the resizing ... */
-		/* Otherwise, the code will fail later on */
-		m_subgraph->completeResizing();
-
-		#ifdef CONFIG_ASSERT
-		assert(m_subgraph->size()==n);
-		#endif
-
-		cout<<"Rank "<<m_parameters->getRank()<<" loading checkpoint GenomeGraph ["<<n<<"/"<<n<<"]"<<endl;
-		cout<<"Rank "<<m_parameters->getRank()<<" loaded "<<n<<" vertices from checkpoint GenomeGraph"<<endl;
 	}
 
-	/* write checkpoint if necessary */
-	if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("GenomeGraph")){
+	/* write checkpoint if necessary, an incremental assembly replaces it */
+	if(m_parameters->writeCheckpoints() && (!m_parameters->hasCheckpoint("GenomeGraph") || m_incrementalAssembly)){
 		/* announce the user that we are writing a checkpoint */
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint GenomeGraph"<<endl;
 
-		ofstream f(m_parameters->getCheckpointFile("GenomeGraph").c_str());
-		ostringstream buffer;
-
-		GridTableIterator iterator;
-		iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
-		LargeCount theSize=m_subgraph->size();
-
-		buffer.write((char*)&theSize, sizeof(LargeCount));
-		while(iterator.hasNext()){
-			Vertex*node=iterator.next();
-			Kmer key=*(iterator.getKey());
-			node->write(&key, &buffer, m_parameters->getWordSize());
-			flushFileOperationBuffer(false, &buffer, &f, CONFIG_FILE_IO_BUFFER_SIZE);
-		}
-		flushFileOperationBuffer(true, &buffer, &f, CONFIG_FILE_IO_BUFFER_SIZE);
-		f.close();
+		checkpoint.write(m_parameters->getCheckpointFile("GenomeGraph").c_str());
 	}
 
 }
@@ -694,6 +630,37 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTICES_DATA(Message*message){
 	int count=message->getCount();
 	MessageUnit*incoming=(MessageUnit*)buffer;
 
+/*
+ * With -threads-per-rank, the threads of the pool insert the k-mers.
+ * When their queue is full, the main thread inserts them itself.
+ */
+	if(m_extractionPool->isEnabled()){
+
+		// the vertices of the checkpoint, before the threads use the table
+		if(!m_queuedInsertions){
+			m_queuedInsertions=true;
+			m_insertedVertices=m_subgraph->size();
+		}
+
+		if(!m_extractionPool->queueInsertion(incoming,count))
+			insertKmers(incoming,count);
+	}else{
+		insertKmers(incoming,count);
+	}
+
+	Message aMessage(NULL,0,message->getSource(),RAY_MPI_TAG_VERTICES_DATA_REPLY,m_rank);
+	m_outbox->push_back(&aMessage);
+}
+
+/*
+ * The threads of the pool call this at the same time, each k-mer is
+ * processed with the lock of its shard. The Bloom filter is shared by
+ * the shards, its bits are set atomically.
+ */
+void MessageProcessor::insertKmers(MessageUnit*incoming,int count){
+
+	bool threads=m_extractionPool->isEnabled();
+
 	for(int i=0;i<count;i+=KMER_U64_ARRAY_SIZE){
 		Kmer kmerObject;
 		int pos=i;
@@ -733,12 +700,21 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTICES_DATA(Message*message){
 
 		if(reverseComplement < lowerKmer)
 			lowerKmer=reverseComplement;
+
+		int shard=m_subgraph->getShard(&lowerKmer);
+
+		if(threads)
+			m_subgraph->lockShard(shard);
+
 /*
  * If the Bloom filter has exactly 0 bits,
  * this means that it is disabled.
  * The Bloom filter only contain the lower k-mers.
+ * K-mers loaded from the GenomeGraph checkpoint already
+ * passed the Bloom filter.
  */
-		if(m_bloomBits>0 && !m_bloomFilter.hasValue(&lowerKmer)){
+		if(m_bloomBits>0 && !m_bloomFilter.hasValue(&lowerKmer)
+			&& !(m_incrementalAssembly && m_subgraph->find(&lowerKmer)!=NULL)){
 /*
 			cout<<"inserting in Bloom filter: "<<endl;
 			kmerObject.print();
@@ -746,11 +722,14 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTICES_DATA(Message*message){
 
 			m_bloomFilter.insertValue(&lowerKmer);
 
+			if(threads)
+				m_subgraph->unlockShard(shard);
+
 			continue;
 		}
 
 
-		if((*m_last_value)!=(int)m_subgraph->size() && (int)m_subgraph->size()%100000==0){
+		if(!threads && (*m_last_value)!=(int)m_subgraph->size() && (int)m_subgraph->size()%100000==0){
 			(*m_last_value)=m_subgraph->size();
 			printf("Rank %i has %i vertices\n",m_rank,(int)m_subgraph->size());
 
@@ -764,7 +743,8 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTICES_DATA(Message*message){
  * We have a go. We insert the k-mer in the distributed
  * de Bruijn graph.
  */
-		Vertex*tmp=m_subgraph->insert(&kmerObject);
+		bool inserted=false;
+		Vertex*tmp=m_subgraph->insert(&kmerObject,&inserted);
 
 		#ifdef CONFIG_ASSERT
 		assert(tmp!=NULL);
@@ -775,7 +755,7 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTICES_DATA(Message*message){
  * It starts at 0 if the Bloom filter
  * is disabled, 1 otherwise.
  */
-		if(m_subgraph->inserted()){
+		if(inserted){
 			tmp->constructor();
 
 			CoverageDepth startingValue=0;
@@ -787,25 +767,40 @@ void MessageProcessor::call_RAY_MPI_TAG_VERTICES_DATA(Message*message){
 			if(m_bloomBits>0)
 				startingValue++;
 
-			tmp->setCoverage(&kmerObject,startingValue);
+			if(kmerObject==lowerKmer)
+				m_subgraph->setCoverage(tmp,startingValue);
+
+			// the other shards change at the same time, so the threads count the vertices
+			if(threads){
+				LargeCount vertices=__sync_add_and_fetch(&m_insertedVertices,2);
+
+				if(vertices%100000==0){
+					printf("Rank %i has %i vertices\n",m_rank,(int)vertices);
+
+					if(m_parameters->showMemoryUsage()){
+						showMemoryUsage(m_rank);
+					}
+				}
+			}
 		}
 
 /*
  * We only increase the k-mer coverage of the pair
  * when we see the lower k-mer of the pair. Otherwise,
  * the coverage will be double what it should be.
- * This logic is implemented in the class Vertex.
  */
-		CoverageDepth oldCoverage=tmp->getCoverage(&kmerObject);
-		CoverageDepth newCoverage=oldCoverage+1;
+		if(kmerObject==lowerKmer){
+			CoverageDepth oldCoverage=m_subgraph->getCoverage(tmp);
+			CoverageDepth newCoverage=oldCoverage+1;
 
-		// avoid integer overflow on data type CoverageDepth
-		if(newCoverage > oldCoverage)
-			tmp->setCoverage(&kmerObject,newCoverage);
-	}
+			// avoid integer overflow on data type CoverageDepth
+			if(newCoverage > oldCoverage)
+				m_subgraph->setCoverage(tmp,newCoverage);
+		}
 
-	Message aMessage(NULL,0,message->getSource(),RAY_MPI_TAG_VERTICES_DATA_REPLY,m_rank);
-	m_outbox->push_back(&aMessage);
+		if(threads)
+			m_subgraph->unlockShard(shard);
+	}
 }
 
 void MessageProcessor::call_RAY_MPI_TAG_PURGE_NULL_EDGES(Message*message){
@@ -885,6 +880,21 @@ void MessageProcessor::call_RAY_MPI_TAG_OUT_EDGES_DATA(Message*message){
 
 void MessageProcessor::call_RAY_MPI_TAG_START_VERTICES_DISTRIBUTION(Message*message){
 
+	/* the k-mers of the new reads are added to the graph of the checkpoint */
+	m_incrementalAssembly=m_parameters->isIncrementalAssembly();
+
+	if(m_incrementalAssembly){
+		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint GenomeGraph"<<endl;
+
+		GenomeGraphCheckpoint checkpoint;
+		checkpoint.constructor(m_parameters,m_subgraph);
+
+		if(!checkpoint.load(m_parameters->getCheckpointFile("GenomeGraph").c_str())){
+			cout<<"Error: Rank "<<m_parameters->getRank()<<" can not use checkpoint GenomeGraph"<<endl;
+			exit(1);
+		}
+	}
+
 	// with 4 000 000 kmers, the ratio is objects/bits is 16.
 	// with 0.000574
 	m_bloomBits=m_verticesExtractor->getDefaultNumberOfBitsForBloomFilter();
@@ -983,6 +993,9 @@ void MessageProcessor::call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_ANSWER(Mes
 
 void MessageProcessor::call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION(Message*message){
 
+	// the k-mers queued for the threads are in the table before it is used
+	m_extractionPool->waitForInsertions();
+
 	uint64_t kmersInBloomFilter=0;
 
 	if(m_bloomBits>0){
@@ -1017,6 +1030,8 @@ void MessageProcessor::call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION(Message*me
 
 	uint64_t kmersInGraph=m_subgraph->size();
 	cout<<"Rank "<<m_rank<<" has "<<kmersInGraph<<" k-mers (completed)"<<endl;
+	cout<<"Rank "<<m_rank<<" has "<<m_subgraph->getNumberOfSaturatedVertices()<<" vertices with a coverage";
+	cout<<" of at least "<<VERTEX_SATURATED_COVERAGE<<" in its overflow table"<<endl;
 
 /*
  * The number of k-mers in the Bloom filter will be greater than
@@ -1045,28 +1060,6 @@ void MessageProcessor::call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION(Message*me
 
 }
 
-void MessageProcessor::call_RAY_MPI_TAG_COVERAGE_DATA(Message*message){
-	void*buffer=message->getBuffer();
-	MessageUnit*incoming=(MessageUnit*)buffer;
-	int count=message->getCount();
-
-	for(int i=0;i<count;i+=2){
-		CoverageDepth coverage=incoming[i+0x0];
-		LargeCount count=incoming[i+1];
-		(*m_coverageDistribution)[coverage]+=count;
-	}
-
-	Message aMessage(NULL,0,message->getSource(),RAY_MPI_TAG_COVERAGE_DATA_REPLY,m_rank);
-	m_outbox->push_back(&aMessage);
-}
-
-void MessageProcessor::call_RAY_MPI_TAG_COVERAGE_END(Message*message){
-	(*m_numberOfMachinesDoneSendingCoverage)++;
-	if((*m_numberOfMachinesDoneSendingCoverage)==m_size){
-		m_switchMan->closeMasterMode();
-	}
-}
-
 void MessageProcessor::call_RAY_MPI_TAG_SEND_COVERAGE_VALUES(Message*message){
 	void*buffer=message->getBuffer();
 	MessageUnit*incoming=(MessageUnit*)buffer;
@@ -1205,7 +1198,7 @@ void MessageProcessor::call_RAY_MPI_TAG_GET_COVERAGE_AND_MARK(Message*message){
 	assert(node!=NULL);
 	#endif
 
-	CoverageDepth coverage=node->getCoverage(&vertex);
+	CoverageDepth coverage=m_subgraph->getCoverage(node);
 	message2[0]=coverage;
 	message2[1]=node->getEdges(&vertex);
 	Kmer rc=m_parameters->_complementVertex(&vertex);
@@ -1241,7 +1234,7 @@ void MessageProcessor::call_RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE(Message*message)
 		CoverageDepth coverage=0;
 
 		if(node!=NULL){
-			coverage=node->getCoverage(&vertex);
+			coverage=m_subgraph->getCoverage(node);
 
 			#ifdef CONFIG_ASSERT
 			assert(coverage!=0);
@@ -1538,7 +1531,7 @@ void MessageProcessor::call_RAY_MPI_TAG_ATTACH_SEQUENCE(Message*message){
 			continue;
 		}
 
-		int coverage=node->getCoverage(&vertex);
+		int coverage=m_subgraph->getCoverage(node);
 
 		if(coverage==1){
 			continue;
@@ -1664,7 +1657,7 @@ void MessageProcessor::call_RAY_MPI_TAG_SAVE_WAVE_PROGRESSION(Message*message){
 		assert(node!=NULL);
 
 		Vertex copy=*node;
-		assert(copy.getCoverage(&vertex)>=1);
+		assert(copy.getCoverageCounter()>=1);
 		#endif
 
 		PathHandle wave=incoming[pos++];
@@ -1753,7 +1746,7 @@ void MessageProcessor::call_RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE(Message*message){
 		}
 		assert(node!=NULL);
 
-		int coverage=node->getCoverage(&vertex);
+		int coverage=m_subgraph->getCoverage(node);
 		assert(coverage >= 1);
 		#endif
 
@@ -1775,6 +1768,64 @@ void MessageProcessor::call_RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY(Message*mess
 	m_seedingData->m_SEEDING_receivedVertexCoverage=incoming[1];
 }
 
+/*
+input: Kmer ; path handle
+output: number of paths ; number of other paths ; first other path ; its progression
+
+Summarizes the paths of a k-mer as seen from the path of the requester.
+In contigs, most k-mers are on at most one other path, so this replaces
+the RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE query followed by one
+RAY_MPI_TAG_ASK_VERTEX_PATH query per path with a single query.
+*/
+void MessageProcessor::call_RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY(Message*message){
+	Rank source=message->getSource();
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+	MessageUnit*message2=(MessageUnit*)m_outboxAllocator->allocate(count*sizeof(MessageUnit));
+
+	int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY);
+
+	for(int i=0;i<count;i+=elementsPerQuery){
+		int pos=i;
+		Kmer vertex;
+		vertex.unpack(incoming,&pos);
+		PathHandle requester=incoming[pos++];
+
+		#ifdef CONFIG_ASSERT
+		Vertex*node=m_subgraph->find(&vertex);
+		assert(node!=NULL);
+		#endif
+
+		vector<Direction> paths=m_subgraph->getDirections(&vertex);
+
+		int otherPaths=0;
+		int firstOther=0;
+
+		for(int j=0;j<(int)paths.size();j++){
+			if(paths[j].getWave()==requester)
+				continue;
+
+			if(otherPaths==0)
+				firstOther=j;
+
+			otherPaths++;
+		}
+
+		message2[i+0]=paths.size();
+		message2[i+1]=otherPaths;
+		message2[i+2]=0;
+		message2[i+3]=0;
+
+		if(otherPaths>0){
+			message2[i+2]=paths[firstOther].getWave().getValue();
+			message2[i+3]=paths[firstOther].getProgression();
+		}
+	}
+
+	Message aMessage(message2,count,source,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY,m_rank);
+	m_outbox->push_back(&aMessage);
+}
+
 void MessageProcessor::call_RAY_MPI_TAG_GET_PATH_LENGTH(Message*message){
 	void*buffer=message->getBuffer();
 	int count=message->getCount();
@@ -1821,7 +1872,7 @@ void MessageProcessor::call_RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION(Message*messa
 		uint8_t edges=0;
 		if(node!=NULL){
 			paths=m_subgraph->getDirections(&vertex);
-			coverage=node->getCoverage(&vertex);
+			coverage=m_subgraph->getCoverage(node);
 			edges=node->getEdges(&vertex);
 		}
 		message2[i+0]=coverage;
@@ -2323,11 +2374,6 @@ void MessageProcessor::call_RAY_MPI_TAG_WRITE_AMOS(Message*message){
 	m_ed->m_EXTENSION_currentPosition=((MessageUnit*)message->getBuffer())[0];
 }
 
-void MessageProcessor::call_RAY_MPI_TAG_WRITE_AMOS_REPLY(Message*message){
-	m_ed->m_EXTENSION_currentRankIsDone=true;
-	m_ed->m_EXTENSION_currentPosition=((MessageUnit*)message->getBuffer())[0];
-}
-
 void MessageProcessor::call_RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION(Message*message){
 
 	(m_seedingData->m_SEEDING_i)=0;
@@ -2578,6 +2624,7 @@ SequencesIndexer*m_si){
 	this->m_ready=m_ready;
 	m_seedingData=seedingData;
 	m_kmerAcademyFinishedRanks=0;
+	m_incrementalAssembly=false;
 }
 
 MessageProcessor::MessageProcessor(){
@@ -2585,6 +2632,9 @@ MessageProcessor::MessageProcessor(){
 	m_consumed=0;
 	m_sentinelValue=0;
 	m_sentinelValue--;// overflow it in an obvious manner
+	m_extractionPool=NULL;
+	m_queuedInsertions=false;
+	m_insertedVertices=0;
 }
 
 void MessageProcessor::setVirtualCommunicator(VirtualCommunicator*a){
@@ -2595,6 +2645,10 @@ void MessageProcessor::setSwitchMan(SwitchMan*a){
 	m_switchMan=a;
 }
 
+void MessageProcessor::setExtractionPool(KmerExtractionPool*pool){
+	m_extractionPool=pool;
+}
+
 void MessageProcessor::registerPlugin(ComputeCore*core){
 
 	m_core = core;
@@ -2701,14 +2755,6 @@ void MessageProcessor::registerPlugin(ComputeCore*core){
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION, __GetAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION,"RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION");
 
-	RAY_MPI_TAG_COVERAGE_DATA=core->allocateMessageTagHandle(plugin);
-	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_COVERAGE_DATA, __GetAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_DATA));
-	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_COVERAGE_DATA,"RAY_MPI_TAG_COVERAGE_DATA");
-
-	RAY_MPI_TAG_COVERAGE_END=core->allocateMessageTagHandle(plugin);
-	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_COVERAGE_END, __GetAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_END));
-	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_COVERAGE_END,"RAY_MPI_TAG_COVERAGE_END");
-
 	RAY_MPI_TAG_SEND_COVERAGE_VALUES=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_SEND_COVERAGE_VALUES, __GetAdapter(MessageProcessor,RAY_MPI_TAG_SEND_COVERAGE_VALUES));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_SEND_COVERAGE_VALUES,"RAY_MPI_TAG_SEND_COVERAGE_VALUES");
@@ -2862,6 +2908,13 @@ void MessageProcessor::registerPlugin(ComputeCore*core){
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY, __GetAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY");
 
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY, __GetAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY");
+
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY");
+
 	RAY_MPI_TAG_GET_PATH_LENGTH=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_GET_PATH_LENGTH, __GetAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_GET_PATH_LENGTH,"RAY_MPI_TAG_GET_PATH_LENGTH");
@@ -2958,9 +3011,6 @@ void MessageProcessor::registerPlugin(ComputeCore*core){
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_WRITE_AMOS, __GetAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_WRITE_AMOS,"RAY_MPI_TAG_WRITE_AMOS");
 
-	RAY_MPI_TAG_WRITE_AMOS_REPLY=core->allocateMessageTagHandle(plugin);
-	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_WRITE_AMOS_REPLY, __GetAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS_REPLY));
-	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_WRITE_AMOS_REPLY,"RAY_MPI_TAG_WRITE_AMOS_REPLY");
 
 	RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION, __GetAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION));
@@ -3098,13 +3148,9 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_VERTICES_DATA_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_VERTICES_DATA_REPLY");
 	RAY_MPI_TAG_VERTICES_DISTRIBUTED=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_VERTICES_DISTRIBUTED");
 	RAY_MPI_TAG_WRITE_AMOS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_AMOS");
-	RAY_MPI_TAG_WRITE_AMOS_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_AMOS_REPLY");
 
 	RAY_MPI_TAG_CONTIG_INFO=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_CONTIG_INFO");
 	RAY_MPI_TAG_CONTIG_INFO_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_CONTIG_INFO_REPLY");
-	RAY_MPI_TAG_COVERAGE_DATA=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COVERAGE_DATA");
-	RAY_MPI_TAG_COVERAGE_DATA_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COVERAGE_DATA_REPLY");
-	RAY_MPI_TAG_COVERAGE_END=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COVERAGE_END");
 	RAY_MPI_TAG_DISTRIBUTE_FUSIONS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_DISTRIBUTE_FUSIONS");
 	RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED");
 	RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED_REPLY");
@@ -3163,6 +3209,8 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_ASK_VERTEX_PATHS_REPLY_END=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_REPLY_END");
 	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE");
 	RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY");
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY");
+	RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY");
 	RAY_MPI_TAG_ASSEMBLE_WAVES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASSEMBLE_WAVES");
 	RAY_MPI_TAG_ASSEMBLE_WAVES_DONE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASSEMBLE_WAVES_DONE");
 	RAY_MPI_TAG_ATTACH_SEQUENCE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ATTACH_SEQUENCE");
@@ -3201,6 +3249,7 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_CONTIG_INFO,                  RAY_MPI_TAG_CONTIG_INFO_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_ASK_READ_LENGTH,              RAY_MPI_TAG_ASK_READ_LENGTH_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,        RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY );
+	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY,     RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_ASK_VERTEX_PATH,              RAY_MPI_TAG_ASK_VERTEX_PATH_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_GET_PATH_VERTEX,              RAY_MPI_TAG_GET_PATH_VERTEX_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_VERTEX_INFO,                  RAY_MPI_TAG_VERTEX_INFO_REPLY );
@@ -3220,6 +3269,7 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_CONTIG_INFO,                  2);
 	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_ASK_READ_LENGTH,              3 );
 	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE, KMER_U64_ARRAY_SIZE );
+	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY, max(4,KMER_U64_ARRAY_SIZE+1) );
 	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_ASK_VERTEX_PATH, (KMER_U64_ARRAY_SIZE + 2) );
 	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_GET_PATH_VERTEX, max(2,KMER_U64_ARRAY_SIZE) );
 	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_SAVE_WAVE_PROGRESSION_WITH_REPLY, KMER_U64_ARRAY_SIZE+2 );
@@ -3250,8 +3300,6 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_QUESTION);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_ANSWER);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION);
-	__BindAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_DATA);
-	__BindAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_END);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_SEND_COVERAGE_VALUES);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_READY_TO_SEED);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_START_SEEDING);
@@ -3290,6 +3338,7 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_FUSION_DONE);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY);
+	__BindAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH_REPLY);
@@ -3314,7 +3363,6 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX_REPLY);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS);
-	__BindAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS_REPLY);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION_IS_DONE);
 	__BindAdapter(MessageProcessor,RAY_MPI_TAG_LIBRARY_DISTANCE_REPLY);
@@ -29,6 +29,7 @@
 #include <code/SequencesIndexer/ReadAnnotation.h>
 #include <code/SequencesIndexer/SequencesIndexer.h>
 #include <code/KmerAcademyBuilder/BloomFilter.h>
+#include <code/KmerAcademyBuilder/KmerExtractionPool.h>
 #include <code/Library/Library.h>
 #include <code/SeedingData/SeedingData.h>
 #include <code/FusionData/FusionData.h>
@@ -78,8 +79,6 @@ __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_IN_EDGES_DATA); /**/
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_QUESTION);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_ANSWER);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION);
-__DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_DATA);
-__DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_END);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_SEND_COVERAGE_VALUES);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_READY_TO_SEED);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_START_SEEDING);
@@ -118,6 +117,7 @@ __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_START_FUSION);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_FUSION_DONE);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY);
+__DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH_REPLY);
@@ -142,7 +142,6 @@ __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ELIMINATE_PATH);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX_REPLY);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS);
-__DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS_REPLY);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION_IS_DONE);
 __DeclareMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_LIBRARY_DISTANCE_REPLY);
@@ -167,7 +166,7 @@ __DeclareMessageTagAdapter(MessageProcessor, RAY_MESSAGE_TAG_PUSH_SEEDS_REPLY);
  *
  * \author Sébastien Boisvert
  */
-class MessageProcessor :  public CorePlugin {
+class MessageProcessor :  public CorePlugin, public KmerInserter {
 
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_CONTIG_INFO);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_SCAFFOLDING_LINKS);
@@ -192,8 +191,6 @@ class MessageProcessor :  public CorePlugin {
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_QUESTION);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_ANSWER);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION);
-	__AddAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_DATA);
-	__AddAdapter(MessageProcessor,RAY_MPI_TAG_COVERAGE_END);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_SEND_COVERAGE_VALUES);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_READY_TO_SEED);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_START_SEEDING);
@@ -232,6 +229,7 @@ class MessageProcessor :  public CorePlugin {
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_FUSION_DONE);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY);
+	__AddAdapter(MessageProcessor,RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_LENGTH_REPLY);
@@ -256,7 +254,6 @@ class MessageProcessor :  public CorePlugin {
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX_REPLY);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS);
-	__AddAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS_REPLY);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION_IS_DONE);
 	__AddAdapter(MessageProcessor,RAY_MPI_TAG_LIBRARY_DISTANCE_REPLY);
@@ -275,6 +272,9 @@ class MessageProcessor :  public CorePlugin {
 
 	uint64_t m_bloomBits;
 
+	/** the graph of the GenomeGraph checkpoint was loaded before counting k-mers */
+	bool m_incrementalAssembly;
+
 	MessageTag RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION;
 	MessageTag RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_ANSWER;
 	MessageTag RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_QUESTION;
@@ -323,13 +323,9 @@ class MessageProcessor :  public CorePlugin {
 	MessageTag RAY_MPI_TAG_VERTICES_DATA_REPLY;
 	MessageTag RAY_MPI_TAG_VERTICES_DISTRIBUTED;
 	MessageTag RAY_MPI_TAG_WRITE_AMOS;
-	MessageTag RAY_MPI_TAG_WRITE_AMOS_REPLY;
 
 	MessageTag RAY_MPI_TAG_CONTIG_INFO;
 	MessageTag RAY_MPI_TAG_CONTIG_INFO_REPLY;
-	MessageTag RAY_MPI_TAG_COVERAGE_DATA;
-	MessageTag RAY_MPI_TAG_COVERAGE_DATA_REPLY;
-	MessageTag RAY_MPI_TAG_COVERAGE_END;
 	MessageTag RAY_MPI_TAG_DISTRIBUTE_FUSIONS;
 	MessageTag RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED;
 	MessageTag RAY_MPI_TAG_DISTRIBUTE_FUSIONS_FINISHED_REPLY;
@@ -390,6 +386,8 @@ class MessageProcessor :  public CorePlugin {
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_REPLY_END;
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY_REPLY;
 	MessageTag RAY_MPI_TAG_ASSEMBLE_WAVES;
 	MessageTag RAY_MPI_TAG_ASSEMBLE_WAVES_DONE;
 	MessageTag RAY_MPI_TAG_ATTACH_SEQUENCE;
@@ -439,6 +437,13 @@ class MessageProcessor :  public CorePlugin {
 	int m_kmerAcademyFinishedRanks;
 	BloomFilter m_bloomFilter;
 
+	/** the threads of -threads-per-rank insert the received k-mers */
+	KmerExtractionPool*m_extractionPool;
+	bool m_queuedInsertions;
+
+	/** vertices in the GridTable, counted by the threads for the progress */
+	LargeCount m_insertedVertices;
+
 	VirtualCommunicator*m_virtualCommunicator;
 	Scaffolder*m_scaffolder;
 	int m_count;
@@ -572,6 +577,10 @@ SequencesIndexer*m_si
 	void setScaffolder(Scaffolder*a);
 	void setVirtualCommunicator(VirtualCommunicator*a);
 	void setSwitchMan(SwitchMan*a);
+	void setExtractionPool(KmerExtractionPool*pool);
+
+	/** inserts the k-mers of a RAY_MPI_TAG_VERTICES_DATA message */
+	void insertKmers(MessageUnit*incoming,int count);
 
 // list of declarations
 
@@ -598,8 +607,6 @@ SequencesIndexer*m_si
 	void call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_QUESTION(Message*message);
 	void call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION_ANSWER(Message*message);
 	void call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION(Message*message);
-	void call_RAY_MPI_TAG_COVERAGE_DATA(Message*message);
-	void call_RAY_MPI_TAG_COVERAGE_END(Message*message);
 	void call_RAY_MPI_TAG_SEND_COVERAGE_VALUES(Message*message);
 	void call_RAY_MPI_TAG_READY_TO_SEED(Message*message);
 	void call_RAY_MPI_TAG_START_SEEDING(Message*message);
@@ -638,6 +645,7 @@ SequencesIndexer*m_si
 	void call_RAY_MPI_TAG_FUSION_DONE(Message*message);
 	void call_RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE(Message*message);
 	void call_RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE_REPLY(Message*message);
+	void call_RAY_MPI_TAG_ASK_VERTEX_PATHS_SUMMARY(Message*message);
 	void call_RAY_MPI_TAG_GET_PATH_LENGTH(Message*message);
 	void call_RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION(Message*message);
 	void call_RAY_MPI_TAG_GET_PATH_LENGTH_REPLY(Message*message);
@@ -662,7 +670,6 @@ SequencesIndexer*m_si
 	void call_RAY_MPI_TAG_GET_PATH_VERTEX(Message*message);
 	void call_RAY_MPI_TAG_GET_PATH_VERTEX_REPLY(Message*message);
 	void call_RAY_MPI_TAG_WRITE_AMOS(Message*message);
-	void call_RAY_MPI_TAG_WRITE_AMOS_REPLY(Message*message);
 	void call_RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION(Message*message);
 	void call_RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION_IS_DONE(Message*message);
 	void call_RAY_MPI_TAG_LIBRARY_DISTANCE_REPLY(Message*message);
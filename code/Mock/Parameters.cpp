@@ -96,6 +96,7 @@ Parameters::Parameters(){
 
 	m_checkpointDirectory="Checkpoints";
 	m_hasCheckpointDirectory=false;
+	m_hasSequenceCheckpointDirectory=false;
 
 	m_maximumSeedCoverage=getMaximumAllowedCoverage();
 }
@@ -335,6 +336,8 @@ void Parameters::parseCommands(){
 	checkpoints.insert("-write-checkpoints");
 	checkpoints.insert("-read-checkpoints");
 
+	set<string> sequenceCheckpoints;
+	sequenceCheckpoints.insert("-sequence-checkpoints");
 
 	set<string> maximumSeedCoverage;
 	maximumSeedCoverage.insert("-use-maximum-seed-coverage");
@@ -344,6 +347,7 @@ void Parameters::parseCommands(){
 
 	vector<set<string> > toAdd;
 	toAdd.push_back(checkpoints);
+	toAdd.push_back(sequenceCheckpoints);
 	toAdd.push_back(coloringOneColor);
 	toAdd.push_back(ontology);
 	toAdd.push_back(phylogeny);
@@ -501,6 +505,27 @@ void Parameters::parseCommands(){
 				}
 			}
 
+		}else if(sequenceCheckpoints.count(token)>0){
+			i++;
+			int items=m_commands.size()-i;
+			if(items<1){
+				if(m_rank==MASTER_RANK){
+					cout<<"Error: "<<token<<" needs 1 item, you provided "<<items<<endl;
+				}
+				m_error=true;
+				return;
+			}
+
+			m_sequenceCheckpointDirectory=m_commands[i];
+			m_hasSequenceCheckpointDirectory=true;
+
+			if(m_rank==MASTER_RANK){
+
+				if(!fileExists(m_sequenceCheckpointDirectory.c_str())){
+					createDirectory(m_sequenceCheckpointDirectory.c_str());
+				}
+			}
+
 		}else if(outputFileCommands.count(token)>0){
 			i++;
 			int items=m_commands.size()-i;
@@ -889,10 +914,7 @@ void Parameters::parseCommands(){
 				return;
 			}
 			token=m_commands[i];
-			m_wordSize=atoi(token.c_str());
-			if(m_wordSize<15){
-				m_wordSize=15;
-			}
+			m_wordSize=getValidWordSize(atoi(token.c_str()));
 			if(m_wordSize>CONFIG_MAXKMERLENGTH){
 				if(m_rank==MASTER_RANK){
 					cout<<endl;
@@ -1066,6 +1088,15 @@ void Parameters::constructor(int argc,char**argv,int rank,int size,
 	m_rank=rank;
 	m_size=size;
 
+	loadCommands(argc,argv);
+
+	setDefaultRoutingOptions();
+
+	parseCommands();
+}
+
+/** the commands are in a file (Ray Ray.conf) or on the command line */
+void Parameters::loadCommands(int argc,char**argv){
 	bool hasCommandFile=false;
 	if(argc==2){
 		ifstream f(argv[1]);
@@ -1079,10 +1110,35 @@ void Parameters::constructor(int argc,char**argv,int rank,int size,
 	}else{
 		loadCommandsFromArguments(argc,argv);
 	}
+}
 
-	setDefaultRoutingOptions();
+/**
+ * k is at least 15 and is odd because reverse-complement
+ * vertices are stored together.
+ */
+int Parameters::getValidWordSize(int wordSize){
+	if(wordSize<15)
+		wordSize=15;
 
-	parseCommands();
+	if(wordSize%2==0)
+		wordSize--;
+
+	return wordSize;
+}
+
+/**
+ * Gets the value of -k in the loaded commands, before
+ * CONFIG_MAXKMERLENGTH is applied.
+ */
+int Parameters::getRequestedWordSize(){
+	int wordSize=m_wordSize;
+
+	for(int i=0;i+1<(int)m_commands.size();i++){
+		if(m_commands[i]=="-k")
+			wordSize=getValidWordSize(atoi(m_commands[i+1].c_str()));
+	}
+
+	return wordSize;
 }
 
 void Parameters::setDefaultRoutingOptions() {
@@ -1538,6 +1594,12 @@ void Parameters::showUsage(){
 	cout<<endl;
 	showOption("-version","Displays Ray version and compilation options.");
 	cout<<endl;
+	showOption("-kmer-benchmark","Benchmarks the k-mer kernels (reverse complement, neighbours) and exits.");
+	showOptionDescription("The results are compared with the symbol-by-symbol implementations.");
+	cout<<endl;
+	showOption("-grid-table-benchmark","Inserts k-mers in the GridTable with 1 to 16 threads and exits.");
+	showOptionDescription("The coverage of every k-mer is verified after each run.");
+	cout<<endl;
 
 	cout<<"  Run Ray in pure MPI mode"<<endl;
 	cout<<endl;
@@ -1552,6 +1614,11 @@ void Parameters::showUsage(){
 
 #endif /* CONFIG_MINI_RANKS */
 
+	cout<<"  Run Ray with one rank per socket, 8 cores / socket (MPI and IEEE POSIX threads)"<<endl;
+	cout<<endl;
+	cout<<"    mpiexec -n 20 Ray -threads-per-rank 7 ..."<<endl;
+	cout<<endl;
+
 	cout<<"  Run Ray on one core only (still needs MPI)"<<endl;
 	cout<<endl;
 	cout<<"    Ray ..."<<endl;
@@ -1572,6 +1639,9 @@ void Parameters::showUsage(){
 	showOptionDescription("It must be odd because reverse-complement vertices are stored together.");
 	showOptionDescription("The maximum length is defined at compilation by CONFIG_MAXKMERLENGTH");
 	showOptionDescription("Larger k-mers utilise more memory.");
+	showOptionDescription("Executables built with make kmer-widths (Ray-32, Ray-64, ...) are started");
+	showOptionDescription("automatically so that k-mers use only the words needed for kmerLength.");
+	showOptionDescription("Set RAY_NO_KMER_DISPATCH to disable this.");
 	cout<<endl;
 
 
@@ -1580,6 +1650,9 @@ void Parameters::showUsage(){
 
 	showOption("-detect-sequence-files SampleDirectory", "Detects files in a directory automatically.");
 	showOptionDescription("This option can generate these commands automatically for you: LoadPairedEndReads (-p) and LoadSingleEndReads (-s)");
+	showOptionDescription("Only a sequence file with an up-to-date samtools index (file.fai) is counted without being read,");
+	showOptionDescription("the number of sequences is then the number of lines of the index.");
+	showOptionDescription("Any other file is still read completely to count its sequences, by one rank per file.");
 
 	cout<<endl;
 	showOption("-p leftSequenceFile rightSequenceFile [averageOuterDistance standardDeviation]","Provides two files containing paired-end reads.");
@@ -1612,6 +1685,7 @@ void Parameters::showUsage(){
 	cout << endl;
 
 	showOption("-read-sample-graph SampleName SampleGraphFile", "Reads a sample graph (generated with -write-kmers from a Ray's assembly)");
+	showOptionDescription("SampleGraphFile is kmers.txt (-write-kmers) or Graph/Manifest.txt (-write-graph)");
 	cout<<endl;
 
 	showOption("-read-sample-assembly SampleName SampleAssemblyFile", "Reads an assembly (fasta file)");
@@ -1690,6 +1764,12 @@ void Parameters::showUsage(){
 	cout<<endl;
 
 
+	showOption("-threads-per-rank threads","Sets the number of threads of the k-mer pool of a rank.");
+	showOptionDescription("The threads compute the k-mers and edges of the local reads and insert");
+	showOptionDescription("the received k-mers in the graph. They run in addition to the main thread,");
+	showOptionDescription("which still sends all the messages. The default is 1 (no pool).");
+	cout<<endl;
+
 	cout<<"  Distributed storage engine (all these values are for each MPI rank)"<<endl;
 	cout<<endl;
 
@@ -1719,6 +1799,15 @@ void Parameters::showUsage(){
 	showOptionDescription(text.str());
 	cout<<endl;
 
+	showOption("-hash-table-shards shards","Sets the number of independent hash tables, selected with the high bits of the hash");
+	text.str("");
+	text<<"Default value: "<<__DEFAULT_HASH_TABLE_SHARDS<<", must be a power of 2 !";
+	showOptionDescription("Each shard has its own lock, the order of the vertices depends on this value.");
+	showOptionDescription("Use more shards than threads with -threads-per-rank so that the threads do not wait on one lock.");
+	showOptionDescription(text.str());
+	text.str("");
+	cout<<endl;
+
 	showOption("-hash-table-verbosity","Activates verbosity for the distributed storage engine");
 	cout<<endl;
 
@@ -1759,15 +1848,36 @@ void Parameters::showUsage(){
 	cout<<endl;
 
 	showOption("-write-kmers","Writes k-mer graph to RayOutput/kmers.txt");
+	showOptionDescription("All the ranks write their part of the file at the same time.");
 	showOptionDescription("The resulting file is not utilised by Ray.");
 	showOptionDescription("The resulting file is very large.");
 	cout<<endl;
 
+	showOption("-write-graph","Writes the k-mer graph in binary to RayOutput/Graph/");
+	showOptionDescription("All the ranks write their vertices at the same time, one file per rank.");
+	showOptionDescription("RayOutput/Graph/Manifest.txt can be given to -read-sample-graph.");
+	cout<<endl;
+
+	showOption("-spectrum-preview fraction","Estimates the k-mer spectrum with a fraction of the reads of each file, and exits.");
+	showOptionDescription("Writes RayOutput/CoverageDistribution.txt (projected on all the reads) and");
+	showOptionDescription("RayOutput/SpectrumPreview.txt (distinct k-mers, error k-mers, peak coverage,");
+	showOptionDescription("GridTable memory per rank). Only the first rank reads the files.");
+	cout<<endl;
+
 	showOption("-graph-only","Exits after building graph.");
 	cout<<endl;
 
+	showOption("-compact-unitigs","Compacts non-branching paths of the graph into unitigs before the seeding.");
+	showOptionDescription("Seeds are extended by whole unitigs instead of one k-mer at a time.");
+	showOptionDescription("The extension of seeds and the neighbourhoods still walk one k-mer at a time.");
+	cout<<endl;
+
 	showOption("-write-read-markers","Writes read markers to disk.");
 	cout<<endl;
+	showOption("-bulk-read-indexing","Selects read markers in batches of reads.");
+	showOptionDescription("The coverage of the k-mers of a batch is fetched with a few large messages");
+	showOptionDescription("instead of one message per k-mer. The selected markers are the same.");
+	cout<<endl;
 	showOption("-write-seeds","Writes seed DNA sequences to RayOutput/Rank<rank>.RaySeeds.fasta");
 	cout<<endl;
 	showOption("-write-extensions","Writes extension DNA sequences to RayOutput/Rank<rank>.RayExtensions.fasta");
@@ -1785,6 +1895,10 @@ void Parameters::showUsage(){
 	cout<<endl;
 	showOption("-show-memory-allocations","Shows memory allocation events");
 	cout<<endl;
+	showOption("-read-cache-memory megabytes","Sets the memory for the reads fetched from other ranks during the extension");
+	showOptionDescription("The least recently found reads are evicted, and fetched again when needed.");
+	showOptionDescription("0 disables the cache. The default is 64.");
+	cout<<endl;
 
 	cout<<"  Algorithm verbosity"<<endl;
 	cout<<endl;
@@ -1819,6 +1933,18 @@ void Parameters::showUsage(){
 	cout<<endl;
 	showOption("-read-write-checkpoints checkpointDirectory","Read and write checkpoint files");
 	cout<<endl;
+	showOption("-sequence-checkpoints checkpointDirectory","Read or write the checkpoints Partition and Sequences in this directory");
+	showOptionDescription("These checkpoints contain the loaded reads and do not depend on -k.");
+	showOptionDescription("Runs with different k-mer lengths and the same number of ranks can share them");
+	showOptionDescription("to load the reads without parsing the sequence files again.");
+	showOptionDescription("Each k-mer length is still a separate MPI job that reads these checkpoints.");
+	showOptionDescription("See scripts/Ray-k-sweep.sh.");
+	cout<<endl;
+	showOption("-incremental-assembly files","Adds new sequence files to the GenomeGraph checkpoint");
+	showOptionDescription("The first files given (a -p pair counts as 2 files) are those already in the checkpoint.");
+	showOptionDescription("K-mers and edges are only extracted from the other files; all the files are used afterwards.");
+	showOptionDescription("Needs -read-checkpoints or -read-write-checkpoints.");
+	cout<<endl;
 
 	cout<<"  Message routing for large number of cores"<<endl;
 	cout<<endl;
@@ -1859,6 +1985,20 @@ void Parameters::showUsage(){
 	showOption("-exchanges NumberOfExchanges","Sets the number of exchanges");
 	cout<<endl;
 
+	showOption("-network-benchmark","Runs a network benchmark suite after the network test.");
+	showOptionDescription("Steps: message size sweep, bandwidth to a peer, all-to-all burst and outstanding messages.");
+	showOptionDescription("Files generated: RankX.NetworkBenchmark.csv and RankX.NetworkBenchmark.json");
+	showOptionDescription("Compare runs with and without -route-messages to choose the routing settings.");
+	cout<<endl;
+
+	showOption("-network-benchmark-messages NumberOfMessages","Sets the number of messages per benchmark step");
+	showOptionDescription("Default is 256.");
+	cout<<endl;
+
+	showOption("-network-benchmark-depth MaximumOutstandingMessages","Sets the maximum number of messages in flight");
+	showOptionDescription("Default is 64.");
+	cout<<endl;
+
 	showOption("-disable-network-test","Skips the network test.");
 	cout<<endl;
 
@@ -1872,6 +2012,11 @@ void Parameters::showUsage(){
 	showOption("-write-scheduling-data", "Writes RayPlatform scheduling information to RayOutput/Scheduling/");
 	cout<<endl;
 
+	showOption("-write-instrumentation-data", "Writes phase-aligned counters for all ranks to RayOutput/Instrumentation.json");
+	showOptionDescription("Counters: wall time, CPU time, resident memory, allocator bytes and hash table lookups.");
+	showOptionDescription("The file is updated at the end of each phase.");
+	cout<<endl;
+
 	showOption("-write-plugin-data", "Writes data for plugins registered with the RayPlatform API to RayOutput/Plugins");
 	cout<<endl;
 
@@ -1968,6 +2113,9 @@ void Parameters::showUsage(){
 	cout<<"     	k-mer graph, required option: -write-kmers"<<endl;
 	cout<<"         The resulting file is not utilised by Ray."<<endl;
 	cout<<"         The resulting file is very large."<<endl;
+	cout<<"     RayOutput/Graph/Manifest.txt"<<endl;
+	cout<<"     	binary k-mer graph, required option: -write-graph"<<endl;
+	cout<<"         Lists the files RayOutput/Graph/Rank*.graph (one per rank)."<<endl;
 	cout<<endl;
 
 	cout<<"  Assembly steps"<<endl;
@@ -2157,6 +2305,10 @@ bool Parameters::writeKmers(){
 	return m_writeKmers;
 }
 
+bool Parameters::writeGraph(){
+	return hasOption("-write-graph");
+}
+
 void Parameters::fileNameHook(string fileName){
 	if(fileName.find(".csfasta")!=string::npos){
 		if(!m_colorSpaceMode&&m_rank==MASTER_RANK){
@@ -2187,9 +2339,28 @@ bool Parameters::hasFile(const char*file){
 	return fileIsOk;
 }
 
+/*
+ * The checkpoints Partition and Sequences do not depend on the k-mer length.
+ */
+bool Parameters::isSequenceCheckpoint(const char*checkpointName){
+	if(!m_hasSequenceCheckpointDirectory)
+		return false;
+
+	/* the reads of the new files are loaded again */
+	if(hasConfigurationOption("-incremental-assembly",1))
+		return false;
+
+	return strcmp(checkpointName,"Partition")==0 || strcmp(checkpointName,"Sequences")==0;
+}
+
 string Parameters::getCheckpointFile(const char*checkpointName){
 	ostringstream a;
-	a<<m_checkpointDirectory<<"/";
+
+	if(isSequenceCheckpoint(checkpointName))
+		a<<m_sequenceCheckpointDirectory<<"/";
+	else
+		a<<m_checkpointDirectory<<"/";
+
 	a<<"Rank"<<getRank()<<".Checkpoint."<<checkpointName<<".ray";
 	return a.str();
 }
@@ -2197,9 +2368,16 @@ string Parameters::getCheckpointFile(const char*checkpointName){
 bool Parameters::hasCheckpoint(const char*checkpointName){
 	//cout<<"hasCheckpoint? "<<checkpointName<<endl;
 
+	if(isSequenceCheckpoint(checkpointName))
+		return hasFile(getCheckpointFile(checkpointName).c_str());
+
 	if(!readCheckpoints())
 		return false;
 
+	/* the other checkpoints do not include the new reads */
+	if(isIncrementalAssembly() && strcmp(checkpointName,"GenomeGraph")!=0)
+		return false;
+
 	return hasFile(getCheckpointFile(checkpointName).c_str());
 }
 
@@ -2212,6 +2390,13 @@ bool Parameters::writeCheckpoints(){
 	return false;
 }
 
+bool Parameters::writeCheckpoint(const char*checkpointName){
+	if(isSequenceCheckpoint(checkpointName))
+		return true;
+
+	return writeCheckpoints();
+}
+
 bool Parameters::readCheckpoints(){
 	if(hasOption("-read-checkpoints"))
 		return true;
@@ -2220,6 +2405,43 @@ bool Parameters::readCheckpoints(){
 	return false;
 }
 
+bool Parameters::isIncrementalAssembly(){
+	if(!hasConfigurationOption("-incremental-assembly",1))
+		return false;
+
+	if(!readCheckpoints())
+		return false;
+
+	/* without a graph, everything is assembled from scratch */
+	return hasFile(getCheckpointFile("GenomeGraph").c_str());
+}
+
+LargeIndex Parameters::getFirstNewSequence(){
+	if(!isIncrementalAssembly())
+		return 0;
+
+	int filesInCheckpoint=getConfigurationInteger("-incremental-assembly",0);
+
+	LargeCount sequences=0;
+	LargeCount sequencesInCheckpoint=0;
+
+	for(int i=0;i<getNumberOfFiles();i++){
+		sequences+=getNumberOfSequences(i);
+
+		if(i<filesInCheckpoint)
+			sequencesInCheckpoint+=getNumberOfSequences(i);
+	}
+
+	/* this is the partition of SequencesLoader */
+	LargeCount sequencesPerRank=sequences/getSize();
+	LargeIndex startingSequenceId=getRank()*sequencesPerRank;
+
+	if(sequencesInCheckpoint<=startingSequenceId)
+		return 0;
+
+	return sequencesInCheckpoint-startingSequenceId;
+}
+
 bool Parameters::showCommunicationEvents(){
 	return m_showCommunicationEvents;
 }
@@ -2319,6 +2541,45 @@ double Parameters::getLoadFactorThreshold(){
 	return loadFactorThreshold;
 }
 
+int Parameters::getNumberOfThreadsPerRank(){
+
+	int threads=1;
+
+	if(hasConfigurationOption("-threads-per-rank",1))
+		threads=getConfigurationInteger("-threads-per-rank",0);
+
+	if(threads<1)
+		threads=1;
+
+	return threads;
+}
+
+int Parameters::getNumberOfHashTableShards(){
+
+	int shards=__DEFAULT_HASH_TABLE_SHARDS;
+
+	if(hasConfigurationOption("-hash-table-shards",1))
+		shards=getConfigurationInteger("-hash-table-shards",0);
+
+	/* the shard is selected with bits of the hash */
+	int powerOfTwo=1;
+
+	while(powerOfTwo<shards)
+		powerOfTwo*=2;
+
+	return powerOfTwo;
+}
+
+uint64_t Parameters::getReadCacheMemory(){
+
+	uint64_t megabytes=__DEFAULT_READ_CACHE_MEGABYTES;
+
+	if(hasConfigurationOption("-read-cache-memory",1))
+		megabytes=getConfigurationInteger("-read-cache-memory",0);
+
+	return megabytes*1024*1024;
+}
+
 bool Parameters::hasConfigurationOption(const char*string,int count){
 	for(int i=0;i<(int)m_commands.size();i++){
 		if(strcmp(m_commands[i].c_str(),string)==0){
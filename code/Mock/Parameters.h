@@ -55,6 +55,20 @@ using namespace std;
  */
 #define __DEFAULT_BUCKETS_PER_GROUP 64
 
+/**
+ * The number of shards of the GridTable. It does not depend
+ * on -threads-per-rank so that the order of the vertices is the
+ * same for any number of threads. With one shard, the table and the
+ * order of its vertices are the same as before the shards.
+ */
+#define __DEFAULT_HASH_TABLE_SHARDS 1
+
+/**
+ * The memory (in MiB) for the reads fetched
+ * from other ranks during the seed extension.
+ */
+#define __DEFAULT_READ_CACHE_MEGABYTES 64
+
 /**
  * This class is the implementation of an interpreter for the RayInputFile.
  * It allows the following commands:
@@ -142,6 +156,7 @@ class Parameters{
 	void loadCommandsFromArguments(int argc,char**argv);
 	void loadCommandsFromFile(char*file);
 	void parseCommands();
+	int getValidWordSize(int wordSize);
 
 	string getLibraryFile(int library);
 	void showOption(string a,string b);
@@ -158,6 +173,12 @@ class Parameters{
 	string m_checkpointDirectory;
 	bool m_hasCheckpointDirectory;
 
+	/** shared directory for the checkpoints that do not depend on -k */
+	string m_sequenceCheckpointDirectory;
+	bool m_hasSequenceCheckpointDirectory;
+
+	bool isSequenceCheckpoint(const char*checkpointName);
+
 	void __shuffleOperationCodes();
 
 	bool isValidInteger(const char*textMessage);
@@ -170,6 +191,10 @@ public:
 	Parameters();
 	string getReceivedMessagesFile();
 	void constructor(int argc,char**argv,Rank rank,int size,int miniRanksPerRank);
+
+	/** loads the commands without parsing them */
+	void loadCommands(int argc,char**argv);
+	int getRequestedWordSize();
 	bool isInitiated();
 	vector<string> getAllFiles();
 	string getDirectory();
@@ -241,6 +266,8 @@ public:
 	void setRepeatCoverage(CoverageDepth a);
 	bool showMemoryAllocations();
 	bool writeKmers();
+	/** binary graph export, one file per rank (-write-graph) */
+	bool writeGraph();
 	CoverageDepth getMinimumCoverageToStore();
 
 	int getLibraryMaxAverageLength(int i);
@@ -259,6 +286,15 @@ public:
 	bool writeCheckpoints();
 	bool readCheckpoints();
 
+	/** true if this checkpoint is written, see -sequence-checkpoints */
+	bool writeCheckpoint(const char*checkpointName);
+
+	/** true if the reads of the new files are added to the GenomeGraph checkpoint */
+	bool isIncrementalAssembly();
+
+	/** local index of the first read that is not in the GenomeGraph checkpoint */
+	LargeIndex getFirstNewSequence();
+
 	void writeCommandFile();
 	bool showCommunicationEvents();
 	bool showReadPlacement();
@@ -282,6 +318,15 @@ public:
 	int getNumberOfBucketsPerGroup();
 	double getLoadFactorThreshold();
 
+	/** threads used to extract k-mers from the local reads, see -threads-per-rank */
+	int getNumberOfThreadsPerRank();
+
+	/** hash tables in the GridTable, see -hash-table-shards */
+	int getNumberOfHashTableShards();
+
+	/** bytes for the reads fetched by the seed extender, see -read-cache-memory */
+	uint64_t getReadCacheMemory();
+
 
 	uint64_t getConfigurationInteger(const char*string,int offset);
 	double getConfigurationDouble(const char*string,int offset);
@@ -35,6 +35,8 @@
 #include <string>
 #include <cstring>
 #include <sstream>
+#include <unistd.h>
+#include <errno.h>
 
 using namespace std;
 
@@ -323,3 +325,51 @@ bool flushFileOperationBuffer_FILE(bool force,ostringstream*buffer,FILE*file,int
 	return false;
 }
 
+bool flushFileOperationBuffer_pwrite(bool force,ostringstream*buffer,int file,uint64_t*offset,int bufferSize,bool*failed){
+
+	int available=buffer->tellp();
+
+	if(available==0)
+		return false;
+
+	if(force || available>=bufferSize){
+
+		string copy=buffer->str();
+		const char*data=copy.c_str();
+		size_t bytes=copy.length();
+		size_t written=0;
+
+/*
+ * pwrite may write fewer bytes than requested.
+ */
+		while(written<bytes){
+			ssize_t returnValue=pwrite(file,data+written,bytes-written,*offset+written);
+
+			if(returnValue<0 && errno==EINTR)
+				continue;
+
+/*
+ * A return value of 0 means that nothing was written, retrying would never end.
+ */
+			if(returnValue<=0){
+				cout<<"Error: could not write to file with pwrite at offset "<<*offset+written<<endl;
+				(*failed)=true;
+				break;
+			}
+
+			written+=returnValue;
+		}
+
+/*
+ * The offset advances by the whole buffer even if a write failed,
+ * otherwise the next writes would land in the range of the failed one.
+ */
+		(*offset)+=bytes;
+
+		buffer->str("");
+
+		return true;
+	}
+
+	return false;
+}
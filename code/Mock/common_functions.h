@@ -95,6 +95,14 @@ void unpack_pointer(void**pointer,MessageUnit integerValue);
 bool flushFileOperationBuffer(bool force,ostringstream*buffer,ostream*file,int bufferSize);
 bool flushFileOperationBuffer_FILE(bool force,ostringstream*buffer,FILE*file,int bufferSize);
 
+/*
+ * Write the buffer at a given offset with pwrite(2) and advance the offset.
+ * Several processes can write disjoint ranges of the same file concurrently.
+ * On a write error, failed is set to true and the offset still advances
+ * by the size of the buffer.
+ */
+bool flushFileOperationBuffer_pwrite(bool force,ostringstream*buffer,int file,uint64_t*offset,int bufferSize,bool*failed);
+
 #ifdef CONFIG_MPI_IO
 bool flushFileOperationBuffer_MPI_IO(bool force,ostringstream*buffer,MPI_File file,int bufferSize);
 #endif
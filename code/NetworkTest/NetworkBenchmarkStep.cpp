@@ -0,0 +1,191 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "NetworkBenchmarkStep.h"
+
+#include <RayPlatform/communication/Message.h>
+
+#include <algorithm>
+#include <assert.h>
+using namespace std;
+
+void NetworkBenchmarkStep::constructor(const char*name,int numberOfWords,int numberOfMessages,
+		int maximumOutstandingMessages,int destinationPattern){
+
+	m_name=name;
+	m_numberOfWords=numberOfWords;
+	m_numberOfMessages=numberOfMessages;
+	m_maximumOutstandingMessages=maximumOutstandingMessages;
+	m_destinationPattern=destinationPattern;
+
+	if(m_maximumOutstandingMessages<1)
+		m_maximumOutstandingMessages=1;
+
+	m_sentMessages=0;
+	m_receivedReplies=0;
+	m_startingTime=0;
+	m_endingTime=0;
+}
+
+const char*NetworkBenchmarkStep::getName(){
+	return m_name.c_str();
+}
+
+const char*NetworkBenchmarkStep::getDestinationPatternName(){
+	if(m_destinationPattern==NETWORK_BENCHMARK_DESTINATION_PEER)
+		return "peer";
+	else if(m_destinationPattern==NETWORK_BENCHMARK_DESTINATION_ALL_TO_ALL)
+		return "all-to-all";
+
+	return "random";
+}
+
+int NetworkBenchmarkStep::getNumberOfWords(){
+	return m_numberOfWords;
+}
+
+int NetworkBenchmarkStep::getDestinationPattern(){
+	return m_destinationPattern;
+}
+
+bool NetworkBenchmarkStep::hasStarted(){
+	return m_startingTime!=0;
+}
+
+bool NetworkBenchmarkStep::isDone(){
+	return m_receivedReplies==m_numberOfMessages;
+}
+
+bool NetworkBenchmarkStep::canSendMessage(){
+	return m_sentMessages<m_numberOfMessages
+		&& getOutstandingMessages()<m_maximumOutstandingMessages;
+}
+
+int NetworkBenchmarkStep::getOutstandingMessages(){
+	return m_sentMessages-m_receivedReplies;
+}
+
+int NetworkBenchmarkStep::getSentMessages(){
+	return m_sentMessages;
+}
+
+void NetworkBenchmarkStep::start(uint64_t time){
+	m_startingTime=time;
+	m_endingTime=time;
+	m_latencies.reserve(m_numberOfMessages);
+}
+
+void NetworkBenchmarkStep::addSentMessage(){
+	m_sentMessages++;
+}
+
+void NetworkBenchmarkStep::addReply(uint64_t latency,uint64_t time){
+	#ifdef CONFIG_ASSERT
+	assert(m_receivedReplies<m_sentMessages);
+	#endif
+
+	m_latencies.push_back(latency);
+	m_receivedReplies++;
+	m_endingTime=time;
+}
+
+uint64_t NetworkBenchmarkStep::getElapsedMicroseconds(){
+	return m_endingTime-m_startingTime;
+}
+
+double NetworkBenchmarkStep::getBandwidth(){
+	uint64_t elapsed=getElapsedMicroseconds();
+
+	if(elapsed==0)
+		return 0;
+
+	double bytes=1.0*m_receivedReplies*m_numberOfWords*sizeof(MessageUnit);
+
+	return bytes/elapsed*1000000;
+}
+
+double NetworkBenchmarkStep::getMessageRate(){
+	uint64_t elapsed=getElapsedMicroseconds();
+
+	if(elapsed==0)
+		return 0;
+
+	return 1.0*m_receivedReplies/elapsed*1000000;
+}
+
+uint64_t NetworkBenchmarkStep::getPercentile(vector<uint64_t>*sortedLatencies,int percentile){
+	if(sortedLatencies->size()==0)
+		return 0;
+
+	int position=(sortedLatencies->size()-1)*percentile/100;
+
+	return sortedLatencies->at(position);
+}
+
+uint64_t NetworkBenchmarkStep::getAverageLatency(){
+	if(m_latencies.size()==0)
+		return 0;
+
+	uint64_t sum=0;
+	for(int i=0;i<(int)m_latencies.size();i++)
+		sum+=m_latencies[i];
+
+	return sum/m_latencies.size();
+}
+
+void NetworkBenchmarkStep::writeCSVHeader(ostream*stream){
+	(*stream)<<"Rank,Step,DestinationPattern,MessageSizeInBytes,Messages,MaximumOutstandingMessages";
+	(*stream)<<",ElapsedMicroseconds,MinimumLatency,AverageLatency,MedianLatency,Percentile99Latency,MaximumLatency";
+	(*stream)<<",MessagesPerSecond,BytesPerSecond"<<endl;
+}
+
+void NetworkBenchmarkStep::writeCSV(ostream*stream,Rank rank){
+	vector<uint64_t> sortedLatencies=m_latencies;
+	sort(sortedLatencies.begin(),sortedLatencies.end());
+
+	uint64_t average=getAverageLatency();
+
+	(*stream)<<rank<<","<<m_name<<","<<getDestinationPatternName();
+	(*stream)<<","<<m_numberOfWords*sizeof(MessageUnit)<<","<<m_receivedReplies<<","<<m_maximumOutstandingMessages;
+	(*stream)<<","<<getElapsedMicroseconds()<<","<<getPercentile(&sortedLatencies,0)<<","<<average;
+	(*stream)<<","<<getPercentile(&sortedLatencies,50)<<","<<getPercentile(&sortedLatencies,99);
+	(*stream)<<","<<getPercentile(&sortedLatencies,100);
+	(*stream)<<","<<(uint64_t)getMessageRate()<<","<<(uint64_t)getBandwidth()<<endl;
+}
+
+void NetworkBenchmarkStep::writeJSON(ostream*stream){
+	vector<uint64_t> sortedLatencies=m_latencies;
+	sort(sortedLatencies.begin(),sortedLatencies.end());
+
+	uint64_t average=getAverageLatency();
+
+	(*stream)<<"{ \"step\": \""<<m_name<<"\", \"destinations\": \""<<getDestinationPatternName()<<"\"";
+	(*stream)<<", \"messageSizeInBytes\": "<<m_numberOfWords*sizeof(MessageUnit);
+	(*stream)<<", \"messages\": "<<m_receivedReplies;
+	(*stream)<<", \"maximumOutstandingMessages\": "<<m_maximumOutstandingMessages;
+	(*stream)<<", \"elapsedMicroseconds\": "<<getElapsedMicroseconds();
+	(*stream)<<", \"latencyMicroseconds\": { \"minimum\": "<<getPercentile(&sortedLatencies,0);
+	(*stream)<<", \"average\": "<<average;
+	(*stream)<<", \"median\": "<<getPercentile(&sortedLatencies,50);
+	(*stream)<<", \"percentile99\": "<<getPercentile(&sortedLatencies,99);
+	(*stream)<<", \"maximum\": "<<getPercentile(&sortedLatencies,100)<<" }";
+	(*stream)<<", \"messagesPerSecond\": "<<(uint64_t)getMessageRate();
+	(*stream)<<", \"bytesPerSecond\": "<<(uint64_t)getBandwidth()<<" }";
+}
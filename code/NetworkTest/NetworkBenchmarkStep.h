@@ -0,0 +1,101 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _NetworkBenchmarkStep_H
+#define _NetworkBenchmarkStep_H
+
+#include <RayPlatform/core/types.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+#define NETWORK_BENCHMARK_DESTINATION_RANDOM 0
+#define NETWORK_BENCHMARK_DESTINATION_PEER 1
+#define NETWORK_BENCHMARK_DESTINATION_ALL_TO_ALL 2
+
+/**
+ * One step of the network benchmark suite.
+ *
+ * A step sends a fixed number of messages of a fixed size with at most
+ * a given number of messages in flight and records the round trip of each
+ * message. Every rank executes the same steps and all ranks synchronize
+ * between steps so that a step measures only its own traffic pattern.
+ *
+ * \author agent
+ */
+class NetworkBenchmarkStep{
+
+	string m_name;
+	int m_numberOfWords;
+	int m_numberOfMessages;
+	int m_maximumOutstandingMessages;
+	int m_destinationPattern;
+
+	int m_sentMessages;
+	int m_receivedReplies;
+
+	uint64_t m_startingTime;
+	uint64_t m_endingTime;
+
+	vector<uint64_t> m_latencies;
+
+	uint64_t getPercentile(vector<uint64_t>*sortedLatencies,int percentile);
+	uint64_t getAverageLatency();
+
+public:
+
+	void constructor(const char*name,int numberOfWords,int numberOfMessages,
+		int maximumOutstandingMessages,int destinationPattern);
+
+	const char*getName();
+	const char*getDestinationPatternName();
+	int getNumberOfWords();
+	int getDestinationPattern();
+
+	bool hasStarted();
+	bool isDone();
+
+	/** returns true if a new message can be put in flight now */
+	bool canSendMessage();
+
+	/** returns the number of messages in flight */
+	int getOutstandingMessages();
+	int getSentMessages();
+
+	void start(uint64_t time);
+	void addSentMessage();
+	void addReply(uint64_t latency,uint64_t time);
+
+	uint64_t getElapsedMicroseconds();
+
+	/** bytes sent per second */
+	double getBandwidth();
+
+	/** messages completed per second */
+	double getMessageRate();
+
+	static void writeCSVHeader(ostream*stream);
+	void writeCSV(ostream*stream,Rank rank);
+	void writeJSON(ostream*stream);
+};
+
+#endif
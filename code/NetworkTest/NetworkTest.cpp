@@ -42,10 +42,15 @@ __CreatePlugin(NetworkTest);
 __CreateMasterModeAdapter(NetworkTest,RAY_MASTER_MODE_TEST_NETWORK);
 __CreateSlaveModeAdapter(NetworkTest,RAY_SLAVE_MODE_TEST_NETWORK);
 __CreateMessageTagAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_MESSAGE);
+__CreateMessageTagAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE);
+__CreateMessageTagAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE);
 
 #define LATENCY_INFORMATION_NOT_AVAILABLE 123123123
 #define __MAXIMUM_LATENCY 4096 // microseconds
 
+/* keep the outbox and the outbox ring allocator within their capacity */
+#define __BENCHMARK_MESSAGES_PER_TICK 8
+
 /** initialize the NetworkTest */
 void NetworkTest::constructor(int rank,int size,StaticVector*inbox,StaticVector*outbox,Parameters*parameters,RingAllocator*outboxAllocator,
 	string*name,TimePrinter*timePrinter){
@@ -94,6 +99,99 @@ void NetworkTest::constructor(int rank,int size,StaticVector*inbox,StaticVector*
 	m_sentMicroseconds.reserve(m_numberOfTestMessages);
 	m_destinations.reserve(m_numberOfTestMessages);
 	m_receivedMicroseconds.reserve(m_numberOfTestMessages);
+
+	configureBenchmark();
+}
+
+/**
+ * The steps are the same on every rank because all the ranks
+ * synchronize with the master after each step.
+ */
+void NetworkTest::configureBenchmark(){
+
+	m_runBenchmark=m_parameters->hasOption("-network-benchmark");
+	m_benchmarkIsRunning=false;
+	m_waitingForBenchmarkStep=false;
+	m_currentBenchmarkStep=0;
+	m_ranksDoneWithBenchmarkStep=0;
+	m_nextBenchmarkDestination=0;
+
+	if(!m_runBenchmark)
+		return;
+
+	int messages=256;
+
+	if(m_parameters->hasConfigurationOption("-network-benchmark-messages",1))
+		messages=m_parameters->getConfigurationInteger("-network-benchmark-messages",0);
+
+	int maximumDepth=64;
+
+	if(m_parameters->hasConfigurationOption("-network-benchmark-depth",1))
+		maximumDepth=m_parameters->getConfigurationInteger("-network-benchmark-depth",0);
+
+	if(messages<1)
+		messages=1;
+	if(maximumDepth<1)
+		maximumDepth=1;
+
+	int maximumWords=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
+
+	NetworkBenchmarkStep step;
+
+	/* message size sweep, one message in flight */
+	int words=1;
+
+	while(1){
+		step.constructor("size-sweep",words,messages,1,NETWORK_BENCHMARK_DESTINATION_RANDOM);
+		m_benchmarkSteps.push_back(step);
+
+		if(words==maximumWords)
+			break;
+
+		words*=2;
+
+		if(words>maximumWords)
+			words=maximumWords;
+	}
+
+	/* stream full messages to a single peer */
+	step.constructor("bandwidth",maximumWords,4*messages,maximumDepth,NETWORK_BENCHMARK_DESTINATION_PEER);
+	m_benchmarkSteps.push_back(step);
+
+	/*
+	 * full messages to every rank in turn with one message in flight
+	 * per destination, like the buffered k-mers of the graph building
+	 */
+	int rounds=messages/m_size;
+	if(rounds<1)
+		rounds=1;
+
+	step.constructor("all-to-all-burst",maximumWords,rounds*m_size,m_size,NETWORK_BENCHMARK_DESTINATION_ALL_TO_ALL);
+	m_benchmarkSteps.push_back(step);
+
+	/* small queries with an increasing number of messages in flight */
+	int smallWords=4;
+	if(smallWords>maximumWords)
+		smallWords=maximumWords;
+
+	int depth=1;
+
+	while(1){
+		int stepMessages=messages;
+		if(stepMessages<4*depth)
+			stepMessages=4*depth;
+
+		step.constructor("outstanding-messages",smallWords,stepMessages,depth,NETWORK_BENCHMARK_DESTINATION_RANDOM);
+		m_benchmarkSteps.push_back(step);
+
+		if(depth==maximumDepth)
+			break;
+
+		depth*=4;
+
+		if(depth>maximumDepth)
+			depth=maximumDepth;
+	}
 }
 
 /** call the slave method 
@@ -119,6 +217,7 @@ void NetworkTest::constructor(int rank,int size,StaticVector*inbox,StaticVector*
  *
  * */
 void NetworkTest::call_RAY_SLAVE_MODE_TEST_NETWORK(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_TEST_NETWORK);
 
 	if(!m_started){
 
@@ -229,8 +328,162 @@ void NetworkTest::call_RAY_SLAVE_MODE_TEST_NETWORK(){
 		// otherwise, the measured latency would be higher...
 		writeData();
 
+		if(m_runBenchmark)
+			m_benchmarkIsRunning=true;
+		else
+			m_switchMan->closeSlaveModeLocally(m_outbox,m_parameters->getRank());
+
+	}else if(m_benchmarkIsRunning){
+		runBenchmark();
+	}
+}
+
+/**
+ * Run the current step of the benchmark suite.
+ *
+ * Every test message carries its sending time in its first word
+ * and the reply echoes it, so replies need not be matched with
+ * queries when many messages are in flight.
+ */
+void NetworkTest::runBenchmark(){
+
+	if(m_currentBenchmarkStep==(int)m_benchmarkSteps.size()){
+		writeBenchmarkData();
+
+		m_benchmarkIsRunning=false;
+
 		m_switchMan->closeSlaveModeLocally(m_outbox,m_parameters->getRank());
+		return;
+	}
+
+	if(m_waitingForBenchmarkStep){
+		if(m_inbox->hasMessage(RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP)){
+			m_waitingForBenchmarkStep=false;
+			m_currentBenchmarkStep++;
+		}
+
+		return;
+	}
+
+	NetworkBenchmarkStep*step=&(m_benchmarkSteps[m_currentBenchmarkStep]);
+
+	if(!step->hasStarted()){
+		if(m_rank==MASTER_RANK){
+			cout<<"Rank "<<m_rank<<" is running network benchmark step "<<m_currentBenchmarkStep+1;
+			cout<<"/"<<m_benchmarkSteps.size()<<": "<<step->getName()<<" ("<<step->getDestinationPatternName()<<", ";
+			cout<<step->getNumberOfWords()*sizeof(MessageUnit)<<" bytes)"<<endl;
+		}
+
+		m_nextBenchmarkDestination=(m_rank+1)%m_size;
+		step->start(getMicroseconds());
 	}
+
+	LargeCount now=getMicroseconds();
+
+	for(int i=0;i<(int)m_inbox->size();i++){
+		Message*message=m_inbox->at(i);
+
+		if(message->getTag()!=RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY)
+			continue;
+
+		LargeCount sendingTime=message->getBuffer()[0];
+
+		step->addReply(now-sendingTime,now);
+	}
+
+	int sentMessages=0;
+
+	while(sentMessages<__BENCHMARK_MESSAGES_PER_TICK && step->canSendMessage()){
+
+		Rank destination=getBenchmarkDestination(step);
+		int numberOfWords=step->getNumberOfWords();
+
+		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(numberOfWords*sizeof(MessageUnit));
+		message[0]=getMicroseconds();
+
+		Message aMessage(message,numberOfWords,destination,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE,m_rank);
+		m_outbox->push_back(&aMessage);
+
+		step->addSentMessage();
+		sentMessages++;
+	}
+
+	if(step->isDone()){
+		m_waitingForBenchmarkStep=true;
+
+		m_switchMan->sendEmptyMessage(m_outbox,m_rank,MASTER_RANK,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE);
+	}
+}
+
+Rank NetworkTest::getBenchmarkDestination(NetworkBenchmarkStep*step){
+
+	if(step->getDestinationPattern()==NETWORK_BENCHMARK_DESTINATION_PEER)
+		return (m_rank+1)%m_size;
+
+	if(step->getDestinationPattern()==NETWORK_BENCHMARK_DESTINATION_ALL_TO_ALL){
+		Rank destination=m_nextBenchmarkDestination;
+		m_nextBenchmarkDestination=(m_nextBenchmarkDestination+1)%m_size;
+		return destination;
+	}
+
+	return rand()%m_size;
+}
+
+void NetworkTest::writeBenchmarkData(){
+
+	ostringstream file;
+	file<<m_parameters->getPrefix();
+	file<<"Rank"<<m_parameters->getRank()<<".NetworkBenchmark.csv";
+
+	ofstream f(file.str().c_str());
+
+	NetworkBenchmarkStep::writeCSVHeader(&f);
+
+	for(int i=0;i<(int)m_benchmarkSteps.size();i++)
+		m_benchmarkSteps[i].writeCSV(&f,m_rank);
+
+	f.close();
+
+	ostringstream file2;
+	file2<<m_parameters->getPrefix();
+	file2<<"Rank"<<m_parameters->getRank()<<".NetworkBenchmark.json";
+
+	ofstream f2(file2.str().c_str());
+
+	bool routing=m_parameters->hasOption("-route-messages");
+
+	f2<<"{"<<endl;
+	f2<<"  \"rank\": "<<m_rank<<","<<endl;
+	f2<<"  \"ranks\": "<<m_size<<","<<endl;
+	f2<<"  \"processorName\": \""<<*m_name<<"\","<<endl;
+	f2<<"  \"routeMessages\": "<<(routing?"true":"false")<<","<<endl;
+
+	if(routing){
+		f2<<"  \"connectionType\": \""<<m_parameters->getConnectionType()<<"\","<<endl;
+		f2<<"  \"routingGraphDegree\": "<<m_parameters->getRoutingDegree()<<","<<endl;
+	}
+
+	f2<<"  \"maximumMessageSizeInBytes\": "<<MAXIMUM_MESSAGE_SIZE_IN_BYTES<<","<<endl;
+	f2<<"  \"messagesPerTick\": "<<__BENCHMARK_MESSAGES_PER_TICK<<","<<endl;
+	f2<<"  \"steps\": ["<<endl;
+
+	for(int i=0;i<(int)m_benchmarkSteps.size();i++){
+		f2<<"    ";
+		m_benchmarkSteps[i].writeJSON(&f2);
+
+		if(i!=(int)m_benchmarkSteps.size()-1)
+			f2<<",";
+		f2<<endl;
+	}
+
+	f2<<"  ]"<<endl;
+	f2<<"}"<<endl;
+
+	f2.close();
+
+	cout<<"Rank "<<m_rank<<" wrote "<<file.str()<<" and "<<file2.str()<<" (-network-benchmark)"<<endl;
+
+	m_benchmarkSteps.clear();
 }
 
 void NetworkTest::writeData(){
@@ -374,6 +627,7 @@ void NetworkTest::call_RAY_MASTER_MODE_TEST_NETWORK (){
 		cout<<"Rank "<<m_parameters->getRank()<<" wrote "<<file.str()<<endl;
 		cout<<endl;
 		m_timePrinter->printElapsedTime("Network testing");
+		m_instrumentation->endPhase("Network testing");
 		cout<<endl;
 
 		if(m_parameters->hasOption("-test-network-only")){
@@ -454,6 +708,28 @@ void NetworkTest::call_RAY_MPI_TAG_TEST_NETWORK_MESSAGE(Message*message){
 	#endif
 }
 
+/* we reply with the sending time of the query */
+void NetworkTest::call_RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE(Message*message){
+
+	MessageUnit*reply=(MessageUnit*)m_outboxAllocator->allocate(sizeof(MessageUnit));
+	reply[0]=message->getBuffer()[0];
+
+	Message aMessage(reply,1,message->getSource(),RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY,m_rank);
+	m_outbox->push_back(&aMessage);
+}
+
+/* the master releases all the ranks when the step is done everywhere */
+void NetworkTest::call_RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE(Message*message){
+
+	m_ranksDoneWithBenchmarkStep++;
+
+	if(m_ranksDoneWithBenchmarkStep==m_size){
+		m_ranksDoneWithBenchmarkStep=0;
+
+		m_switchMan->sendToAll(m_outbox,m_rank,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP);
+	}
+}
+
 void NetworkTest::registerPlugin(ComputeCore*core){
 
 	PluginHandle plugin = core->allocatePluginHandle();
@@ -491,9 +767,25 @@ void NetworkTest::registerPlugin(ComputeCore*core){
 	RAY_MPI_TAG_TEST_NETWORK_WRITE_DATA=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_TEST_NETWORK_WRITE_DATA,"RAY_MPI_TAG_TEST_NETWORK_WRITE_DATA");
 
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE, __GetAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE");
+
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY");
+
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE, __GetAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE");
+
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP");
+
 }
 
 void NetworkTest::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_TEST_NETWORK=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_TEST_NETWORK");
 
 	RAY_MASTER_MODE_COUNT_FILE_ENTRIES=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_COUNT_FILE_ENTRIES");
@@ -505,6 +797,10 @@ void NetworkTest::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_TEST_NETWORK_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK_REPLY");
 	RAY_MPI_TAG_TEST_NETWORK_REPLY_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK_REPLY_REPLY");
 	RAY_MPI_TAG_TEST_NETWORK_WRITE_DATA=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK_WRITE_DATA");
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE");
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY");
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE");
+	RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP");
 
 	RAY_MPI_TAG_TEST_NETWORK=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_TEST_NETWORK");
 
@@ -522,6 +818,8 @@ void NetworkTest::resolveSymbols(ComputeCore*core){
 
 	__BindAdapter(NetworkTest,RAY_MASTER_MODE_TEST_NETWORK);
 	__BindAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_MESSAGE);
+	__BindAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE);
+	__BindAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE);
 	__BindAdapter(NetworkTest,RAY_SLAVE_MODE_TEST_NETWORK);
 }
 
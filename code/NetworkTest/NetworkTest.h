@@ -21,7 +21,10 @@
 #ifndef _NetworkTest_H
 #define _NetworkTest_H
 
+#include "NetworkBenchmarkStep.h"
+
 #include <code/Mock/Parameters.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/structures/StaticVector.h>
 #include <RayPlatform/profiling/TimePrinter.h>
@@ -32,6 +35,7 @@
 #include <RayPlatform/core/ComputeCore.h>
 
 #include <string>
+#include <vector>
 #include <map>
 using namespace std;
 
@@ -40,6 +44,8 @@ __DeclarePlugin(NetworkTest);
 __DeclareMasterModeAdapter(NetworkTest,RAY_MASTER_MODE_TEST_NETWORK);
 __DeclareSlaveModeAdapter(NetworkTest,RAY_SLAVE_MODE_TEST_NETWORK);
 __DeclareMessageTagAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_MESSAGE);
+__DeclareMessageTagAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE);
+__DeclareMessageTagAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE);
 
 /**
  * This class tests the network
@@ -47,6 +53,15 @@ __DeclareMessageTagAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_MESSAGE);
  *
  *     - latency to get a response for a message
  *
+ *     With -network-benchmark, a suite runs after the latency test:
+ *
+ *          - message size sweep (one message in flight)
+ *          - bandwidth to a single peer
+ *          - all-to-all burst with full messages, like the graph building
+ *          - increasing numbers of outstanding messages
+ *
+ *     Each rank writes its results in CSV and JSON.
+ *
  *     Dependencies from the Ray software stack (mostly):
  *
  *          - message inbox
@@ -60,6 +75,8 @@ class NetworkTest :  public CorePlugin {
 	__AddAdapter(NetworkTest,RAY_MASTER_MODE_TEST_NETWORK);
 	__AddAdapter(NetworkTest,RAY_SLAVE_MODE_TEST_NETWORK);
 	__AddAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_MESSAGE);
+	__AddAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE);
+	__AddAdapter(NetworkTest,RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE);
 
 	MessageTag RAY_MPI_TAG_TEST_NETWORK;
 	MessageTag RAY_MPI_TAG_TEST_NETWORK_MESSAGE;
@@ -67,6 +84,10 @@ class NetworkTest :  public CorePlugin {
 	MessageTag RAY_MPI_TAG_TEST_NETWORK_REPLY;
 	MessageTag RAY_MPI_TAG_TEST_NETWORK_REPLY_REPLY;
 	MessageTag RAY_MPI_TAG_TEST_NETWORK_WRITE_DATA;
+	MessageTag RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE;
+	MessageTag RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE_REPLY;
+	MessageTag RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE;
+	MessageTag RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_NEXT_STEP;
 
 	MasterMode RAY_MASTER_MODE_KILL_ALL_MPI_RANKS;
 	MasterMode RAY_MASTER_MODE_TEST_NETWORK;
@@ -102,6 +123,7 @@ class NetworkTest :  public CorePlugin {
 	int m_numberOfWords;
 
 	TimePrinter*m_timePrinter;
+	Instrumentation*m_instrumentation;
 	/** the message inbox */
 	StaticVector*m_inbox;
 	/** the message outbox */
@@ -143,8 +165,26 @@ class NetworkTest :  public CorePlugin {
 	/* processor name */
 	string*m_name;
 
+	/** run the benchmark suite after the latency test ? */
+	bool m_runBenchmark;
+	bool m_benchmarkIsRunning;
+	/** the steps of the benchmark suite, the same on every rank */
+	vector<NetworkBenchmarkStep> m_benchmarkSteps;
+	int m_currentBenchmarkStep;
+	/** waiting for the other ranks to finish the current step */
+	bool m_waitingForBenchmarkStep;
+	/** next destination for the all-to-all pattern */
+	Rank m_nextBenchmarkDestination;
+	/** number of ranks that finished the current step, master only */
+	int m_ranksDoneWithBenchmarkStep;
+
 	int getModeLatency();
 	int getAverageLatency();
+
+	void configureBenchmark();
+	void runBenchmark();
+	Rank getBenchmarkDestination(NetworkBenchmarkStep*step);
+	void writeBenchmarkData();
 public:
 	/** initialize the NetworkTest */
 	void constructor(Rank rank,int size,StaticVector*inbox,StaticVector*outbox,Parameters*parameters,RingAllocator*outboxAllocator,
@@ -154,6 +194,8 @@ public:
 	void call_RAY_MASTER_MODE_TEST_NETWORK ();
 
 	void call_RAY_MPI_TAG_TEST_NETWORK_MESSAGE(Message*message);
+	void call_RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_MESSAGE(Message*message);
+	void call_RAY_MPI_TAG_TEST_NETWORK_BENCHMARK_STEP_DONE(Message*message);
 
 	/** work method for the slave mode */
 	void call_RAY_SLAVE_MODE_TEST_NETWORK();
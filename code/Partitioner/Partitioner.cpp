@@ -23,7 +23,17 @@
 
 #include <RayPlatform/core/OperatingSystem.h>
 
+#include <sys/stat.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <fstream>
+
+#ifdef CONFIG_HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+/* bytes read at once when counting the lines of a file */
+#define PARTITIONER_COUNTING_BUFFER_SIZE 4194304
 
 __CreatePlugin(Partitioner);
 
@@ -64,15 +74,19 @@ void Partitioner::call_RAY_MASTER_MODE_COUNT_FILE_ENTRIES(){
 				m_outbox->push_back(&aMessage);
 			}
 		}
-	/** a peer send the count for one file */
+	/** a peer send the counts for some files, as pairs <file, count> */
 	}else if(m_inbox->size()>0 && m_inbox->at(0)->getTag()== RAY_MPI_TAG_FILE_ENTRY_COUNT){
 		MessageUnit*buffer=m_inbox->at(0)->getBuffer();
-		int file=buffer[0];
-		LargeCount count=buffer[1];
-		m_masterCounts[file]=count;
+		int elements=m_inbox->at(0)->getCount();
 
-		if(m_parameters->hasOption("-debug-partitioner"))
-			cout<<"Rank "<<m_parameters->getRank()<<" received from "<<m_inbox->at(0)->getSource()<<" File "<<file<<" Entries "<<count<<endl;
+		for(int i=0;i<elements;i+=2){
+			int file=buffer[i];
+			LargeCount count=buffer[i+1];
+			m_masterCounts[file]=count;
+
+			if(m_parameters->hasOption("-debug-partitioner"))
+				cout<<"Rank "<<m_parameters->getRank()<<" received from "<<m_inbox->at(0)->getSource()<<" File "<<file<<" Entries "<<count<<endl;
+		}
 		/** reply to the peer */
 		Message aMessage(NULL,0,m_inbox->at(0)->getSource(),RAY_MPI_TAG_FILE_ENTRY_COUNT_REPLY,m_parameters->getRank());
 		m_outbox->push_back(&aMessage);
@@ -235,7 +249,178 @@ bool Partitioner::checkIfPairedFilesAreValid() {
 	return true;
 }
 
+/**
+ * Gets the number of entries of a file from its index file (file.fai),
+ * written by samtools faidx or samtools fqidx. The index has one line
+ * per sequence, so counting its lines is much faster than decompressing
+ * the file. An index older than the file is ignored.
+ *
+ * Only indexed files benefit: a file without an index is still read
+ * completely by the rank in charge of it (see countEntriesWithoutLoading).
+ */
+bool Partitioner::getNumberOfEntriesFromIndex(string&file,LargeCount*entries){
+
+	string indexFile=file+".fai";
+
+	struct stat fileInformation;
+	struct stat indexInformation;
+
+	if(stat(file.c_str(),&fileInformation)!=0 || stat(indexFile.c_str(),&indexInformation)!=0)
+		return false;
+
+	if(indexInformation.st_mtime<fileInformation.st_mtime){
+		cout<<"Rank "<<m_parameters->getRank()<<": "<<indexFile<<" is older than "<<file<<", it is not used"<<endl;
+		return false;
+	}
+
+	ifstream f(indexFile.c_str());
+
+	if(!f.is_open())
+		return false;
+
+	LargeCount lines=0;
+	char buffer[4096];
+	char lastByte='\n';
+
+	while(f.read(buffer,sizeof(buffer)) || f.gcount()>0){
+		int bytes=f.gcount();
+
+		for(int i=0;i<bytes;i++){
+			if(buffer[i]=='\n')
+				lines++;
+		}
+
+		lastByte=buffer[bytes-1];
+	}
+
+	/* the last line has no newline */
+	if(lastByte!='\n')
+		lines++;
+
+	f.close();
+
+	(*entries)=lines;
+
+	return true;
+}
+
+bool Partitioner::hasExtension(string&file,const char*extension){
+
+	string suffix=extension;
+
+	return file.length()>=suffix.length()
+		&& file.compare(file.length()-suffix.length(),suffix.length(),suffix)==0;
+}
+
+/**
+ * Counts the entries of a FASTA or FASTQ file, plain or gzipped, by
+ * counting its lines: the loaders read 2 lines per entry for FASTA
+ * and 4 for FASTQ, and count an entry at its second line. Nothing is
+ * stored, so the memory does not depend on the size of the file.
+ *
+ * Other formats (sff, csfasta, export, bz2) return false and are
+ * counted by the Loader.
+ */
+bool Partitioner::countEntriesWithoutLoading(string&file,LargeCount*entries){
+
+	int period=0;
+	bool compressed=false;
+
+	if(hasExtension(file,".fastq") || hasExtension(file,".fq")){
+		period=4;
+	}else if(hasExtension(file,".fasta") || hasExtension(file,".fa")){
+		period=2;
+	}else if(hasExtension(file,".fastq.gz") || hasExtension(file,".fq.gz")){
+		period=4;
+		compressed=true;
+	}else if(hasExtension(file,"fasta.gz") || hasExtension(file,"fa.gz")){
+		period=2;
+		compressed=true;
+	}
+
+	if(period==0)
+		return false;
+
+	#ifndef CONFIG_HAVE_LIBZ
+	if(compressed)
+		return false;
+	#endif
+
+	LargeCount lines=0;
+	char lastByte='\n';
+	bool failed=false;
+
+	char*buffer=(char*)__Malloc(PARTITIONER_COUNTING_BUFFER_SIZE,"RAY_MALLOC_TYPE_PARTITIONER_BUFFER",m_parameters->showMemoryAllocations());
+
+	if(compressed){
+		#ifdef CONFIG_HAVE_LIBZ
+		gzFile f=gzopen(file.c_str(),"r");
+
+		if(f==NULL){
+			failed=true;
+		}else{
+			int bytes=0;
+
+			while((bytes=gzread(f,buffer,PARTITIONER_COUNTING_BUFFER_SIZE))>0){
+				for(int i=0;i<bytes;i++){
+					if(buffer[i]=='\n')
+						lines++;
+				}
+
+				lastByte=buffer[bytes-1];
+			}
+
+			if(bytes<0)
+				failed=true;
+
+			gzclose(f);
+		}
+		#endif
+	}else{
+		FILE*f=fopen(file.c_str(),"r");
+
+		if(f==NULL){
+			failed=true;
+		}else{
+			size_t bytes=0;
+
+			while((bytes=fread(buffer,1,PARTITIONER_COUNTING_BUFFER_SIZE,f))>0){
+				for(size_t i=0;i<bytes;i++){
+					if(buffer[i]=='\n')
+						lines++;
+				}
+
+				lastByte=buffer[bytes-1];
+			}
+
+			if(ferror(f))
+				failed=true;
+
+			fclose(f);
+		}
+	}
+
+	__Free(buffer,"RAY_MALLOC_TYPE_PARTITIONER_BUFFER",m_parameters->showMemoryAllocations());
+
+	if(failed){
+		cout<<"Rank "<<m_parameters->getRank()<<" Error: "<<file<<" can not be read"<<endl;
+		(*entries)=0;
+		return true;
+	}
+
+	/* the last line has no newline */
+	if(lastByte!='\n')
+		lines++;
+
+	/* the lines 1, 1+period, 1+2*period, ... start an entry */
+	(*entries)=(lines+period-2)/period;
+
+	return true;
+}
+
 void Partitioner::call_RAY_SLAVE_MODE_COUNT_FILE_ENTRIES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_COUNT_FILE_ENTRIES);
+
 	/** initialize the slave */
 	if(!m_initiatedSlave){
 		m_initiatedSlave=true;
@@ -278,7 +463,7 @@ void Partitioner::call_RAY_SLAVE_MODE_COUNT_FILE_ENTRIES(){
 		m_currentFileToCount++;
 
 		/* Here we write the checkpoint Partition */
-		if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("Partition")){
+		if(m_parameters->writeCheckpoint("Partition") && !m_parameters->hasCheckpoint("Partition")){
 			ofstream f(m_parameters->getCheckpointFile("Partition").c_str());
 			ostringstream buffer;
 			cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint Partition"<<endl;
@@ -302,16 +487,31 @@ void Partitioner::call_RAY_SLAVE_MODE_COUNT_FILE_ENTRIES(){
 		if(rankInCharge==m_parameters->getRank()){
 			/** count the entries in the file */
 			string file=m_parameters->getFile(m_currentFileToCount);
-			//cout<<"Rank "<<m_parameters->getRank()<<" Reading "<<file<<endl;
-			int res=m_loader.load(file,false);
-			if(res==EXIT_FAILURE){
-				cout<<"Rank "<<m_parameters->getRank()<<" Error: "<<file<<" failed to load properly..."<<endl;
-			}
-			m_slaveCounts[m_currentFileToCount]=m_loader.size();
+			LargeCount entries=0;
+
+			/* the index file gives the count without reading the sequences */
+			if(getNumberOfEntriesFromIndex(file,&entries)){
+				m_slaveCounts[m_currentFileToCount]=entries;
+
+				cout<<"Rank "<<m_parameters->getRank()<<": File "<<file<<" (Number "<<m_currentFileToCount<<") has "<<entries<<" sequences (from "<<file<<".fai)"<<endl;
+
+			/* FASTA and FASTQ files are counted line by line */
+			}else if(countEntriesWithoutLoading(file,&entries)){
+				m_slaveCounts[m_currentFileToCount]=entries;
+
+				cout<<"Rank "<<m_parameters->getRank()<<": File "<<file<<" (Number "<<m_currentFileToCount<<") has "<<entries<<" sequences"<<endl;
+			}else{
+				//cout<<"Rank "<<m_parameters->getRank()<<" Reading "<<file<<endl;
+				int res=m_loader.load(file,false);
+				if(res==EXIT_FAILURE){
+					cout<<"Rank "<<m_parameters->getRank()<<" Error: "<<file<<" failed to load properly..."<<endl;
+				}
+				m_slaveCounts[m_currentFileToCount]=m_loader.size();
 
-			m_loader.clear();
+				m_loader.clear();
 
-			cout<<"Rank "<<m_parameters->getRank()<<": File "<<file<<" (Number "<<m_currentFileToCount<<") has "<<m_slaveCounts[m_currentFileToCount]<<" sequences"<<endl;
+				cout<<"Rank "<<m_parameters->getRank()<<": File "<<file<<" (Number "<<m_currentFileToCount<<") has "<<m_slaveCounts[m_currentFileToCount]<<" sequences"<<endl;
+			}
 		}
 		m_currentFileToCount++;
 
@@ -321,23 +521,33 @@ void Partitioner::call_RAY_SLAVE_MODE_COUNT_FILE_ENTRIES(){
 		m_currentlySendingCounts=true;
 	/** sending counts */
 	}else if(m_currentlySendingCounts){
-		if(m_currentFileToSend<m_parameters->getNumberOfFiles()){
-			int rankInCharge=m_currentFileToSend%m_parameters->getSize();
-			/** skip the file, we are not in charge */
-			if(rankInCharge!=m_parameters->getRank()){
+		/** we got a reply, let's continue */
+		if(m_sentCount){
+			if(m_inbox->size()>0 && m_inbox->at(0)->getTag() == RAY_MPI_TAG_FILE_ENTRY_COUNT_REPLY){
+				m_sentCount=false;
+			}
+		/** send as many counts as a message can hold and wait for a reply to continue */
+		}else if(m_currentFileToSend<m_parameters->getNumberOfFiles()){
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+			int maximumElements=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
+			int elements=0;
+
+			while(m_currentFileToSend<m_parameters->getNumberOfFiles() && elements+2<=maximumElements){
+				int rankInCharge=m_currentFileToSend%m_parameters->getSize();
+
+				/** only the files we are in charge of */
+				if(rankInCharge==m_parameters->getRank()){
+					message[elements++]=m_currentFileToSend;
+					message[elements++]=m_slaveCounts[m_currentFileToSend];
+				}
+
 				m_currentFileToSend++;
-			/** send the count and wait for a reply to continue */
-			}else if(!m_sentCount){
-				MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
-				message[0]=m_currentFileToSend;
-				message[1]=m_slaveCounts[m_currentFileToSend];
-				Message aMessage(message,2,MASTER_RANK,RAY_MPI_TAG_FILE_ENTRY_COUNT,m_parameters->getRank());
+			}
+
+			if(elements>0){
+				Message aMessage(message,elements,MASTER_RANK,RAY_MPI_TAG_FILE_ENTRY_COUNT,m_parameters->getRank());
 				m_outbox->push_back(&aMessage);
 				m_sentCount=true;
-			/** we got a reply, let's continue */
-			}else if(m_inbox->size()>0 && m_inbox->at(0)->getTag() == RAY_MPI_TAG_FILE_ENTRY_COUNT_REPLY){
-				m_sentCount=false;
-				m_currentFileToSend++;
 			}
 		/** all counts were processed, report this to the control peer */
 		}else{
@@ -389,6 +599,7 @@ void Partitioner::registerPlugin(ComputeCore*core){
 }
 
 void Partitioner::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
 
 	RAY_MASTER_MODE_KILL_ALL_MPI_RANKS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_KILL_ALL_MPI_RANKS");
 
@@ -24,6 +24,7 @@
 
 #include <code/Mock/Parameters.h>
 #include <code/SequencesLoader/Loader.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/structures/StaticVector.h>
 #include <RayPlatform/memory/RingAllocator.h>
@@ -33,6 +34,7 @@
 #include <RayPlatform/core/ComputeCore.h>
 
 #include <map>
+#include <string>
 using namespace std;
 
 __DeclarePlugin(Partitioner);
@@ -41,7 +43,8 @@ __DeclareMasterModeAdapter(Partitioner,RAY_MASTER_MODE_COUNT_FILE_ENTRIES);
 __DeclareSlaveModeAdapter(Partitioner,RAY_SLAVE_MODE_COUNT_FILE_ENTRIES);
 
 /**
- * This class counts the number of entries in each input file in parallel 
+ * This class counts the number of entries in each input file in parallel.
+ * A file with an up-to-date samtools index (file.fai) is not read.
  * \author Sébastien Boisvert
  */
 class Partitioner :  public CorePlugin{
@@ -104,6 +107,15 @@ class Partitioner :  public CorePlugin{
 
 	bool checkIfPairedFilesAreValid();
 
+	/** count the entries with the index file, if there is one */
+	bool getNumberOfEntriesFromIndex(string&file,LargeCount*entries);
+
+	/** count the entries of a FASTA or FASTQ file without storing them */
+	bool countEntriesWithoutLoading(string&file,LargeCount*entries);
+	bool hasExtension(string&file,const char*extension);
+
+	Instrumentation*m_instrumentation;
+
 public:
 	void constructor(RingAllocator*outboxAllocator,StaticVector*inbox,StaticVector*outbox,Parameters*parameters,
 	SwitchMan*switchMan);
@@ -41,6 +41,7 @@ void PathEvaluator::call_RAY_MASTER_MODE_EVALUATE_PATHS(){
 }
 
 void PathEvaluator::call_RAY_SLAVE_MODE_EVALUATE_PATHS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_EVALUATE_PATHS);
 
 	writeCheckpointForContigPaths();
 
@@ -97,6 +98,7 @@ void PathEvaluator::registerPlugin(ComputeCore*core){
 }
 
 void PathEvaluator::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
 
 	RAY_MASTER_MODE_EVALUATE_PATHS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_EVALUATE_PATHS");
 	RAY_MASTER_MODE_ASK_EXTENSIONS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_ASK_EXTENSIONS");
@@ -22,6 +22,7 @@
 #define _PathEvaluator_h
 
 #include <code/Mock/Parameters.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/core/ComputeCore.h>
 
@@ -56,6 +57,8 @@ class PathEvaluator :  public CorePlugin {
 	vector<GraphPath>*m_contigs;
 	vector<PathHandle>*m_contigNames;
 
+	Instrumentation*m_instrumentation;
+
 public:
 
 	void registerPlugin(ComputeCore*core);
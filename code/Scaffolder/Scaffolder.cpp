@@ -381,6 +381,7 @@ void Scaffolder::constructor(StaticVector*outbox,StaticVector*inbox,RingAllocato
 	m_inbox=inbox;
 	m_outboxAllocator=outboxAllocator;
 	m_parameters=parameters;
+	m_mateTable.constructor(m_parameters);
 	m_initialised=false;
 	m_workerId=0;
 
@@ -392,6 +393,8 @@ void Scaffolder::constructor(StaticVector*outbox,StaticVector*inbox,RingAllocato
 }
 
 void Scaffolder::call_RAY_SLAVE_MODE_SCAFFOLDER(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_SCAFFOLDER);
+
 	if(!m_initialised){
 		m_initialised=true;
 		m_ready=true;
@@ -947,23 +950,12 @@ void Scaffolder::processAnnotation(){
 	int positionOnStrand=a->getPositionOnStrand();
 
 	if(!m_hasPairRequested){
-		MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(Kmer));
-		buffer[0]=sequenceId;
-		Message aMessage(buffer,1,rank,RAY_MPI_TAG_HAS_PAIRED_READ,m_parameters->getRank());
-		m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
+		// the mate is known without asking the rank that has the read
+		PairedRead mate;
+		m_hasPair=m_mateTable.getMate(rank,sequenceId,&mate);
 		m_hasPairRequested=true;
-		m_hasPairReceived=false;
-
-	}else if(!m_hasPairReceived
-	&&m_virtualCommunicator->isMessageProcessed(m_workerId)){
-
-		vector<MessageUnit> response;
-		m_virtualCommunicator->getMessageResponseElements(m_workerId,&response);
-		m_hasPair=response[0];
 		m_hasPairReceived=true;
 		m_pairRequested=false;
-	}else if(!m_hasPairReceived){
-		return;
 	}else if(!m_hasPair){
 		m_readAnnotationId++;
 		m_hasPairRequested=false;
@@ -1711,6 +1703,7 @@ void Scaffolder::call_RAY_MASTER_MODE_WRITE_SCAFFOLDS(){
 		m_switchMan->closeMasterMode();
 
 		m_timePrinter->printElapsedTime("Scaffolding of contigs");
+		m_instrumentation->endPhase("Scaffolding of contigs");
 	}
 }
 
@@ -1903,6 +1896,8 @@ void Scaffolder::registerPlugin(ComputeCore*core){
 }
 
 void Scaffolder::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_SCAFFOLDER=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_SCAFFOLDER");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
@@ -29,6 +29,8 @@
 #include <code/Mock/Parameters.h>
 #include <code/Mock/constants.h>
 #include <code/SeedingData/GraphPath.h>
+#include <code/SequencesIndexer/MateTable.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/structures/StaticVector.h>
 #include <RayPlatform/memory/RingAllocator.h>
@@ -95,6 +97,7 @@ class Scaffolder :  public CorePlugin{
 	SwitchMan*m_switchMan;
 	
 	TimePrinter*m_timePrinter;
+	Instrumentation*m_instrumentation;
 
 /**
  * Added to skip scaffolding in case of unpaired reads
@@ -190,6 +193,7 @@ class Scaffolder :  public CorePlugin{
 	vector<PathHandle>*m_contigNames;
 
 	Parameters*m_parameters;
+	MateTable m_mateTable;
 	StaticVector*m_inbox;
 	StaticVector*m_outbox;
 	RingAllocator*m_outboxAllocator;
@@ -159,7 +159,7 @@ void Searcher::call_RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE_AND_COLORS(Message*messa
 		int numberOfPhysicalColors=0;
 
 		if(node!=NULL){
-			coverage=node->getCoverage(&vertex);
+			coverage=m_subgraph->getCoverage(node);
 
 			VirtualKmerColorHandle color=node->getVirtualColor();
 			set<PhysicalKmerColor>*physicalColors=m_colorSet.getPhysicalColors(color);
@@ -281,6 +281,7 @@ void Searcher::call_RAY_MASTER_MODE_COUNT_SEARCH_ELEMENTS(){
 }
 
 void Searcher::call_RAY_SLAVE_MODE_COUNT_SEARCH_ELEMENTS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_COUNT_SEARCH_ELEMENTS);
 
 	if(!m_countElementsSlaveStarted){
 
@@ -543,7 +544,7 @@ void Searcher::countKmerObservations(LargeCount*localAssembledKmerObservations,
 
 		// at this point, we have a nicely assembled k-mer
 
-		CoverageDepth kmerCoverage=node->getCoverage(&key);
+		CoverageDepth kmerCoverage=m_subgraph->getCoverage(node);
 
 		(*totalKmers)++;
 		(*totalKmerObservations)+=kmerCoverage;
@@ -781,6 +782,8 @@ void Searcher::call_RAY_MPI_TAG_GRAPH_COUNTS(Message*message){
 
 
 void Searcher::call_RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES);
+
 	// Process virtual messages
 	m_virtualCommunicator->forceFlush();
 	m_virtualCommunicator->processInbox(&m_activeWorkers);
@@ -1274,6 +1277,7 @@ void Searcher::call_RAY_MASTER_MODE_SEARCHER_CLOSE(){
 }
 
 void Searcher::call_RAY_SLAVE_MODE_SEARCHER_CLOSE(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_SEARCHER_CLOSE);
 
 	// close identification files
 	for(map<int,FILE*>::iterator i=m_identificationFiles.begin();
@@ -1459,6 +1463,7 @@ void Searcher::browseColoredGraph(){
  * \author Sébastien Boisvert
  */
 void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES);
 
 	// Process virtual messages
 	m_virtualCommunicator->forceFlush();
@@ -2741,7 +2746,7 @@ void Searcher::call_RAY_MPI_TAG_GET_COVERAGE_AND_PATHS(Message*message){
 		int coverage=0;
 
 		if(node!=NULL){
-			coverage=node->getCoverage(&vertex);
+			coverage=m_subgraph->getCoverage(node);
 
 			#ifdef CONFIG_CONTIG_IDENTITY_VERBOSE
 			cout<<"Not NULL, coverage= "<<coverage<<endl;
@@ -3024,6 +3029,7 @@ void Searcher::call_RAY_MASTER_MODE_ADD_COLORS(){
 }
 
 void Searcher::call_RAY_SLAVE_MODE_ADD_COLORS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_ADD_COLORS);
 
 	// Process virtual messages
 	m_virtualCommunicator->forceFlush();
@@ -4294,6 +4300,8 @@ void Searcher::registerPlugin(ComputeCore*core){
 }
 
 void Searcher::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_ADD_COLORS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_ADD_COLORS");
 	RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES");
 	RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES");
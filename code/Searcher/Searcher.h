@@ -52,6 +52,7 @@ using namespace std;
 #include <RayPlatform/plugins/CorePlugin.h>
 #include <code/Searcher/QualityCaller.h>
 #include <code/Searcher/DistributionWriter.h>
+#include <code/Instrumentation/Instrumentation.h>
 #include <RayPlatform/core/ComputeCore.h>
 
 #define CONFIG_NICELY_ASSEMBLED_KMER_POSITION 0
@@ -464,6 +465,8 @@ class Searcher :  public CorePlugin {
 	int getNamespace(PhysicalKmerColor handle);
 
 	void generateSummaryOfColoredDeBruijnGraph();
+	Instrumentation*m_instrumentation;
+
 public:
 
 	void call_RAY_MASTER_MODE_COUNT_SEARCH_ELEMENTS();
@@ -23,6 +23,7 @@
 #define _BubbleData
 
 #include <code/Mock/common_functions.h>
+#include <code/SeedExtender/FlatMap.h>
 
 #include <vector>
 #include <map>
@@ -40,11 +41,9 @@ class BubbleData{
 public:
 	// arcs with good coverage
 	std::vector<std::vector<Kmer> > m_BUBBLE_visitedVertices;
-	// all vertices.
-	std::vector<std::set<Kmer> > m_visitedVertices;
 	bool m_doChoice_bubbles_Detected;
 	bool m_doChoice_bubbles_Initiated;
-	map<Kmer,int> m_coverages;
+	FlatMap<Kmer,int> m_coverages;
 };
 
 #endif
@@ -30,16 +30,18 @@
 using namespace std;
 
 void BubbleTool::printStuff(Kmer root,vector<vector<Kmer> >*trees,
-map<Kmer,int>*coverages){
+FlatMap<Kmer,int>*coverages){
 	int m_wordSize=m_parameters->getWordSize();
 	cout<<"Trees="<<trees->size()<<endl;
 	cout<<"root="<<root.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<endl;
 	cout<<"digraph{"<<endl;
 	map<Kmer,set<Kmer> > printedEdges;
 	
-	for(map<Kmer ,int>::iterator i=coverages->begin();i!=coverages->end();i++){
-		Kmer kmer=i->first;
-		cout<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" [label=\""<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" "<<i->second<<"\"]"<<endl;
+	for(int slot=0;slot<coverages->getCapacity();slot++){
+		if(!coverages->isUsed(slot))
+			continue;
+		Kmer kmer=coverages->getKeyAt(slot);
+		cout<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" [label=\""<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" "<<coverages->getValueAt(slot)<<"\"]"<<endl;
 	}
 	for(int j=0;j<(int)trees->size();j++){
 		for(int i=0;i<(int)trees->at(j).size();i+=2){
@@ -62,7 +64,7 @@ map<Kmer,int>*coverages){
  *
  */
 bool BubbleTool::isGenuineBubble(Kmer root,vector<vector<Kmer > >*trees,
-map<Kmer ,int>*coverages,int repeatCoverage){
+FlatMap<Kmer,int>*coverages,int repeatCoverage){
 	#ifdef NO_BUBBLES
 	return false;
 	#endif
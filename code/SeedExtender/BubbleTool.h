@@ -25,6 +25,7 @@
 #include <code/Mock/common_functions.h>
 #include <code/Mock/Parameters.h>
 #include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/SeedExtender/FlatMap.h>
 
 #include <map>
 #include <vector>
@@ -41,13 +42,13 @@ class BubbleTool{
 	Kmer m_choice;
 public:
 	bool isGenuineBubble(Kmer root, vector<vector<Kmer > >*trees,
-map<Kmer ,int>*coverages,int repeatCoverage);
+FlatMap<Kmer,int>*coverages,int repeatCoverage);
 	void constructor(Parameters*p);
 
 	Kmer getTraversalStartingPoint();
 
 	void printStuff(Kmer root, vector<vector<Kmer > >*trees,
-map<Kmer ,int>*coverages);
+FlatMap<Kmer,int>*coverages);
 };
 
 #endif
@@ -24,8 +24,21 @@
 #include <code/Mock/constants.h>
 #include <code/SeedingData/SeedingData.h>
 
+#include <RayPlatform/communication/Message.h>
+
+DepthFirstSearchData::DepthFirstSearchData(){
+	m_frontierDepth=0;
+	m_prefetchDone=true;
+	m_pendingReplies=0;
+}
+
 /*
  * do a depth first search with max depth of maxDepth;
+ *
+ * The coverage and edges of the vertices are taken from the vertices
+ * fetched by prefetch(), so the search is done in one call.
+ * A vertex that was not prefetched (see DFS_MAXIMUM_PREFETCHED_VERTICES)
+ * is fetched on its own.
  */
 void DepthFirstSearchData::depthFirstSearch(Kmer root,Kmer a,int maxDepth,
 	bool*edgesRequested,bool*vertexCoverageRequested,bool*vertexCoverageReceived,
@@ -59,91 +72,212 @@ void DepthFirstSearchData::depthFirstSearch(Kmer root,Kmer a,int maxDepth,
 		(*vertexCoverageRequested)=false;
 		#ifdef SHOW_MINI_GRAPH
 		cout<<"<MiniGraph>"<<endl;
-		cout<<root->idToWord(wordSize,parameters->getColorSpaceMode())<<" -> "<<a->idToWord(wordSize,parameters->getColorSpaceMode())<<endl;
+		cout<<root.idToWord(wordSize,parameters->getColorSpaceMode())<<" -> "<<a.idToWord(wordSize,parameters->getColorSpaceMode())<<endl;
 		#endif
 	}
-	if(m_depthFirstSearchVerticesToVisit.size()>0){
+
+	// a vertex that was not prefetched is on its way
+	if(m_pendingReplies>0)
+		return;
+
+	while(m_depthFirstSearchVerticesToVisit.size()>0){
 		Kmer vertexToVisit=m_depthFirstSearchVerticesToVisit.top();
-		if(!(*vertexCoverageRequested)){
-			(*vertexCoverageRequested)=true;
-			(*vertexCoverageReceived)=false;
-			
-			MessageUnit*message=(MessageUnit*)(*outboxAllocator).allocate(KMER_U64_ARRAY_SIZE*sizeof(MessageUnit));
-			int j=0;
-			vertexToVisit.pack(message,&j);
-			int dest=parameters->vertexRank(&vertexToVisit);
-			
-			Message aMessage(message,j,dest,RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,theRank);
-			(*outbox).push_back(&aMessage);
-		}else if((*vertexCoverageReceived)){
-			if(!(*edgesRequested)){
-				m_coverages[vertexToVisit]=(*receivedVertexCoverage);
-				m_depthFirstSearchVisitedVertices.insert(vertexToVisit);
-				int theDepth=m_depthFirstSearchDepths.top();
+		int*coverage=m_fetchedCoverages.find(vertexToVisit);
+
+		if(coverage==NULL){
+			vector<Kmer> vertices;
+			vertices.push_back(vertexToVisit);
+			queueVertices(&vertices,parameters);
+			sendQueries(outboxAllocator,outbox,theRank);
+			return;
+		}
 
-				if(theDepth> m_depthFirstSearch_maxDepth){
-					m_depthFirstSearch_maxDepth=theDepth;
-				}
-			
-				// visit the vertex, and ask next edges.
-				MessageUnit*message=(MessageUnit*)(*outboxAllocator).allocate(1*sizeof(MessageUnit));
-				int bufferPosition=0;
-				vertexToVisit.pack(message,&bufferPosition);
-				int destination=parameters->vertexRank(&vertexToVisit);
-				Message aMessage(message,bufferPosition,destination,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,theRank);
-				(*outbox).push_back(&aMessage);
-				(*edgesRequested)=true;
-				(*edgesReceived)=false;
-			}else if((*edgesReceived)){
-				Kmer vertexToVisit=m_depthFirstSearchVerticesToVisit.top();
-				int theDepth=m_depthFirstSearchDepths.top();
-				#ifdef CONFIG_ASSERT
-				assert(theDepth>=0);
-				assert(theDepth<=maxDepth);
-				#endif
-				int newDepth=theDepth+1;
+		m_coverages[vertexToVisit]=*coverage;
+		m_depthFirstSearchVisitedVertices.insert(vertexToVisit);
+		int theDepth=m_depthFirstSearchDepths.top();
 
-				m_depthFirstSearchVerticesToVisit.pop();
-				m_depthFirstSearchDepths.pop();
+		if(theDepth> m_depthFirstSearch_maxDepth){
+			m_depthFirstSearch_maxDepth=theDepth;
+		}
 
-				for(int i=0;i<(int)(*receivedOutgoingEdges).size();i++){
-					Kmer nextVertex=(*receivedOutgoingEdges)[i];
-					if(m_depthFirstSearchVisitedVertices.count(nextVertex)>0){
-						continue;
-					}
-					if(newDepth>maxDepth){
-						m_maxDepthReached=true;
-						continue;
-					}
+		#ifdef CONFIG_ASSERT
+		assert(theDepth>=0);
+		assert(theDepth<=maxDepth);
+		#endif
+		int newDepth=theDepth+1;
 
-					if(m_depthFirstSearchVisitedVertices.size()<MAX_VERTICES_TO_VISIT){
-						// add an arc
-						m_depthFirstSearchVisitedVertices_vector.push_back(vertexToVisit);
-						m_depthFirstSearchVisitedVertices_vector.push_back(nextVertex);
+		m_depthFirstSearchVerticesToVisit.pop();
+		m_depthFirstSearchDepths.pop();
 
-						// add the depth for the vertex
-						m_depthFirstSearchVisitedVertices_depths.push_back(newDepth);
+		vector<Kmer> outgoingEdges=vertexToVisit.getOutgoingEdges(*(m_fetchedEdges.find(vertexToVisit)),wordSize);
 
-						// stacks
-						m_depthFirstSearchVerticesToVisit.push(nextVertex);
-						m_depthFirstSearchDepths.push(newDepth);
-					}
+		for(int i=0;i<(int)outgoingEdges.size();i++){
+			Kmer nextVertex=outgoingEdges[i];
+			if(m_depthFirstSearchVisitedVertices.count(nextVertex)>0){
+				continue;
+			}
+			if(newDepth>maxDepth){
+				m_maxDepthReached=true;
+				continue;
+			}
 
+			if(m_depthFirstSearchVisitedVertices.size()<MAX_VERTICES_TO_VISIT){
+				// add an arc
+				m_depthFirstSearchVisitedVertices_vector.push_back(vertexToVisit);
+				m_depthFirstSearchVisitedVertices_vector.push_back(nextVertex);
 
-					#ifdef SHOW_MINI_GRAPH
-					cout<<vertexToVisit->idToWord(wordSize,parameters->getColorSpaceMode())<<" -> "<<nextVertex->idToWord(wordSize,parameters->getColorSpaceMode())<<endl;
-					#endif
-				}
-				(*edgesRequested)=false;
-				(*vertexCoverageRequested)=false;
+				// add the depth for the vertex
+				m_depthFirstSearchVisitedVertices_depths.push_back(newDepth);
+
+				// stacks
+				m_depthFirstSearchVerticesToVisit.push(nextVertex);
+				m_depthFirstSearchDepths.push(newDepth);
 			}
+
+
+			#ifdef SHOW_MINI_GRAPH
+			cout<<vertexToVisit.idToWord(wordSize,parameters->getColorSpaceMode())<<" -> "<<nextVertex.idToWord(wordSize,parameters->getColorSpaceMode())<<endl;
+			#endif
 		}
-	}else{
-		m_doChoice_tips_dfs_done=true;
-		#ifdef SHOW_MINI_GRAPH
-		cout<<"</MiniGraph>"<<endl;
-		#endif
 	}
+
+	m_doChoice_tips_dfs_done=true;
+	#ifdef SHOW_MINI_GRAPH
+	cout<<"</MiniGraph>"<<endl;
+	#endif
+}
+
+/*
+ * The depth-first searches of a decision visit the vertices within
+ * maxDepth of the choices. They are fetched here before, level by level:
+ * all the vertices of a level are sent in one message per owner
+ * (or a few if they do not fit), so that a decision waits for
+ * maxDepth+1 round trips instead of 2 per visited vertex.
+ */
+void DepthFirstSearchData::startPrefetch(vector<Kmer>*choices,Parameters*parameters){
+	m_fetchedCoverages.clear();
+	m_fetchedEdges.clear();
+	m_discoveredVertices.clear();
+	m_frontier.clear();
+	m_queries.clear();
+	m_frontierDepth=0;
+
+	// with one choice, there is no search
+	if(choices->size()<=1){
+		m_prefetchDone=true;
+		return;
+	}
+
+	for(int i=0;i<(int)choices->size();i++){
+		Kmer vertex=choices->at(i);
+
+		if(m_discoveredVertices.count(vertex)>0)
+			continue;
+
+		m_discoveredVertices.insert(vertex);
+		m_frontier.push_back(vertex);
+	}
+
+	queueVertices(&m_frontier,parameters);
+	m_prefetchDone=false;
+}
+
+bool DepthFirstSearchData::prefetch(int maxDepth,RingAllocator*outboxAllocator,StaticVector*outbox,int theRank,Parameters*parameters){
+	if(m_prefetchDone)
+		return true;
+
+	if(m_queries.size()>0){
+		sendQueries(outboxAllocator,outbox,theRank);
+		return false;
+	}
+
+	if(m_pendingReplies>0)
+		return false;
+
+	// the level is there, the next level is made of the new children
+	vector<Kmer> nextFrontier;
+
+	if(m_frontierDepth<maxDepth){
+		for(int i=0;i<(int)m_frontier.size();i++){
+			Kmer vertex=m_frontier[i];
+			vector<Kmer> children=vertex.getOutgoingEdges(*(m_fetchedEdges.find(vertex)),parameters->getWordSize());
+
+			for(int j=0;j<(int)children.size();j++){
+				Kmer child=children[j];
+
+				if(m_discoveredVertices.count(child)>0)
+					continue;
+				if(m_discoveredVertices.size()>=DFS_MAXIMUM_PREFETCHED_VERTICES)
+					continue;
+
+				m_discoveredVertices.insert(child);
+				nextFrontier.push_back(child);
+			}
+		}
+	}
+
+	m_frontier.swap(nextFrontier);
+	m_frontierDepth++;
+
+	if(m_frontier.size()==0){
+		m_prefetchDone=true;
+		return true;
+	}
+
+	queueVertices(&m_frontier,parameters);
+	return false;
+}
+
+void DepthFirstSearchData::queueVertices(vector<Kmer>*vertices,Parameters*parameters){
+	for(int i=0;i<(int)vertices->size();i++){
+		Kmer vertex=vertices->at(i);
+		Rank destination=parameters->vertexRank(&vertex);
+		m_queries[destination].push_back(vertex);
+	}
+}
+
+/*
+ * message: <--vertex--><--vertex-->...
+ * reply: <--vertex--><--edges--><--coverage-->...
+ */
+void DepthFirstSearchData::sendQueries(RingAllocator*outboxAllocator,StaticVector*outbox,int theRank){
+	int verticesPerMessage=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit)/(KMER_U64_ARRAY_SIZE+2);
+	int messages=0;
+
+	while(m_queries.size()>0 && messages<DFS_MAXIMUM_MESSAGES_PER_CALL){
+		map<Rank,vector<Kmer> >::iterator query=m_queries.begin();
+		vector<Kmer>*vertices=&(query->second);
+
+		MessageUnit*message=(MessageUnit*)outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+		int bufferPosition=0;
+
+		for(int i=0;i<verticesPerMessage && vertices->size()>0;i++){
+			vertices->back().pack(message,&bufferPosition);
+			vertices->pop_back();
+		}
+
+		Message aMessage(message,bufferPosition,query->first,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES,theRank);
+		outbox->push_back(&aMessage);
+
+		m_pendingReplies++;
+		messages++;
+
+		if(vertices->size()==0)
+			m_queries.erase(query);
+	}
+}
+
+void DepthFirstSearchData::receiveVertexAttributes(MessageUnit*buffer,int count){
+	int bufferPosition=0;
+
+	while(bufferPosition<count){
+		Kmer vertex;
+		vertex.unpack(buffer,&bufferPosition);
+		m_fetchedEdges[vertex]=buffer[bufferPosition++];
+		m_fetchedCoverages[vertex]=buffer[bufferPosition++];
+	}
+
+	m_pendingReplies--;
 }
 
 void DepthFirstSearchData::depthFirstSearchBidirectional(Kmer a,int maxDepth,
@@ -336,18 +470,20 @@ void DepthFirstSearchData::depthFirstSearchBidirectional(Kmer a,int maxDepth,
 	}
 }
 
-map<Kmer,vector<Kmer> >*DepthFirstSearchData::getIngoingEdges(){
+FlatMap<Kmer,vector<Kmer> >*DepthFirstSearchData::getIngoingEdges(){
 	return &m_ingoingEdges;
 }
 
-map<Kmer,vector<Kmer> >*DepthFirstSearchData::getOutgoingEdges(){
+FlatMap<Kmer,vector<Kmer> >*DepthFirstSearchData::getOutgoingEdges(){
 	return &m_outgoingEdges;
 }
 
 void DepthFirstSearchData::setTags(	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_EDGES,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES
 ){
+	this->RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES=RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES;
 	this->RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES=RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES;
 	this->RAY_MPI_TAG_REQUEST_VERTEX_EDGES=RAY_MPI_TAG_REQUEST_VERTEX_EDGES;
 	this->RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE=RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
@@ -22,9 +22,11 @@
 #ifndef _DepthFirstSearchData
 #define _DepthFirstSearchData
 
+#include <code/Mock/constants.h>
 #include <code/Mock/Parameters.h>
 #include <code/Mock/common_functions.h>
 #include <code/SeedingData/SeedingData.h>
+#include <code/SeedExtender/FlatMap.h>
 
 #include <RayPlatform/memory/RingAllocator.h>
 #include <RayPlatform/structures/StaticVector.h>
@@ -37,6 +39,12 @@ using namespace std;
 
 class SeedingData;
 
+/* vertices fetched around the choices of a decision, the search fetches the others one by one */
+#define DFS_MAXIMUM_PREFETCHED_VERTICES (4*MAX_VERTICES_TO_VISIT)
+
+/* messages sent at each call */
+#define DFS_MAXIMUM_MESSAGES_PER_CALL 16
+
 /*
  * Data for depth first search.
  *
@@ -47,17 +55,36 @@ class DepthFirstSearchData{
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_EDGES;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES;
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES;
 
 	bool m_outgoingEdgesDone;
 
-	map<Kmer,vector<Kmer> > m_outgoingEdges;
-	map<Kmer,vector<Kmer> > m_ingoingEdges;
+	FlatMap<Kmer,vector<Kmer> > m_outgoingEdges;
+	FlatMap<Kmer,vector<Kmer> > m_ingoingEdges;
+
+	/** coverage and edges of the vertices around the choices, see prefetch() */
+	FlatMap<Kmer,int> m_fetchedCoverages;
+	FlatMap<Kmer,uint8_t> m_fetchedEdges;
+
+	/** breadth-first search of the prefetch, one level at a time */
+	FlatSet<Kmer> m_discoveredVertices;
+	vector<Kmer> m_frontier;
+	int m_frontierDepth;
+	bool m_prefetchDone;
+
+	/** vertices to fetch, by owner */
+	map<Rank,vector<Kmer> > m_queries;
+	int m_pendingReplies;
+
+	void queueVertices(vector<Kmer>*vertices,Parameters*parameters);
+	void sendQueries(RingAllocator*outboxAllocator,StaticVector*outbox,int theRank);
 
 public:
 	void setTags(
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_EDGES,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES
 );
 
 	bool m_maxDepthReached;
@@ -71,11 +98,22 @@ public:
 	MyStack<int> m_depthFirstSearchDepths;
 	int m_doChoice_tips_i;
 	vector<int> m_doChoice_tips_newEdges;
-	set<Kmer> m_depthFirstSearchVisitedVertices;
+	FlatSet<Kmer> m_depthFirstSearchVisitedVertices;
 	MyStack<Kmer> m_depthFirstSearchVerticesToVisit;
 	vector<Kmer> m_depthFirstSearchVisitedVertices_vector;
 	vector<int> m_depthFirstSearchVisitedVertices_depths;
-	map<Kmer,int> m_coverages;
+	FlatMap<Kmer,int> m_coverages;
+
+	DepthFirstSearchData();
+
+	/** starts to fetch the vertices within maxDepth of the choices */
+	void startPrefetch(vector<Kmer>*choices,Parameters*parameters);
+
+	/** returns true when all the levels are fetched */
+	bool prefetch(int maxDepth,RingAllocator*outboxAllocator,StaticVector*outbox,int theRank,Parameters*parameters);
+
+	/** stores the reply of RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES */
+	void receiveVertexAttributes(MessageUnit*buffer,int count);
 
 
 	void depthFirstSearch(Kmer root,Kmer a,int maxDepth,
@@ -91,8 +129,8 @@ public:
 		int minimumCoverage,bool*edgesReceived,Parameters*parameters);
 
 	
-	map<Kmer,vector<Kmer> >*getIngoingEdges();
-	map<Kmer,vector<Kmer> >*getOutgoingEdges();
+	FlatMap<Kmer,vector<Kmer> >*getIngoingEdges();
+	FlatMap<Kmer,vector<Kmer> >*getOutgoingEdges();
 
 
 };
@@ -23,6 +23,7 @@
 #define _ExtensionData
 
 #include "ExtensionElement.h"
+#include "FlatMap.h"
 
 #include <code/SequencesLoader/ReadHandle.h>
 #include <code/SequencesIndexer/PairedRead.h>
@@ -92,6 +93,9 @@ public:
 
 	int m_EXTENSION_numberOfRanksDone;
 	vector<GraphPath> m_EXTENSION_contigs;
+
+	/** number of contigs stored by each rank, only populated on the master */
+	vector<uint64_t> m_EXTENSION_contigsPerRank;
 	bool m_EXTENSION_checkedIfCurrentVertexIsAssembled;
 	bool m_EXTENSION_VertexMarkAssembled_requested;
 	bool m_EXTENSION_reverseComplement_requested;
@@ -128,10 +132,12 @@ public:
 	// reads to check (the ones "in range")
 	bool m_EXTENSION_singleEndResolution;
 	set<ReadHandle>::iterator m_EXTENSION_readIterator;
-	map<Kmer,vector<int> > m_EXTENSION_readPositionsForVertices;
-	map<Kmer,vector<int> > m_EXTENSION_pairedReadPositionsForVertices;
-	map<Kmer,vector<int> > m_EXTENSION_pairedLibrariesForVertices;
-	map<Kmer,vector<ReadHandle> > m_EXTENSION_pairedReadsForVertices;
+
+	/** reads on the choices of the current step, cleared at each step */
+	FlatMap<Kmer,vector<int> > m_EXTENSION_readPositionsForVertices;
+	FlatMap<Kmer,vector<int> > m_EXTENSION_pairedReadPositionsForVertices;
+	FlatMap<Kmer,vector<int> > m_EXTENSION_pairedLibrariesForVertices;
+	FlatMap<Kmer,vector<ReadHandle> > m_EXTENSION_pairedReadsForVertices;
 	CoverageDepth m_currentCoverage;
 
 	set<ReadHandle> m_EXTENSION_readsInRange;
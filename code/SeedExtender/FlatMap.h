@@ -0,0 +1,276 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _FlatMap_h
+#define _FlatMap_h
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/SequencesLoader/ReadHandle.h>
+
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+/* the smallest table, a power of 2 */
+#define FLAT_MAP_MINIMUM_CAPACITY 16
+
+inline uint64_t getFlatHash(const Kmer&key){
+	return key.hash_function_1();
+}
+
+inline uint64_t getFlatHash(const ReadHandle&key){
+	// Fibonacci hashing, the low bits are used
+	uint64_t value=key.getValue()*0x9E3779B97F4A7C15ULL;
+	return value^(value>>32);
+}
+
+inline uint64_t getFlatHash(int key){
+	return getFlatHash(ReadHandle(key));
+}
+
+/* a value of a new key, vectors keep their memory */
+template<class Value>
+inline void resetFlatValue(Value&value){
+	value=Value();
+}
+
+template<class Element>
+inline void resetFlatValue(vector<Element>&value){
+	value.clear();
+}
+
+/**
+ * A hash map with open addressing (linear probing) in flat arrays,
+ * for the working sets of the seed extension that are filled and
+ * emptied at each step.
+ *
+ * clear() does not touch the slots: each slot has the stamp of the
+ * clear() that was current when it was filled, and a slot with an
+ * older stamp is empty. The keys and values stay allocated, so a
+ * vector<int> value reuses its memory for the next seed.
+ *
+ * Like std::map, operator[] inserts a default value.
+ * Slots are visited with getCapacity/isUsed/getKeyAt/getValueAt,
+ * in no particular order.
+ *
+ * \author agent
+ */
+template<class Key,class Value>
+class FlatMap{
+
+	vector<Key> m_keys;
+	vector<Value> m_values;
+	vector<uint32_t> m_stamps;
+	uint32_t m_stamp;
+	int m_size;
+
+	/** returns the slot of the key, or the empty slot where it would go */
+	int findSlot(const Key&key)const{
+		int mask=m_keys.size()-1;
+		int slot=getFlatHash(key)&mask;
+
+		while(m_stamps[slot]==m_stamp && !(m_keys[slot]==key))
+			slot=(slot+1)&mask;
+
+		return slot;
+	}
+
+	void grow(){
+		vector<Key> keys;
+		vector<Value> values;
+		vector<uint32_t> stamps;
+
+		keys.swap(m_keys);
+		values.swap(m_values);
+		stamps.swap(m_stamps);
+
+		int capacity=2*keys.size();
+
+		if(capacity<FLAT_MAP_MINIMUM_CAPACITY)
+			capacity=FLAT_MAP_MINIMUM_CAPACITY;
+
+		m_keys.resize(capacity);
+		m_values.resize(capacity);
+		m_stamps.assign(capacity,0);
+
+		uint32_t oldStamp=m_stamp;
+		m_stamp=1;
+
+		for(int i=0;i<(int)keys.size();i++){
+			if(stamps[i]!=oldStamp)
+				continue;
+
+			int slot=findSlot(keys[i]);
+			m_keys[slot]=keys[i];
+			m_stamps[slot]=m_stamp;
+
+			// no copy of the value
+			std::swap(m_values[slot],values[i]);
+		}
+	}
+
+public:
+
+	FlatMap(){
+		m_stamp=1;
+		m_size=0;
+	}
+
+	Value&operator[](const Key&key){
+
+		// at most half of the slots are used
+		if(2*(m_size+1)>(int)m_keys.size())
+			grow();
+
+		int slot=findSlot(key);
+
+		if(m_stamps[slot]!=m_stamp){
+			m_keys[slot]=key;
+			m_stamps[slot]=m_stamp;
+			resetFlatValue(m_values[slot]);
+			m_size++;
+		}
+
+		return m_values[slot];
+	}
+
+	Value*find(const Key&key){
+		if(m_size==0)
+			return NULL;
+
+		int slot=findSlot(key);
+
+		if(m_stamps[slot]!=m_stamp)
+			return NULL;
+
+		return &(m_values[slot]);
+	}
+
+	int count(const Key&key)const{
+		if(m_size==0)
+			return 0;
+
+		return m_stamps[findSlot(key)]==m_stamp;
+	}
+
+	/**
+	 * Removes a key. The following keys of its cluster are moved back
+	 * so that there is no tombstone.
+	 */
+	void erase(const Key&key){
+		if(m_size==0)
+			return;
+
+		int mask=m_keys.size()-1;
+		int hole=findSlot(key);
+
+		if(m_stamps[hole]!=m_stamp)
+			return;
+
+		m_size--;
+
+		int slot=(hole+1)&mask;
+
+		while(m_stamps[slot]==m_stamp){
+			int home=getFlatHash(m_keys[slot])&mask;
+
+			// the key can fill the hole if the hole is between its home and its slot
+			if(((slot-home)&mask)>=((slot-hole)&mask)){
+				m_keys[hole]=m_keys[slot];
+				std::swap(m_values[hole],m_values[slot]);
+				hole=slot;
+			}
+
+			slot=(slot+1)&mask;
+		}
+
+		// 0 is never the current stamp
+		m_stamps[hole]=0;
+	}
+
+	int size()const{
+		return m_size;
+	}
+
+	void clear(){
+		m_size=0;
+		m_stamp++;
+
+		// the stamp wrapped around, the old stamps are ambiguous
+		if(m_stamp==0){
+			m_stamps.assign(m_stamps.size(),0);
+			m_stamp=1;
+		}
+	}
+
+	int getCapacity()const{
+		return m_keys.size();
+	}
+
+	/** the memory of the slots, the memory owned by the values is not counted */
+	uint64_t getBytes()const{
+		return m_keys.capacity()*sizeof(Key)+m_values.capacity()*sizeof(Value)
+			+m_stamps.capacity()*sizeof(uint32_t);
+	}
+
+	bool isUsed(int slot)const{
+		return m_stamps[slot]==m_stamp;
+	}
+
+	const Key&getKeyAt(int slot)const{
+		return m_keys[slot];
+	}
+
+	Value&getValueAt(int slot){
+		return m_values[slot];
+	}
+};
+
+/**
+ * A set with the same layout as FlatMap.
+ *
+ * \author agent
+ */
+template<class Key>
+class FlatSet{
+
+	// not bool, vector<bool> has no references
+	FlatMap<Key,uint8_t> m_map;
+
+public:
+
+	void insert(const Key&key){
+		m_map[key]=1;
+	}
+
+	int count(const Key&key)const{
+		return m_map.count(key);
+	}
+
+	int size()const{
+		return m_map.size();
+	}
+
+	void clear(){
+		m_map.clear();
+	}
+};
+
+#endif
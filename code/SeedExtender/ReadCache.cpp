@@ -0,0 +1,222 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "ReadCache.h"
+
+#include <code/SequencesLoader/Read.h>
+#include <code/Mock/common_functions.h>
+
+#include <iostream>
+#include <string.h>
+using namespace std;
+
+void ReadCache::constructor(uint64_t maximumBytes){
+	m_maximumBytes=maximumBytes;
+	m_hand=0;
+	m_hits=0;
+	m_misses=0;
+	m_evictions=0;
+
+	clear();
+}
+
+bool ReadCache::isEnabled(){
+	return m_maximumBytes>0;
+}
+
+/**
+ * The size of the heap block of an allocation: like the malloc of
+ * glibc on 64-bit systems, a header of 8 bytes, a multiple of 16 bytes
+ * and at least 32 bytes.
+ */
+uint64_t ReadCache::getAllocationBytes(uint64_t bytes){
+	if(bytes==0)
+		return 0;
+
+	uint64_t block=(bytes+8+15)/16*16;
+
+	if(block<32)
+		block=32;
+
+	return block;
+}
+
+/**
+ * The memory of the cache, with the capacities and not the sizes:
+ * the slots of the index, the entries (also the free ones) and the
+ * sequences.
+ */
+uint64_t ReadCache::getBytes(){
+	return m_sequenceBytes+m_index.getBytes()
+		+getAllocationBytes(m_entries.capacity()*sizeof(ReadCacheEntry))
+		+getAllocationBytes(m_freeEntries.capacity()*sizeof(int));
+}
+
+bool ReadCache::find(ReadHandle handle,char*sequence,PairedRead*pairedRead,int*type){
+
+	if(!isEnabled())
+		return false;
+
+	int*entryIndex=m_index.find(handle);
+
+	if(entryIndex==NULL){
+		m_misses++;
+		return false;
+	}
+
+	m_hits++;
+
+	ReadCacheEntry*entry=&(m_entries[*entryIndex]);
+	entry->m_referenced=true;
+
+	Read read;
+	read.setRawSequence(&(entry->m_sequence[0]),entry->m_length);
+	read.getSeq(sequence,false,false);
+
+	*pairedRead=entry->m_pairedRead;
+	*type=entry->m_type;
+
+	return true;
+}
+
+void ReadCache::evictEntry(){
+
+	// an entry is referenced at most once per turn
+	while(1){
+		ReadCacheEntry*entry=&(m_entries[m_hand]);
+		int entryIndex=m_hand;
+
+		m_hand=(m_hand+1)%m_entries.size();
+
+		if(!entry->m_used)
+			continue;
+
+		if(entry->m_referenced){
+			entry->m_referenced=false;
+			continue;
+		}
+
+		m_index.erase(entry->m_handle);
+		m_sequenceBytes-=getAllocationBytes(entry->m_sequence.capacity());
+
+		// give the memory back
+		vector<uint8_t> empty;
+		entry->m_sequence.swap(empty);
+		entry->m_used=false;
+
+		m_freeEntries.push_back(entryIndex);
+		m_evictions++;
+
+		return;
+	}
+}
+
+void ReadCache::insert(ReadHandle handle,const char*sequence,PairedRead*pairedRead,int type){
+
+	if(!isEnabled())
+		return;
+
+	if(m_index.count(handle)>0)
+		return;
+
+	int length=strlen(sequence);
+	uint64_t bytes=getAllocationBytes((length+3)/4);
+
+	if(length==0||bytes>m_maximumBytes)
+		return;
+
+	while(getBytes()+bytes>m_maximumBytes && m_index.size()>0)
+		evictEntry();
+
+	// the index and the entries alone use all the memory
+	if(getBytes()+bytes>m_maximumBytes)
+		return;
+
+	int entryIndex=m_entries.size();
+
+	if(m_freeEntries.size()>0){
+		entryIndex=m_freeEntries.back();
+		m_freeEntries.pop_back();
+	}else{
+		m_entries.resize(m_entries.size()+1);
+	}
+
+	ReadCacheEntry*entry=&(m_entries[entryIndex]);
+	entry->m_handle=handle;
+	entry->m_pairedRead=*pairedRead;
+	entry->m_length=length;
+	entry->m_type=type;
+	entry->m_referenced=false;
+	entry->m_used=true;
+
+	// same layout as in Read
+	entry->m_sequence.assign((length+3)/4,0);
+
+	for(int position=0;position<length;position++){
+		uint8_t code=charToCode(sequence[position]);
+		entry->m_sequence[position/4]|=(code<<(2*(position%4)));
+	}
+
+	m_index[handle]=entryIndex;
+	m_sequenceBytes+=getAllocationBytes(entry->m_sequence.capacity());
+
+	// the index or the entries may have grown for this read
+	while(getBytes()>m_maximumBytes && m_index.size()>0)
+		evictEntry();
+}
+
+/* the memory is given back */
+void ReadCache::clear(){
+	FlatMap<ReadHandle,int> index;
+	vector<ReadCacheEntry> entries;
+	vector<int> freeEntries;
+
+	m_index=index;
+	m_entries.swap(entries);
+	m_freeEntries.swap(freeEntries);
+	m_hand=0;
+	m_sequenceBytes=0;
+}
+
+uint64_t ReadCache::getHits(){
+	return m_hits;
+}
+
+uint64_t ReadCache::getMisses(){
+	return m_misses;
+}
+
+uint64_t ReadCache::getEvictions(){
+	return m_evictions;
+}
+
+void ReadCache::printStatistics(Rank rank){
+	if(!isEnabled())
+		return;
+
+	uint64_t lookups=m_hits+m_misses;
+	double hitRate=0;
+
+	if(lookups>0)
+		hitRate=(100.0*m_hits)/lookups;
+
+	cout<<"Rank "<<rank<<" read cache: "<<m_hits<<" hits, "<<m_misses<<" misses ("<<hitRate<<"% hit rate), ";
+	cout<<m_evictions<<" evictions, "<<m_index.size()<<" reads in "<<getBytes()<<" bytes (maximum: "<<m_maximumBytes<<")"<<endl;
+}
@@ -0,0 +1,107 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _ReadCache_h
+#define _ReadCache_h
+
+#include "FlatMap.h"
+
+#include <code/SequencesLoader/ReadHandle.h>
+#include <code/SequencesIndexer/PairedRead.h>
+
+#include <RayPlatform/core/types.h>
+
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+/**
+ * A read in the ReadCache, with 2 bits per nucleotide.
+ *
+ * \author agent
+ */
+class ReadCacheEntry{
+public:
+	ReadHandle m_handle;
+	PairedRead m_pairedRead;
+	vector<uint8_t> m_sequence;
+	uint16_t m_length;
+	uint8_t m_type;
+
+	/** the second chance of the CLOCK */
+	bool m_referenced;
+	bool m_used;
+};
+
+/**
+ * Reads fetched from other ranks by the seed extender.
+ *
+ * A read is requested again when a later seed reaches it, so the
+ * replies are kept here, within a number of bytes
+ * (-read-cache-memory). The bytes are those really allocated: the
+ * capacities of the index and of the vectors, and the heap blocks of
+ * the sequences. When the cache is full, an entry is evicted
+ * with the CLOCK algorithm: the hand skips (and clears) the entries
+ * that were found since it last passed.
+ *
+ * \author agent
+ */
+class ReadCache{
+
+	FlatMap<ReadHandle,int> m_index;
+	vector<ReadCacheEntry> m_entries;
+	vector<int> m_freeEntries;
+	int m_hand;
+
+	uint64_t m_maximumBytes;
+
+	/** the heap blocks of the sequences */
+	uint64_t m_sequenceBytes;
+
+	uint64_t m_hits;
+	uint64_t m_misses;
+	uint64_t m_evictions;
+
+	uint64_t getAllocationBytes(uint64_t bytes);
+	uint64_t getBytes();
+	void evictEntry();
+
+public:
+
+	/** a maximum of 0 disables the cache */
+	void constructor(uint64_t maximumBytes);
+
+	bool isEnabled();
+
+	/** fills sequence, pairedRead and type if the read is in the cache */
+	bool find(ReadHandle handle,char*sequence,PairedRead*pairedRead,int*type);
+
+	void insert(ReadHandle handle,const char*sequence,PairedRead*pairedRead,int type);
+
+	void clear();
+
+	uint64_t getHits();
+	uint64_t getMisses();
+	uint64_t getEvictions();
+
+	void printStatistics(Rank rank);
+};
+
+#endif
@@ -52,6 +52,8 @@ __CreateSlaveModeAdapter(SeedExtender,RAY_SLAVE_MODE_EXTENSION); /**/
 __CreateMessageTagAdapter(SeedExtender,RAY_MPI_TAG_ADD_GRAPH_PATH);
 __CreateMessageTagAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED); /**/
 __CreateMessageTagAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY); /**/
+__CreateMessageTagAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES);
+__CreateMessageTagAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY);
 
 using namespace std;
 
@@ -67,6 +69,7 @@ void SeedExtender::closePathFile(){
 
 /** extend the seeds */
 void SeedExtender::call_RAY_SLAVE_MODE_EXTENSION(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_EXTENSION);
 
 	MACRO_COLLECT_PROFILING_INFORMATION();
 
@@ -673,12 +676,16 @@ Presently, insertions or deletions up to 8 are supported.
 				m_dfsData->m_doChoice_tips_dfs_done=false;
 				m_dfsData->m_doChoice_tips_Initiated=true;
 				bubbleData->m_BUBBLE_visitedVertices.clear();
-				bubbleData->m_visitedVertices.clear();
 				bubbleData->m_coverages.clear();
 				bubbleData->m_coverages[(*currentVertex)]=ed->m_currentCoverage;
 
+				m_dfsData->startPrefetch(&(ed->m_enumerateChoices_outgoingEdges),m_parameters);
 			}
 
+			// the vertices around the choices are fetched level by level
+			if(!m_dfsData->prefetch(maxDepth,outboxAllocator,outbox,theRank,m_parameters))
+				return;
+
 			MACRO_COLLECT_PROFILING_INFORMATION();
 
 			if(m_dfsData->m_doChoice_tips_i<(int)ed->m_enumerateChoices_outgoingEdges.size()){
@@ -698,12 +705,13 @@ size,theRank,outbox,receivedVertexCoverage,receivedOutgoingEdges,minimumCoverage
 
 					// store visited vertices for bubble detection purposes.
 					bubbleData->m_BUBBLE_visitedVertices.push_back(m_dfsData->m_depthFirstSearchVisitedVertices_vector);
-					for(map<Kmer,int>::iterator i=m_dfsData->m_coverages.begin();
-						i!=m_dfsData->m_coverages.end();i++){
-						bubbleData->m_coverages[i->first]=i->second;
+					FlatMap<Kmer,int>*coverages=&(m_dfsData->m_coverages);
+
+					for(int slot=0;slot<coverages->getCapacity();slot++){
+						if(coverages->isUsed(slot))
+							bubbleData->m_coverages[coverages->getKeyAt(slot)]=coverages->getValueAt(slot);
 					}
 
-					bubbleData->m_visitedVertices.push_back(m_dfsData->m_depthFirstSearchVisitedVertices);
 					// keep the edge if it is not a tip.
 					if(m_dfsData->m_depthFirstSearch_maxDepth>=TIP_LIMIT){
 						m_dfsData->m_doChoice_tips_newEdges.push_back(m_dfsData->m_doChoice_tips_i);
@@ -918,7 +926,7 @@ size,theRank,outbox,receivedVertexCoverage,receivedOutgoingEdges,minimumCoverage
 }
 
 void SeedExtender::printTree(Kmer root,
-map<Kmer,set<Kmer> >*arcs,map<Kmer,int>*coverages,int depth,set<Kmer>*visited){
+map<Kmer,set<Kmer> >*arcs,FlatMap<Kmer,int>*coverages,int depth,set<Kmer>*visited){
 	if(arcs->count(root)==0)
 		return;
 	if(visited->count(root)>0)
@@ -1163,7 +1171,8 @@ void SeedExtender::checkIfCurrentVertexIsAssembled(ExtensionData*ed,StaticVector
 			MACRO_COLLECT_PROFILING_INFORMATION();
 			delete m_dfsData;
 			m_dfsData=new DepthFirstSearchData;
-			m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES);
+			m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+				RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES);
 
 			m_receivedDirections.clear();
 			if(ed->m_EXTENSION_currentSeedIndex%1000==0 && ed->m_EXTENSION_currentPosition==0
@@ -1557,29 +1566,10 @@ BubbleData*bubbleData,int minimumCoverage,OpenAssemblerChooser*oa,int wordSize,v
 
 				m_sequenceIndexToCache++;
 
-			/** this case never happens because m_cacheForRepeatedReads is never populated */
+			/** the read was fetched for a previous seed */
 			}else if(!m_sequenceRequested
-				&&m_cacheForRepeatedReads.find(uniqueId,false)!=NULL){
-
-				SplayNode<ReadHandle,Read>*node=m_cacheForRepeatedReads.find(uniqueId,false);
-
-				#ifdef CONFIG_ASSERT
-				assert(node!=NULL);
-				#endif
-
-				node->getValue()->getSeq(m_receivedString,m_parameters->getColorSpaceMode(),false);
-				PairedRead*pr=node->getValue()->getPairedRead();
-
-				PairedRead dummy;
-				dummy.constructor(0,0,DUMMY_LIBRARY);
-				if(pr==NULL){
-					pr=&dummy;
-				}
+				&&m_readCache.find(uniqueId,m_receivedString,&(ed->m_EXTENSION_pairedRead),&(ed->m_readType))){
 
-				#ifdef CONFIG_ASSERT
-				assert(pr!=NULL);
-				#endif
-				ed->m_EXTENSION_pairedRead=*pr;
 				m_sequenceRequested=true;
 				m_sequenceReceived=true;
 
@@ -1607,6 +1597,8 @@ BubbleData*bubbleData,int minimumCoverage,OpenAssemblerChooser*oa,int wordSize,v
 			/* we will add the read to our soup */
 			}else if(m_sequenceReceived){
 
+				m_readCache.insert(uniqueId,m_receivedString,&(ed->m_EXTENSION_pairedRead),ed->m_readType);
+
 				bool addRead=true;
 				int startPosition=ed->m_EXTENSION_extension.size()-1;
 				int readLength=strlen(m_receivedString);
@@ -1833,11 +1825,11 @@ Chooser*chooser,OpenAssemblerChooser*oa
 
 	m_checkedCheckpoint=false;
 
-	m_cacheForRepeatedReads.constructor();
-	m_cacheForListOfReads.constructor();
 	ostringstream prefixFull;
 	m_parameters=parameters;
 
+	m_readCache.constructor(m_parameters->getReadCacheMemory());
+
 	m_rank=m_parameters->getRank();
 
 	prefixFull<<m_parameters->getMemoryPrefix()<<"_SeedExtender";
@@ -1845,7 +1837,8 @@ Chooser*chooser,OpenAssemblerChooser*oa
 	m_inbox=inbox;
 	m_subgraph=subgraph;
 	m_dfsData=new DepthFirstSearchData;
-	m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES);
+	m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+		RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES);
 	m_cache.constructor();
 	m_ed=ed;
 	m_bubbleTool.constructor(parameters);
@@ -2453,6 +2446,9 @@ void SeedExtender::finalizeExtensions(vector<GraphPath>*seeds,FusionData*fusionD
 	printf("Rank %i extended %i seeds out of %i (%.2f%%)\n",m_parameters->getRank(),
 		m_extended,(int)seeds->size(),ratio);
 
+	m_readCache.printStatistics(m_parameters->getRank());
+	m_readCache.clear();
+
 	MACRO_COLLECT_PROFILING_INFORMATION();
 	if(m_parameters->showMemoryUsage()){
 		showMemoryUsage(m_parameters->getRank());
@@ -2592,6 +2588,48 @@ void SeedExtender::call_RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY(Message*message){
 	#endif
 }
 
+/*
+ * The vertices around the choices of a decision, see DepthFirstSearchData::prefetch
+ *
+ * message: <--vertex--><--vertex-->...
+ * reply: <--vertex--><--edges--><--coverage-->...
+ */
+void SeedExtender::call_RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES(Message*message){
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+	MessageUnit*message2=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+
+	int bufferPosition=0;
+	int outputPosition=0;
+
+	while(bufferPosition<count){
+		Kmer vertex;
+		vertex.unpack(incoming,&bufferPosition);
+
+		Vertex*node=m_subgraph->find(&vertex);
+
+		// if it is not there, then it has a coverage of 0 and no edges
+		uint8_t edges=0;
+		CoverageDepth coverage=0;
+
+		if(node!=NULL){
+			edges=node->getEdges(&vertex);
+			coverage=m_subgraph->getCoverage(node);
+		}
+
+		vertex.pack(message2,&outputPosition);
+		message2[outputPosition++]=edges;
+		message2[outputPosition++]=coverage;
+	}
+
+	Message aMessage(message2,outputPosition,message->getSource(),RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY,m_rank);
+	m_outbox->push_back(&aMessage);
+}
+
+void SeedExtender::call_RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY(Message*message){
+	m_dfsData->receiveVertexAttributes((MessageUnit*)message->getBuffer(),message->getCount());
+}
+
 
 void SeedExtender::call_RAY_MPI_TAG_ADD_GRAPH_PATH(Message*message){
 
@@ -2686,12 +2724,22 @@ void SeedExtender::registerPlugin(ComputeCore*core){
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY, __GetAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY,"RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY");
 
+	RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES, __GetAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES,"RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES");
+
+	RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY, __GetAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY,"RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY");
+
 // this needs to be started here because it is shared between plugins
 
 	m_core->setObjectSymbol(m_plugin,&m_directionsAllocatorInstance,"/RayAssembler/ObjectStore/directionMemoryPool.ray");
 }
 
 void SeedExtender::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_EXTENSION=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_EXTENSION");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
@@ -2711,6 +2759,8 @@ void SeedExtender::resolveSymbols(ComputeCore*core){
 
 	RAY_MPI_TAG_ASK_IS_ASSEMBLED=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_IS_ASSEMBLED");
 	RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY");
+	RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES");
+	RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY");
 
 	__BindPlugin(SeedExtender);
 
@@ -2718,6 +2768,8 @@ void SeedExtender::resolveSymbols(ComputeCore*core){
 	__BindAdapter(SeedExtender,RAY_MPI_TAG_ADD_GRAPH_PATH);
 	__BindAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED); /**/
 	__BindAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY); /**/
+	__BindAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES);
+	__BindAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY);
 
 	m_parameters=(Parameters*)m_core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Parameters.ray");
 
@@ -29,6 +29,7 @@
 #include "OpenAssemblerChooser.h"
 #include "VertexMessenger.h"
 #include "ExtensionData.h"
+#include "ReadCache.h"
 
 #include <code/SequencesLoader/ReadHandle.h>
 #include <code/Mock/common_functions.h>
@@ -38,6 +39,7 @@
 #include <code/SeedingData/SeedingData.h>
 #include <code/FusionData/FusionData.h>
 #include <code/VerticesExtractor/GridTable.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/handlers/SlaveModeHandler.h>
 #include <RayPlatform/core/ComputeCore.h>
@@ -61,6 +63,8 @@ __DeclareSlaveModeAdapter(SeedExtender,RAY_SLAVE_MODE_EXTENSION); /**/
 __DeclareMessageTagAdapter(SeedExtender,RAY_MPI_TAG_ADD_GRAPH_PATH);
 __DeclareMessageTagAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED); /**/
 __DeclareMessageTagAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY); /**/
+__DeclareMessageTagAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES);
+__DeclareMessageTagAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY);
 
 /*
  * Performs the extension of seeds.
@@ -82,6 +86,8 @@ class SeedExtender: public CorePlugin  {
 	__AddAdapter(SeedExtender,RAY_MPI_TAG_ADD_GRAPH_PATH);
 	__AddAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED); /**/
 	__AddAdapter(SeedExtender,RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY); /**/
+	__AddAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES);
+	__AddAdapter(SeedExtender,RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY);
 
 /** hot skipping technology (TM) **/
 
@@ -98,6 +104,8 @@ class SeedExtender: public CorePlugin  {
 
 	MessageTag RAY_MPI_TAG_ASK_IS_ASSEMBLED;
 	MessageTag RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY;
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES;
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY;
 	MessageTag RAY_MPI_TAG_EXTENSION_IS_DONE;
 	MessageTag RAY_MPI_TAG_REQUEST_READ_SEQUENCE;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
@@ -158,10 +166,11 @@ class SeedExtender: public CorePlugin  {
 	int m_extended;
 	bool m_hasPairedSequences;
 	bool m_pickedInformation;
-	SplayTree<ReadHandle,Read>m_cacheForRepeatedReads;
-	SplayTree<uint64_t,ReadAnnotation*> m_cacheForListOfReads;
 	MyAllocator m_cacheAllocator;
 
+	/** reads fetched from other ranks, kept for the next seeds */
+	ReadCache m_readCache;
+
 	vector<int> m_flowedVertices;
 
 	StaticVector*m_inbox;
@@ -198,7 +207,7 @@ class SeedExtender: public CorePlugin  {
 	void printExtensionStatus(Kmer*currentVertex);
 
 	void printTree(Kmer root,
-map<Kmer,set<Kmer> >*arcs,map<Kmer,int>*coverages,int depth,set<Kmer>*visited);
+map<Kmer,set<Kmer> >*arcs,FlatMap<Kmer,int>*coverages,int depth,set<Kmer>*visited);
 
 	void readCheckpoint(FusionData*fusionData);
 	void writeCheckpoint();
@@ -256,6 +265,8 @@ int*receivedVertexCoverage,bool*edgesReceived,vector<Kmer>*receivedOutgoingEdges
 
 	SwitchMan*m_switchMan;
 
+	Instrumentation*m_instrumentation;
+
 public:
 	bool m_sequenceReceived;
 	bool m_sequenceRequested;
@@ -283,6 +294,8 @@ public:
 	void call_RAY_MPI_TAG_ADD_GRAPH_PATH(Message*message);
 	void call_RAY_MPI_TAG_ASK_IS_ASSEMBLED(Message*message);
 	void call_RAY_MPI_TAG_ASK_IS_ASSEMBLED_REPLY(Message*message);
+	void call_RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES(Message*message);
+	void call_RAY_MPI_TAG_REQUEST_VERTEX_ATTRIBUTES_REPLY(Message*message);
 
 	void registerPlugin(ComputeCore*core);
 	void resolveSymbols(ComputeCore*core);
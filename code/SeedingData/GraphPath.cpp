@@ -43,6 +43,7 @@ GraphPath::GraphPath(){
 
 	m_kmerLength=0;
 	m_errorRaised=false;
+	m_numberOfCoverageValues=0;
 
 #ifdef CONFIG_PATH_STORAGE_BLOCK
 	m_size=0;
@@ -79,12 +80,149 @@ void GraphPath::at(int i,Kmer*value)const{
 #endif
 }
 
+static inline uint64_t getCoverageMask(int bits){
+	if(bits>=64)
+		return ~((uint64_t)0);
+
+	return (((uint64_t)1)<<bits)-1;
+}
+
 CoverageDepth GraphPath::getCoverageAt(int position)const{
 
-	if(m_coverageValues.size()==0)
+	if(m_numberOfCoverageValues==0)
 		return 0;
 
-	return m_coverageValues[position];
+	const GraphPathCoverageBlock*block=&(m_coverageBlocks[position/CONFIG_PATH_COVERAGE_BLOCK_SIZE]);
+
+	if(block->m_bits==0)
+		return block->m_base;
+
+	int bit=(position%CONFIG_PATH_COVERAGE_BLOCK_SIZE)*block->m_bits;
+	int index=bit/64;
+	int offset=bit%64;
+
+	uint64_t delta=block->m_content[index]>>offset;
+
+	if(offset+block->m_bits>64)
+		delta|=block->m_content[index+1]<<(64-offset);
+
+	return block->m_base+(delta&getCoverageMask(block->m_bits));
+}
+
+int GraphPath::getCoverageValuesInBlock(int block)const{
+	int values=m_numberOfCoverageValues-block*CONFIG_PATH_COVERAGE_BLOCK_SIZE;
+
+	if(values>CONFIG_PATH_COVERAGE_BLOCK_SIZE)
+		values=CONFIG_PATH_COVERAGE_BLOCK_SIZE;
+
+	return values;
+}
+
+void GraphPath::unpackCoverageBlock(int block,CoverageDepth*values)const{
+	int first=block*CONFIG_PATH_COVERAGE_BLOCK_SIZE;
+	int count=getCoverageValuesInBlock(block);
+
+	for(int i=0;i<count;i++)
+		values[i]=getCoverageAt(first+i);
+}
+
+void GraphPath::packCoverageBlock(int blockNumber,const CoverageDepth*values){
+	GraphPathCoverageBlock*block=&(m_coverageBlocks[blockNumber]);
+	int count=getCoverageValuesInBlock(blockNumber);
+
+	CoverageDepth minimum=values[0];
+	CoverageDepth maximum=values[0];
+
+	for(int i=1;i<count;i++){
+		if(values[i]<minimum)
+			minimum=values[i];
+		if(values[i]>maximum)
+			maximum=values[i];
+	}
+
+	uint64_t range=maximum-minimum;
+	int bits=0;
+
+	while(bits<64 && (range>>bits)!=0)
+		bits++;
+
+	block->m_base=minimum;
+	block->m_bits=bits;
+
+	if(bits==0){
+		vector<uint64_t> empty;
+		block->m_content.swap(empty);
+		return;
+	}
+
+	block->m_content.assign((CONFIG_PATH_COVERAGE_BLOCK_SIZE*bits+63)/64,0);
+
+	for(int i=0;i<count;i++){
+		uint64_t delta=values[i]-minimum;
+		int bit=i*bits;
+		int index=bit/64;
+		int offset=bit%64;
+
+		block->m_content[index]|=delta<<offset;
+
+		if(offset+bits>64)
+			block->m_content[index+1]|=delta>>(64-offset);
+	}
+}
+
+void GraphPath::storeCoverageValue(int position,CoverageDepth value){
+	int blockNumber=position/CONFIG_PATH_COVERAGE_BLOCK_SIZE;
+	GraphPathCoverageBlock*block=&(m_coverageBlocks[blockNumber]);
+	int bits=block->m_bits;
+	uint64_t mask=getCoverageMask(bits);
+
+	// the value fits in the block
+	if(value>=block->m_base && (uint64_t)(value-block->m_base)<=mask){
+
+		if(bits==0)
+			return;
+
+		uint64_t delta=value-block->m_base;
+		int bit=(position%CONFIG_PATH_COVERAGE_BLOCK_SIZE)*bits;
+		int index=bit/64;
+		int offset=bit%64;
+
+		block->m_content[index]&=~(mask<<offset);
+		block->m_content[index]|=delta<<offset;
+
+		if(offset+bits>64){
+			int lowBits=64-offset;
+			block->m_content[index+1]&=~(mask>>lowBits);
+			block->m_content[index+1]|=delta>>lowBits;
+		}
+
+		return;
+	}
+
+	// otherwise the block is packed again
+	CoverageDepth values[CONFIG_PATH_COVERAGE_BLOCK_SIZE];
+	unpackCoverageBlock(blockNumber,values);
+	values[position%CONFIG_PATH_COVERAGE_BLOCK_SIZE]=value;
+	packCoverageBlock(blockNumber,values);
+}
+
+void GraphPath::getCoverageFrequencies(map<CoverageDepth,int>*frequencies)const{
+	CoverageDepth values[CONFIG_PATH_COVERAGE_BLOCK_SIZE];
+
+	for(int block=0;block<(int)m_coverageBlocks.size();block++){
+		int count=getCoverageValuesInBlock(block);
+
+		// a run of identical values
+		if(m_coverageBlocks[block].m_bits==0){
+			(*frequencies)[m_coverageBlocks[block].m_base]+=count;
+			continue;
+		}
+
+		unpackCoverageBlock(block,values);
+
+		for(int i=0;i<count;i++)
+			(*frequencies)[values[i]]++;
+	}
 }
 
 bool GraphPath::canBeAdded(const Kmer*object)const{
@@ -92,11 +230,38 @@ bool GraphPath::canBeAdded(const Kmer*object)const{
 	if(size()==0)
 		return true;
 
+#ifdef CONFIG_PATH_STORAGE_BLOCK
+
+/*
+ * The first k-1 symbols of the object must be the last
+ * k-1 symbols of the path, which start at position size().
+ */
+	Kmer expected;
+	readSymbolsInBlock(size(),m_kmerLength-1,&expected);
+
+	int bits=(m_kmerLength-1)*BITS_PER_NUCLEOTIDE;
+
+	for(int i=0;i<expected.getNumberOfU64();i++){
+		uint64_t word=object->getU64(i);
+		int remaining=bits-64*i;
+
+		if(remaining<=0)
+			word=0;
+		else if(remaining<64)
+			word&=(((uint64_t)1)<<remaining)-1;
+
+		if(word!=expected.getU64(i))
+			return false;
+	}
+
+	return true;
+#else
 	Kmer lastKmer;
 	int position=size()-1;
 	at(position,&lastKmer);
 
 	return lastKmer.canHaveChild(object,m_kmerLength);
+#endif
 }
 
 void GraphPath::push_back(const Kmer*a){
@@ -154,7 +319,8 @@ void GraphPath::clear(){
 }
 
 void GraphPath::resetCoverageValues(){
-	m_coverageValues.clear();
+	m_coverageBlocks.clear();
+	m_numberOfCoverageValues=0;
 }
 
 void GraphPath::computePeakCoverage(){
@@ -166,10 +332,10 @@ void GraphPath::computePeakCoverage(){
 	int selectedAlgorithm=ALGORITHM_STAGGERED_MEAN;
 
 	#ifdef CONFIG_ASSERT
-	if((int)m_coverageValues.size()!=size())
-		cout<<"Error: there are "<<size()<<" objects, but only "<<m_coverageValues.size()<<" coverage values"<<endl;
+	if(m_numberOfCoverageValues!=size())
+		cout<<"Error: there are "<<size()<<" objects, but only "<<m_numberOfCoverageValues<<" coverage values"<<endl;
 
-	assert((int)m_coverageValues.size() == size());
+	assert(m_numberOfCoverageValues == size());
 
 	for(int i = 0 ; i < (int)size() ; ++i) {
 
@@ -202,16 +368,25 @@ CoverageDepth GraphPath::getPeakCoverage()const{
 }
 
 void GraphPath::addCoverageValue(CoverageDepth value){
-	m_coverageValues.push_back(value);
+
+	// a new block starts with a single value and uses no bits
+	if(m_numberOfCoverageValues%CONFIG_PATH_COVERAGE_BLOCK_SIZE==0){
+		GraphPathCoverageBlock block;
+		block.m_base=value;
+		block.m_bits=0;
+		m_coverageBlocks.push_back(block);
+		m_numberOfCoverageValues++;
+		return;
+	}
+
+	m_numberOfCoverageValues++;
+	storeCoverageValue(m_numberOfCoverageValues-1,value);
 }
 
 void GraphPath::computePeakCoverageUsingMode(){
 
 	map<CoverageDepth,int> frequencies;
-
-	for(int i=0;i<(int)m_coverageValues.size();i++){
-		frequencies[m_coverageValues[i]]++;
-	}
+	getCoverageFrequencies(&frequencies);
 
 	int best=-1;
 
@@ -238,10 +413,7 @@ void GraphPath::computePeakCoverageUsingMode(){
 void GraphPath::computePeakCoverageUsingMean(){
 
 	map<CoverageDepth,int> frequencies;
-
-	for(int i=0;i<(int)m_coverageValues.size();i++){
-		frequencies[m_coverageValues[i]]++;
-	}
+	getCoverageFrequencies(&frequencies);
 
 	LargeCount sum=0;
 	LargeCount count=0;
@@ -261,7 +433,7 @@ void GraphPath::computePeakCoverageUsingMean(){
 	}
 
 	#ifdef CONFIG_ASSERT
-	assert(m_coverageValues.size()>=1);
+	assert(m_numberOfCoverageValues>=1);
 	assert(count!=0);
 	assert(count>0);
 	assert(sum > 0);
@@ -278,20 +450,16 @@ void GraphPath::reserve(int size){
 #ifdef CONFIG_PATH_STORAGE_DEFAULT
 	m_vertices.reserve(size);
 #endif
-	m_coverageValues.reserve(size);
+	m_coverageBlocks.reserve(size/CONFIG_PATH_COVERAGE_BLOCK_SIZE+1);
 
 }
 
 void GraphPath::computePeakCoverageUsingStaggeredMean(){
 
 	map<CoverageDepth,int> frequencies;
-	uint64_t totalCount=0;
-
-	for(int i=0;i<(int)m_coverageValues.size();i++){
-		frequencies[m_coverageValues[i]]++;
+	getCoverageFrequencies(&frequencies);
 
-		totalCount++;
-	}
+	uint64_t totalCount=m_numberOfCoverageValues;
 
 	CoverageDepth NO_VALUE=0;
 
@@ -329,7 +497,7 @@ void GraphPath::computePeakCoverageUsingStaggeredMean(){
 		}
 
 		#ifdef CONFIG_ASSERT
-		assert(m_coverageValues.size()>=1);
+		assert(m_numberOfCoverageValues>=1);
 		assert(count!=0);
 		assert(count>0);
 		assert(sum > 0);
@@ -479,19 +647,56 @@ void GraphPath::readObjectInBlock(int position,Kmer*object)const{
 	assert(m_kmerLength!=0);
 	#endif
 
-	char kmer[CONFIG_MAXKMERLENGTH+1];
+	readSymbolsInBlock(position,m_kmerLength,object);
+}
 
-	for(int i=0;i<m_kmerLength;i++){
-		kmer[i]=readSymbolInBlock(position+i);
-	}
+/*
+ * Symbols are stored with 2 bits each in the same order as in Kmer,
+ * so the words of a Kmer are copied directly from the blocks
+ * instead of decoding each symbol.
+ */
+void GraphPath::readSymbolsInBlock(int position,int symbols,Kmer*object)const{
+
+	int firstBit=position*BITS_PER_NUCLEOTIDE;
+	int bits=symbols*BITS_PER_NUCLEOTIDE;
+
+	for(int i=0;i<object->getNumberOfU64();i++){
+		uint64_t word=0;
+		int remaining=bits-64*i;
+
+		if(remaining>0){
+			int bit=firstBit+64*i;
+			int index=bit/64;
+			int offset=bit%64;
 
-	kmer[m_kmerLength]='\0';
+			word=getWordInBlocks(index)>>offset;
+
+			if(offset!=0)
+				word|=getWordInBlocks(index+1)<<(64-offset);
+
+			if(remaining<64)
+				word&=(((uint64_t)1)<<remaining)-1;
+		}
+
+		object->setU64(i,word);
+	}
 
 #ifdef CONFIG_PATH_VERBOSITY
-	cout<<"Object: "<<kmer<<endl;
+	cout<<"Object: "<<object->idToWord(symbols,false)<<endl;
 #endif
+}
+
+/*
+ * Blocks are consecutive, so a word is addressed by its index
+ * over all the blocks.
+ */
+uint64_t GraphPath::getWordInBlocks(int index)const{
+	int blockNumber=index/NUMBER_OF_64_BIT_INTEGERS;
+
+	if(blockNumber>=(int)m_blocks.size())
+		return 0;
 
-	(*object)=wordId(kmer);
+	return m_blocks[blockNumber].m_content[index%NUMBER_OF_64_BIT_INTEGERS];
 }
 
 char GraphPath::readSymbolInBlock(int position)const{
@@ -721,16 +926,16 @@ bool comparePaths(const GraphPath & a,const GraphPath & b){
 void GraphPath::setCoverageValueAt(int position, CoverageDepth value) {
 
 #ifdef CONFIG_ASSERT
-	assert((int)m_coverageValues.size() == size());
+	assert(m_numberOfCoverageValues == size());
 	assert(position < size());
 #endif
 
-	m_coverageValues[position] = value;
+	storeCoverageValue(position, value);
 }
 
 void GraphPath::reserveSpaceForCoverage() {
 
-	m_coverageValues.reserve(size());
+	reserve(size());
 
 	for(int i = 0 ; i < (int) size() ; ++i) {
 
@@ -26,6 +26,7 @@
 
 #include <RayPlatform/store/CarriageableItem.h>
 
+#include <map>
 #include <vector>
 using namespace std;
 
@@ -51,6 +52,28 @@ public:
 };
 #endif
 
+/*
+ * The number of coverage values per coverage block.
+ */
+#define CONFIG_PATH_COVERAGE_BLOCK_SIZE 256
+
+/**
+ * Coverage values are stored in blocks with a frame of reference:
+ * each value is stored as its difference with the smallest value
+ * of the block, using only the bits required by the largest
+ * difference. A block where all the values are equal uses no bits.
+ *
+ * Values can still be changed in any order, the block is packed
+ * again when a new value does not fit.
+ */
+class GraphPathCoverageBlock {
+
+public:
+	CoverageDepth m_base;
+	uint8_t m_bits;
+	vector<uint64_t> m_content;
+};
+
 /**
  * This class describes objects representing assembly seeds.
  * An assembly seed is a path in the de Bruijn graph.
@@ -79,7 +102,8 @@ class GraphPath  : public CarriageableItem {
 	int m_size;
 #endif
 
-	vector<CoverageDepth> m_coverageValues;
+	vector<GraphPathCoverageBlock> m_coverageBlocks;
+	int m_numberOfCoverageValues;
 
 	CoverageDepth m_peakCoverage;
 
@@ -93,8 +117,18 @@ class GraphPath  : public CarriageableItem {
 
 	bool m_hasPeakCoverage;
 
+/** gets the frequency of each coverage value, blocks with one value are not unpacked **/
+	void getCoverageFrequencies(map<CoverageDepth,int>*frequencies)const;
+
+	int getCoverageValuesInBlock(int block)const;
+	void unpackCoverageBlock(int block,CoverageDepth*values)const;
+	void packCoverageBlock(int block,const CoverageDepth*values);
+	void storeCoverageValue(int position,CoverageDepth value);
+
 #ifdef CONFIG_PATH_STORAGE_BLOCK
 	void readObjectInBlock(int position,Kmer*object)const;
+	void readSymbolsInBlock(int position,int symbols,Kmer*object)const;
+	uint64_t getWordInBlocks(int index)const;
 	void writeObjectInBlock(const Kmer*a);
 #endif
 
@@ -75,8 +75,15 @@ void SeedWorker::work(){
 	// check if currentVertex has 1 ingoing edge and 1 outgoing edge, if yes, add it
 	}else if(m_elongationMode){
 
+		// the last added vertex starts a unitig
+		if(m_fetchingUnitig){
+			if(m_unitigFetcher.fetchUnitig(&m_unitigStart)){
+				m_fetchingUnitig=false;
+				addUnitig();
+			}
+
 		// attempt to add m_SEEDING_currentVertex
-		if(!m_SEEDING_1_1_test_done){
+		}else if(!m_SEEDING_1_1_test_done){
 			do_1_1_test();
 		}else{
 			if(m_SEEDING_vertices.count(m_SEEDING_currentVertex)>0){// avoid infinite loops.
@@ -127,6 +134,18 @@ void SeedWorker::work(){
 					m_SEEDING_seed.addCoverageValue(m_cache[m_SEEDING_currentVertex]);
 
 					m_SEEDING_vertices.insert(m_SEEDING_currentVertex);
+
+					// a vertex starts a unitig unless its only parent has only one child
+					if(m_useUnitigs && (m_SEEDING_seed.size()==1
+						|| m_SEEDING_receivedIngoingEdges.size()!=1
+						|| m_lastOutgoingDegree!=1)){
+
+						m_unitigStart=m_SEEDING_currentVertex;
+						m_unitigFetcher.reset();
+						m_fetchingUnitig=true;
+					}
+
+					m_lastOutgoingDegree=m_SEEDING_receivedOutgoingEdges.size();
 					m_SEEDING_currentVertex=m_SEEDING_currentChildVertex;
 					m_SEEDING_testInitiated=false;
 					m_SEEDING_1_1_test_done=false;
@@ -149,6 +168,63 @@ void SeedWorker::work(){
 	}
 }
 
+/*
+ * Adds the interior vertices of the unitig that starts with the last
+ * added vertex. An interior vertex has one parent and one child, so the
+ * 1-1 test only needs the coverage values of the unitig.
+ */
+void SeedWorker::addUnitig(){
+
+	vector<Kmer>*vertices=m_unitigFetcher.getVertices();
+	vector<CoverageDepth>*coverageValues=m_unitigFetcher.getCoverageValues();
+
+	int length=vertices->size();
+
+	if(length<3)
+		return;
+
+	for(int i=0;i<length;i++)
+		m_cache[vertices->at(i)]=coverageValues->at(i);
+
+	int minimumCoverageToStore=m_parameters->getMinimumCoverageToStore();
+
+	int i=1;
+
+	while(i<length-1){
+		Kmer vertex=vertices->at(i);
+		int coverage=coverageValues->at(i);
+
+		if(m_SEEDING_vertices.count(vertex)>0
+			|| coverageValues->at(i-1)>=2*coverage
+			|| coverageValues->at(i+1)>=2*coverage
+			|| coverage<minimumCoverageToStore){
+
+			break;
+		}
+
+		m_SEEDING_seed.push_back(&vertex);
+		m_SEEDING_seed.addCoverageValue(coverage);
+		m_SEEDING_vertices.insert(vertex);
+
+		i++;
+	}
+
+	if(i==1)
+		return;
+
+	// the vertex i did not pass the test
+	if(i<length-1){
+		m_elongationMode=false;
+		m_endChecksMode=true;
+		return;
+	}
+
+	m_lastOutgoingDegree=1;
+	m_SEEDING_currentVertex=vertices->at(length-1);
+	m_SEEDING_testInitiated=false;
+	m_SEEDING_1_1_test_done=false;
+}
+
 bool SeedWorker::getPathAfter(Kmer*kmer,int depth){
 
 	Kmer object=*kmer;
@@ -380,7 +456,8 @@ void SeedWorker::constructor(Kmer*key,Parameters*parameters,RingAllocator*outbox
 		VirtualCommunicator*virtualCommunicator,WorkerHandle workerId,
 
 	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
+	MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK
 ){
 
 	m_active = true;
@@ -395,6 +472,7 @@ void SeedWorker::constructor(Kmer*key,Parameters*parameters,RingAllocator*outbox
 
 	this->RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE=RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
 	this->RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT=RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
+	this->RAY_MPI_TAG_GET_UNITIG_CHUNK=RAY_MPI_TAG_GET_UNITIG_CHUNK;
 
 	m_workerIdentifier=workerId;
 	m_virtualCommunicator=virtualCommunicator;
@@ -432,6 +510,14 @@ void SeedWorker::constructor(Kmer*key,Parameters*parameters,RingAllocator*outbox
 			m_workerIdentifier, m_outboxAllocator,
 			RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT);
 
+	m_useUnitigs=m_parameters->hasOption("-compact-unitigs");
+	m_fetchingUnitig=false;
+	m_lastOutgoingDegree=0;
+
+	if(m_useUnitigs)
+		m_unitigFetcher.initialize(m_parameters,m_virtualCommunicator,
+			m_workerIdentifier,m_outboxAllocator,
+			RAY_MPI_TAG_GET_UNITIG_CHUNK);
 }
 
 void SeedWorker::enableDebugMode(){
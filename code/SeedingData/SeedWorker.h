@@ -25,6 +25,7 @@
 #include "DepthFirstSearch.h"
 
 #include <code/SeedingData/GraphPath.h>
+#include <code/UnitigCompactor/UnitigFetcher.h>
 #include <code/Mock/Parameters.h>
 
 #include <RayPlatform/memory/RingAllocator.h>
@@ -52,6 +53,19 @@ private:
 
 	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
+	MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK;
+
+/*
+ * Unitigs computed by UnitigCompactor, when -compact-unitigs is provided.
+ * The interior of a unitig is added without doing a 1-1 test on each vertex.
+ */
+	bool m_useUnitigs;
+	bool m_fetchingUnitig;
+	Kmer m_unitigStart;
+	int m_lastOutgoingDegree;
+	UnitigFetcher m_unitigFetcher;
+
+	void addUnitig();
 
 	int m_mainVertexCoverage;
 
@@ -149,7 +163,8 @@ public:
 		VirtualCommunicator*vc,WorkerHandle workerId,
 
 	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
+	MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK
 );
 
 	GraphPath*getSeed();
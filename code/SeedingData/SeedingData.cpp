@@ -45,6 +45,8 @@ __CreateSlaveModeAdapter(SeedingData,RAY_SLAVE_MODE_SEND_SEED_LENGTHS);
 
 
 void SeedingData::call_RAY_SLAVE_MODE_START_SEEDING(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_START_SEEDING);
+
 	if(!m_initiatedIterator){
 		m_last=time(NULL);
 
@@ -244,7 +246,8 @@ void SeedingData::call_RAY_SLAVE_MODE_START_SEEDING(){
 
 				m_aliveWorkers[m_SEEDING_i].constructor(&vertexKey,m_parameters,m_outboxAllocator,m_virtualCommunicator,m_SEEDING_i,
 RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
+RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
+RAY_MPI_TAG_GET_UNITIG_CHUNK
 );
 				if(m_debugSeeds)
 					m_aliveWorkers[m_SEEDING_i].enableDebugMode();
@@ -409,6 +412,8 @@ void SeedingData::updateStates(){
 }
 
 void SeedingData::call_RAY_SLAVE_MODE_SEND_SEED_LENGTHS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_SEND_SEED_LENGTHS);
+
 	if(!m_initialized){
 
 		m_virtualCommunicator->resetCounters();
@@ -513,12 +518,15 @@ void SeedingData::registerPlugin(ComputeCore*core){
 }
 
 void SeedingData::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_START_SEEDING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_START_SEEDING");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 	RAY_SLAVE_MODE_SEND_SEED_LENGTHS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_SEND_SEED_LENGTHS");
 
 	RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT");
 	RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE");
+	RAY_MPI_TAG_GET_UNITIG_CHUNK=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_UNITIG_CHUNK");
 
 	RAY_MPI_TAG_IS_DONE_SENDING_SEED_LENGTHS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_IS_DONE_SENDING_SEED_LENGTHS");
 	RAY_MPI_TAG_SEEDING_IS_OVER=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_SEEDING_IS_OVER");
@@ -32,6 +32,7 @@ class SeedExtender;
 #include <code/VerticesExtractor/GridTableIterator.h>
 #include <code/VerticesExtractor/Vertex.h>
 #include <code/Mock/common_functions.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/communication/VirtualCommunicator.h>
 #include <RayPlatform/structures/SplayTreeIterator.h>
@@ -72,6 +73,7 @@ class SeedingData : public CorePlugin{
 
 	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
+	MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK;
 
 	SlaveMode RAY_SLAVE_MODE_DO_NOTHING;
 	SlaveMode RAY_SLAVE_MODE_START_SEEDING;
@@ -128,6 +130,8 @@ class SeedingData : public CorePlugin{
 	void loadCheckpoint();
 
 	void writeCheckpoints();
+	Instrumentation*m_instrumentation;
+
 public:
 
 	// TODO: move these attributes in the private zone
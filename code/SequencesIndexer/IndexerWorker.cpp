@@ -21,8 +21,6 @@
 
 #include "IndexerWorker.h"
 
-#include <RayPlatform/core/statistics.h>
-
 #include <string.h>
 
 void IndexerWorker::constructor(int sequenceId,Parameters*parameters,RingAllocator*outboxAllocator,
@@ -58,6 +56,7 @@ void IndexerWorker::constructor(int sequenceId,Parameters*parameters,RingAllocat
 	m_fetchedCoverageValues=false;
 	m_coverages.constructor();
 	m_vertices.constructor();
+	m_selector.constructor(m_parameters);
 }
 
 bool IndexerWorker::isDone(){
@@ -97,53 +96,11 @@ void IndexerWorker::work(){
 	}else if(!m_forwardIndexed){
 		if(!m_vertexIsDone){
 
-			// the position is selected with an algorithm
-			int selectedPosition=-1;
-
-#ifdef CONFIG_USE_COVERAGE_DISTRIBUTION
-			// find a vertex that is not an error and that is not repeated
-			for(int i=0;i<(int)m_coverages.size()/2;i++){
-				int coverage=(m_coverages).at(i);
-				if(coverage>=m_parameters->getMinimumCoverage()/2&&coverage<m_parameters->getPeakCoverage()*2){
-					selectedPosition=i;
-					break;
-				}
-			}
-
-			// find a vertex that is not an error 
-			if(selectedPosition==-1){
-				for(int i=0;i<(int)m_coverages.size();i++){
-					int coverage=(m_coverages).at(i);
-					if(coverage>=m_parameters->getMinimumCoverage()/2){
-						selectedPosition=i;
-						break;
-					}
-				}
-	
-			}
-
-#else
-	// get the average
-	// take the first above the average/2
-	// gg
-
 			vector<int> data;
+			getCoverages(&data);
 
-			for(int i=0;i<(int)m_coverages.size();i++){
-				int coverageValue=m_coverages.at(i);
-				data.push_back(coverageValue);
-			}
-
-			int threshold=getThreshold(&data);
-
-			for(int i=0;i<(int)m_coverages.size();i++){
-				if(m_coverages.at(i)>=threshold){
-					selectedPosition=i;
-					break;
-				}
-			}
-
-#endif
+			// the position is selected with an algorithm
+			int selectedPosition=m_selector.selectForwardMarker(&data);
 
 			// index it
 			if(selectedPosition!=-1){
@@ -172,54 +129,12 @@ void IndexerWorker::work(){
 		}
 	}else if(!m_reverseIndexed){
 		if(!m_vertexIsDone){
-			// the position is selected with an algorithm
-			int selectedPosition=-1;
-
-#ifdef CONFIG_USE_COVERAGE_DISTRIBUTION
-
-			// find a vertex that is not an error and that is not repeated
-			for(int i=(int)(m_coverages).size()-1;i>=(int)m_coverages.size()/2;i--){
-				int coverage=(m_coverages).at(i);
-				if(coverage>=m_parameters->getMinimumCoverage()/2&&coverage<m_parameters->getPeakCoverage()*2){
-					selectedPosition=i;
-					break;
-				}
-			}
-
-			// find a vertex that is not an error 
-			if(selectedPosition==-1){
-				for(int i=(int)(m_coverages).size()-1;i>=0;i--){
-					int coverage=(m_coverages).at(i);
-					if(coverage>=m_parameters->getMinimumCoverage()/2){
-						selectedPosition=i;
-						break;
-					}
-				}
-	
-			}
-
-#else
-	// get the average
-	// take the first above the average/2
-	// gg
 
 			vector<int> data;
+			getCoverages(&data);
 
-			for(int i=0;i<(int)m_coverages.size();i++){
-				int coverageValue=m_coverages.at(i);
-				data.push_back(coverageValue);
-			}
-
-			int threshold=getThreshold(&data);
-
-			for(int i=m_coverages.size()-1;i>=0;i--){
-				if(m_coverages.at(i)>=threshold){
-					selectedPosition=i;
-					break;
-				}
-			}
-
-#endif
+			// the position is selected with an algorithm
+			int selectedPosition=m_selector.selectReverseMarker(&data);
 
 			// index it
 			if(selectedPosition!=-1){
@@ -248,36 +163,15 @@ void IndexerWorker::work(){
 		}
 
 	}else{
-		if(m_parameters->hasOption("-write-read-markers")){
-			#ifdef CONFIG_ASSERT
-			assert(m_readMarkerFile != NULL);
-			#endif
-
-			// append read marker information to a file.
-			(*m_readMarkerFile)<<m_sequenceId<<" Count: "<<m_coverages.size();
+		vector<int> data;
+		getCoverages(&data);
 
+		if(m_parameters->hasOption("-write-read-markers")){
 			#ifdef CONFIG_ASSERT
 			assert(m_workerId < (int)m_reads->size());
 			#endif
 
-			(*m_readMarkerFile)<<" Selections:";
-			(*m_readMarkerFile)<<" "<<m_reads->at(m_workerId)->getForwardOffset();
-			(*m_readMarkerFile)<<" "<<m_reads->at(m_workerId)->getReverseOffset();
-
-			(*m_readMarkerFile)<<" Values:";
-
-			vector<int> data;
-
-			for(int i=0;i<(int)m_coverages.size();i++){
-				int coverageValue=m_coverages.at(i);
-				(*m_readMarkerFile)<<" "<<i<<" "<<coverageValue;
-				data.push_back(coverageValue);
-			}
-
-			(*m_readMarkerFile)<<" average: "<<getAverage(&data);
-
-			(*m_readMarkerFile)<<endl;
-
+			m_selector.writeMarkers(m_readMarkerFile,m_sequenceId,m_reads->at(m_workerId),&data);
 		}
 
 		if(m_parameters->hasOption("-write-marker-summary")){
@@ -285,33 +179,7 @@ void IndexerWorker::work(){
 			assert(m_workerId < (int)m_reads->size());
 			#endif
 
-			int forwardOffset = m_reads->at(m_workerId)->getForwardOffset();
-
-			if(forwardOffset < m_coverages.size() && m_coverages.size() > 0){
-				#ifdef CONFIG_ASSERT
-				assert(m_coverages.size() > 0);
-				#endif
-
-				int forwardCoverage = m_coverages.at(forwardOffset);
-				(*m_forwardStatistics)[forwardOffset][forwardCoverage] ++ ;
-			}else{
-				// invalid selection, probably because there are nothing to poke around
-				(*m_forwardStatistics)[-1][-1] ++ ;
-			}
-
-			int reverseOffset = m_reads->at(m_workerId)->getReverseOffset();
-
-			if(reverseOffset < m_coverages.size() && m_coverages.size() > 0){
-				#ifdef CONFIG_ASSERT
-				assert(m_coverages.size() > 0);
-				#endif
-
-				int reverseCoverage = m_coverages.at(m_coverages.size()- 1 - reverseOffset);
-				(*m_reverseStatistics)[reverseOffset][reverseCoverage] ++ ;
-			}else{
-				// invalid selection, probably because there are nothing to poke around
-				(*m_reverseStatistics)[-1][-1] ++ ;
-			}
+			m_selector.addStatistics(m_forwardStatistics,m_reverseStatistics,m_reads->at(m_workerId),&data);
 		}
 
 		m_vertices.destructor(m_allocator);
@@ -324,39 +192,8 @@ WorkerHandle IndexerWorker::getWorkerIdentifier(){
 	return m_workerId;
 }
 
-// we want a (local) threshold that removes things that are errors
-int IndexerWorker::getThreshold(vector<int>*data){
-	// now, we know that repeats will add bias to the average...
-	// so if the average is too large
-	// we want to correct this
-	
-	int multiplicator=2;
-
-	int bestScore=0;
-	int bestEntry=-1;
-
-	for(int value=10;value>=1;value--){
-		int bin1=value;
-		int bin2=value*multiplicator;
-		
-		int bin1Count=0;
-		int bin2Count=0;
-
-		for(int i=0;i<(int)data->size();i++){
-			int point=data->at(i);
-			if(point<=bin1)
-				bin1Count++;
-			if(point>=bin2)
-				bin2Count++;
-		}
-		
-		int score=bin1Count+bin2Count;
-
-		if(bestEntry==-1 || score > bestScore){
-			bestEntry=value;
-			bestScore=score;
-		}
+void IndexerWorker::getCoverages(vector<int>*data){
+	for(int i=0;i<(int)m_coverages.size();i++){
+		data->push_back(m_coverages.at(i));
 	}
-
-	return multiplicator*bestEntry;
 }
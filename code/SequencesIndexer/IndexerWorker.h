@@ -23,6 +23,7 @@
 #define _IndexerWorker
 
 #include "DynamicVector.h"
+#include "ReadMarkerSelector.h"
 
 #include <code/Mock/Parameters.h>
 #include <code/SequencesLoader/ArrayOfReads.h>
@@ -74,7 +75,9 @@ class IndexerWorker /*: public Worker*/{
 	DynamicVector<Kmer> m_vertices;
 	DynamicVector<int> m_coverages;
 
-	int getThreshold(vector<int>*data);
+	ReadMarkerSelector m_selector;
+
+	void getCoverages(vector<int>*data);
 
 public:
 	void constructor(int sequenceId,Parameters*parameters,RingAllocator*outboxAllocator,
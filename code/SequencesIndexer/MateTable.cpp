@@ -0,0 +1,95 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "MateTable.h"
+
+#include <assert.h>
+
+void MateTable::constructor(Parameters*parameters){
+	m_parameters=parameters;
+	m_fileStarts.clear();
+}
+
+/*
+ * The number of sequences in each file is only known once
+ * the files are counted, so the table is built on first use.
+ */
+void MateTable::buildTable(){
+	LargeIndex start=0;
+
+	for(int file=0;file<m_parameters->getNumberOfFiles();file++){
+		m_fileStarts.push_back(start);
+		start+=m_parameters->getNumberOfSequences(file);
+	}
+
+	m_fileStarts.push_back(start);
+}
+
+bool MateTable::getMate(Rank rank,int readIndex,PairedRead*mate){
+	if(m_fileStarts.size()==0)
+		buildTable();
+
+	ReadHandle globalIdentifier=m_parameters->getGlobalIdFromRankAndLocalId(rank,readIndex);
+
+	// find the file with a binary search
+	int first=0;
+	int last=m_fileStarts.size()-2;
+
+	while(first<last){
+		int middle=first+(last-first+1)/2;
+
+		if(m_fileStarts[middle]<=globalIdentifier)
+			first=middle;
+		else
+			last=middle-1;
+	}
+
+	int file=first;
+
+	#ifdef CONFIG_ASSERT
+	assert(file>=0);
+	assert(m_fileStarts[file]<=globalIdentifier);
+	assert(globalIdentifier<m_fileStarts[file+1]);
+	#endif
+
+	LargeCount sequencesInFile=m_fileStarts[file+1]-m_fileStarts[file];
+	LargeIndex positionInFile=globalIdentifier-m_fileStarts[file];
+	ReadHandle mateIdentifier=0;
+
+	// same rules as in SequencesLoader::registerSequence
+	if(m_parameters->isLeftFile(file)){
+		mateIdentifier=globalIdentifier+sequencesInFile;
+	}else if(m_parameters->isRightFile(file)){
+		mateIdentifier=globalIdentifier-sequencesInFile;
+	}else if(m_parameters->isInterleavedFile(file) && positionInFile%2==0){
+		mateIdentifier=globalIdentifier+1;
+	}else if(m_parameters->isInterleavedFile(file) && positionInFile%2==1){
+		mateIdentifier=globalIdentifier-1;
+	}else{
+		return false;
+	}
+
+	Rank mateRank=m_parameters->getRankFromGlobalId(mateIdentifier);
+	int mateIndex=m_parameters->getIdFromGlobalId(mateIdentifier);
+
+	mate->constructor(mateRank,mateIndex,m_parameters->getLibrary(file));
+
+	return true;
+}
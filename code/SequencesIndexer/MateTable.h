@@ -0,0 +1,63 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _MateTable_h
+#define _MateTable_h
+
+#include "PairedRead.h"
+
+#include <code/Mock/Parameters.h>
+
+#include <vector>
+using namespace std;
+
+/**
+ * Resolves the mate of any read without communication.
+ *
+ * SequencesLoader gives global identifiers in file order and pairs
+ * reads with a rule that depends only on the file (left/right files
+ * and interleaved files). Since the file entries are known by every
+ * rank, the mate of a read can be computed from its rank and its
+ * index on that rank. The table is therefore replicated but only
+ * stores one offset per file.
+ *
+ * \author agent
+ */
+class MateTable{
+
+	Parameters*m_parameters;
+
+	/** global identifier of the first sequence of each file */
+	vector<LargeIndex> m_fileStarts;
+
+	void buildTable();
+
+public:
+
+	void constructor(Parameters*parameters);
+
+	/**
+	 * Gets the mate of the read <rank,readIndex>.
+	 * Returns false if the read is not paired.
+	 */
+	bool getMate(Rank rank,int readIndex,PairedRead*mate);
+};
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "ReadMarkerSelector.h"
+
+#include <RayPlatform/core/statistics.h>
+
+#include <assert.h>
+
+void ReadMarkerSelector::constructor(Parameters*parameters){
+	m_parameters=parameters;
+}
+
+int ReadMarkerSelector::selectForwardMarker(vector<int>*coverages){
+
+	// the position is selected with an algorithm
+	int selectedPosition=-1;
+
+#ifdef CONFIG_USE_COVERAGE_DISTRIBUTION
+	// find a vertex that is not an error and that is not repeated
+	for(int i=0;i<(int)coverages->size()/2;i++){
+		int coverage=coverages->at(i);
+		if(coverage>=m_parameters->getMinimumCoverage()/2&&coverage<m_parameters->getPeakCoverage()*2){
+			selectedPosition=i;
+			break;
+		}
+	}
+
+	// find a vertex that is not an error 
+	if(selectedPosition==-1){
+		for(int i=0;i<(int)coverages->size();i++){
+			int coverage=coverages->at(i);
+			if(coverage>=m_parameters->getMinimumCoverage()/2){
+				selectedPosition=i;
+				break;
+			}
+		}
+	}
+
+#else
+	// get the average
+	// take the first above the average/2
+
+	int threshold=getThreshold(coverages);
+
+	for(int i=0;i<(int)coverages->size();i++){
+		if(coverages->at(i)>=threshold){
+			selectedPosition=i;
+			break;
+		}
+	}
+#endif
+
+	return selectedPosition;
+}
+
+int ReadMarkerSelector::selectReverseMarker(vector<int>*coverages){
+
+	// the position is selected with an algorithm
+	int selectedPosition=-1;
+
+#ifdef CONFIG_USE_COVERAGE_DISTRIBUTION
+
+	// find a vertex that is not an error and that is not repeated
+	for(int i=(int)coverages->size()-1;i>=(int)coverages->size()/2;i--){
+		int coverage=coverages->at(i);
+		if(coverage>=m_parameters->getMinimumCoverage()/2&&coverage<m_parameters->getPeakCoverage()*2){
+			selectedPosition=i;
+			break;
+		}
+	}
+
+	// find a vertex that is not an error 
+	if(selectedPosition==-1){
+		for(int i=(int)coverages->size()-1;i>=0;i--){
+			int coverage=coverages->at(i);
+			if(coverage>=m_parameters->getMinimumCoverage()/2){
+				selectedPosition=i;
+				break;
+			}
+		}
+	}
+
+#else
+	// get the average
+	// take the first above the average/2
+
+	int threshold=getThreshold(coverages);
+
+	for(int i=coverages->size()-1;i>=0;i--){
+		if(coverages->at(i)>=threshold){
+			selectedPosition=i;
+			break;
+		}
+	}
+#endif
+
+	return selectedPosition;
+}
+
+void ReadMarkerSelector::writeMarkers(ofstream*file,int sequenceId,Read*read,vector<int>*coverages){
+
+	#ifdef CONFIG_ASSERT
+	assert(file != NULL);
+	#endif
+
+	// append read marker information to a file.
+	(*file)<<sequenceId<<" Count: "<<coverages->size();
+
+	(*file)<<" Selections:";
+	(*file)<<" "<<read->getForwardOffset();
+	(*file)<<" "<<read->getReverseOffset();
+
+	(*file)<<" Values:";
+
+	for(int i=0;i<(int)coverages->size();i++){
+		(*file)<<" "<<i<<" "<<coverages->at(i);
+	}
+
+	(*file)<<" average: "<<getAverage(coverages);
+
+	(*file)<<endl;
+}
+
+void ReadMarkerSelector::addStatistics(map<int,map<int,int> >*forwardStatistics,map<int,map<int,int> >*reverseStatistics,
+	Read*read,vector<int>*coverages){
+
+	int forwardOffset = read->getForwardOffset();
+
+	if(forwardOffset < (int)coverages->size() && coverages->size() > 0){
+		int forwardCoverage = coverages->at(forwardOffset);
+		(*forwardStatistics)[forwardOffset][forwardCoverage] ++ ;
+	}else{
+		// invalid selection, probably because there are nothing to poke around
+		(*forwardStatistics)[-1][-1] ++ ;
+	}
+
+	int reverseOffset = read->getReverseOffset();
+
+	if(reverseOffset < (int)coverages->size() && coverages->size() > 0){
+		int reverseCoverage = coverages->at(coverages->size()- 1 - reverseOffset);
+		(*reverseStatistics)[reverseOffset][reverseCoverage] ++ ;
+	}else{
+		// invalid selection, probably because there are nothing to poke around
+		(*reverseStatistics)[-1][-1] ++ ;
+	}
+}
+
+// we want a (local) threshold that removes things that are errors
+int ReadMarkerSelector::getThreshold(vector<int>*data){
+	// now, we know that repeats will add bias to the average...
+	// so if the average is too large
+	// we want to correct this
+	
+	int multiplicator=2;
+
+	int bestScore=0;
+	int bestEntry=-1;
+
+	for(int value=10;value>=1;value--){
+		int bin1=value;
+		int bin2=value*multiplicator;
+		
+		int bin1Count=0;
+		int bin2Count=0;
+
+		for(int i=0;i<(int)data->size();i++){
+			int point=data->at(i);
+			if(point<=bin1)
+				bin1Count++;
+			if(point>=bin2)
+				bin2Count++;
+		}
+		
+		int score=bin1Count+bin2Count;
+
+		if(bestEntry==-1 || score > bestScore){
+			bestEntry=value;
+			bestScore=score;
+		}
+	}
+
+	return multiplicator*bestEntry;
+}
@@ -0,0 +1,64 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _ReadMarkerSelector_h
+#define _ReadMarkerSelector_h
+
+#include <code/Mock/Parameters.h>
+#include <code/SequencesLoader/Read.h>
+
+#include <map>
+#include <vector>
+#include <fstream>
+using namespace std;
+
+/**
+ * Selects the optimal read markers of a read from the coverage
+ * of its k-mers. It is shared by IndexerWorker (one coverage
+ * query per k-mer) and by the bulk indexing of SequencesIndexer
+ * so that both select the same markers.
+ *
+ * \author agent
+ */
+class ReadMarkerSelector{
+
+	Parameters*m_parameters;
+
+	int getThreshold(vector<int>*data);
+
+public:
+
+	void constructor(Parameters*parameters);
+
+	/** returns the position of the forward marker, -1 if there is none */
+	int selectForwardMarker(vector<int>*coverages);
+
+	/** returns the position (on the forward strand) of the reverse marker, -1 if there is none */
+	int selectReverseMarker(vector<int>*coverages);
+
+	/** for -write-read-markers */
+	void writeMarkers(ofstream*file,int sequenceId,Read*read,vector<int>*coverages);
+
+	/** for -write-marker-summary */
+	void addStatistics(map<int,map<int,int> >*forwardStatistics,map<int,map<int,int> >*reverseStatistics,
+		Read*read,vector<int>*coverages);
+};
+
+#endif
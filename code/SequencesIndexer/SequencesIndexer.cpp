@@ -34,8 +34,18 @@
 __CreatePlugin(SequencesIndexer);
 
 __CreateSlaveModeAdapter(SequencesIndexer,RAY_SLAVE_MODE_INDEX_SEQUENCES);
+__CreateMessageTagAdapter(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES);
+__CreateMessageTagAdapter(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY);
+
+/** number of reads processed together by -bulk-read-indexing */
+#define BULK_INDEXING_READS_PER_BATCH 4096
+
+/** upper bound on messages sent per call by -bulk-read-indexing */
+#define BULK_INDEXING_MESSAGES_PER_CALL 8
 
 void SequencesIndexer::call_RAY_SLAVE_MODE_INDEX_SEQUENCES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_INDEX_SEQUENCES);
+
 	if(!m_initiatedIterator){
 		m_theSequenceId=0;
 
@@ -58,6 +68,11 @@ void SequencesIndexer::call_RAY_SLAVE_MODE_INDEX_SEQUENCES(){
 		m_checkedCheckpoint=true;
 	}
 
+	if(m_bulkIndexing){
+		indexReadsInBulk();
+		return;
+	}
+
 	m_virtualCommunicator->processInbox(&m_activeWorkersToRestore);
 
 	if(!m_virtualCommunicator->isReady()){
@@ -142,79 +157,334 @@ void SequencesIndexer::call_RAY_SLAVE_MODE_INDEX_SEQUENCES(){
 	#endif
 
 	if((int)m_myReads->size()==m_completedJobs){
-		printf("Rank %i is selecting optimal read markers [%i/%i] (completed)\n",m_rank,(int)m_myReads->size(),(int)m_myReads->size());
+		finishIndexing();
+	}
+}
+
+void SequencesIndexer::finishIndexing(){
+	printf("Rank %i is selecting optimal read markers [%i/%i] (completed)\n",m_rank,(int)m_myReads->size(),(int)m_myReads->size());
+	if(!m_bulkIndexing)
 		printf("Rank %i: peak number of workers: %i, maximum: %i\n",m_rank,m_maximumWorkers,m_maximumAliveWorkers);
-		(*m_mode)=RAY_SLAVE_MODE_DO_NOTHING;
-		Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_MASTER_IS_DONE_ATTACHING_READS_REPLY,m_rank);
-		m_outbox->push_back(&aMessage);
+	(*m_mode)=RAY_SLAVE_MODE_DO_NOTHING;
+	Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_MASTER_IS_DONE_ATTACHING_READS_REPLY,m_rank);
+	m_outbox->push_back(&aMessage);
 
-		m_derivative.writeFile(&cout);
+	m_derivative.writeFile(&cout);
 
+	if(!m_bulkIndexing)
 		m_virtualCommunicator->printStatistics();
 
-		if(m_parameters->showMemoryUsage()){
-			showMemoryUsage(m_rank);
+	if(m_parameters->showMemoryUsage()){
+		showMemoryUsage(m_rank);
+	}
+
+	#ifdef CONFIG_ASSERT
+	assert(m_aliveWorkers.size()==0);
+	assert(m_activeWorkers.size()==0);
+	#endif
+
+	int freed=m_workAllocator.getNumberOfChunks()*m_workAllocator.getChunkSize();
+	m_workAllocator.clear();
+
+	if(m_parameters->showMemoryUsage()){
+		cout<<"Rank "<<m_parameters->getRank()<<": Freeing unused assembler memory: "<<freed/1024<<" KiB freed"<<endl;
+		showMemoryUsage(m_rank);
+	}
+
+	if(m_parameters->hasOption("-write-read-markers")){
+		m_readMarkerFile.close();
+	}
+
+	if(m_parameters->hasOption("-write-marker-summary")){
+
+		ostringstream file1;
+		file1<<m_parameters->getPrefix()<<"Rank"<<m_parameters->getRank()<<".ForwardMarkerSummary.txt";
+		string fileName1=file1.str();
+		ofstream f1(fileName1.c_str());
+
+		for(map<int,map<int,int> >::iterator i=m_forwardStatistics.begin();i!=m_forwardStatistics.end();i++){
+			int offset=i->first;
+			for(map<int,int>::iterator j=i->second.begin();j!=i->second.end();j++){
+				int coverage=j->first;
+				int count=j->second;
+				f1<<offset<<"	"<<coverage<<"	"<<count<<endl;
+			}
+		}
+		f1.close();
+
+		ostringstream file2;
+		file2<<m_parameters->getPrefix()<<"Rank"<<m_parameters->getRank()<<".ReverseMarkerSummary.txt";
+		string fileName2=file2.str();
+		ofstream f2(fileName2.c_str());
+
+		for(map<int,map<int,int> >::iterator i=m_reverseStatistics.begin();i!=m_reverseStatistics.end();i++){
+			int offset=i->first;
+			for(map<int,int>::iterator j=i->second.begin();j!=i->second.end();j++){
+				int coverage=j->first;
+				int count=j->second;
+				f2<<offset<<"	"<<coverage<<"	"<<count<<endl;
+			}
 		}
+		f2.close();
 
-		#ifdef CONFIG_ASSERT
-		assert(m_aliveWorkers.size()==0);
-		assert(m_activeWorkers.size()==0);
-		#endif
+	}
+
+	m_forwardStatistics.clear();
+	m_reverseStatistics.clear();
+}
+
+/*
+ * Bulk-synchronous read indexing (-bulk-read-indexing).
+ *
+ * Instead of running one worker per read, each issuing one coverage
+ * query per k-mer through the virtual communicator, reads are processed
+ * in batches of BULK_INDEXING_READS_PER_BATCH. The k-mers of a batch are
+ * grouped by owner and their coverages are obtained with a few large
+ * messages. Markers are then selected with the same ReadMarkerSelector
+ * used by IndexerWorker and attached with RAY_MPI_TAG_ATTACH_SEQUENCE,
+ * again grouped by owner.
+ */
+void SequencesIndexer::indexReadsInBulk(){
+
+	if(!m_batchIsLoaded){
+		if(m_theSequenceId==(int)m_myReads->size()){
+			finishIndexing();
+			return;
+		}
+
+		loadBatch();
+		return;
+	}
+
+	if(!m_batchHasCoverages){
+		if(!sendBatchMessages(RAY_MPI_TAG_INDEX_KMER_COVERAGES,KMER_U64_ARRAY_SIZE+1))
+			return;
+
+		if(m_pendingMessages>0)
+			return;
+
+		m_batchHasCoverages=true;
+		attachBatchMarkers();
+		return;
+	}
+
+	if(!sendBatchMessages(RAY_MPI_TAG_ATTACH_SEQUENCE,KMER_U64_ARRAY_SIZE+4))
+		return;
+
+	if(m_pendingMessages>0)
+		return;
+
+	m_completedJobs+=m_batchEnd-m_theSequenceId;
+	m_theSequenceId=m_batchEnd;
+	m_batchIsLoaded=false;
+}
+
+void SequencesIndexer::loadBatch(){
+	int numberOfReads=m_myReads->size();
 
-		int freed=m_workAllocator.getNumberOfChunks()*m_workAllocator.getChunkSize();
-		m_workAllocator.clear();
+	m_batchEnd=m_theSequenceId+BULK_INDEXING_READS_PER_BATCH;
+	if(m_batchEnd>numberOfReads)
+		m_batchEnd=numberOfReads;
 
-		if(m_parameters->showMemoryUsage()){
-			cout<<"Rank "<<m_parameters->getRank()<<": Freeing unused assembler memory: "<<freed/1024<<" KiB freed"<<endl;
+	if(m_theSequenceId==0 || m_theSequenceId/100000!=m_batchEnd/100000){
+		printf("Rank %i is selecting optimal read markers [%i/%i]\n",m_rank,m_theSequenceId+1,numberOfReads);
+
+		m_derivative.addX(m_theSequenceId);
+		m_derivative.printStatus(SLAVE_MODES[RAY_SLAVE_MODE_INDEX_SEQUENCES],RAY_SLAVE_MODE_INDEX_SEQUENCES);
+		m_derivative.printEstimatedTime(numberOfReads);
+
+		if(m_parameters->showMemoryUsage())
 			showMemoryUsage(m_rank);
+	}
+
+	if(m_outgoingEntries.size()==0)
+		m_outgoingEntries.resize(m_size);
+
+	m_batchKmers.clear();
+	m_batchReadStarts.clear();
+
+	int kmerLength=m_parameters->getWordSize();
+	bool colorSpace=m_parameters->getColorSpaceMode();
+
+	for(int sequenceId=m_theSequenceId;sequenceId<m_batchEnd;sequenceId++){
+		Read*read=m_myReads->at(sequenceId);
+		m_batchReadStarts.push_back(m_batchKmers.size());
+
+		int numberOfKmers=read->length()-kmerLength+1;
+
+		for(int position=0;position<numberOfKmers;position++){
+			Kmer kmer=read->getVertex(position,kmerLength,'F',colorSpace);
+			MessageUnit slot=m_batchKmers.size();
+			m_batchKmers.push_back(kmer);
+
+			appendEntry(&kmer,&slot,1);
 		}
+	}
+
+	m_batchReadStarts.push_back(m_batchKmers.size());
+	m_batchCoverages.assign(m_batchKmers.size(),0);
+
+	m_batchIsLoaded=true;
+	m_batchHasCoverages=false;
+	m_outgoingDestination=0;
+	m_outgoingPosition=0;
+}
 
-		if(m_parameters->hasOption("-write-read-markers")){
-			m_readMarkerFile.close();
+void SequencesIndexer::attachBatchMarkers(){
+	int kmerLength=m_parameters->getWordSize();
+	bool writeMarkers=m_parameters->hasOption("-write-read-markers");
+	bool writeSummary=m_parameters->hasOption("-write-marker-summary");
+
+	vector<int> coverages;
+
+	for(int sequenceId=m_theSequenceId;sequenceId<m_batchEnd;sequenceId++){
+		Read*read=m_myReads->at(sequenceId);
+		int first=m_batchReadStarts[sequenceId-m_theSequenceId];
+		int last=m_batchReadStarts[sequenceId-m_theSequenceId+1];
+
+		coverages.assign(m_batchCoverages.begin()+first,m_batchCoverages.begin()+last);
+
+		int forwardPosition=m_selector.selectForwardMarker(&coverages);
+
+		if(forwardPosition!=-1){
+			Kmer vertex=m_batchKmers[first+forwardPosition];
+			MessageUnit values[4];
+			values[0]=m_rank;
+			values[1]=sequenceId;
+			values[2]=forwardPosition;
+			values[3]='F';
+			appendEntry(&vertex,values,4);
+
+			read->setForwardOffset(forwardPosition);
 		}
 
-		if(m_parameters->hasOption("-write-marker-summary")){
+		int reversePosition=m_selector.selectReverseMarker(&coverages);
 
-			ostringstream file1;
-			file1<<m_parameters->getPrefix()<<"Rank"<<m_parameters->getRank()<<".ForwardMarkerSummary.txt";
-			string fileName1=file1.str();
-			ofstream f1(fileName1.c_str());
+		if(reversePosition!=-1){
+			Kmer vertex=m_parameters->_complementVertex(&(m_batchKmers[first+reversePosition]));
+			int positionOnStrand=read->length()-kmerLength-reversePosition;
+			MessageUnit values[4];
+			values[0]=m_rank;
+			values[1]=sequenceId;
+			values[2]=positionOnStrand;
+			values[3]='R';
+			appendEntry(&vertex,values,4);
 
-			for(map<int,map<int,int> >::iterator i=m_forwardStatistics.begin();i!=m_forwardStatistics.end();i++){
-				int offset=i->first;
-				for(map<int,int>::iterator j=i->second.begin();j!=i->second.end();j++){
-					int coverage=j->first;
-					int count=j->second;
-					f1<<offset<<"	"<<coverage<<"	"<<count<<endl;
-				}
-			}
-			f1.close();
-
-			ostringstream file2;
-			file2<<m_parameters->getPrefix()<<"Rank"<<m_parameters->getRank()<<".ReverseMarkerSummary.txt";
-			string fileName2=file2.str();
-			ofstream f2(fileName2.c_str());
-
-			for(map<int,map<int,int> >::iterator i=m_reverseStatistics.begin();i!=m_reverseStatistics.end();i++){
-				int offset=i->first;
-				for(map<int,int>::iterator j=i->second.begin();j!=i->second.end();j++){
-					int coverage=j->first;
-					int count=j->second;
-					f2<<offset<<"	"<<coverage<<"	"<<count<<endl;
-				}
-			}
-			f2.close();
+			read->setReverseOffset(positionOnStrand);
+		}
+
+		if(writeMarkers)
+			m_selector.writeMarkers(&m_readMarkerFile,sequenceId,read,&coverages);
 
+		if(writeSummary)
+			m_selector.addStatistics(&m_forwardStatistics,&m_reverseStatistics,read,&coverages);
+	}
+
+	m_outgoingDestination=0;
+	m_outgoingPosition=0;
+}
+
+/*
+ * An entry is a k-mer followed by some values, it is buffered
+ * for the rank that owns the k-mer.
+ */
+void SequencesIndexer::appendEntry(Kmer*kmer,MessageUnit*values,int numberOfValues){
+	Rank destination=m_parameters->vertexRank(kmer);
+	vector<MessageUnit>*buffer=&(m_outgoingEntries[destination]);
+
+	for(int i=0;i<kmer->getNumberOfU64();i++)
+		buffer->push_back(kmer->getU64(i));
+
+	for(int i=0;i<numberOfValues;i++)
+		buffer->push_back(values[i]);
+}
+
+/*
+ * Sends the buffered entries, destination by destination.
+ * Returns true when everything was sent.
+ */
+bool SequencesIndexer::sendBatchMessages(MessageTag tag,int unitsPerEntry){
+	int maximumUnits=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
+	maximumUnits-=maximumUnits%unitsPerEntry;
+
+	int sentMessages=0;
+
+	while(m_outgoingDestination<m_size && sentMessages<BULK_INDEXING_MESSAGES_PER_CALL){
+		vector<MessageUnit>*buffer=&(m_outgoingEntries[m_outgoingDestination]);
+		int units=buffer->size()-m_outgoingPosition;
+
+		if(units==0){
+			buffer->clear();
+			m_outgoingDestination++;
+			m_outgoingPosition=0;
+			continue;
 		}
 
-		m_forwardStatistics.clear();
-		m_reverseStatistics.clear();
+		if(units>maximumUnits)
+			units=maximumUnits;
+
+		MessageUnit*messageBuffer=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+		memcpy(messageBuffer,&((*buffer)[m_outgoingPosition]),units*sizeof(MessageUnit));
+
+		Message aMessage(messageBuffer,units,m_outgoingDestination,tag,m_rank);
+		m_outbox->push_back(&aMessage);
+
+		m_pendingMessages++;
+		m_outgoingPosition+=units;
+		sentMessages++;
+	}
+
+	return m_outgoingDestination==m_size;
+}
+
+/*
+ * Replies with a (slot, coverage) pair for each k-mer.
+ * The coverage is 0 if the k-mer is not in the graph.
+ */
+void SequencesIndexer::call_RAY_MPI_TAG_INDEX_KMER_COVERAGES(Message*message){
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+	int unitsPerEntry=KMER_U64_ARRAY_SIZE+1;
+
+	MessageUnit*outgoing=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+	int outputPosition=0;
+
+	for(int i=0;i<count;i+=unitsPerEntry){
+		int position=i;
+		Kmer kmer;
+		kmer.unpack(incoming,&position);
+		MessageUnit slot=incoming[position];
+
+		Vertex*node=m_subgraph->find(&kmer);
+		CoverageDepth coverage=0;
+
+		if(node!=NULL)
+			coverage=m_subgraph->getCoverage(node);
+
+		outgoing[outputPosition++]=slot;
+		outgoing[outputPosition++]=coverage;
 	}
+
+	Message aMessage(outgoing,outputPosition,message->getSource(),
+		RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY,m_rank);
+	m_outbox->push_back(&aMessage);
+}
+
+void SequencesIndexer::call_RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY(Message*message){
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+
+	for(int i=0;i<count;i+=2){
+		int slot=incoming[i];
+		m_batchCoverages[slot]=incoming[i+1];
+	}
+
+	m_pendingMessages--;
 }
 
 void SequencesIndexer::constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*inbox,StaticVector*outbox,VirtualCommunicator*vc,
 SlaveMode*mode,
-	ArrayOfReads*myReads
+	ArrayOfReads*myReads,GridTable*subgraph
 ){
 	m_mode=mode;
 	m_outboxAllocator=outboxAllocator;
@@ -241,6 +511,15 @@ SlaveMode*mode,
 	m_theSequenceId=0;
 	m_virtualCommunicator=vc;
 
+	m_subgraph=subgraph;
+	m_bulkIndexing=m_parameters->hasOption("-bulk-read-indexing");
+	m_batchIsLoaded=false;
+	m_batchHasCoverages=false;
+	m_batchEnd=0;
+	m_outgoingDestination=0;
+	m_outgoingPosition=0;
+	m_selector.constructor(m_parameters);
+
 	if(m_parameters->hasOption("-write-read-markers")){
 		ostringstream file;
 		file<<m_parameters->getPrefix()<<"Rank"<<m_parameters->getRank()<<".OptimalReadMarkers.txt";
@@ -304,6 +583,9 @@ void SequencesIndexer::registerPlugin(ComputeCore*core){
 	core->setSlaveModeObjectHandler(plugin,RAY_SLAVE_MODE_INDEX_SEQUENCES,__GetAdapter(SequencesIndexer,RAY_SLAVE_MODE_INDEX_SEQUENCES));
 	core->setSlaveModeSymbol(plugin,RAY_SLAVE_MODE_INDEX_SEQUENCES,"RAY_SLAVE_MODE_INDEX_SEQUENCES");
 
+	__ConfigureMessageTagHandler(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES);
+	__ConfigureMessageTagHandler(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY);
+
 	RAY_MPI_TAG_GET_READ_MARKERS_REPLY=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_GET_READ_MARKERS_REPLY,"RAY_MPI_TAG_GET_READ_MARKERS_REPLY");
 
@@ -322,6 +604,8 @@ void SequencesIndexer::registerPlugin(ComputeCore*core){
 }
 
 void SequencesIndexer::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_INDEX_SEQUENCES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_INDEX_SEQUENCES");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
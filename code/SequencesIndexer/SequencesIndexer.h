@@ -23,11 +23,14 @@
 #define _SequencesIndexer
 
 #include "IndexerWorker.h"
+#include "ReadMarkerSelector.h"
 
 #include <code/Mock/Parameters.h>
 #include <code/Mock/common_functions.h>
 #include <code/SequencesLoader/ArrayOfReads.h>
 #include <code/SequencesLoader/Read.h>
+#include <code/VerticesExtractor/GridTable.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/profiling/Derivative.h>
 #include <RayPlatform/core/ComputeCore.h>
@@ -48,6 +51,8 @@ using namespace std;
 __DeclarePlugin(SequencesIndexer);
 
 __DeclareSlaveModeAdapter(SequencesIndexer,RAY_SLAVE_MODE_INDEX_SEQUENCES);
+__DeclareMessageTagAdapter(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES);
+__DeclareMessageTagAdapter(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY);
 
 /*
  * Computes optimal read markers using workers.
@@ -56,6 +61,8 @@ __DeclareSlaveModeAdapter(SequencesIndexer,RAY_SLAVE_MODE_INDEX_SEQUENCES);
 class SequencesIndexer: public CorePlugin{
 
 	__AddAdapter(SequencesIndexer,RAY_SLAVE_MODE_INDEX_SEQUENCES);
+	__AddAdapter(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES);
+	__AddAdapter(SequencesIndexer,RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY);
 
 	MessageTag RAY_MPI_TAG_GET_READ_MARKERS_REPLY;
 	MessageTag RAY_MPI_TAG_GET_READ_MATE_REPLY;
@@ -66,6 +73,8 @@ class SequencesIndexer: public CorePlugin{
 	MessageTag RAY_MPI_TAG_MASTER_IS_DONE_ATTACHING_READS_REPLY;
 	MessageTag RAY_MPI_TAG_ATTACH_SEQUENCE;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
+	MessageTag RAY_MPI_TAG_INDEX_KMER_COVERAGES;
+	MessageTag RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY;
 
 	SlaveMode RAY_SLAVE_MODE_INDEX_SEQUENCES;
 	SlaveMode RAY_SLAVE_MODE_DO_NOTHING;
@@ -112,12 +121,43 @@ class SequencesIndexer: public CorePlugin{
 	int m_theSequenceId;
 	void updateStates();
 
+	/** for -bulk-read-indexing */
+	bool m_bulkIndexing;
+	bool m_batchIsLoaded;
+	bool m_batchHasCoverages;
+	int m_batchEnd;
+	GridTable*m_subgraph;
+	ReadMarkerSelector m_selector;
+
+	/** k-mers of the reads in the batch */
+	vector<Kmer> m_batchKmers;
+	/** coverage of each k-mer of the batch, filled by the owners */
+	vector<int> m_batchCoverages;
+	/** first k-mer of each read of the batch in m_batchKmers */
+	vector<int> m_batchReadStarts;
+
+	/** one buffer of entries per destination */
+	vector<vector<MessageUnit> > m_outgoingEntries;
+	Rank m_outgoingDestination;
+	int m_outgoingPosition;
+
+	void indexReadsInBulk();
+	void loadBatch();
+	void attachBatchMarkers();
+	bool sendBatchMessages(MessageTag tag,int unitsPerEntry);
+	void appendEntry(Kmer*kmer,MessageUnit*values,int numberOfValues);
+	void finishIndexing();
+
+	Instrumentation*m_instrumentation;
+
 public:
 
 	void call_RAY_SLAVE_MODE_INDEX_SEQUENCES();
+	void call_RAY_MPI_TAG_INDEX_KMER_COVERAGES(Message*message);
+	void call_RAY_MPI_TAG_INDEX_KMER_COVERAGES_REPLY(Message*message);
 
 	void constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*inbox,StaticVector*outbox,
-	VirtualCommunicator*vc,SlaveMode*mode,ArrayOfReads*myReads);
+	VirtualCommunicator*vc,SlaveMode*mode,ArrayOfReads*myReads,GridTable*subgraph);
 
 	void setReadiness();
 	MyAllocator*getAllocator();
@@ -250,6 +250,7 @@ bool SequencesLoader::writeSequencesToAMOSFile(int rank,int size,
 }
 
 bool SequencesLoader::call_RAY_SLAVE_MODE_LOAD_SEQUENCES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_LOAD_SEQUENCES);
 
 	printf("Rank %i is loading sequence reads\n",m_rank);
 
@@ -367,7 +368,7 @@ bool SequencesLoader::call_RAY_SLAVE_MODE_LOAD_SEQUENCES(){
 	cout<<"Rank "<<m_rank<<" has "<<amount<<" sequence reads (completed)"<<endl;
 
 	/* write the checkpoint file */
-	if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("Sequences")){
+	if(m_parameters->writeCheckpoint("Sequences") && !m_parameters->hasCheckpoint("Sequences")){
 		/* announce the user that we are writing a checkpoint */
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint Sequences"<<endl;
 
@@ -463,6 +464,8 @@ void SequencesLoader::registerPlugin(ComputeCore*core){
 }
 
 void SequencesLoader::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_LOAD_SEQUENCES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_LOAD_SEQUENCES");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 
@@ -27,6 +27,7 @@
 #include <code/Mock/Parameters.h>
 #include <code/SequencesLoader/Loader.h>
 #include <code/SeedExtender/BubbleData.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/memory/RingAllocator.h>
 #include <RayPlatform/memory/MyAllocator.h>
@@ -84,6 +85,8 @@ class SequencesLoader : public CorePlugin{
 
 	void registerSequence();
 
+	Instrumentation*m_instrumentation;
+
 public:
 	bool call_RAY_SLAVE_MODE_LOAD_SEQUENCES();
 	void call_RAY_MPI_TAG_LOAD_SEQUENCES(Message*message);
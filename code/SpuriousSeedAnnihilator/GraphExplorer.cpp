@@ -20,132 +20,56 @@
 
 #include "GraphExplorer.h"
 
-// #define DEBUG_EXPLORATION_123
+#include <set>
+using namespace std;
 
 #define DEBUG_EXPLORATION_SHOW_SUMMARY
 
-void GraphExplorer::start(WorkerHandle key, Kmer * start, GraphPath * seed, int direction, Parameters * parameters,
-	VirtualCommunicator * virtualCommunicator,
-	RingAllocator * outboxAllocator,
-	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE, MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
-	PathHandle seedName
-) {
-
-	m_seed = seed;
-	m_start = *start;
-
-	//cout << "[DEBUG] starting graph search with explorer technology" << endl;
-
-	m_key = key;
-	m_direction = direction;
+void GraphExplorer::initialize(GraphSearchEngine * engine, Parameters * parameters) {
 
+	m_engine = engine;
 	m_parameters = parameters;
-	m_virtualCommunicator = virtualCommunicator;
-	m_outboxAllocator = outboxAllocator;
-
-	this->RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT = RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
-	this->RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE = RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
-	this->RAY_MPI_TAG_ASK_VERTEX_PATH = RAY_MPI_TAG_ASK_VERTEX_PATH;
 
-	m_done = false;
 	m_maximumDepth = 128;
 	m_maximumVisitedVertices = 1024;
 
-	while(!m_verticesToVisit.empty())
-		m_verticesToVisit.pop();
-
-	while(!m_depths.empty())
-		m_depths.pop();
-
-	m_verticesToVisit.push(*start);
-
-	int depth = 0;
-	m_depths.push(depth);
-
-	m_haveAttributes = false;
-	m_haveAnnotations = false;
-	m_haveAnnotationsReverse = false;
-
-	WorkerHandle identifier = m_key;
-
-	m_attributeFetcher.initialize(parameters, virtualCommunicator,
-			identifier, outboxAllocator,
-			RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT);
-
-	m_annotationFetcher.initialize(parameters, virtualCommunicator,
-			identifier, outboxAllocator,
-			RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
-			RAY_MPI_TAG_ASK_VERTEX_PATH);
-
-	m_annotationFetcherReverse.initialize(parameters, virtualCommunicator,
-			identifier, outboxAllocator,
-			RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
-			RAY_MPI_TAG_ASK_VERTEX_PATH);
-
+	clear();
+}
 
-	m_stopAtFirstHit = true;
+void GraphExplorer::clear() {
 
-	m_seedName = seedName;
-	m_visitedVertices = 0;
-	m_maximumVisitedDepth = 0;
-	m_searchDepthForFirstResult = -1;
+	m_engine->clear();
 
-	m_vertexDepths.clear();
-	m_parents.clear();
+	m_directions.clear();
+	m_seedNames.clear();
+	m_starts.clear();
+	m_seedLengths.clear();
+	m_searchDepthsForFirstResult.clear();
 	m_searchResults.clear();
-
-	//cout << "[DEBUG] explorer is ready" << endl;
-
-	m_debug = false;
-
-#ifdef DEBUG_EXPLORATION_123
-	bool tryToDebug = true;
-
-	/**
-	 * DEBUG URI http://genome.ulaval.ca:10241/client/?map=3&section=0&region=254&location=1734&depth=10
-	 */
-
-	//const char * key1 = "GGAATCATGAGAAGTCAGCCG";
-	//const char * key1 = "AAATCCCTCTTTTTACAATTG";
-	//const char * key1 = "TTTCGTGAAAAAAGTTAACAA";
-	const char * key1 = "ATAATAAGAGTTATCATCTCC"; // \see http://genome.ulaval.ca:10241/client/?map=3&section=0&region=480&location=0&depth=10&zoom=0.8088851319448179
-
-	if(tryToDebug && start->idToWord(m_parameters->getWordSize(), m_parameters->getColorSpaceMode()) == key1) {
-		m_debug = true;
-		cout << "[DEBUG] 8d97f6e851 BEGIN" << endl;
-	}
-#endif
-
-
 }
 
-// TODO: use the coverage value instead of depth
-bool GraphExplorer::getBestParent(Kmer * parent, Kmer kmer) {
-
-	if(m_parents.count(kmer) == 0)
-		return false;
+int GraphExplorer::addSeedEnd(Kmer * start, GraphPath * seed, int direction, PathHandle seedName) {
 
-	int bestDepth = 99999;
-	Kmer bestKmer;
+	int searchDirection = GRAPH_SEARCH_PARENTS;
 
-	for(vector<Kmer>::iterator i = m_parents[kmer].begin();
-			i != m_parents[kmer].end();
-			i++) {
+	if(direction == EXPLORER_RIGHT)
+		searchDirection = GRAPH_SEARCH_CHILDREN;
 
-		Kmer theParent = *i;
+	int source = m_engine->addSource(start, searchDirection, GRAPH_SEARCH_DEPTH_FIRST,
+		m_maximumDepth, GRAPH_SEARCH_UNLIMITED);
 
-		int parentDepth = m_vertexDepths[theParent];
+	m_directions.push_back(direction);
+	m_seedNames.push_back(seedName);
+	m_starts.push_back(*start);
+	m_seedLengths.push_back(seed->size());
+	m_searchDepthsForFirstResult.push_back(-1);
+	m_searchResults.push_back(vector<GraphSearchResult>());
 
-		if(parentDepth < bestDepth) {
-			bestKmer = theParent;
-			bestDepth = parentDepth;
-		}
-	}
-
-	*parent = bestKmer;
+#ifdef CONFIG_ASSERT
+	assert(source == (int)m_directions.size() - 1);
+#endif
 
-	return true;
+	return source;
 }
 
 /**
@@ -153,7 +77,7 @@ bool GraphExplorer::getBestParent(Kmer * parent, Kmer kmer) {
  * course. If we use EXPLORER_LEFT, then parents are truly parents.
  * But with EXPLORER_RIGHT, parents are in fact children.
  */
-bool GraphExplorer::backtrackPath(vector<Kmer> * path, Kmer * vertex) {
+bool GraphExplorer::backtrackPath(int source, vector<Kmer> * path, Kmer * vertex) {
 	Kmer item = *vertex;
 
 	set<Kmer> visited;
@@ -168,12 +92,12 @@ bool GraphExplorer::backtrackPath(vector<Kmer> * path, Kmer * vertex) {
 		aPath.push_back(item);
 		visited.insert(item);
 
-		if(item == m_start)
+		if(item == m_starts[source])
 			break;
 
 		Kmer parent;
 
-		if(!getBestParent(&parent, item))
+		if(!m_engine->getParent(source, &item, &parent))
 			break;
 
 		item = parent;
@@ -201,11 +125,10 @@ bool GraphExplorer::backtrackPath(vector<Kmer> * path, Kmer * vertex) {
 	aPath.clear();
 
 	// reverse to enforce the de Bruijn property
-	if(m_direction == EXPLORER_RIGHT) {
+	if(m_directions[source] == EXPLORER_RIGHT) {
 		int firstPosition = 0;
 		int lastPosition = path->size()-1;
 
-		// while(firstPosition < lastPosition) {  error: stray ‘\302’ in program
 		while(firstPosition < lastPosition) {
 			Kmer holder = (*path)[firstPosition];
 			(*path)[firstPosition] = (*path)[lastPosition];
@@ -218,20 +141,23 @@ bool GraphExplorer::backtrackPath(vector<Kmer> * path, Kmer * vertex) {
 	return true;
 }
 
-bool GraphExplorer::processAnnotations(AnnotationFetcher & annotationFetcher, int currentDepth, Kmer & object) {
+bool GraphExplorer::processAnnotations(int source, vector<Direction> * directions, int currentDepth, Kmer * object) {
+
+	int seedDirection = m_directions[source];
+	PathHandle seedName = m_seedNames[source];
 
 	bool foundSomething = false;
-	for(int i=0;i< (int) annotationFetcher.getDirections()->size(); i++){
+	for(int i=0;i< (int) directions->size(); i++){
 
-		Direction & direction = annotationFetcher.getDirections()->at(i);
+		Direction & direction = directions->at(i);
 
 		PathHandle pathName = direction.getPathHandle();
 		int position = direction.getPosition();
 		bool pathStrand = false;
 
-		if(m_direction == EXPLORER_RIGHT && position != 0)
+		if(seedDirection == EXPLORER_RIGHT && position != 0)
 			pathStrand = true;
-		else if(m_direction == EXPLORER_LEFT && position == 0)
+		else if(seedDirection == EXPLORER_LEFT && position == 0)
 			pathStrand = true;
 
 		// the self path will always be found at depth 0
@@ -242,33 +168,31 @@ bool GraphExplorer::processAnnotations(AnnotationFetcher & annotationFetcher, in
 		if(currentDepth != 0) {
 
 			// skip self loops
-			if(pathName == m_seedName) {
+			if(pathName == seedName) {
 				continue;
 			}
 
 #ifdef INTERNET_EXPLORER_DEBUG_PATHS
 			cout << "[DEBUG] GraphExplorer found path " << pathName << " during graph search";
-			cout << ", visited " << m_visitedVertices << ", started from " << m_seedName;
+			cout << ", visited " << m_engine->getVisitedVertices(source) << ", started from " << seedName;
 
 			cout << " direction ";
 
-			if(m_direction == EXPLORER_LEFT)
+			if(seedDirection == EXPLORER_LEFT)
 				cout << "EXPLORER_LEFT";
-			else if(m_direction == EXPLORER_RIGHT)
+			else if(seedDirection == EXPLORER_RIGHT)
 				cout << "EXPLORER_RIGHT";
 
 			cout << " depth " << currentDepth;
 #endif
 
-
-
 			// here we can not use GraphPath directly because the de Bruijn property
 			// is hardly enforced in both directions
 			vector<Kmer> pathToOrigin;
 
-			if(!backtrackPath(&pathToOrigin, &object)) {
+			if(!backtrackPath(source, &pathToOrigin, object)) {
 				cout << "DEBUG Warning backtrackPath failed ";
-				cout << " m_seedName " << m_seedName << " ";
+				cout << " m_seedName " << seedName << " ";
 				cout << " pathName " << pathName << endl;
 
 				continue;
@@ -290,202 +214,94 @@ bool GraphExplorer::processAnnotations(AnnotationFetcher & annotationFetcher, in
 
 			GraphSearchResult result;
 
-			if(m_direction == EXPLORER_RIGHT) {
-				result.addPathHandle(m_seedName, false);
+			if(seedDirection == EXPLORER_RIGHT) {
+				result.addPathHandle(seedName, false);
 				result.addPath(aPath);
 				result.addPathHandle(pathName, pathStrand);
-			} else if(m_direction == EXPLORER_LEFT) {
+			} else if(seedDirection == EXPLORER_LEFT) {
 				result.addPathHandle(pathName, pathStrand);
 				result.addPath(aPath);
-				result.addPathHandle(m_seedName, false);
+				result.addPathHandle(seedName, false);
 			}
 
-			m_searchResults.push_back(result);
+			m_searchResults[source].push_back(result);
 		}
 	}
 
 	return foundSomething;
 }
 
-// TODO: query also the other DNA strand for annotations
-bool GraphExplorer::work() {
-
-	if(m_verticesToVisit.empty())
-		m_done = true;
-
-	if(m_done) {
+// TODO: use the coverage value to select the parent
+bool GraphExplorer::visitVertex(int source, Kmer * vertex, int depth, CoverageDepth coverage,
+		vector<Direction> * directions, vector<Direction> * reverseDirections,
+		vector<Kmer> * links) {
 
 #ifdef DEBUG_EXPLORATION_SHOW_SUMMARY
-		m_debug = true;
-		if(m_debug) {
-			cout << "[DEBUG] 8d97f6e851 completed, m_visitedVertices " << m_visitedVertices;
-			cout << " path " << m_seedName;
-			cout << " m_searchDepthForFirstResult " << m_searchDepthForFirstResult;
-			cout << " m_maximumVisitedDepth " << m_maximumVisitedDepth;
-			cout << " lengthInKmers " << m_seed->size();
-			cout << " direction ";
-
 
-			if(m_direction == EXPLORER_LEFT)
-				cout << "EXPLORER_LEFT";
-			else
-				cout << "EXPLORER_RIGHT";
-
-			cout << " search results: " << m_searchResults.size();
-			cout << endl;
-		}
-		m_debug = false;
-#endif
-
-		return m_done;
+	if(depth == 0) {
+		cout << "DEBUG -> ";
+		cout << "BiologicalObject: ";
+		cout << vertex->idToWord(m_parameters->getWordSize(), m_parameters->getColorSpaceMode());
+		cout << " SequencingDepth: ";
+		cout << coverage;
+		cout << endl;
 	}
-
-#ifdef CONFIG_ASSERT
-	assert(!m_verticesToVisit.empty());
-	assert(!m_depths.empty());
 #endif
 
-	Kmer object = m_verticesToVisit.top();
-	Kmer reverseObject = object.complementVertex(m_parameters->getWordSize(), m_parameters->getColorSpaceMode());
-
-	if(!m_haveAttributes && m_attributeFetcher.fetchObjectMetaData(&object)) {
-
-		m_haveAttributes = true;
-		m_haveAnnotations = false;
-		//cout << "[DEBUG] have attributes" << endl;
-
-	} else if(m_haveAttributes && !m_haveAnnotations && m_annotationFetcher.fetchDirections(&object)) {
-
-		m_haveAnnotations = true;
-		m_haveAnnotationsReverse = false;
-
-	} else if(m_haveAttributes && m_haveAnnotations && !m_haveAnnotationsReverse
-		&& m_annotationFetcherReverse.fetchDirections(&reverseObject)) {
-
-		m_haveAnnotationsReverse = true;
-		//cout << "[DEBUG] have annotations" << endl;
-
-	} else if(m_haveAttributes && m_haveAnnotations && m_haveAnnotationsReverse) {
-
-#ifdef DEBUG_EXPLORATION_123
-		if(m_debug) {
-			cout << "[DEBUG] 8d97f6e851 vertex " << object.idToWord(m_parameters->getWordSize(), m_parameters->getColorSpaceMode());
-			cout << " depth " << m_attributeFetcher.getDepth() << " children [ ";
-
-			for(int i = 0 ; i < (int) m_attributeFetcher.getChildren()->size() ; ++i) {
-
-				cout << " " << m_attributeFetcher.getChildren()->at(i).idToWord(m_parameters->getWordSize(), m_parameters->getColorSpaceMode());
-			}
-			cout << " ]";
-
-			cout << " forward annotations: " << m_annotationFetcher.getDirections()->size();
-			cout << " reverse annotations: " << m_annotationFetcherReverse.getDirections()->size();
-			cout << endl;
-		}
-#endif
-
-#ifdef DEBUG_EXPLORATION_SHOW_SUMMARY
-
-		if(m_visitedVertices == 0) {
-			CoverageDepth coverageDepthForFirstVertex = 0;
-			coverageDepthForFirstVertex = m_attributeFetcher.getDepth();
-
-			cout << "DEBUG -> ";
-			cout << "BiologicalObject: ";
-			cout << object.idToWord(m_parameters->getWordSize(), m_parameters->getColorSpaceMode());
-			cout << " SequencingDepth: ";
-			cout << coverageDepthForFirstVertex;
-			cout << endl;
-		}
-#endif
-
-		int currentDepth = m_depths.top();
-
-		m_vertexDepths[object] = currentDepth;
-
-		bool foundSomething = false;
-
-		if(currentDepth > m_maximumVisitedDepth)
-			m_maximumVisitedDepth = currentDepth;
-
-		//cout << "[DEBUG] processing object now depth=" << currentDepth << " visited= " << m_visitedVertices << endl;
-
-		if(processAnnotations(m_annotationFetcher, currentDepth, object))
-			foundSomething = true;
-		if(processAnnotations(m_annotationFetcherReverse, currentDepth, object))
-			foundSomething = true;
-
-		if(foundSomething && m_searchDepthForFirstResult < 0)
-			m_searchDepthForFirstResult = currentDepth;
-
-#ifdef CONFIG_ASSERT
-		assert(!m_depths.empty());
-#endif
-
-		int newDepth = currentDepth + 1;
-
-		m_depths.pop();
-		m_verticesToVisit.pop();
-
-		vector<Kmer> * links = NULL;
-
-		if(m_direction == EXPLORER_LEFT)
-			links = m_attributeFetcher.getParents();
-		else if(m_direction == EXPLORER_RIGHT)
-			links = m_attributeFetcher.getChildren();
-
-#ifdef CONFIG_ASSERT
-		assert(links != NULL);
-#endif
-
-		if(newDepth <= m_maximumDepth
-			&& m_visitedVertices + (int)links->size() <= m_maximumVisitedVertices) {
-
-			for(int i = 0 ; i < (int)links->size() ; i ++) {
-
-				if(!foundSomething) {
-					Kmer nextKmer = links->at(i);
-
-					// implemented already: check if there is not already another parent.
-					// if it is the case, select the path with the coverage
-					// that is the nearest to the one of both paths
-					m_parents[nextKmer].push_back(object);
-
-					m_verticesToVisit.push(nextKmer);
-					m_depths.push(newDepth);
-				}
-			}
-		}
+	bool foundSomething = false;
 
-		m_annotationFetcher.reset();
-		m_annotationFetcherReverse.reset();
-		m_attributeFetcher.reset();
+	if(processAnnotations(source, directions, depth, vertex))
+		foundSomething = true;
+	if(processAnnotations(source, reverseDirections, depth, vertex))
+		foundSomething = true;
 
-		m_visitedVertices ++;
+	if(foundSomething && m_searchDepthsForFirstResult[source] < 0)
+		m_searchDepthsForFirstResult[source] = depth;
 
-		m_haveAttributes = false;
-	}
+	if(foundSomething)
+		return false;
 
-	return m_done;
+	// the vertex is already counted by the engine
+	return m_engine->getVisitedVertices(source) - 1 + (int)links->size() <= m_maximumVisitedVertices;
 }
 
-vector<GraphSearchResult> & GraphExplorer::getSearchResults() {
-	return m_searchResults;
+vector<GraphSearchResult> & GraphExplorer::getSearchResults(int source) {
+	return m_searchResults[source];
 }
 
 /**
  * \see http://stackoverflow.com/questions/13639535/what-are-the-naming-conventions-of-functions-that-return-boolean
  */
-bool GraphExplorer::isValid() const {
+bool GraphExplorer::isValid(int source) {
 
-	if(m_searchResults.size() != 1)
+	if(m_searchResults[source].size() != 1)
 		return false;
 
-	if(m_visitedVertices >= m_maximumVisitedVertices)
+	if(m_engine->getVisitedVertices(source) >= m_maximumVisitedVertices)
 		return false;
 
-	if(m_maximumVisitedDepth >= m_maximumDepth)
+	if(m_engine->getMaximumVisitedDepth(source) >= m_maximumDepth)
 		return false;
 
 	return true;
 }
+
+void GraphExplorer::printSummary(int source) {
+
+#ifdef DEBUG_EXPLORATION_SHOW_SUMMARY
+	cout << "[DEBUG] 8d97f6e851 completed, m_visitedVertices " << m_engine->getVisitedVertices(source);
+	cout << " path " << m_seedNames[source];
+	cout << " m_searchDepthForFirstResult " << m_searchDepthsForFirstResult[source];
+	cout << " m_maximumVisitedDepth " << m_engine->getMaximumVisitedDepth(source);
+	cout << " lengthInKmers " << m_seedLengths[source];
+	cout << " direction ";
+
+	if(m_directions[source] == EXPLORER_LEFT)
+		cout << "EXPLORER_LEFT";
+	else
+		cout << "EXPLORER_RIGHT";
+
+	cout << " search results: " << m_searchResults[source].size();
+	cout << endl;
+#endif
+}
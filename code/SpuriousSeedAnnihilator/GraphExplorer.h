@@ -21,17 +21,13 @@
 #ifndef GraphExplorer_header
 #define GraphExplorer_header
 
-#include "AttributeFetcher.h"
-#include "AnnotationFetcher.h"
+#include "GraphSearchConsumer.h"
+#include "GraphSearchEngine.h"
 #include "GraphSearchResult.h"
 
 #include <code/Mock/Parameters.h>
-#include <code/Mock/Parameters.h>
-
-#include <RayPlatform/core/ComputeCore.h>
-#include <RayPlatform/communication/VirtualCommunicator.h>
 
-#include <stack>
+#include <vector>
 using namespace std;
 
 #define EXPLORER_LEFT 0x89
@@ -40,73 +36,59 @@ using namespace std;
 /**
  * This class is an explorer to find paths leading to new paths.
  *
+ * Each seed end is a source of a GraphSearchEngine, and all the
+ * seed ends of a batch are explored at the same time.
+ *
+ * The search of each seed end is depth-first, like the older explorer
+ * that searched one seed end at a time: there is no visited set, and
+ * the limit of m_maximumVisitedVertices (1024) is spent along the
+ * branches in the order of a stack. Only the fetches of the seed ends
+ * of a batch are grouped, so the results are the same as before.
+ *
  * \author Sébastien Boisvert
  */
-class GraphExplorer {
-
-	int m_searchDepthForFirstResult;
-	bool m_debug;
-	vector<GraphSearchResult> m_searchResults;
+class GraphExplorer: public GraphSearchConsumer {
 
-	stack<Kmer> m_verticesToVisit;
-	stack<int> m_depths;
-
-	int m_maximumVisitedDepth;
-
-	AnnotationFetcher m_annotationFetcher;
-	AnnotationFetcher m_annotationFetcherReverse;
-	AttributeFetcher m_attributeFetcher;
-
-	WorkerHandle m_key;
-	int m_direction;
-	PathHandle m_seedName;
-
-	map<Kmer, vector<Kmer> > m_parents;
-	map<Kmer, int> m_vertexDepths;
+	GraphSearchEngine * m_engine;
+	Parameters * m_parameters;
 
-	CoverageDepth m_coverage1;
+	int m_maximumDepth;
+	int m_maximumVisitedVertices;
 
-	Kmer m_start;
+	/* for each source */
+	vector<int> m_directions;
+	vector<PathHandle> m_seedNames;
+	vector<Kmer> m_starts;
+	vector<int> m_seedLengths;
+	vector<int> m_searchDepthsForFirstResult;
+	vector<vector<GraphSearchResult> > m_searchResults;
 
-	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
-	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
-	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH;
+	bool backtrackPath(int source, vector<Kmer> * path, Kmer * vertex);
+	bool processAnnotations(int source, vector<Direction> * directions, int currentDepth, Kmer * object);
 
-	bool m_haveAttributes;
-	bool m_haveAnnotations;
-	bool m_haveAnnotationsReverse;
+public:
 
-	bool m_stopAtFirstHit;
-	bool m_done;
-	int m_maximumDepth;
+	void initialize(GraphSearchEngine * engine, Parameters * parameters);
 
-	VirtualCommunicator * m_virtualCommunicator;
-	Parameters * m_parameters;
-	int m_maximumVisitedVertices;
-	int m_visitedVertices;
-	RingAllocator*m_outboxAllocator;
-	GraphPath * m_seed;
+	/** removes the seed ends and the sources of the engine */
+	void clear();
 
-	bool backtrackPath(vector<Kmer> * path, Kmer * vertex);
-	bool getBestParent(Kmer * parent, Kmer kmer);
-	bool processAnnotations(AnnotationFetcher & annotationFetcher, int currentDepth, Kmer & object);
+	/**
+	 * Adds a seed end, direction is EXPLORER_LEFT or EXPLORER_RIGHT.
+	 *
+	 * @returns the source
+	 */
+	int addSeedEnd(Kmer * start, GraphPath * seed, int direction, PathHandle seedName);
 
-public:
-	void start(WorkerHandle worker, Kmer * start, GraphPath * seed, int direction, Parameters * parameters,
-		VirtualCommunicator * virtualCommunicator,
-		RingAllocator * outboxAllocator,
-		MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE, MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
-		PathHandle seedName
-	);
+	bool visitVertex(int source, Kmer * vertex, int depth, CoverageDepth coverage,
+		vector<Direction> * directions, vector<Direction> * reverseDirections,
+		vector<Kmer> * links);
 
-	bool work();
+	vector<GraphSearchResult> & getSearchResults(int source);
 
-	vector<GraphSearchResult> & getSearchResults();
+	bool isValid(int source);
 
-	bool isValid() const ;
+	void printSummary(int source);
 };
 
 #endif /* GraphExplorer_header */
-
-
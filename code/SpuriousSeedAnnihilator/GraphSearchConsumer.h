@@ -0,0 +1,56 @@
+/*
+ *  Ray -- Parallel genome assemblies for parallel DNA sequencing
+ *  Copyright (C) 2026 agent
+ *
+ *  http://DeNovoAssembler.SourceForge.Net/
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You have received a copy of the GNU General Public License
+ *  along with this program (gpl-3.0.txt).
+ *  see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef GraphSearchConsumer_Header
+#define GraphSearchConsumer_Header
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/SeedExtender/Direction.h>
+
+#include <vector>
+using namespace std;
+
+/**
+ * The interface of the code that uses a GraphSearchEngine.
+ *
+ * \author agent
+ */
+class GraphSearchConsumer {
+
+public:
+
+	/**
+	 * Called once for each vertex reached by a source, level by level.
+	 *
+	 * directions are the paths on the vertex and reverseDirections are
+	 * the paths on its reverse complement. links are the parents or
+	 * the children of the vertex, depending on the source.
+	 *
+	 * @returns false if the search of this source must not continue
+	 * after this vertex.
+	 */
+	virtual bool visitVertex(int source, Kmer * vertex, int depth, CoverageDepth coverage,
+		vector<Direction> * directions, vector<Direction> * reverseDirections,
+		vector<Kmer> * links) = 0;
+
+	virtual ~GraphSearchConsumer() {}
+};
+
+#endif /* GraphSearchConsumer_Header */
@@ -0,0 +1,505 @@
+/*
+ *  Ray -- Parallel genome assemblies for parallel DNA sequencing
+ *  Copyright (C) 2026 agent
+ *
+ *  http://DeNovoAssembler.SourceForge.Net/
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You have received a copy of the GNU General Public License
+ *  along with this program (gpl-3.0.txt).
+ *  see <http://www.gnu.org/licenses/>
+ */
+
+#include "GraphSearchEngine.h"
+
+#ifdef CONFIG_ASSERT
+#include <assert.h>
+#endif
+
+#define GRAPH_SEARCH_STEP_COLLECT 0
+#define GRAPH_SEARCH_STEP_ATTRIBUTES 1
+#define GRAPH_SEARCH_STEP_PATHS 2
+#define GRAPH_SEARCH_STEP_DONE 3
+
+void GraphSearchEngine::initialize(Parameters * parameters, VirtualCommunicator * virtualCommunicator,
+		RingAllocator * outboxAllocator,
+		MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
+		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
+		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH) {
+
+	m_parameters = parameters;
+	m_virtualCommunicator = virtualCommunicator;
+	m_outboxAllocator = outboxAllocator;
+
+	this->RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT = RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
+	this->RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE = RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
+	this->RAY_MPI_TAG_ASK_VERTEX_PATH = RAY_MPI_TAG_ASK_VERTEX_PATH;
+
+	m_consumer = NULL;
+
+	m_handles.assign(GRAPH_SEARCH_MAXIMUM_QUERIES, -1);
+	m_freeHandles.clear();
+
+	// the first handles are used first
+	for(int i = GRAPH_SEARCH_MAXIMUM_QUERIES - 1 ; i >= 0 ; i--)
+		m_freeHandles.push_back(i);
+
+	clear();
+}
+
+void GraphSearchEngine::clear() {
+
+	m_numberOfSources = 0;
+
+	m_vertices.clear();
+	m_newVertices.clear();
+	m_queries.clear();
+	m_nextQuery = 0;
+
+	m_step = GRAPH_SEARCH_STEP_DONE;
+}
+
+int GraphSearchEngine::addSource(Kmer * start, int direction, int order, int maximumDepth, int maximumQueuedVertices) {
+
+#ifdef CONFIG_ASSERT
+	assert(direction == GRAPH_SEARCH_PARENTS || direction == GRAPH_SEARCH_CHILDREN);
+	assert(order == GRAPH_SEARCH_BREADTH_FIRST || order == GRAPH_SEARCH_DEPTH_FIRST);
+#endif
+
+	if(m_numberOfSources == (int)m_sources.size())
+		m_sources.resize(m_numberOfSources + 1);
+
+	GraphSearchSource & source = m_sources[m_numberOfSources];
+
+	source.m_direction = direction;
+	source.m_order = order;
+	source.m_maximumDepth = maximumDepth;
+	source.m_maximumQueuedVertices = maximumQueuedVertices;
+	source.m_queuedVertices = 1;
+	source.m_visitedVertices = 0;
+	source.m_maximumVisitedDepth = 0;
+
+	source.m_frontier.clear();
+	source.m_frontier.push_back(*start);
+	source.m_stackDepths.clear();
+	source.m_stackDepths.push_back(0);
+
+	source.m_depths.clear();
+	source.m_parents.clear();
+	source.m_allParents.clear();
+	source.m_depths[*start] = 0;
+
+	return m_numberOfSources ++;
+}
+
+void GraphSearchEngine::start(GraphSearchConsumer * consumer) {
+
+#ifdef CONFIG_ASSERT
+	assert(m_freeHandles.size() == GRAPH_SEARCH_MAXIMUM_QUERIES);
+#endif
+
+	m_consumer = consumer;
+	m_step = GRAPH_SEARCH_STEP_COLLECT;
+}
+
+bool GraphSearchEngine::work(vector<WorkerHandle> * activeWorkers) {
+
+	if(m_step == GRAPH_SEARCH_STEP_COLLECT) {
+
+		collectFrontiers();
+
+	} else if(m_step == GRAPH_SEARCH_STEP_ATTRIBUTES) {
+
+		if(processQueries(activeWorkers)) {
+			queuePathQueries();
+			m_step = GRAPH_SEARCH_STEP_PATHS;
+		}
+
+	} else if(m_step == GRAPH_SEARCH_STEP_PATHS) {
+
+		if(processQueries(activeWorkers)) {
+			visitFrontiers();
+		}
+	}
+
+	return m_step == GRAPH_SEARCH_STEP_DONE;
+}
+
+void GraphSearchEngine::queueQuery(Kmer * vertex, MessageTag tag, int strand, int pathIndex) {
+
+	GraphSearchQuery query;
+	query.m_vertex = *vertex;
+	query.m_tag = tag;
+	query.m_strand = strand;
+	query.m_pathIndex = pathIndex;
+
+	m_queries.push_back(query);
+}
+
+/**
+ * Queues the attributes and the number of paths of the vertices
+ * in the frontiers that were not fetched before. Only the top of
+ * the frontier of a depth-first source is visited at this level.
+ */
+void GraphSearchEngine::collectFrontiers() {
+
+	m_newVertices.clear();
+	m_queries.clear();
+	m_nextQuery = 0;
+
+	bool active = false;
+
+	for(int i = 0 ; i < m_numberOfSources ; i++) {
+
+		vector<Kmer> & frontier = m_sources[i].m_frontier;
+
+		int first = 0;
+
+		if(m_sources[i].m_order == GRAPH_SEARCH_DEPTH_FIRST)
+			first = (int)frontier.size() - 1;
+
+		for(int j = first ; j >= 0 && j < (int)frontier.size() ; j++) {
+
+			active = true;
+
+			Kmer & vertex = frontier[j];
+
+			if(m_vertices.count(vertex) > 0)
+				continue;
+
+			GraphSearchVertex & data = m_vertices[vertex];
+
+			for(int strand = 0 ; strand < 2 ; strand ++) {
+				data.m_numberOfPaths[strand] = 0;
+				data.m_directions[strand].clear();
+			}
+
+			m_newVertices.push_back(vertex);
+
+			queueQuery(&vertex, RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT, 0, 0);
+			queueQuery(&vertex, RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE, 0, 0);
+			queueQuery(&vertex, RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE, 1, 0);
+		}
+	}
+
+	if(active)
+		m_step = GRAPH_SEARCH_STEP_ATTRIBUTES;
+	else
+		m_step = GRAPH_SEARCH_STEP_DONE;
+}
+
+void GraphSearchEngine::queuePathQueries() {
+
+	m_queries.clear();
+	m_nextQuery = 0;
+
+	for(int i = 0 ; i < (int)m_newVertices.size() ; i++) {
+
+		Kmer & vertex = m_newVertices[i];
+		GraphSearchVertex * data = m_vertices.find(vertex);
+
+		for(int strand = 0 ; strand < 2 ; strand ++) {
+
+			// replies come in any order, each one has its slot
+			data->m_directions[strand].resize(data->m_numberOfPaths[strand]);
+
+			for(int pathIndex = 0 ; pathIndex < data->m_numberOfPaths[strand] ; pathIndex ++)
+				queueQuery(&vertex, RAY_MPI_TAG_ASK_VERTEX_PATH, strand, pathIndex);
+		}
+	}
+}
+
+/**
+ * Receives the replies and sends the queued queries.
+ *
+ * @returns true when all the queries have their reply
+ */
+bool GraphSearchEngine::processQueries(vector<WorkerHandle> * activeWorkers) {
+
+	for(int i = 0 ; i < (int)activeWorkers->size() ; i++) {
+
+		WorkerHandle handle = activeWorkers->at(i);
+
+		if(handle >= m_handles.size() || m_handles[handle] < 0)
+			continue;
+
+		if(!m_virtualCommunicator->isMessageProcessed(handle))
+			continue;
+
+		vector<MessageUnit> elements;
+		m_virtualCommunicator->getMessageResponseElements(handle, &elements);
+
+		receiveReply(&(m_queries[m_handles[handle]]), &elements);
+
+		m_handles[handle] = -1;
+		m_freeHandles.push_back(handle);
+	}
+
+	while(m_nextQuery < (int)m_queries.size() && !m_freeHandles.empty()) {
+
+		WorkerHandle handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+
+		m_handles[handle] = m_nextQuery;
+
+		sendQuery(handle, &(m_queries[m_nextQuery]));
+
+		m_nextQuery ++;
+	}
+
+	return m_nextQuery == (int)m_queries.size()
+		&& m_freeHandles.size() == GRAPH_SEARCH_MAXIMUM_QUERIES;
+}
+
+void GraphSearchEngine::sendQuery(WorkerHandle handle, GraphSearchQuery * query) {
+
+	Kmer kmer = query->m_vertex;
+
+	if(query->m_strand == 1)
+		kmer = kmer.complementVertex(m_parameters->getWordSize(), m_parameters->getColorSpaceMode());
+
+	int elementsPerQuery = m_virtualCommunicator->getElementsPerQuery(query->m_tag);
+
+	MessageUnit * message = (MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery * sizeof(MessageUnit));
+	int position = 0;
+	kmer.pack(message, &position);
+
+	if(query->m_tag == RAY_MPI_TAG_ASK_VERTEX_PATH)
+		message[position++] = query->m_pathIndex;
+
+	Rank destination = m_parameters->vertexRank(&kmer);
+
+	Message aMessage(message, elementsPerQuery, destination, query->m_tag, m_parameters->getRank());
+
+	m_virtualCommunicator->pushMessage(handle, &aMessage);
+}
+
+void GraphSearchEngine::receiveReply(GraphSearchQuery * query, vector<MessageUnit> * elements) {
+
+	GraphSearchVertex * data = m_vertices.find(query->m_vertex);
+
+#ifdef CONFIG_ASSERT
+	assert(data != NULL);
+#endif
+
+	if(query->m_tag == RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT) {
+
+		data->m_edges = elements->at(0);
+		data->m_coverage = elements->at(1);
+
+	} else if(query->m_tag == RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE) {
+
+		data->m_numberOfPaths[query->m_strand] = elements->at(0);
+
+	} else if(query->m_tag == RAY_MPI_TAG_ASK_VERTEX_PATH) {
+
+		/* skip the k-mer because we don't need it */
+		int position = query->m_vertex.getNumberOfU64();
+		PathHandle path = elements->at(position++);
+		int progression = elements->at(position++);
+
+		data->m_directions[query->m_strand][query->m_pathIndex].constructor(path, progression, false);
+	}
+}
+
+/**
+ * Each source visits its level, and the sources that still have
+ * vertices to visit start another level.
+ */
+void GraphSearchEngine::visitFrontiers() {
+
+	bool active = false;
+
+	vector<Kmer> nextFrontier;
+
+	for(int i = 0 ; i < m_numberOfSources ; i++) {
+
+		GraphSearchSource & source = m_sources[i];
+
+		if(source.m_order == GRAPH_SEARCH_DEPTH_FIRST) {
+
+			if(!source.m_frontier.empty())
+				visitTop(i);
+
+		} else {
+
+			nextFrontier.clear();
+			visitLevel(i, &nextFrontier);
+			source.m_frontier.swap(nextFrontier);
+		}
+
+		if(!source.m_frontier.empty())
+			active = true;
+	}
+
+	if(active)
+		m_step = GRAPH_SEARCH_STEP_COLLECT;
+	else
+		m_step = GRAPH_SEARCH_STEP_DONE;
+}
+
+/**
+ * A breadth-first source visits the vertices of its frontier, in order, and
+ * the vertices that it did not reach before form its next frontier.
+ */
+void GraphSearchEngine::visitLevel(int index, vector<Kmer> * nextFrontier) {
+
+	int kmerLength = m_parameters->getWordSize();
+
+	GraphSearchSource & source = m_sources[index];
+
+	for(int j = 0 ; j < (int)source.m_frontier.size() ; j++) {
+
+		Kmer vertex = source.m_frontier[j];
+		GraphSearchVertex * data = m_vertices.find(vertex);
+		int depth = *(source.m_depths.find(vertex));
+
+		source.m_visitedVertices ++;
+
+		if(depth > source.m_maximumVisitedDepth)
+			source.m_maximumVisitedDepth = depth;
+
+		vector<Kmer> links;
+
+		if(source.m_direction == GRAPH_SEARCH_PARENTS)
+			links = vertex.getIngoingEdges(data->m_edges, kmerLength);
+		else
+			links = vertex.getOutgoingEdges(data->m_edges, kmerLength);
+
+		bool follow = m_consumer->visitVertex(index, &vertex, depth, data->m_coverage,
+			&(data->m_directions[0]), &(data->m_directions[1]), &links);
+
+		if(!follow || depth + 1 > source.m_maximumDepth)
+			continue;
+
+		for(int k = 0 ; k < (int)links.size() ; k++) {
+
+			Kmer & link = links[k];
+
+			if(source.m_depths.count(link) > 0)
+				continue;
+
+			if(source.m_maximumQueuedVertices != GRAPH_SEARCH_UNLIMITED
+				&& source.m_queuedVertices >= source.m_maximumQueuedVertices)
+				break;
+
+			source.m_depths[link] = depth + 1;
+			source.m_parents[link] = vertex;
+			nextFrontier->push_back(link);
+			source.m_queuedVertices ++;
+		}
+	}
+}
+
+/**
+ * A depth-first source pops the top of its stack and pushes the links
+ * of the vertex, without a visited set.
+ */
+void GraphSearchEngine::visitTop(int index) {
+
+	int kmerLength = m_parameters->getWordSize();
+
+	GraphSearchSource & source = m_sources[index];
+
+	Kmer vertex = source.m_frontier.back();
+	int depth = source.m_stackDepths.back();
+	GraphSearchVertex * data = m_vertices.find(vertex);
+
+	source.m_frontier.pop_back();
+	source.m_stackDepths.pop_back();
+
+	source.m_depths[vertex] = depth;
+	source.m_visitedVertices ++;
+
+	if(depth > source.m_maximumVisitedDepth)
+		source.m_maximumVisitedDepth = depth;
+
+	vector<Kmer> links;
+
+	if(source.m_direction == GRAPH_SEARCH_PARENTS)
+		links = vertex.getIngoingEdges(data->m_edges, kmerLength);
+	else
+		links = vertex.getOutgoingEdges(data->m_edges, kmerLength);
+
+	bool follow = m_consumer->visitVertex(index, &vertex, depth, data->m_coverage,
+		&(data->m_directions[0]), &(data->m_directions[1]), &links);
+
+	if(!follow || depth + 1 > source.m_maximumDepth)
+		return;
+
+	for(int k = 0 ; k < (int)links.size() ; k++) {
+
+		if(source.m_maximumQueuedVertices != GRAPH_SEARCH_UNLIMITED
+			&& source.m_queuedVertices >= source.m_maximumQueuedVertices)
+			break;
+
+		Kmer & link = links[k];
+
+		source.m_allParents[link].push_back(vertex);
+		source.m_frontier.push_back(link);
+		source.m_stackDepths.push_back(depth + 1);
+		source.m_queuedVertices ++;
+	}
+}
+
+int GraphSearchEngine::getNumberOfSources() const {
+	return m_numberOfSources;
+}
+
+bool GraphSearchEngine::getParent(int source, Kmer * vertex, Kmer * parent) {
+
+	if(m_sources[source].m_order == GRAPH_SEARCH_DEPTH_FIRST)
+		return getNearestParent(source, vertex, parent);
+
+	Kmer * value = m_sources[source].m_parents.find(*vertex);
+
+	if(value == NULL)
+		return false;
+
+	*parent = *value;
+
+	return true;
+}
+
+int GraphSearchEngine::getVisitedVertices(int source) const {
+	return m_sources[source].m_visitedVertices;
+}
+
+int GraphSearchEngine::getMaximumVisitedDepth(int source) const {
+	return m_sources[source].m_maximumVisitedDepth;
+}
+
+bool GraphSearchEngine::getNearestParent(int source, Kmer * vertex, Kmer * parent) {
+
+	GraphSearchSource & search = m_sources[source];
+
+	vector<Kmer> * parents = search.m_allParents.find(*vertex);
+
+	if(parents == NULL)
+		return false;
+
+	int bestDepth = 99999;
+	Kmer bestKmer;
+
+	for(int i = 0 ; i < (int)parents->size() ; i++) {
+
+		int * parentDepth = search.m_depths.find(parents->at(i));
+
+		if(parentDepth != NULL && *parentDepth < bestDepth) {
+			bestKmer = parents->at(i);
+			bestDepth = *parentDepth;
+		}
+	}
+
+	*parent = bestKmer;
+
+	return true;
+}
@@ -0,0 +1,226 @@
+/*
+ *  Ray -- Parallel genome assemblies for parallel DNA sequencing
+ *  Copyright (C) 2026 agent
+ *
+ *  http://DeNovoAssembler.SourceForge.Net/
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You have received a copy of the GNU General Public License
+ *  along with this program (gpl-3.0.txt).
+ *  see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef GraphSearchEngine_Header
+#define GraphSearchEngine_Header
+
+#include "GraphSearchConsumer.h"
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/SeedExtender/Direction.h>
+#include <code/SeedExtender/FlatMap.h>
+#include <code/Mock/Parameters.h>
+
+#include <RayPlatform/communication/VirtualCommunicator.h>
+#include <RayPlatform/memory/RingAllocator.h>
+
+#include <vector>
+using namespace std;
+
+#define GRAPH_SEARCH_PARENTS 0
+#define GRAPH_SEARCH_CHILDREN 1
+
+#define GRAPH_SEARCH_BREADTH_FIRST 0
+#define GRAPH_SEARCH_DEPTH_FIRST 1
+
+/* no limit on the vertices queued by a source */
+#define GRAPH_SEARCH_UNLIMITED -1
+
+/* the number of sources searched at the same time */
+#define GRAPH_SEARCH_SOURCES_PER_BATCH 1024
+
+/* the number of queries waiting for a reply in the VirtualCommunicator */
+#define GRAPH_SEARCH_MAXIMUM_QUERIES 4096
+
+/**
+ * The attributes and the annotations of a vertex, fetched once
+ * for all the sources.
+ *
+ * \author agent
+ */
+class GraphSearchVertex {
+
+public:
+
+	uint8_t m_edges;
+	CoverageDepth m_coverage;
+
+	/* 0 is the vertex, 1 is its reverse complement */
+	int m_numberOfPaths[2];
+	vector<Direction> m_directions[2];
+};
+
+/**
+ * A query for the attributes or the annotations of a vertex.
+ *
+ * \author agent
+ */
+class GraphSearchQuery {
+
+public:
+
+	Kmer m_vertex;
+	MessageTag m_tag;
+	int m_strand;
+	int m_pathIndex;
+};
+
+/**
+ * A search from one vertex.
+ *
+ * A breadth-first source visits its whole frontier at each level.
+ * A depth-first source uses its frontier as a stack and visits its
+ * top only, so it advances by one vertex at each level.
+ *
+ * \author agent
+ */
+class GraphSearchSource {
+
+public:
+
+	int m_direction;
+	int m_order;
+	int m_maximumDepth;
+	int m_maximumQueuedVertices;
+	int m_queuedVertices;
+	int m_visitedVertices;
+	int m_maximumVisitedDepth;
+
+	vector<Kmer> m_frontier;
+
+	/* depth-first: the depth of each vertex of the stack */
+	vector<int> m_stackDepths;
+
+	/* breadth-first: the visited set, with the depth of each vertex;
+	 * depth-first: the depth of the last visit of each vertex */
+	FlatMap<Kmer, int> m_depths;
+
+	/* breadth-first: the first parent is the nearest since levels are done in order */
+	FlatMap<Kmer, Kmer> m_parents;
+
+	/* depth-first: all the vertices that queued each vertex */
+	FlatMap<Kmer, vector<Kmer> > m_allParents;
+};
+
+/**
+ * A search from many sources at the same time.
+ *
+ * The search is level-synchronous: the vertices of the current level of
+ * all the sources are fetched together, and then each source
+ * visits its level. A vertex reached by several sources is fetched only once.
+ *
+ * A breadth-first source visits a vertex once, at its shortest depth.
+ * A depth-first source has no visited set: it visits its vertices in the
+ * order of a stack, like the older one-seed-at-a-time explorers, and
+ * only the fetches of the sources are grouped.
+ *
+ * A source stops queuing vertices after maximumQueuedVertices, which
+ * bounds the memory of a batch.
+ *
+ * The queries go through the VirtualCommunicator with one worker handle per
+ * pending query, so that they are grouped in messages for each rank.
+ *
+ * The caller must call forceFlush and processInbox on the VirtualCommunicator
+ * before each call to work, and no other worker handle can be used while the
+ * search is running.
+ *
+ * \author agent
+ */
+class GraphSearchEngine {
+
+	Parameters * m_parameters;
+	VirtualCommunicator * m_virtualCommunicator;
+	RingAllocator * m_outboxAllocator;
+
+	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH;
+
+	GraphSearchConsumer * m_consumer;
+
+	/* sources are kept between batches to keep their memory */
+	vector<GraphSearchSource> m_sources;
+	int m_numberOfSources;
+
+	FlatMap<Kmer, GraphSearchVertex> m_vertices;
+	vector<Kmer> m_newVertices;
+
+	vector<GraphSearchQuery> m_queries;
+	int m_nextQuery;
+
+	/* the query of each worker handle, or -1 */
+	vector<int> m_handles;
+	vector<WorkerHandle> m_freeHandles;
+
+	int m_step;
+
+	void queueQuery(Kmer * vertex, MessageTag tag, int strand, int pathIndex);
+	void collectFrontiers();
+	void queuePathQueries();
+	bool processQueries(vector<WorkerHandle> * activeWorkers);
+	void sendQuery(WorkerHandle handle, GraphSearchQuery * query);
+	void receiveReply(GraphSearchQuery * query, vector<MessageUnit> * elements);
+	void visitFrontiers();
+	void visitLevel(int index, vector<Kmer> * nextFrontier);
+	void visitTop(int index);
+	bool getNearestParent(int source, Kmer * vertex, Kmer * parent);
+
+public:
+
+	void initialize(Parameters * parameters, VirtualCommunicator * virtualCommunicator,
+		RingAllocator * outboxAllocator,
+		MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
+		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
+		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH);
+
+	/** removes the sources and the fetched vertices */
+	void clear();
+
+	/**
+	 * Adds a source, direction is GRAPH_SEARCH_PARENTS or GRAPH_SEARCH_CHILDREN,
+	 * order is GRAPH_SEARCH_BREADTH_FIRST or GRAPH_SEARCH_DEPTH_FIRST.
+	 * maximumQueuedVertices can be GRAPH_SEARCH_UNLIMITED.
+	 *
+	 * @returns the index of the source
+	 */
+	int addSource(Kmer * start, int direction, int order, int maximumDepth, int maximumQueuedVertices);
+
+	void start(GraphSearchConsumer * consumer);
+
+	/**
+	 * activeWorkers are the worker handles given by processInbox.
+	 *
+	 * @returns true when all the sources are done
+	 */
+	bool work(vector<WorkerHandle> * activeWorkers);
+
+	int getNumberOfSources() const;
+
+	/**
+	 * gets the vertex that reached a vertex first, or for a depth-first
+	 * source the one with the smallest depth at its last visit
+	 */
+	bool getParent(int source, Kmer * vertex, Kmer * parent);
+
+	int getVisitedVertices(int source) const;
+	int getMaximumVisitedDepth(int source) const;
+};
+
+#endif /* GraphSearchEngine_Header */
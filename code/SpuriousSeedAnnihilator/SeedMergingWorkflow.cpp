@@ -19,14 +19,44 @@
  */
 
 #include "SeedMergingWorkflow.h"
-#include "NanoMerger.h"
 
 /*
- * Methods to implement for the TaskCreator interface.
- *
- * The TaskCreator stack is used in the handler
- * RAY_SLAVE_MODE_FILTER_SEEDS.
+ * The slave mode RAY_SLAVE_MODE_MERGE_SEEDS calls mainLoop.
  */
+void SeedMergingWorkflow::mainLoop(){
+
+	m_activeWorkers.clear();
+	m_virtualCommunicator->forceFlush();
+	m_virtualCommunicator->processInbox(&m_activeWorkers);
+
+	if(!m_initialized){
+
+		initializeMethod();
+
+		m_initialized = true;
+		m_batchIsStarted = false;
+
+	}else if(!m_batchIsStarted){
+
+		if(!hasUnassignedTask()){
+
+			finalizeMethod();
+
+			m_initialized = false;
+			return;
+		}
+
+		startBatch();
+
+		m_batchIsStarted = true;
+
+	}else if(m_engine.work(&m_activeWorkers)){
+
+		processBatch();
+
+		m_batchIsStarted = false;
+	}
+}
 
 /** initialize the whole thing */
 void SeedMergingWorkflow::initializeMethod(){
@@ -34,6 +64,14 @@ void SeedMergingWorkflow::initializeMethod(){
 	m_seedIndex=0;
 
 	m_finished = 0 ;
+
+	m_engine.initialize(m_parameters, m_virtualCommunicator, m_core->getOutboxAllocator(),
+		RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
+		RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
+		RAY_MPI_TAG_ASK_VERTEX_PATH
+	);
+
+	m_explorer.initialize(&m_engine, m_parameters);
 }
 
 /** finalize the whole thing */
@@ -41,10 +79,12 @@ void SeedMergingWorkflow::finalizeMethod(){
 
 	//cout << "[DEBUG] number of relations: " << m_searchResults.size() << endl;
 
+	m_explorer.clear();
+
 	m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getRank());
 }
 
-/** has an unassigned task left to compute */
+/** has a seed left to explore */
 bool SeedMergingWorkflow::hasUnassignedTask(){
 
 	/*
@@ -61,37 +101,62 @@ bool SeedMergingWorkflow::hasUnassignedTask(){
 	return m_seedIndex < (int) m_seeds->size () ;
 }
 
-/** assign the next task to a worker and return this worker */
-Worker*SeedMergingWorkflow::assignNextTask(){
+/**
+ * Each seed has 2 sources: its first k-mer for the left side
+ * and its last k-mer for the right side.
+ */
+void SeedMergingWorkflow::startBatch(){
 
-#ifdef CONFIG_ASSERT
-	assert(m_seedIndex < (int)m_seeds->size());
-#endif
+	m_explorer.clear();
 
-	if(m_seedIndex % m_period == 0)
-		cout<<"Rank "<<m_rank<< " assignNextTask "<<m_seedIndex<< "/" << m_seeds->size()<<endl;
+	m_firstSeedOfBatch = m_seedIndex;
 
-	NanoMerger*worker = new NanoMerger();
+	while(m_seedIndex < (int)m_seeds->size()
+		&& 2 * (m_seedIndex - m_firstSeedOfBatch) < GRAPH_SEARCH_SOURCES_PER_BATCH){
 
-	worker->initialize(m_seedIndex, &((*m_seeds)[m_seedIndex]), m_parameters,
-		m_virtualCommunicator,
-		m_core->getOutboxAllocator(),
-		RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-		RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
-		RAY_MPI_TAG_ASK_VERTEX_PATH
-	);
+		if(m_seedIndex % m_period == 0)
+			cout<<"Rank "<<m_rank<< " assignNextTask "<<m_seedIndex<< "/" << m_seeds->size()<<endl;
+
+		GraphPath * seed = &((*m_seeds)[m_seedIndex]);
+		PathHandle seedName = getPathUniqueId(m_rank, m_seedIndex);
 
-	m_seedIndex++;
+		Kmer first;
+		seed->at(0, &first);
 
-	return worker;
+		Kmer last;
+		seed->at(seed->size() - 1, &last);
+
+		m_explorer.addSeedEnd(&first, seed, EXPLORER_LEFT, seedName);
+		m_explorer.addSeedEnd(&last, seed, EXPLORER_RIGHT, seedName);
+
+		m_seedIndex++;
+	}
+
+	m_engine.start(&m_explorer);
 }
 
-/** get the result of a worker */
-void SeedMergingWorkflow::processWorkerResult(Worker*worker){
+void SeedMergingWorkflow::processBatch(){
+
+	for(int seedIndex = m_firstSeedOfBatch ; seedIndex < m_seedIndex ; seedIndex ++){
+
+		vector<GraphSearchResult> results;
 
-	NanoMerger * theWorker = (NanoMerger*)worker;
+		for(int side = 0 ; side < 2 ; side ++){
 
-	vector<GraphSearchResult> & results = theWorker->getResults();
+			int source = 2 * (seedIndex - m_firstSeedOfBatch) + side;
+
+			m_explorer.printSummary(source);
+
+			if(m_explorer.isValid(source))
+				results.push_back(m_explorer.getSearchResults(source)[0]);
+		}
+
+		processSeedResults(results);
+	}
+}
+
+/** get the results of a seed */
+void SeedMergingWorkflow::processSeedResults(vector<GraphSearchResult> & results){
 
 	bool runTransaction = true;
 
@@ -136,17 +201,8 @@ void SeedMergingWorkflow::processWorkerResult(Worker*worker){
 	m_finished++;
 }
 
-/** destroy a worker */
-void SeedMergingWorkflow::destroyWorker(Worker*worker){
-
-	NanoMerger * concreteWorker = (NanoMerger*)worker;
-	delete concreteWorker;
-	worker = NULL; // this does nothing useful
-	concreteWorker = NULL;
-}
-
 void SeedMergingWorkflow::initialize(vector<GraphPath>*seeds, VirtualCommunicator*virtualCommunicator,
-	VirtualProcessor * virtualProcessor,ComputeCore * core, Parameters * parameters,
+	ComputeCore * core, Parameters * parameters,
 	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH){
@@ -154,7 +210,6 @@ void SeedMergingWorkflow::initialize(vector<GraphPath>*seeds, VirtualCommunicato
 	m_rank = core->getRank();
 	m_seeds = seeds;
 	m_virtualCommunicator = virtualCommunicator;
-	m_virtualProcessor = virtualProcessor;
 	m_core = core;
 	m_parameters = parameters;
 
@@ -164,6 +219,8 @@ void SeedMergingWorkflow::initialize(vector<GraphPath>*seeds, VirtualCommunicato
 
 	m_period = 100;
 
+	m_initialized = false;
+
 }
 
 vector<GraphSearchResult> & SeedMergingWorkflow::getResults() {
@@ -21,13 +21,14 @@
 #ifndef _SeedMergingWorkflow_h
 #define _SeedMergingWorkflow_h
 
+#include "GraphExplorer.h"
+#include "GraphSearchEngine.h"
 #include "GraphSearchResult.h"
 
 #include <code/SeedingData/GraphPath.h>
 #include <code/Mock/Parameters.h>
 
 #include <RayPlatform/core/ComputeCore.h>
-#include <RayPlatform/scheduling/TaskCreator.h>
 #include <RayPlatform/communication/VirtualCommunicator.h>
 
 #include <vector>
@@ -37,61 +38,64 @@ using namespace std;
  *
  * This is used to merge seeds.
  *
- * This class is derived directly from the SeedFilteringWorkflow.
+ * The ends of a batch of seeds are explored at the same time
+ * with a GraphSearchEngine.
  *
  * \author Sébastien Boisvert
  */
-class SeedMergingWorkflow: public TaskCreator {
+class SeedMergingWorkflow {
 
 	vector<GraphSearchResult> m_searchResults;
 	vector<GraphSearchResult> m_remoteResults;
 
+	GraphSearchEngine m_engine;
+	GraphExplorer m_explorer;
+
 	ComputeCore*m_core;
 	int m_seedIndex;
+	int m_firstSeedOfBatch;
 	Parameters * m_parameters;
 	vector<GraphPath>*m_seeds;
 	vector<bool> m_states;
 
+	bool m_initialized;
+	bool m_batchIsStarted;
+
 	int m_finished;
 	int m_rank;
 	int m_period;
 
-/* TODO: maybe this should be in the TaskCreator */
 	VirtualCommunicator * m_virtualCommunicator;
+	vector<WorkerHandle> m_activeWorkers;
 
 	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH;
 
-public:
-
-/*
- * Methods to implement for the TaskCreator interface.
- *
- * The TaskCreator stack is used in the handler
- * RAY_SLAVE_MODE_FILTER_SEEDS.
- */
-
 	/** initialize the whole thing */
 	void initializeMethod();
 
 	/** finalize the whole thing */
 	void finalizeMethod();
 
-	/** has an unassigned task left to compute */
+	/** has a seed left to explore */
 	bool hasUnassignedTask();
 
-	/** assign the next task to a worker and return this worker */
-	Worker*assignNextTask();
+	/** add the ends of the next seeds in the engine */
+	void startBatch();
+
+	/** get the results of the seeds of the batch */
+	void processBatch();
 
-	/** get the result of a worker */
-	void processWorkerResult(Worker*worker);
+	void processSeedResults(vector<GraphSearchResult> & results);
+
+public:
 
-	/** destroy a worker */
-	void destroyWorker(Worker*worker);
+	/** called in the slave mode until it is closed */
+	void mainLoop();
 
 	void initialize(vector<GraphPath>*seeds, VirtualCommunicator*virtualCommunicator,
-		VirtualProcessor * virtualProcessor, ComputeCore * core,
+		ComputeCore * core,
 		Parameters * parameters, MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
 		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
 		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH
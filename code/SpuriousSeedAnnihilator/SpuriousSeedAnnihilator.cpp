@@ -66,6 +66,8 @@ __CreateMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_REQUEST_VERTE
 __CreateMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP);
 __CreateMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY);
 __CreateMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_ARBITER_SIGNAL);
+__CreateMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE);
+__CreateMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY);
 
 SpuriousSeedAnnihilator::SpuriousSeedAnnihilator(){
 }
@@ -74,6 +76,8 @@ SpuriousSeedAnnihilator::SpuriousSeedAnnihilator(){
  * Even if checkpoints exist, we don't skip this code path.
  */
 void SpuriousSeedAnnihilator::call_RAY_SLAVE_MODE_PUSH_SEED_LENGTHS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_PUSH_SEED_LENGTHS);
+
 	if(!m_initialized){
 
 		vector<GraphPath> newSeeds;
@@ -462,16 +466,18 @@ void SpuriousSeedAnnihilator::checkResults() {
 
 	m_mergingTechnology.getResults().clear();
 
-	m_hasNewGossips = true;
-	m_lastGossipingEventTime = time(NULL);
-
 	//cout << "[DEBUG] MODE_CHECK_RESULTS gossiping begins..." << endl;
 
 	m_messagesSentForGossiping = 0;
+	m_gossipsReceived = 0;
 
-	m_initialGossips = m_gossipAssetManager.getGossips().size();
+	// the first probe wave can not conclude anything
+	m_receivedGossipSinceLastProbe = true;
+	m_gossipProbeIsPending = false;
+	m_gossipProbeWasSent = false;
+	m_gossipProbeWaves = 0;
 
-	m_messageWasSentToArbiter = false;
+	m_initialGossips = m_gossipAssetManager.getGossips().size();
 
 	// this is a barrier
 
@@ -518,6 +524,12 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_SEED_GOSSIP(Message * message
 	this->m_core->getSwitchMan()->sendEmptyMessage(m_outbox, m_rank, message->getSource(),
 		RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY);
 
+	// counters for the termination detection
+	m_gossipsReceived ++;
+	m_receivedGossipSinceLastProbe = true;
+
+	Rank actor = message->getSource();
+
 	int availableUnits = message->getCount();
 
 	// if the message is empty, we have nothing to do.
@@ -542,7 +554,9 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_SEED_GOSSIP(Message * message
 
 	bool found = m_gossipAssetManager.hasGossip(gossip);
 
+	// the source has a copy, so don't send it back there later.
 	if(found) {
+		m_gossipAssetManager.registerRemoteGossip(gossip, actor);
 		return;
 	}
 
@@ -550,8 +564,6 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_SEED_GOSSIP(Message * message
 	// yay we got new gossip to share !!!
 	m_gossipAssetManager.addGossip(gossip);
 
-	m_lastGossipingEventTime = time(NULL);
-
 	// we could also update the m_gossipStatus
 	// because we know that message->getSource() has this gossip
 	// already.
@@ -562,9 +574,6 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_SEED_GOSSIP(Message * message
 	// all ranks
 	//
 
-
-	Rank actor = message->getSource();
-
 #ifdef CONFIG_ASSERT
 	vector<GraphSearchResult> & gossips = m_gossipAssetManager.getGossips();
 	int gossipIndex = gossips.size() - 1;
@@ -591,9 +600,6 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_SEED_GOSSIP(Message * message
 
 	//m_gossipStatus[gossipIndex].insert(actor);
 
-	// we have new gossip, so this is important to store.
-	m_hasNewGossips = true;
-
 	//cout << "[DEBUG] MODE_SHARE_WITH_LINKED_ACTORS Rank rank:" << m_rank << " received gossip gossip:" << key << " from rank rank:" << actor << endl;
 
 	//return;
@@ -606,8 +612,98 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY(Message * m
 #ifdef CONFIG_ASSERT
 	assert(m_activeQueries >= 0);
 #endif // CONFIG_ASSERT
+}
+
+/*
+ * Termination detection for the gossip phase.
+ *
+ * A rank only creates gossip traffic after receiving a gossip, and every
+ * RAY_MESSAGE_TAG_SEED_GOSSIP is acknowledged with
+ * RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY. A rank is passive when it has nothing to
+ * share and no unacknowledged gossip.
+ *
+ * The arbiter probes all the ranks in waves. A rank answers a probe only
+ * when it is passive, with its counters of sent and received gossips and
+ * a flag telling if it received a gossip since its previous answer. The
+ * phase is over when, in a single wave, no rank received anything since its
+ * previous answer and the number of sent gossips is equal to the number of
+ * received gossips. A rank that received a gossip before answering
+ * invalidates the wave, so the first wave never concludes.
+ *
+ * Only the arbiter starts waves, and only when it is passive itself.
+ */
+void SpuriousSeedAnnihilator::startGossipProbe() {
+
+	if(m_rank != getArbiter())
+		return;
+
+	if(m_gossipProbeWasSent)
+		return;
+
+	m_gossipProbeReplies = 0;
+	m_gossipProbeIsClean = true;
+	m_gossipProbeSentMessages = 0;
+	m_gossipProbeReceivedMessages = 0;
+
+	this->m_core->getSwitchMan()->sendToAll(m_outbox, m_rank, RAY_MESSAGE_TAG_GOSSIP_PROBE);
+
+	m_gossipProbeWasSent = true;
+}
+
+void SpuriousSeedAnnihilator::answerGossipProbe() {
 
-	m_lastGossipingEventTime = time(NULL);
+	if(!m_gossipProbeIsPending)
+		return;
+
+	MessageUnit * buffer = (MessageUnit *) m_outboxAllocator->allocate(3 * sizeof(MessageUnit));
+	buffer[0] = m_messagesSentForGossiping;
+	buffer[1] = m_gossipsReceived;
+	buffer[2] = m_receivedGossipSinceLastProbe;
+
+	Message aMessage(buffer, 3, getArbiter(), RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY, m_rank);
+	m_outbox->push_back(&aMessage);
+
+	m_receivedGossipSinceLastProbe = false;
+	m_gossipProbeIsPending = false;
+}
+
+void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_GOSSIP_PROBE(Message * message) {
+
+	// the answer is sent by shareWithLinkedActors when this rank is passive
+	m_gossipProbeIsPending = true;
+}
+
+void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY(Message * message) {
+
+	MessageUnit * buffer = (MessageUnit *) message->getBuffer();
+
+	m_gossipProbeSentMessages += buffer[0];
+	m_gossipProbeReceivedMessages += buffer[1];
+
+	if(buffer[2])
+		m_gossipProbeIsClean = false;
+
+	m_gossipProbeReplies ++;
+
+	if(m_gossipProbeReplies < m_core->getSize())
+		return;
+
+	m_gossipProbeWaves ++;
+
+	if(m_gossipProbeIsClean && m_gossipProbeSentMessages == m_gossipProbeReceivedMessages) {
+
+		cout << "Rank " << m_rank << ": gossiping terminated after " << m_gossipProbeWaves;
+		cout << " probe waves (" << m_gossipProbeSentMessages << " gossip messages)" << endl;
+
+		// m_gossipProbeWasSent stays true, there is no other wave
+		m_mustAdviseRanks = true;
+		m_rankToAdvise = 0;
+
+		return;
+	}
+
+	// start another wave
+	m_gossipProbeWasSent = false;
 }
 
 
@@ -638,60 +734,15 @@ void SpuriousSeedAnnihilator::shareWithLinkedActors() {
 	// for correctness, use 1
 	maximumActiveQueries = 1;
 
-	/**
-	 *
-	 * We wait a specific amount of time before stopping the
-	 * gossip process.
-	 *
-	 * This code will fail if the process receives a SIGSTOP
-	 *
-	 * TODO  or if the process is not scheduled during too many seconds.
-	 */
-
-	if(!m_hasNewGossips && !m_messageWasSentToArbiter) {
-
-		// we don't care about the response because
-		// the rank does not have anything to send...
-		//if(m_activeQueries > 0)
-			//m_activeQueries = 0;
-
-		if(m_activeQueries > 0)
-			return;
-
-		// check delay and latency
-		time_t currentTime = time(NULL);
+	// the arbiter signal that ends the gossip phase moves to this mode
+	m_nextMode = MODE_SHARE_PUSH_DATA_IN_KEY_VALUE_STORE;
 
-		int minimumWaitTime = 10; // seconds
-		int distance = currentTime - m_lastGossipingEventTime;
+	bool isPassive = (m_activeQueries == 0 && !m_gossipAssetManager.hasGossipToShare());
 
-		if(distance < minimumWaitTime)
-			return;
+	if(isPassive) {
 
-		//cout << "[DEBUG] MODE_SHARE_WITH_LINKED_ACTORS Rank " << m_rank << " gossips have spreaded." << endl;
-
-		//m_gossipStatus.clear();
-
-		// synchronize indexes in m_indexesToShareWithArbiter
-		//m_mode = MODE_EVALUATE_GOSSIPS;
-		//m_mode = MODE_SHARE_PUSH_DATA_IN_KEY_VALUE_STORE;
-
-		cout << "Rank " << m_core->getRank() << ": gossiping generated " << m_messagesSentForGossiping;
-		cout << " messages";
-		cout << " (gossips: " << m_initialGossips;
-		cout << " ---> " << m_gossipAssetManager.getGossips().size();
-		cout << ")" << endl;
-
-		int currentMode = m_mode;
-		sendMessageToArbiter();
-
-		// remain in the current mode to be able to send the messages correctly
-		// for incoming new gossips
-		m_mode = currentMode;
-		m_nextMode = MODE_SHARE_PUSH_DATA_IN_KEY_VALUE_STORE;
-
-		//cout << "DEBUG call sendMessageToArbiter for m_messageWasSentToArbiter" << endl;
-
-		m_messageWasSentToArbiter = true;
+		answerGossipProbe();
+		startGossipProbe();
 
 		return;
 	}
@@ -713,8 +764,6 @@ void SpuriousSeedAnnihilator::shareWithLinkedActors() {
 
 		// we found a gossip that needs to be shared with actor <actor>
 
-		m_lastGossipingEventTime = time(NULL);
-
 		char *messageBuffer = (char *)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
 
 #ifdef CONFIG_ASSERT_CONFIG
@@ -762,16 +811,8 @@ void SpuriousSeedAnnihilator::shareWithLinkedActors() {
 		cout << "[DEBUG] MODE_SHARE_WITH_LINKED_ACTORS Rank rank:" << m_rank << " sent gossip gossip:" << key << " from rank rank:" << actor << endl;
 #endif
 
-		m_hasNewGossips = true;
-
 		m_messagesSentForGossiping ++;
-
-		return;
 	}
-
-	// at this point, we tried every gossip and they are all synchronized.
-
-	m_hasNewGossips = false;
 }
 
 void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_ARBITER_SIGNAL(Message * message) {
@@ -781,10 +822,19 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_ARBITER_SIGNAL(Message * mess
 	cout << m_nextMode << endl;
 #endif
 
+	if(m_mode == MODE_SHARE_WITH_LINKED_ACTORS) {
+		cout << "Rank " << m_core->getRank() << ": gossiping generated " << m_messagesSentForGossiping;
+		cout << " messages";
+		cout << " (gossips: " << m_initialGossips;
+		cout << " ---> " << m_gossipAssetManager.getGossips().size();
+		cout << ")" << endl;
+	}
+
 	m_mode = m_nextMode;
 }
 
 void SpuriousSeedAnnihilator::call_RAY_SLAVE_MODE_PROCESS_MERGING_ASSETS() {
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_PROCESS_MERGING_ASSETS);
 
 	initializeMergingProcess();
 
@@ -1337,7 +1387,7 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_REQUEST_VERTEX_COVERAGE_WITH_
 		CoverageDepth coverage=0;
 
 		if(node!=NULL){
-			coverage=node->getCoverage(&vertex);
+			coverage=m_subgraph->getCoverage(node);
 
 			#ifdef CONFIG_ASSERT
 			assert(coverage!=0);
@@ -1523,6 +1573,7 @@ void SpuriousSeedAnnihilator::call_RAY_MASTER_MODE_CLEAN_SEEDS(){
 }
 
 void SpuriousSeedAnnihilator::call_RAY_SLAVE_MODE_REGISTER_SEEDS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_REGISTER_SEEDS);
 
 	if(!m_initializedSeedRegistration) {
 
@@ -1671,6 +1722,8 @@ void SpuriousSeedAnnihilator::call_RAY_MASTER_MODE_MERGE_SEEDS() {
 }
 
 void SpuriousSeedAnnihilator::call_RAY_SLAVE_MODE_MERGE_SEEDS() {
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_MERGE_SEEDS);
+
 	// merge the seeds using arbitration
 
 	if(this->m_debug) {
@@ -1689,6 +1742,7 @@ void SpuriousSeedAnnihilator::call_RAY_MESSAGE_TAG_MERGE_SEEDS(Message*message)
 }
 
 void SpuriousSeedAnnihilator::call_RAY_SLAVE_MODE_FILTER_SEEDS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_FILTER_SEEDS);
 
 	if((!m_debugCode && m_hasCheckpointFilesForSeeds) || m_skip){
 
@@ -1700,6 +1754,7 @@ void SpuriousSeedAnnihilator::call_RAY_SLAVE_MODE_FILTER_SEEDS(){
 }
 
 void SpuriousSeedAnnihilator::call_RAY_SLAVE_MODE_CLEAN_SEEDS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_CLEAN_SEEDS);
 
 	m_cleaningIterations ++;
 
@@ -1893,6 +1948,8 @@ void SpuriousSeedAnnihilator::registerPlugin(ComputeCore*core){
 	__ConfigureMessageTagHandler(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP);
 	__ConfigureMessageTagHandler(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY);
 	__ConfigureMessageTagHandler(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_ARBITER_SIGNAL);
+	__ConfigureMessageTagHandler(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE);
+	__ConfigureMessageTagHandler(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY);
 
 	__ConfigureMasterModeHandler(SpuriousSeedAnnihilator, RAY_MASTER_MODE_REGISTER_SEEDS);
 	__ConfigureMasterModeHandler(SpuriousSeedAnnihilator, RAY_MASTER_MODE_FILTER_SEEDS);
@@ -1975,6 +2032,7 @@ void SpuriousSeedAnnihilator::registerPlugin(ComputeCore*core){
 }
 
 void SpuriousSeedAnnihilator::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
 
 	// before arriving here, there is this edition to be performed elsewhere in the code
 	// replace RAY_MASTER_MODE_TRIGGER_DETECTION by RAY_MASTER_MODE_CLEAN_SEEDS
@@ -2008,7 +2066,7 @@ void SpuriousSeedAnnihilator::resolveSymbols(ComputeCore*core){
 		RAY_MPI_TAG_ASK_VERTEX_PATH
 	);
 
-	m_mergingTechnology.initialize(m_seeds, m_virtualCommunicator, m_virtualProcessor, m_core, m_parameters,
+	m_mergingTechnology.initialize(m_seeds, m_virtualCommunicator, m_core, m_parameters,
 		RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT, RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
 		RAY_MPI_TAG_ASK_VERTEX_PATH
 	);
@@ -28,6 +28,7 @@
 #include <code/SeedingData/GraphPath.h>
 #include <code/Mock/Parameters.h>
 #include <code/VerticesExtractor/GridTable.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/core/ComputeCore.h>
 #include <RayPlatform/communication/VirtualCommunicator.h>
@@ -67,6 +68,8 @@ __DeclareMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_REQUEST_VERT
 __DeclareMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP);
 __DeclareMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY);
 __DeclareMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_ARBITER_SIGNAL);
+__DeclareMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE);
+__DeclareMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY);
 
 #ifndef _SpuriousSeedAnnihilator_h
 #define _SpuriousSeedAnnihilator_h
@@ -93,14 +96,13 @@ __DeclareMessageTagAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_ARBITER_SIGN
  *                   |                                   |
  *                   |                                   |
  *                   |                                   |
- *              AnnihilationWorker                    NanoMerger
- *              |               |                     |      |
- *              |               |                     |      |
- *              |               |                     |      |
- *     AttributeFetcher         |                     |  AnnotationFetcher
- *                              |                     |
- *                      AnnotationFetcher             |
- *                                                  AttributeFetcher
+ *              AnnihilationWorker                    GraphExplorer
+ *              |               |                        |
+ *              |               |                        |
+ *              |               |                        |
+ *     AttributeFetcher         |                  GraphSearchEngine
+ *                              |
+ *                      AnnotationFetcher
  *
  * \author Sébastien Boisvert
  *
@@ -135,6 +137,8 @@ class SpuriousSeedAnnihilator: public CorePlugin {
 	__AddAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP);
 	__AddAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY);
 	__AddAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_ARBITER_SIGNAL);
+	__AddAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE);
+	__AddAdapter(SpuriousSeedAnnihilator, RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY);
 
 	int m_toDistribute;
 	SeedGossipSolver m_seedGossipSolver;
@@ -183,6 +187,8 @@ class SpuriousSeedAnnihilator: public CorePlugin {
 	MessageTag RAY_MESSAGE_TAG_SEED_GOSSIP;
 	MessageTag RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY;
 	MessageTag RAY_MESSAGE_TAG_SAY_HELLO_TO_ARBITER;
+	MessageTag RAY_MESSAGE_TAG_GOSSIP_PROBE;
+	MessageTag RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY;
 
 	GossipAssetManager m_gossipAssetManager;
 	int m_initialGossips;
@@ -201,8 +207,6 @@ class SpuriousSeedAnnihilator: public CorePlugin {
 	int MODE_GENERATE_NEW_SEEDS;
 	Rank m_rankToAdvise;
 
-	bool m_messageWasSentToArbiter;
-
 	bool m_mustAdviseRanks;
 	int m_synced;
 	int m_mode;
@@ -235,6 +239,9 @@ class SpuriousSeedAnnihilator: public CorePlugin {
  * The workflow implements the TaskCreator interface so that it's possible for a 
  * single CorePlugin to implement several workflows that use VirtualCommunicator and
  * VirtualProcessor via TaskCreator.
+ *
+ * The merging explores the ends of many seeds at the same time with a
+ * GraphSearchEngine instead.
  */
 	SeedFilteringWorkflow m_workflow;
 	SeedMergingWorkflow m_mergingTechnology;
@@ -275,10 +282,22 @@ class SpuriousSeedAnnihilator: public CorePlugin {
 	bool m_messageWasReceived;
 
 #ifdef GOSSIP_ALGORITHM_FOR_SEEDS
-	bool m_hasNewGossips;
-	time_t m_lastGossipingEventTime;
 	map<int, set<Rank> > m_gossipStatus;
 	set<Rank> m_linkedActorsForGossip;
+
+/*
+ * Termination detection for the gossip phase (see startGossipProbe).
+ */
+	int m_gossipsReceived;
+	bool m_receivedGossipSinceLastProbe;
+	bool m_gossipProbeIsPending;
+
+	bool m_gossipProbeWasSent;
+	int m_gossipProbeReplies;
+	int m_gossipProbeWaves;
+	bool m_gossipProbeIsClean;
+	uint64_t m_gossipProbeSentMessages;
+	uint64_t m_gossipProbeReceivedMessages;
 #endif /* GOSSIP_ALGORITHM_FOR_SEEDS */
 
 	ComputeCore * getCore();
@@ -303,6 +322,8 @@ class SpuriousSeedAnnihilator: public CorePlugin {
 	void initializeMergingProcess();
 	void spreadAcquiredData();
 	void shareWithLinkedActors();
+	void startGossipProbe();
+	void answerGossipProbe();
 	void checkResults();
 	void evaluateGossips();
 	void rebuildSeedAssets();
@@ -315,6 +336,8 @@ class SpuriousSeedAnnihilator: public CorePlugin {
 	void cleanKeyValueStore();
 	void gatherCoverageValues();
 
+	Instrumentation*m_instrumentation;
+
 public:
 
 	SpuriousSeedAnnihilator();
@@ -358,6 +381,8 @@ public:
 	void call_RAY_MESSAGE_TAG_ARBITER_SIGNAL(Message * message);
 	void call_RAY_MESSAGE_TAG_SEED_GOSSIP(Message*message);
 	void call_RAY_MESSAGE_TAG_SEED_GOSSIP_REPLY(Message*message);
+	void call_RAY_MESSAGE_TAG_GOSSIP_PROBE(Message*message);
+	void call_RAY_MESSAGE_TAG_GOSSIP_PROBE_REPLY(Message*message);
 };
 
 #endif /* _SpuriousSeedAnnihilator_h */
@@ -286,7 +286,8 @@ void CoalescenceManager::receivePayload(Message & message) {
 
 	int position = 0;
 	Vertex vertex;
-	position += vertex.load(buffer + position);
+	CoverageDepth coverage = 0;
+	position += vertex.load(buffer + position, &coverage);
 
 	int sample = -1;
 	memcpy(&sample, buffer + position, sizeof(sample));
@@ -294,7 +295,7 @@ void CoalescenceManager::receivePayload(Message & message) {
 
 	int producer = source;
 
-	if(!classifyKmerInBuffer(producer, sample, vertex)) {
+	if(!classifyKmerInBuffer(producer, sample, vertex, coverage)) {
 
 		Message response;
 		response.setTag(PAYLOAD_RESPONSE);
@@ -303,7 +304,7 @@ void CoalescenceManager::receivePayload(Message & message) {
 	}
 }
 
-bool CoalescenceManager::classifyKmerInBuffer(int producer, int & sample, Vertex & vertex) {
+bool CoalescenceManager::classifyKmerInBuffer(int producer, int & sample, Vertex & vertex, CoverageDepth coverage) {
 
 	Kmer kmer = vertex.getKey();
 	int storageDestination = getVertexDestination(kmer);
@@ -321,10 +322,10 @@ bool CoalescenceManager::classifyKmerInBuffer(int producer, int & sample, Vertex
 	cout << "Destination -> " << storageDestination << endl;
 #endif
 
-	return addKmerInBuffer(producer, storageDestination, sample, vertex);
+	return addKmerInBuffer(producer, storageDestination, sample, vertex, coverage);
 }
 
-bool CoalescenceManager::addKmerInBuffer(int producer, int & actor, int & sample, Vertex & vertex) {
+bool CoalescenceManager::addKmerInBuffer(int producer, int & actor, int & sample, Vertex & vertex, CoverageDepth coverage) {
 
 	int actorIndex = actor - m_storeFirstActor;
 
@@ -339,7 +340,7 @@ bool CoalescenceManager::addKmerInBuffer(int producer, int & actor, int & sample
 	requiredBytes += vertex.getRequiredNumberOfBytes();
 	requiredBytes += sizeof(sample);
 
-	offset += vertex.dump(buffer + offset);
+	offset += vertex.dump(buffer + offset, coverage);
 	memcpy(buffer + offset, &sample, sizeof(sample));
 	offset += sizeof(sample);
 
@@ -154,7 +154,7 @@ void GenomeAssemblyReader::manageCommunicationForNewKmer(string & sequence, Cove
 #endif
 	Vertex vertex;
 	vertex.setKey(kmer);
-	vertex.setCoverageValue(coverage);
+	vertex.setCoverageCounter(coverage);
 
 	// add parents
 	for(int i = 0 ; i < (int)parents.length() ; ++i) {
@@ -189,7 +189,7 @@ void GenomeAssemblyReader::manageCommunicationForNewKmer(string & sequence, Cove
 	char messageBuffer[100];
 	int position = 0;
 
-	position += vertex.dump(messageBuffer + position);
+	position += vertex.dump(messageBuffer + position, coverage);
 	memcpy(messageBuffer + position, &m_sample, sizeof(m_sample));
 
 	position += sizeof(m_sample);
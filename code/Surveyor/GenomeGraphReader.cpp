@@ -28,6 +28,9 @@
 #include <code/Mock/common_functions.h>
 #include <code/KmerAcademyBuilder/Kmer.h>
 #include <code/VerticesExtractor/Vertex.h>
+#include <code/VerticesExtractor/GenomeGraphCheckpoint.h>
+
+#include <RayPlatform/cryptography/crypto.h>
 
 #include <iostream>
 #include <sstream>
@@ -54,22 +57,38 @@ void GenomeGraphReader::receive(Message & message) {
 	} else if(type == CoalescenceManager::PAYLOAD_RESPONSE) {
 
 		// read the next line now !
-		readLine();
+		readNext();
 	}
 }
 
+void GenomeGraphReader::readNext() {
+
+	if(m_binary)
+		readRecord();
+	else
+		readLine();
+}
+
 void GenomeGraphReader::startParty(Message & message) {
 
 	char * buffer = (char*) message.getBufferBytes();
 
 	memcpy(&m_aggregator, buffer, sizeof(int));
 
-	m_reader.open(m_fileName.c_str());
-
 	m_bad = false;
+	m_binary = isManifest();
 
-	if(!m_reader.isValid())
-		m_bad = true;
+	if(m_binary) {
+
+		if(!readManifest() || !openGraphFile())
+			m_bad = true;
+
+	} else {
+		m_reader.open(m_fileName.c_str());
+
+		if(!m_reader.isValid())
+			m_bad = true;
+	}
 
 	m_loaded = 0;
 
@@ -84,7 +103,7 @@ void GenomeGraphReader::startParty(Message & message) {
 
 	send(source, response);
 
-	readLine();
+	readNext();
 }
 
 void GenomeGraphReader::readLine() {
@@ -108,23 +127,8 @@ void GenomeGraphReader::readLine() {
 
 		m_reader.close();
 
-		printName();
-
-		if(m_bad) {
-			cout << "[GraphReader] Error: file " << m_fileName << " does not exist";
-			cout << endl;
-
-		} else {
-			cout << "[GraphReader] finished reading file " << m_fileName;
-			cout << " got " << m_loaded << " objects" << endl;
-		}
-
-		Message finishedMessage;
-		finishedMessage.setTag(DONE);
-
-		send(m_parent, finishedMessage);
+		finish();
 
-		die();
 	} else {
 
 		// AGCTGTGAAACTGGTGCAAGCTACCAGAATC;36;A;C
@@ -168,25 +172,12 @@ void GenomeGraphReader::readLine() {
 		cout << "DEBUG " << sequence << " with " << coverage << endl;
 #endif
 
-		// if this is the first one, send the k-mer length too
-		if(m_loaded == 0) {
-
-			Message aMessage;
-			aMessage.setTag(CoalescenceManager::SET_KMER_INFO);
-
-			int length = sequence.length();
-			aMessage.setBuffer(&length);
-			aMessage.setNumberOfBytes(sizeof(length));
-
-			send(m_aggregator, aMessage);
-		}
-
 		Kmer kmer;
 		kmer.loadFromTextRepresentation(sequence.c_str());
 
 		Vertex vertex;
 		vertex.setKey(kmer);
-		vertex.setCoverageValue(coverage);
+		vertex.setCoverageCounter(coverage);
 
 		// add parents
 		for(int i = 0 ; i < (int)parents.length() ; ++i) {
@@ -218,39 +209,299 @@ void GenomeGraphReader::readLine() {
 			vertex.addOutgoingEdge(&kmer, &childKmer, sequence.length());
 		}
 
-		char messageBuffer[100];
-		int position = 0;
+		sendVertex(vertex, coverage, sequence.length());
+	}
+}
+
+void GenomeGraphReader::sendVertex(Vertex & vertex, CoverageDepth coverage, int kmerLength) {
+
+	// if this is the first one, send the k-mer length too
+	if(m_loaded == 0) {
+
+		Message aMessage;
+		aMessage.setTag(CoalescenceManager::SET_KMER_INFO);
+
+		int length = kmerLength;
+		aMessage.setBuffer(&length);
+		aMessage.setNumberOfBytes(sizeof(length));
+
+		send(m_aggregator, aMessage);
+	}
+
+	char messageBuffer[100];
+	int position = 0;
 
-		position += vertex.dump(messageBuffer + position);
-		memcpy(messageBuffer + position, &m_sample, sizeof(m_sample));
+	position += vertex.dump(messageBuffer + position, coverage);
+	memcpy(messageBuffer + position, &m_sample, sizeof(m_sample));
 
-		position += sizeof(m_sample);
+	position += sizeof(m_sample);
 
-		// maybe: accumulate many objects before flushing it.
-		// we can go up to MAXIMUM_MESSAGE_SIZE_IN_BYTES bytes.
+	// maybe: accumulate many objects before flushing it.
+	// we can go up to MAXIMUM_MESSAGE_SIZE_IN_BYTES bytes.
 
-		// Sending PAYLOAD to the CoalescenceManager
-		Message message;
-		message.setTag(CoalescenceManager::PAYLOAD);
-		message.setBuffer(messageBuffer);
-		message.setNumberOfBytes(position);
+	// Sending PAYLOAD to the CoalescenceManager
+	Message message;
+	message.setTag(CoalescenceManager::PAYLOAD);
+	message.setBuffer(messageBuffer);
+	message.setNumberOfBytes(position);
 
 #if 0
+	printName();
+	cout << "DEBUG sending PAYLOAD to " << m_aggregator;
+	cout << " with " << position << " bytes ";
+	vertex.print(kmerLength, false);
+	cout << endl;
+#endif
+
+	int period = 1000000;
+	if(m_loaded % period == 0 && m_loaded > 0) {
 		printName();
-		cout << "DEBUG sending PAYLOAD to " << m_aggregator;
-		cout << " with " << position << " bytes ";
-		vertex.print(sequence.length(), false);
+		cout << "[GraphReader] loaded " << m_loaded << " sequences" << endl;
+	}
+	m_loaded ++;
+	send(m_aggregator, message);
+}
+
+void GenomeGraphReader::finish() {
+
+	printName();
+
+	if(m_bad && m_binary) {
+		cout << "[GraphReader] Error: graph " << m_fileName << " can not be read";
 		cout << endl;
-#endif
 
-		int period = 1000000;
-		if(m_loaded % period == 0 && m_loaded > 0) {
-			printName();
-			cout << "[GraphReader] loaded " << m_loaded << " sequences" << endl;
+	} else if(m_bad) {
+		cout << "[GraphReader] Error: file " << m_fileName << " does not exist";
+		cout << endl;
+
+	} else {
+		cout << "[GraphReader] finished reading file " << m_fileName;
+		cout << " got " << m_loaded << " objects" << endl;
+	}
+
+	Message finishedMessage;
+	finishedMessage.setTag(DONE);
+
+	send(m_parent, finishedMessage);
+
+	die();
+}
+
+/*
+ * Graph/Manifest.txt is written by Ray with -write-graph.
+ */
+bool GenomeGraphReader::isManifest() {
+
+	ifstream file(m_fileName.c_str());
+
+	string line;
+	getline(file, line);
+
+	return line == GRAPH_MANIFEST_HEADER;
+}
+
+bool GenomeGraphReader::readManifest() {
+
+	ifstream file(m_fileName.c_str());
+
+	// the graph files are in the directory of the manifest
+	string directory = "";
+	size_t slash = m_fileName.rfind('/');
+
+	if(slash != string::npos)
+		directory = m_fileName.substr(0, slash + 1);
+
+	m_kmerLength = 0;
+	m_graphFiles.clear();
+	m_graphFileRecords.clear();
+
+	int files = -1;
+	string line;
+
+	while(getline(file, line)) {
+
+		if(line.length() == 0 || line[0] == '#')
+			continue;
+
+		istringstream stringBuffer(line);
+		string key;
+		stringBuffer >> key;
+
+		if(key == "KmerLength") {
+			stringBuffer >> m_kmerLength;
+		} else if(key == "Files") {
+			stringBuffer >> files;
+		} else {
+			uint64_t records = 0;
+			stringBuffer >> records;
+
+			if(!stringBuffer) {
+				printName();
+				cout << "[GraphReader] Error: manifest " << m_fileName;
+				cout << " has no number of records for " << key << endl;
+				return false;
+			}
+
+			m_graphFiles.push_back(directory + key);
+			m_graphFileRecords.push_back(records);
 		}
-		m_loaded ++;
-		send(m_aggregator, message);
 	}
+
+	if(m_kmerLength == 0 || m_graphFiles.size() == 0) {
+		printName();
+		cout << "[GraphReader] Error: manifest " << m_fileName << " is incomplete" << endl;
+		return false;
+	}
+
+	if(files != (int)m_graphFiles.size()) {
+		printName();
+		cout << "[GraphReader] Error: manifest " << m_fileName << " lists ";
+		cout << m_graphFiles.size() << " graph files, but Files is " << files << endl;
+		return false;
+	}
+
+	printName();
+	cout << "[GraphReader] manifest " << m_fileName << " has " << m_graphFiles.size();
+	cout << " graph files" << endl;
+
+	m_graphFile = 0;
+
+	return true;
+}
+
+bool GenomeGraphReader::openGraphFile() {
+
+	string & fileName = m_graphFiles[m_graphFile];
+
+	m_graphStream.close();
+	m_graphStream.clear();
+	m_graphStream.open(fileName.c_str(), ios::binary);
+
+	uint64_t header[GENOME_GRAPH_HEADER_BYTES / sizeof(uint64_t)];
+	m_graphStream.read((char*)header, GENOME_GRAPH_HEADER_BYTES);
+
+	Vertex prototype;
+
+	if(!m_graphStream
+		|| memcmp(header + GENOME_GRAPH_HEADER_MAGIC, GENOME_GRAPH_MAGIC, sizeof(uint64_t)) != 0
+		|| header[GENOME_GRAPH_HEADER_VERSION] != GENOME_GRAPH_CHECKPOINT_VERSION
+		|| header[GENOME_GRAPH_HEADER_WORD_SIZE] != (uint64_t)m_kmerLength
+		|| header[GENOME_GRAPH_HEADER_RECORD_SIZE] != (uint64_t)prototype.getRequiredNumberOfBytes()
+		|| header[GENOME_GRAPH_HEADER_RECORDS_PER_BLOCK] == 0) {
+
+		printName();
+		cout << "[GraphReader] Error: " << fileName << " is not a graph file written";
+		cout << " with -k " << m_kmerLength << " by this Ray" << endl;
+		return false;
+	}
+
+	if(header[GENOME_GRAPH_HEADER_RECORDS] != m_graphFileRecords[m_graphFile]) {
+
+		printName();
+		cout << "[GraphReader] Error: " << fileName << " has ";
+		cout << header[GENOME_GRAPH_HEADER_RECORDS] << " records, but the manifest lists ";
+		cout << m_graphFileRecords[m_graphFile] << endl;
+		return false;
+	}
+
+	m_recordSize = header[GENOME_GRAPH_HEADER_RECORD_SIZE];
+	m_recordsPerBlock = header[GENOME_GRAPH_HEADER_RECORDS_PER_BLOCK];
+	m_recordsLeft = header[GENOME_GRAPH_HEADER_RECORDS];
+
+	// one checksum per block, after the records
+	m_checksums.resize(header[GENOME_GRAPH_HEADER_BLOCKS]);
+
+	m_graphStream.seekg(header[GENOME_GRAPH_HEADER_CHECKSUMS_OFFSET]);
+
+	if(m_checksums.size() > 0)
+		m_graphStream.read((char*)&(m_checksums[0]), m_checksums.size() * sizeof(uint32_t));
+
+	m_graphStream.seekg(header[GENOME_GRAPH_HEADER_RECORDS_OFFSET]);
+
+	if(!m_graphStream) {
+		printName();
+		cout << "[GraphReader] Error: " << fileName << " is truncated" << endl;
+		return false;
+	}
+
+	m_block.resize(m_recordsPerBlock * m_recordSize);
+	m_blockIndex = 0;
+	m_recordsInBlock = 0;
+	m_recordInBlock = 0;
+
+	return true;
+}
+
+bool GenomeGraphReader::readBlock() {
+
+	if(m_recordsLeft == 0)
+		return false;
+
+	uint64_t count = m_recordsLeft;
+
+	if(count > m_recordsPerBlock)
+		count = m_recordsPerBlock;
+
+	m_graphStream.read(&(m_block[0]), count * m_recordSize);
+
+	if(!m_graphStream || m_blockIndex >= (int)m_checksums.size()
+		|| computeCyclicRedundancyCode32((uint8_t*)&(m_block[0]), count * m_recordSize) != m_checksums[m_blockIndex]) {
+
+		printName();
+		cout << "[GraphReader] Error: block " << m_blockIndex << " of ";
+		cout << m_graphFiles[m_graphFile] << " is corrupted" << endl;
+
+		m_bad = true;
+		return false;
+	}
+
+	m_blockIndex ++;
+	m_recordsLeft -= count;
+	m_recordsInBlock = count;
+	m_recordInBlock = 0;
+
+	return true;
+}
+
+/*
+ * The records are read one block at a time, one record is sent
+ * for each PAYLOAD_RESPONSE like the lines of kmers.txt.
+ */
+void GenomeGraphReader::readRecord() {
+
+	while(!m_bad && m_recordInBlock == m_recordsInBlock) {
+
+		if(readBlock())
+			break;
+
+		if(m_bad)
+			break;
+
+		// this file is done, go to the next one
+		m_graphFile ++;
+
+		if(m_graphFile == (int)m_graphFiles.size())
+			break;
+
+		if(!openGraphFile())
+			m_bad = true;
+	}
+
+	if(m_bad || m_graphFile == (int)m_graphFiles.size()) {
+
+		m_graphStream.close();
+
+		finish();
+		return;
+	}
+
+	// the record holds the lower k-mer, the coverage and the edges
+	Vertex vertex;
+	CoverageDepth coverage = 0;
+	vertex.load(&(m_block[0]) + m_recordInBlock * m_recordSize, &coverage);
+	m_recordInBlock ++;
+
+	sendVertex(vertex, coverage, m_kmerLength);
 }
 
 void GenomeGraphReader::setFileName(string & fileName, int sample) {
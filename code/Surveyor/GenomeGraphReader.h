@@ -26,8 +26,11 @@
 #include <RayPlatform/files/FileReader.h>
 
 
+#include <code/VerticesExtractor/Vertex.h>
+
 #include <string>
 #include <fstream>
+#include <vector>
 using namespace std;
 
 #define I_LIKE_FAST_IO
@@ -55,7 +58,35 @@ private:
 	int m_aggregator;
 	int m_parent;
 
+	/*
+	 * The binary graph (-write-graph): a manifest and one file per rank
+	 * with the records of the GenomeGraph checkpoint.
+	 */
+	bool m_binary;
+	vector<string> m_graphFiles;
+	/* the number of records of each file in the manifest */
+	vector<uint64_t> m_graphFileRecords;
+	int m_graphFile;
+	ifstream m_graphStream;
+	int m_kmerLength;
+	uint64_t m_recordSize;
+	uint64_t m_recordsPerBlock;
+	uint64_t m_recordsLeft;
+	vector<uint32_t> m_checksums;
+	int m_blockIndex;
+	vector<char> m_block;
+	int m_recordsInBlock;
+	int m_recordInBlock;
+
 	void startParty(Message & message);
+	bool isManifest();
+	bool readManifest();
+	bool openGraphFile();
+	bool readBlock();
+	void readRecord();
+	void readNext();
+	void sendVertex(Vertex & vertex, CoverageDepth coverage, int kmerLength);
+	void finish();
 
 public:
 
@@ -459,8 +459,9 @@ void StoreKeeper::pushSampleVertex(Message & message) {
 
 	while(position < bytes) {
 		Vertex vertex;
+		CoverageDepth coverage = 0;
 
-		position += vertex.load(buffer + position);
+		position += vertex.load(buffer + position, &coverage);
 
 		int sample = -1;
 		memcpy(&sample, buffer + position, sizeof(sample));
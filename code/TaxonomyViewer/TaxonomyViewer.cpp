@@ -153,6 +153,8 @@ void TaxonomyViewer::copyTaxonsFromSecondaryTable(){
 }
 
 void TaxonomyViewer::call_RAY_SLAVE_MODE_PHYLOGENY_MAIN(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_PHYLOGENY_MAIN);
+
 	if(!m_extractedColorsForPhylogeny){
 
 		extractColorsForPhylogeny();
@@ -431,7 +433,7 @@ void TaxonomyViewer::gatherKmerObservations(){
 		#endif
 
 		// at this point, we have a nicely assembled k-mer
-		int kmerCoverage=node->getCoverage(&key);
+		int kmerCoverage=m_subgraph->getCoverage(node);
 
 		VirtualKmerColorHandle color=node->getVirtualColor();
 		set<PhysicalKmerColor>*physicalColors=m_colorSet->getPhysicalColors(color);
@@ -1360,6 +1362,7 @@ void TaxonomyViewer::registerPlugin(ComputeCore*core){
 }
 
 void TaxonomyViewer::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
 
 	RAY_MASTER_MODE_PHYLOGENY_MAIN=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_PHYLOGENY_MAIN");
 	RAY_MASTER_MODE_KILL_RANKS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_KILL_RANKS");
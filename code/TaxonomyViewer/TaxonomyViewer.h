@@ -27,6 +27,7 @@
 #include <code/Mock/Parameters.h>
 #include <code/VerticesExtractor/GridTable.h>
 #include <code/Searcher/Searcher.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/profiling/TimePrinter.h>
 #include <RayPlatform/plugins/CorePlugin.h>
@@ -209,6 +210,8 @@ class TaxonomyViewer: public CorePlugin{
 		map<string,LargeCount>*rankRecursiveObservations);
 	LargeCount getSelfCount(TaxonIdentifier taxon);
 
+	Instrumentation*m_instrumentation;
+
 public:
 
 	void call_RAY_MASTER_MODE_PHYLOGENY_MAIN();
@@ -0,0 +1,391 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "UnitigCompactor.h"
+#include "UnitigWorker.h"
+
+#include <RayPlatform/communication/Message.h>
+
+#include <iostream>
+using namespace std;
+
+#ifdef CONFIG_ASSERT
+#include <assert.h>
+#endif
+
+__CreatePlugin(UnitigCompactor);
+
+__CreateMasterModeAdapter(UnitigCompactor,RAY_MASTER_MODE_MARK_UNITIG_STARTS);
+__CreateMasterModeAdapter(UnitigCompactor,RAY_MASTER_MODE_COMPACT_UNITIGS);
+__CreateSlaveModeAdapter(UnitigCompactor,RAY_SLAVE_MODE_MARK_UNITIG_STARTS);
+__CreateSlaveModeAdapter(UnitigCompactor,RAY_SLAVE_MODE_COMPACT_UNITIGS);
+__CreateMessageTagAdapter(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES);
+__CreateMessageTagAdapter(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES_REPLY);
+__CreateMessageTagAdapter(UnitigCompactor,RAY_MPI_TAG_GET_UNITIG_CHUNK);
+
+void UnitigCompactor::call_RAY_MASTER_MODE_MARK_UNITIG_STARTS(){
+
+	if(!m_markingMasterModeStarted){
+		m_core->getSwitchMan()->openMasterMode(m_core->getOutbox(),m_core->getRank());
+
+		m_markingMasterModeStarted=true;
+
+	}else if(m_core->getSwitchMan()->allRanksAreReady()){
+		m_core->getSwitchMan()->closeMasterMode();
+	}
+}
+
+void UnitigCompactor::call_RAY_MASTER_MODE_COMPACT_UNITIGS(){
+
+	if(!m_masterModeStarted){
+		m_core->getSwitchMan()->openMasterMode(m_core->getOutbox(),m_core->getRank());
+
+		m_masterModeStarted=true;
+
+	}else if(m_core->getSwitchMan()->allRanksAreReady()){
+		m_core->getSwitchMan()->closeMasterMode();
+	}
+}
+
+/*
+ * Sends the children of the branching k-mers to their owners. A rank
+ * closes the mode when all its messages are acknowledged, so all the
+ * marks are received before RAY_SLAVE_MODE_COMPACT_UNITIGS starts.
+ */
+void UnitigCompactor::call_RAY_SLAVE_MODE_MARK_UNITIG_STARTS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_MARK_UNITIG_STARTS);
+
+	if(!m_parameters->hasOption("-compact-unitigs")){
+		m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getRank());
+		return;
+	}
+
+	if(!m_markingStarted){
+		m_branchChildren.clear();
+		m_branchBuffers.constructor(m_parameters->getSize(),MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit),
+			"RAY_MALLOC_TYPE_UNITIG_BRANCHES",m_parameters->showMemoryAllocations(),KMER_U64_ARRAY_SIZE);
+		m_pendingMessages=0;
+		m_graphIterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
+		m_markingStarted=true;
+	}
+
+	if(m_pendingMessages>0)
+		return;
+
+	int kmerLength=m_parameters->getWordSize();
+	int vertices=0;
+
+	// a few k-mers at a time, until a message is sent
+	while(m_graphIterator.hasNext() && m_pendingMessages==0 && vertices<CONFIG_UNITIG_MARKING_BATCH){
+		Vertex*vertex=m_graphIterator.next();
+		Kmer*key=m_graphIterator.getKey();
+		vertices++;
+
+		uint8_t edges=vertex->getEdges(key);
+
+		// 4 bits for the children, 4 bits for the parents
+		int children=0;
+		for(int i=0;i<4;i++)
+			children+=(edges>>(4+i))&1;
+
+		if(children<2)
+			continue;
+
+		vector<Kmer> childKmers=vertex->getOutgoingEdges(key,kmerLength);
+
+		for(int i=0;i<(int)childKmers.size();i++){
+			Rank rank=m_parameters->vertexRank(&(childKmers[i]));
+
+			for(int j=0;j<KMER_U64_ARRAY_SIZE;j++)
+				m_branchBuffers.addAt(rank,childKmers[i].getU64(j));
+
+			if(m_branchBuffers.flush(rank,KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_UNITIG_BRANCHES,
+				m_core->getOutboxAllocator(),m_core->getOutbox(),m_core->getRank(),false)){
+
+				m_pendingMessages++;
+			}
+		}
+	}
+
+	if(m_graphIterator.hasNext() || m_pendingMessages>0)
+		return;
+
+	if(!m_branchBuffers.isEmpty()){
+		m_pendingMessages+=m_branchBuffers.flushAll(RAY_MPI_TAG_UNITIG_BRANCHES,
+			m_core->getOutboxAllocator(),m_core->getOutbox(),m_core->getRank());
+		return;
+	}
+
+	m_markingStarted=false;
+
+	m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getRank());
+}
+
+void UnitigCompactor::call_RAY_MPI_TAG_UNITIG_BRANCHES(Message*message){
+
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+
+	for(int position=0;position<count;){
+		Kmer child;
+		child.unpack(incoming,&position);
+		m_branchChildren.insert(child);
+	}
+
+	m_core->getSwitchMan()->sendEmptyMessage(m_core->getOutbox(),m_core->getRank(),message->getSource(),
+		RAY_MPI_TAG_UNITIG_BRANCHES_REPLY);
+}
+
+void UnitigCompactor::call_RAY_MPI_TAG_UNITIG_BRANCHES_REPLY(Message*message){
+	m_pendingMessages--;
+
+	#ifdef CONFIG_ASSERT
+	assert(m_pendingMessages>=0);
+	#endif
+}
+
+void UnitigCompactor::call_RAY_SLAVE_MODE_COMPACT_UNITIGS(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_COMPACT_UNITIGS);
+
+	if(!m_parameters->hasOption("-compact-unitigs")){
+		m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getRank());
+		return;
+	}
+
+	mainLoop();
+}
+
+void UnitigCompactor::initializeMethod(){
+
+	m_store.clear();
+	m_vertexIndex=0;
+	m_scannedVertices=0;
+	m_hasNextStart=false;
+	m_graphIterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
+}
+
+void UnitigCompactor::finalizeMethod(){
+
+	cout<<"Rank "<<m_parameters->getRank()<<" compacted "<<m_store.getNumberOfUnitigs()<<" unitigs";
+	cout<<" with "<<m_store.getNumberOfVertices()<<" vertices"<<endl;
+
+	m_branchChildren.clear();
+
+	m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getRank());
+}
+
+/*
+ * A k-mer with exactly one parent is in the unitig of its parent,
+ * unless the parent sent it because it has several children.
+ */
+bool UnitigCompactor::isUnitigStart(Vertex*vertex,Kmer*key){
+
+	uint8_t edges=vertex->getEdges(key);
+
+	int parents=0;
+	for(int i=0;i<4;i++)
+		parents+=(edges>>i)&1;
+
+	if(parents!=1)
+		return true;
+
+	return m_branchChildren.count(*key)>0;
+}
+
+/*
+ * The iterator returns each k-mer and its reverse complement.
+ * The k-mers that do not start a unitig are skipped here, so
+ * there is no worker for them.
+ */
+bool UnitigCompactor::hasUnassignedTask(){
+
+	while(!m_hasNextStart && m_graphIterator.hasNext()){
+		Vertex*vertex=m_graphIterator.next();
+		Kmer*key=m_graphIterator.getKey();
+
+		m_scannedVertices++;
+
+		if(m_scannedVertices%1000000==0){
+			cout<<"Rank "<<m_parameters->getRank()<<" is compacting unitigs ["<<m_scannedVertices;
+			cout<<"/"<<m_subgraph->size()<<"]"<<endl;
+		}
+
+		if(!isUnitigStart(vertex,key))
+			continue;
+
+		m_hasNextStart=true;
+		m_nextVertex=vertex;
+		m_nextKey=*key;
+	}
+
+	return m_hasNextStart;
+}
+
+Worker*UnitigCompactor::assignNextTask(){
+
+	#ifdef CONFIG_ASSERT
+	assert(m_hasNextStart);
+	#endif
+
+	UnitigWorker*worker=new UnitigWorker;
+	worker->constructor(m_vertexIndex,m_nextVertex,&m_nextKey,m_subgraph->getCoverage(m_nextVertex),m_parameters,
+		m_subgraph,m_virtualCommunicator,m_core->getOutboxAllocator(),&m_store,RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT);
+
+	m_vertexIndex++;
+	m_hasNextStart=false;
+
+	return worker;
+}
+
+void UnitigCompactor::processWorkerResult(Worker*worker){
+}
+
+void UnitigCompactor::destroyWorker(Worker*worker){
+	delete worker;
+}
+
+/*
+ * Query: <--first k-mer--><--offset-->
+ *
+ * Reply: <--length of the unitig--><--count--><--count coverage values--><--count symbols, 2 bits each-->
+ *
+ * The length is 0 if no unitig starts with the k-mer.
+ */
+void UnitigCompactor::call_RAY_MPI_TAG_GET_UNITIG_CHUNK(Message*message){
+
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int bufferPosition=0;
+	Kmer first;
+	first.unpack(incoming,&bufferPosition);
+	int offset=incoming[bufferPosition++];
+
+	int elements=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_GET_UNITIG_CHUNK);
+	MessageUnit*outgoingMessage=(MessageUnit*)m_core->getOutboxAllocator()->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+
+	for(int i=0;i<elements;i++)
+		outgoingMessage[i]=0;
+
+	int unitig=m_store.findUnitig(&first);
+	int length=0;
+	int count=0;
+
+	if(unitig>=0){
+		length=m_store.getLength(unitig);
+
+		// each vertex uses 1 message unit and 2 bits
+		int capacity=((elements-2)*32)/33;
+
+		count=length-offset;
+
+		if(count>capacity)
+			count=capacity;
+		if(count<0)
+			count=0;
+	}
+
+	outgoingMessage[0]=length;
+	outgoingMessage[1]=count;
+
+	int symbols=2+count;
+
+	for(int i=0;i<count;i++){
+		outgoingMessage[2+i]=m_store.getCoverage(unitig,offset+i);
+
+		int bit=i*BITS_PER_NUCLEOTIDE;
+		uint64_t symbol=m_store.getSymbol(unitig,offset+i);
+		outgoingMessage[symbols+bit/64]|=symbol<<(bit%64);
+	}
+
+	Message aMessage(outgoingMessage,elements,message->getSource(),
+		RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY,m_core->getRank());
+	m_core->getOutbox()->push_back(&aMessage);
+}
+
+void UnitigCompactor::registerPlugin(ComputeCore*core){
+
+	PluginHandle plugin=core->allocatePluginHandle();
+	m_plugin=plugin;
+	m_core=core;
+
+	core->setPluginName(plugin,"UnitigCompactor");
+	core->setPluginDescription(plugin,"Builds the unitigs of the graph");
+	core->setPluginAuthors(plugin,"agent");
+	core->setPluginLicense(plugin,"GNU General Public License version 3");
+
+	__ConfigureMasterModeHandler(UnitigCompactor,RAY_MASTER_MODE_MARK_UNITIG_STARTS);
+	__ConfigureMasterModeHandler(UnitigCompactor,RAY_MASTER_MODE_COMPACT_UNITIGS);
+	__ConfigureSlaveModeHandler(UnitigCompactor,RAY_SLAVE_MODE_MARK_UNITIG_STARTS);
+	__ConfigureSlaveModeHandler(UnitigCompactor,RAY_SLAVE_MODE_COMPACT_UNITIGS);
+	__ConfigureMessageTagHandler(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES);
+	__ConfigureMessageTagHandler(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES_REPLY);
+	__ConfigureMessageTagHandler(UnitigCompactor,RAY_MPI_TAG_GET_UNITIG_CHUNK);
+
+	RAY_MPI_TAG_MARK_UNITIG_STARTS=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_MARK_UNITIG_STARTS,"RAY_MPI_TAG_MARK_UNITIG_STARTS");
+
+	RAY_MPI_TAG_COMPACT_UNITIGS=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_COMPACT_UNITIGS,"RAY_MPI_TAG_COMPACT_UNITIGS");
+
+	RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY,"RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY");
+
+	__BindPlugin(UnitigCompactor);
+}
+
+void UnitigCompactor::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
+	RAY_MASTER_MODE_MARK_UNITIG_STARTS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_MARK_UNITIG_STARTS");
+	RAY_MASTER_MODE_COMPACT_UNITIGS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_COMPACT_UNITIGS");
+	RAY_MASTER_MODE_TRIGGER_INDEXING=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_TRIGGER_INDEXING");
+	RAY_SLAVE_MODE_MARK_UNITIG_STARTS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_MARK_UNITIG_STARTS");
+	RAY_SLAVE_MODE_COMPACT_UNITIGS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_COMPACT_UNITIGS");
+
+	RAY_MPI_TAG_UNITIG_BRANCHES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_UNITIG_BRANCHES");
+	RAY_MPI_TAG_UNITIG_BRANCHES_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_UNITIG_BRANCHES_REPLY");
+	RAY_MPI_TAG_GET_UNITIG_CHUNK=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_UNITIG_CHUNK");
+	RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY");
+	RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT");
+
+	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_MARK_UNITIG_STARTS,RAY_MASTER_MODE_COMPACT_UNITIGS);
+	core->setMasterModeToMessageTagSwitch(m_plugin,RAY_MASTER_MODE_MARK_UNITIG_STARTS,RAY_MPI_TAG_MARK_UNITIG_STARTS);
+	core->setMessageTagToSlaveModeSwitch(m_plugin,RAY_MPI_TAG_MARK_UNITIG_STARTS,RAY_SLAVE_MODE_MARK_UNITIG_STARTS);
+
+	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_COMPACT_UNITIGS,RAY_MASTER_MODE_TRIGGER_INDEXING);
+	core->setMasterModeToMessageTagSwitch(m_plugin,RAY_MASTER_MODE_COMPACT_UNITIGS,RAY_MPI_TAG_COMPACT_UNITIGS);
+	core->setMessageTagToSlaveModeSwitch(m_plugin,RAY_MPI_TAG_COMPACT_UNITIGS,RAY_SLAVE_MODE_COMPACT_UNITIGS);
+
+	core->setMessageTagReplyMessageTag(m_plugin,RAY_MPI_TAG_GET_UNITIG_CHUNK,RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY);
+	core->setMessageTagSize(m_plugin,RAY_MPI_TAG_GET_UNITIG_CHUNK,MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit));
+
+	m_parameters=(Parameters*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Parameters.ray");
+	m_subgraph=(GridTable*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/deBruijnGraph_part.ray");
+
+	m_virtualCommunicator=core->getVirtualCommunicator();
+
+	/* for TaskCreator */
+	m_initialized=false;
+	m_virtualProcessor=core->getVirtualProcessor();
+
+	m_markingMasterModeStarted=false;
+	m_masterModeStarted=false;
+	m_markingStarted=false;
+	m_pendingMessages=0;
+}
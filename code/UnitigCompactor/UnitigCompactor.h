@@ -0,0 +1,171 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _UnitigCompactor_h
+#define _UnitigCompactor_h
+
+#include "UnitigStore.h"
+
+#include <code/Mock/Parameters.h>
+#include <code/VerticesExtractor/GridTable.h>
+#include <code/VerticesExtractor/GridTableIterator.h>
+#include <code/Instrumentation/Instrumentation.h>
+
+#include <RayPlatform/core/ComputeCore.h>
+#include <RayPlatform/scheduling/TaskCreator.h>
+#include <RayPlatform/communication/BufferedData.h>
+#include <RayPlatform/communication/VirtualCommunicator.h>
+
+#include <set>
+#include <stdint.h>
+using namespace std;
+
+/** k-mers checked at each call of RAY_SLAVE_MODE_MARK_UNITIG_STARTS */
+#define CONFIG_UNITIG_MARKING_BATCH 4096
+
+__DeclarePlugin(UnitigCompactor);
+
+__DeclareMasterModeAdapter(UnitigCompactor,RAY_MASTER_MODE_MARK_UNITIG_STARTS);
+__DeclareMasterModeAdapter(UnitigCompactor,RAY_MASTER_MODE_COMPACT_UNITIGS);
+__DeclareSlaveModeAdapter(UnitigCompactor,RAY_SLAVE_MODE_MARK_UNITIG_STARTS);
+__DeclareSlaveModeAdapter(UnitigCompactor,RAY_SLAVE_MODE_COMPACT_UNITIGS);
+__DeclareMessageTagAdapter(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES);
+__DeclareMessageTagAdapter(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES_REPLY);
+__DeclareMessageTagAdapter(UnitigCompactor,RAY_MPI_TAG_GET_UNITIG_CHUNK);
+
+/**
+ * Builds the unitigs of the de Bruijn graph after EdgePurger
+ * when -compact-unitigs is provided.
+ *
+ * A k-mer starts a unitig unless it has exactly one parent and this
+ * parent has exactly one child. The first step
+ * (RAY_SLAVE_MODE_MARK_UNITIG_STARTS) decides this without any query:
+ * each rank sends the children of its branching k-mers (more than one
+ * child) to their owners in one bulk exchange. A k-mer then starts a
+ * unitig if its local edges do not have exactly one parent, or if its
+ * only parent sent it.
+ *
+ * Then each rank walks the unitigs that start with its k-mers and stores
+ * them in a UnitigStore, one worker for each start only. A walk reads the
+ * vertices of its rank in the local GridTable and queries the others.
+ * Other plugins fetch a unitig in a few messages with
+ * RAY_MPI_TAG_GET_UNITIG_CHUNK (see UnitigFetcher) instead of fetching
+ * its vertices one by one.
+ *
+ * Only SeedWorker uses the unitigs. SeedExtender and GenomeNeighbourhood
+ * still walk one vertex at a time: they need the read annotations or the
+ * path handles of each vertex, which a UnitigStore does not keep, so a
+ * unitig would not save their per-vertex queries.
+ *
+ * The walks are not replaced by pointer jumping: a walk fetches each
+ * vertex of a unitig once, and the virtual communicator groups the
+ * queries of all the walks. Pointer jumping exchanges every vertex at
+ * each of its log(length) rounds and needs a successor and a rank for
+ * each vertex of the GridTable.
+ *
+ * \author agent
+ */
+class UnitigCompactor : public TaskCreator, public CorePlugin {
+
+	__AddAdapter(UnitigCompactor,RAY_MASTER_MODE_MARK_UNITIG_STARTS);
+	__AddAdapter(UnitigCompactor,RAY_MASTER_MODE_COMPACT_UNITIGS);
+	__AddAdapter(UnitigCompactor,RAY_SLAVE_MODE_MARK_UNITIG_STARTS);
+	__AddAdapter(UnitigCompactor,RAY_SLAVE_MODE_COMPACT_UNITIGS);
+	__AddAdapter(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES);
+	__AddAdapter(UnitigCompactor,RAY_MPI_TAG_UNITIG_BRANCHES_REPLY);
+	__AddAdapter(UnitigCompactor,RAY_MPI_TAG_GET_UNITIG_CHUNK);
+
+	MasterMode RAY_MASTER_MODE_MARK_UNITIG_STARTS;
+	MasterMode RAY_MASTER_MODE_COMPACT_UNITIGS;
+	MasterMode RAY_MASTER_MODE_TRIGGER_INDEXING;
+
+	SlaveMode RAY_SLAVE_MODE_MARK_UNITIG_STARTS;
+	SlaveMode RAY_SLAVE_MODE_COMPACT_UNITIGS;
+
+	MessageTag RAY_MPI_TAG_MARK_UNITIG_STARTS;
+	MessageTag RAY_MPI_TAG_UNITIG_BRANCHES;
+	MessageTag RAY_MPI_TAG_UNITIG_BRANCHES_REPLY;
+	MessageTag RAY_MPI_TAG_COMPACT_UNITIGS;
+	MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK;
+	MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK_REPLY;
+	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
+
+	bool m_markingMasterModeStarted;
+	bool m_masterModeStarted;
+
+	Parameters*m_parameters;
+	GridTable*m_subgraph;
+	VirtualCommunicator*m_virtualCommunicator;
+
+	GridTableIterator m_graphIterator;
+	uint64_t m_vertexIndex;
+
+	/** the children of branching k-mers of other ranks, owned by this rank */
+	set<Kmer> m_branchChildren;
+
+	BufferedData m_branchBuffers;
+	int m_pendingMessages;
+	bool m_markingStarted;
+
+	/** the next k-mer that starts a unitig, see hasUnassignedTask */
+	bool m_hasNextStart;
+	Vertex*m_nextVertex;
+	Kmer m_nextKey;
+	LargeCount m_scannedVertices;
+
+	UnitigStore m_store;
+
+	bool isUnitigStart(Vertex*vertex,Kmer*key);
+
+	Instrumentation*m_instrumentation;
+
+public:
+
+	void call_RAY_MASTER_MODE_MARK_UNITIG_STARTS();
+	void call_RAY_MASTER_MODE_COMPACT_UNITIGS();
+	void call_RAY_SLAVE_MODE_MARK_UNITIG_STARTS();
+	void call_RAY_SLAVE_MODE_COMPACT_UNITIGS();
+	void call_RAY_MPI_TAG_UNITIG_BRANCHES(Message*message);
+	void call_RAY_MPI_TAG_UNITIG_BRANCHES_REPLY(Message*message);
+	void call_RAY_MPI_TAG_GET_UNITIG_CHUNK(Message*message);
+
+	/** initialize the whole thing */
+	void initializeMethod();
+
+	/** finalize the whole thing */
+	void finalizeMethod();
+
+	/** has an unassigned task left to compute */
+	bool hasUnassignedTask();
+
+	/** assign the next task to a worker and return this worker */
+	Worker*assignNextTask();
+
+	/** get the result of a worker */
+	void processWorkerResult(Worker*worker);
+
+	/** destroy a worker */
+	void destroyWorker(Worker*worker);
+
+	void registerPlugin(ComputeCore*core);
+	void resolveSymbols(ComputeCore*core);
+};
+
+#endif /* _UnitigCompactor_h */
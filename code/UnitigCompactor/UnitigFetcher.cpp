@@ -0,0 +1,126 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "UnitigFetcher.h"
+
+#include <RayPlatform/communication/Message.h>
+
+#ifdef CONFIG_ASSERT
+#include <assert.h>
+#endif
+
+void UnitigFetcher::initialize(Parameters*parameters,VirtualCommunicator*virtualCommunicator,
+		WorkerHandle identifier,RingAllocator*outboxAllocator,
+		MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK){
+
+	m_parameters=parameters;
+	m_virtualCommunicator=virtualCommunicator;
+	m_identifier=identifier;
+	m_outboxAllocator=outboxAllocator;
+	m_rank=m_parameters->getRank();
+	this->RAY_MPI_TAG_GET_UNITIG_CHUNK=RAY_MPI_TAG_GET_UNITIG_CHUNK;
+
+	reset();
+}
+
+void UnitigFetcher::reset(){
+	m_initializedFetcher=false;
+}
+
+/*
+ * The reply is
+ *
+ * <--length of the unitig--><--count--><--count coverage values--><--count symbols, 2 bits each-->
+ */
+bool UnitigFetcher::fetchUnitig(Kmer*first){
+
+	if(!m_initializedFetcher){
+
+		m_vertices.clear();
+		m_coverageValues.clear();
+		m_length=0;
+		m_queryWasSent=false;
+		m_initializedFetcher=true;
+
+	}else if(!m_queryWasSent){
+
+		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+		int bufferPosition=0;
+		first->pack(message,&bufferPosition);
+		message[bufferPosition++]=m_vertices.size();
+
+		Message aMessage(message,bufferPosition,m_parameters->vertexRank(first),
+			RAY_MPI_TAG_GET_UNITIG_CHUNK,m_rank);
+		m_virtualCommunicator->pushMessage(m_identifier,&aMessage);
+
+		m_queryWasSent=true;
+
+	}else if(m_virtualCommunicator->isMessageProcessed(m_identifier)){
+
+		vector<MessageUnit> elements;
+		m_virtualCommunicator->getMessageResponseElements(m_identifier,&elements);
+
+		int bufferPosition=0;
+		m_length=elements[bufferPosition++];
+		int count=elements[bufferPosition++];
+		int symbols=bufferPosition+count;
+
+		for(int i=0;i<count;i++){
+			int bit=i*BITS_PER_NUCLEOTIDE;
+			uint8_t symbol=(elements[symbols+bit/64]>>(bit%64))&3;
+
+			addVertex(first,symbol,elements[bufferPosition+i]);
+		}
+
+		m_queryWasSent=false;
+
+		return count==0 || (int)m_vertices.size()>=m_length;
+	}
+
+	return false;
+}
+
+void UnitigFetcher::addVertex(const Kmer*first,uint8_t symbol,CoverageDepth coverage){
+
+	m_coverageValues.push_back(coverage);
+
+	if(m_vertices.size()==0){
+		m_vertices.push_back(*first);
+		return;
+	}
+
+	// the child that has this last symbol
+	uint8_t edges=1<<(4+symbol);
+	vector<Kmer> children=m_vertices.back().getOutgoingEdges(edges,m_parameters->getWordSize());
+
+#ifdef CONFIG_ASSERT
+	assert(children.size()==1);
+#endif
+
+	m_vertices.push_back(children[0]);
+}
+
+vector<Kmer>*UnitigFetcher::getVertices(){
+	return &m_vertices;
+}
+
+vector<CoverageDepth>*UnitigFetcher::getCoverageValues(){
+	return &m_coverageValues;
+}
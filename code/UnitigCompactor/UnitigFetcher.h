@@ -0,0 +1,98 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _UnitigFetcher_h
+#define _UnitigFetcher_h
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/Mock/Parameters.h>
+
+#include <RayPlatform/communication/VirtualCommunicator.h>
+#include <RayPlatform/memory/RingAllocator.h>
+#include <RayPlatform/scheduling/Worker.h>
+
+#include <vector>
+using namespace std;
+
+/**
+ * This is a building block to fetch the unitig that starts
+ * with a k-mer, with RAY_MPI_TAG_GET_UNITIG_CHUNK.
+ *
+ * A long unitig is fetched in several chunks.
+ *
+ * \author agent
+ */
+class UnitigFetcher {
+
+	Rank m_rank;
+	Parameters*m_parameters;
+	VirtualCommunicator*m_virtualCommunicator;
+	WorkerHandle m_identifier;
+	RingAllocator*m_outboxAllocator;
+
+	bool m_initializedFetcher;
+	bool m_queryWasSent;
+	int m_length;
+
+	vector<Kmer> m_vertices;
+	vector<CoverageDepth> m_coverageValues;
+
+	MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK;
+
+	void addVertex(const Kmer*first,uint8_t symbol,CoverageDepth coverage);
+public:
+
+	/**
+	 * Initializes the object.
+	 */
+	void initialize(Parameters*parameters,VirtualCommunicator*virtualCommunicator,
+		WorkerHandle identifier,RingAllocator*outboxAllocator,
+		MessageTag RAY_MPI_TAG_GET_UNITIG_CHUNK);
+
+	/**
+	 * Fetches the unitig that starts with a k-mer.
+	 *
+	 * @returns true if the result is available, false if additional calls
+	 * are required for the request to complete.
+	 */
+	bool fetchUnitig(Kmer*first);
+
+	/**
+	 * Resets the object so that fetchUnitig can be called on another k-mer.
+	 */
+	void reset();
+
+	/**
+	 * Gets the vertices of the unitig, the first one is the k-mer.
+	 * This is empty if no unitig starts with the k-mer.
+	 *
+	 * fetchUnitig must have returned true before calling this.
+	 */
+	vector<Kmer>*getVertices();
+
+	/**
+	 * Gets the coverage depth of the vertices of the unitig.
+	 *
+	 * fetchUnitig must have returned true before calling this.
+	 */
+	vector<CoverageDepth>*getCoverageValues();
+};
+
+#endif /* _UnitigFetcher_h */
@@ -0,0 +1,102 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "UnitigStore.h"
+
+#ifdef CONFIG_ASSERT
+#include <assert.h>
+#endif
+
+UnitigStore::UnitigStore(){
+	clear();
+}
+
+void UnitigStore::clear(){
+	m_index.clear();
+	m_offsets.clear();
+	m_lengths.clear();
+	m_symbols.clear();
+	m_coverageValues.clear();
+}
+
+void UnitigStore::setSymbol(uint64_t position,uint64_t symbol){
+	uint64_t bit=position*BITS_PER_NUCLEOTIDE;
+	uint64_t index=bit/64;
+
+	while(m_symbols.size()<=index)
+		m_symbols.push_back(0);
+
+	m_symbols[index]|=symbol<<(bit%64);
+}
+
+void UnitigStore::addUnitig(const vector<Kmer>*vertices,const vector<CoverageDepth>*coverageValues,int kmerLength){
+
+#ifdef CONFIG_ASSERT
+	assert(vertices->size()==coverageValues->size());
+	assert(vertices->size()>=1);
+#endif
+
+	int unitig=m_offsets.size();
+	uint64_t offset=m_coverageValues.size();
+
+	m_index[vertices->at(0)]=unitig;
+	m_offsets.push_back(offset);
+	m_lengths.push_back(vertices->size());
+
+	int bit=(kmerLength-1)*BITS_PER_NUCLEOTIDE;
+
+	for(int i=0;i<(int)vertices->size();i++){
+		uint64_t symbol=(vertices->at(i).getU64(bit/64)>>(bit%64))&3;
+
+		setSymbol(offset+i,symbol);
+		m_coverageValues.push_back(coverageValues->at(i));
+	}
+}
+
+int UnitigStore::findUnitig(const Kmer*first)const{
+	map<Kmer,int>::const_iterator iterator=m_index.find(*first);
+
+	if(iterator==m_index.end())
+		return -1;
+
+	return iterator->second;
+}
+
+int UnitigStore::getLength(int unitig)const{
+	return m_lengths[unitig];
+}
+
+uint8_t UnitigStore::getSymbol(int unitig,int position)const{
+	uint64_t bit=(m_offsets[unitig]+position)*BITS_PER_NUCLEOTIDE;
+
+	return (m_symbols[bit/64]>>(bit%64))&3;
+}
+
+CoverageDepth UnitigStore::getCoverage(int unitig,int position)const{
+	return m_coverageValues[m_offsets[unitig]+position];
+}
+
+int UnitigStore::getNumberOfUnitigs()const{
+	return m_offsets.size();
+}
+
+LargeCount UnitigStore::getNumberOfVertices()const{
+	return m_coverageValues.size();
+}
@@ -0,0 +1,91 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _UnitigStore_h
+#define _UnitigStore_h
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/Mock/constants.h>
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+using namespace std;
+
+/*
+ * Unitigs shorter than this are not stored because they
+ * have no vertex between their first and last vertices.
+ */
+#define CONFIG_MINIMUM_UNITIG_LENGTH 3
+
+/**
+ * The unitigs that start on this rank.
+ *
+ * A unitig is a maximal path where each vertex after the first one
+ * has exactly one parent and each vertex before the last one has
+ * exactly one child. Unitigs are indexed by their first k-mer, which
+ * is owned by this rank. For each vertex, the last symbol (2 bits) and
+ * the coverage depth are stored; the k-mers are rebuilt from the
+ * first k-mer and the symbols.
+ *
+ * \author agent
+ */
+class UnitigStore {
+
+	map<Kmer,int> m_index;
+
+	/** first vertex of each unitig in m_symbols and m_coverageValues */
+	vector<uint64_t> m_offsets;
+	vector<int> m_lengths;
+
+	vector<uint64_t> m_symbols;
+	vector<CoverageDepth> m_coverageValues;
+
+	void setSymbol(uint64_t position,uint64_t symbol);
+
+public:
+
+	UnitigStore();
+
+	void clear();
+
+	/**
+	 * Add a unitig given its vertices.
+	 */
+	void addUnitig(const vector<Kmer>*vertices,const vector<CoverageDepth>*coverageValues,int kmerLength);
+
+	/**
+	 * Get the unitig that starts with a k-mer.
+	 *
+	 * \returns -1 if no stored unitig starts with this k-mer
+	 */
+	int findUnitig(const Kmer*first)const;
+
+	int getLength(int unitig)const;
+
+	/** the last symbol of the vertex at a position in a unitig */
+	uint8_t getSymbol(int unitig,int position)const;
+	CoverageDepth getCoverage(int unitig,int position)const;
+
+	int getNumberOfUnitigs()const;
+	LargeCount getNumberOfVertices()const;
+};
+
+#endif /* _UnitigStore_h */
@@ -0,0 +1,142 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "UnitigWorker.h"
+
+#ifdef CONFIG_ASSERT
+#include <assert.h>
+#endif
+
+void UnitigWorker::constructor(WorkerHandle workerIdentifier,Vertex*vertex,Kmer*key,CoverageDepth coverage,Parameters*parameters,
+		GridTable*subgraph,VirtualCommunicator*virtualCommunicator,RingAllocator*outboxAllocator,UnitigStore*store,
+		MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT){
+
+	m_workerIdentifier=workerIdentifier;
+	m_vertex=vertex;
+	m_first=*key;
+	m_firstCoverage=coverage;
+	m_parameters=parameters;
+	m_store=store;
+	m_subgraph=subgraph;
+	m_kmerLength=m_parameters->getWordSize();
+
+	m_attributeFetcher.initialize(parameters,virtualCommunicator,workerIdentifier,outboxAllocator,
+		RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT);
+
+	m_isDone=false;
+	m_started=false;
+}
+
+void UnitigWorker::work(){
+
+	if(m_isDone)
+		return;
+
+	walk();
+}
+
+/*
+ * Each iteration fetches the edges and the coverage of the only child
+ * of the last vertex. The children owned by this rank are read directly,
+ * up to CONFIG_UNITIG_LOCAL_STEPS in a row, so that a walk only waits
+ * for the virtual communicator when it leaves the rank.
+ */
+void UnitigWorker::walk(){
+
+	if(!m_started){
+		m_vertices.push_back(m_first);
+		m_coverageValues.push_back(m_firstCoverage);
+		m_children=m_vertex->getOutgoingEdges(&m_first,m_kmerLength);
+		m_started=true;
+	}
+
+	for(int step=0;step<CONFIG_UNITIG_LOCAL_STEPS && !m_isDone;step++){
+
+		if(m_children.size()!=1 || m_children[0]==m_first){
+			finish();
+			return;
+		}
+
+		Kmer child=m_children[0];
+
+		if(stepLocally(&child))
+			continue;
+
+		if(!m_attributeFetcher.fetchObjectMetaData(&child))
+			return;
+
+		m_attributeFetcher.reset();
+
+		addChild(&child,m_attributeFetcher.getParents()->size(),m_attributeFetcher.getDepth(),
+			m_attributeFetcher.getChildren());
+		return;
+	}
+}
+
+/*
+ * Returns false if the child is owned by another rank.
+ */
+bool UnitigWorker::stepLocally(Kmer*child){
+
+	if(m_parameters->vertexRank(child)!=m_parameters->getRank())
+		return false;
+
+	Vertex*node=m_subgraph->find(child);
+
+	// same answer as RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT for a missing k-mer
+	if(node==NULL){
+		finish();
+		return true;
+	}
+
+	vector<Kmer> children=node->getOutgoingEdges(child,m_kmerLength);
+	addChild(child,node->getIngoingEdges(child,m_kmerLength).size(),m_subgraph->getCoverage(node),&children);
+
+	return true;
+}
+
+void UnitigWorker::addChild(Kmer*child,int parents,CoverageDepth coverage,vector<Kmer>*children){
+
+	// the child starts another unitig
+	if(parents!=1){
+		finish();
+		return;
+	}
+
+	m_vertices.push_back(*child);
+	m_coverageValues.push_back(coverage);
+	m_children=*children;
+}
+
+void UnitigWorker::finish(){
+
+	if((int)m_vertices.size()>=CONFIG_MINIMUM_UNITIG_LENGTH)
+		m_store->addUnitig(&m_vertices,&m_coverageValues,m_kmerLength);
+
+	m_isDone=true;
+}
+
+bool UnitigWorker::isDone(){
+	return m_isDone;
+}
+
+WorkerHandle UnitigWorker::getWorkerIdentifier(){
+	return m_workerIdentifier;
+}
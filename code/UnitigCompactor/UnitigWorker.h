@@ -0,0 +1,87 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _UnitigWorker_h
+#define _UnitigWorker_h
+
+#include "UnitigStore.h"
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/VerticesExtractor/Vertex.h>
+#include <code/VerticesExtractor/GridTable.h>
+#include <code/Mock/Parameters.h>
+#include <code/SpuriousSeedAnnihilator/AttributeFetcher.h>
+
+#include <RayPlatform/memory/RingAllocator.h>
+#include <RayPlatform/scheduling/Worker.h>
+#include <RayPlatform/communication/VirtualCommunicator.h>
+
+#include <vector>
+using namespace std;
+
+/** local steps taken at most by a UnitigWorker in one call of work() */
+#define CONFIG_UNITIG_LOCAL_STEPS 64
+
+/**
+ * A UnitigWorker walks the unitig that starts with a local k-mer
+ * and stores it. UnitigCompactor creates workers only for the
+ * k-mers that start a unitig.
+ *
+ * A child owned by this rank is read in the local GridTable;
+ * only the children owned by other ranks are queried.
+ *
+ * \author agent
+ */
+class UnitigWorker : public Worker {
+
+	WorkerHandle m_workerIdentifier;
+	Parameters*m_parameters;
+	UnitigStore*m_store;
+	GridTable*m_subgraph;
+	AttributeFetcher m_attributeFetcher;
+
+	Kmer m_first;
+	CoverageDepth m_firstCoverage;
+	Vertex*m_vertex;
+	int m_kmerLength;
+
+	bool m_isDone;
+	bool m_started;
+
+	vector<Kmer> m_children;
+
+	vector<Kmer> m_vertices;
+	vector<CoverageDepth> m_coverageValues;
+
+	void walk();
+	bool stepLocally(Kmer*child);
+	void addChild(Kmer*child,int parents,CoverageDepth coverage,vector<Kmer>*children);
+	void finish();
+public:
+	void constructor(WorkerHandle workerIdentifier,Vertex*vertex,Kmer*key,CoverageDepth coverage,Parameters*parameters,
+		GridTable*subgraph,VirtualCommunicator*virtualCommunicator,RingAllocator*outboxAllocator,UnitigStore*store,
+		MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT);
+
+	void work();
+	bool isDone();
+	WorkerHandle getWorkerIdentifier();
+};
+
+#endif /* _UnitigWorker_h */
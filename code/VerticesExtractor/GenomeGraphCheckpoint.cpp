@@ -0,0 +1,515 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "GenomeGraphCheckpoint.h"
+
+#include <RayPlatform/cryptography/crypto.h>
+#include <RayPlatform/structures/MyHashTableIterator.h>
+
+#include <iostream>
+#include <vector>
+#include <string.h>
+#include <assert.h>
+using namespace std;
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void GenomeGraphCheckpoint::constructor(Parameters*parameters,GridTable*subgraph){
+	m_parameters=parameters;
+	m_subgraph=subgraph;
+}
+
+void GenomeGraphCheckpoint::setHeader(uint64_t*header,uint64_t records,uint64_t blocks){
+	Vertex prototype;
+	uint64_t recordSize=prototype.getRequiredNumberOfBytes();
+
+	memset(header,0,GENOME_GRAPH_HEADER_BYTES);
+	memcpy(header+GENOME_GRAPH_HEADER_MAGIC,GENOME_GRAPH_MAGIC,sizeof(uint64_t));
+
+	header[GENOME_GRAPH_HEADER_VERSION]=GENOME_GRAPH_CHECKPOINT_VERSION;
+	header[GENOME_GRAPH_HEADER_WORD_SIZE]=m_parameters->getWordSize();
+	header[GENOME_GRAPH_HEADER_COLOR_SPACE]=m_parameters->getColorSpaceMode();
+	header[GENOME_GRAPH_HEADER_KMER_WORDS]=KMER_U64_ARRAY_SIZE;
+	header[GENOME_GRAPH_HEADER_COVERAGE_BYTES]=sizeof(CoverageDepth);
+	header[GENOME_GRAPH_HEADER_RECORD_SIZE]=recordSize;
+	header[GENOME_GRAPH_HEADER_RANK]=m_parameters->getRank();
+	header[GENOME_GRAPH_HEADER_RANKS]=m_parameters->getSize();
+	header[GENOME_GRAPH_HEADER_BUCKETS]=m_parameters->getNumberOfBuckets();
+	header[GENOME_GRAPH_HEADER_BUCKETS_PER_GROUP]=m_parameters->getNumberOfBucketsPerGroup();
+	header[GENOME_GRAPH_HEADER_RECORDS]=records;
+	header[GENOME_GRAPH_HEADER_RECORDS_PER_BLOCK]=GENOME_GRAPH_RECORDS_PER_BLOCK;
+	header[GENOME_GRAPH_HEADER_BLOCKS]=blocks;
+	header[GENOME_GRAPH_HEADER_RECORDS_OFFSET]=GENOME_GRAPH_HEADER_BYTES;
+	header[GENOME_GRAPH_HEADER_CHECKSUMS_OFFSET]=GENOME_GRAPH_HEADER_BYTES+records*recordSize;
+
+	header[GENOME_GRAPH_HEADER_CHECKSUM]=computeCyclicRedundancyCode32((uint8_t*)header,
+		GENOME_GRAPH_HEADER_CHECKSUM*sizeof(uint64_t));
+}
+
+bool GenomeGraphCheckpoint::write(const char*file){
+
+	ofstream f(file,ios::binary);
+
+	if(!f){
+		cout<<"Error: can not write checkpoint file "<<file<<endl;
+		return false;
+	}
+
+	uint64_t header[GENOME_GRAPH_HEADER_BYTES/sizeof(uint64_t)];
+	memset(header,0,GENOME_GRAPH_HEADER_BYTES);
+
+	/* the header is written again when the counts are known */
+	f.write((char*)header,GENOME_GRAPH_HEADER_BYTES);
+
+	Vertex prototype;
+	int recordSize=prototype.getRequiredNumberOfBytes();
+
+	vector<char> block(GENOME_GRAPH_RECORDS_PER_BLOCK*recordSize);
+	vector<uint32_t> checksums;
+	uint64_t records=0;
+	int recordsInBlock=0;
+
+	int shards=m_subgraph->getNumberOfShards();
+
+	/* the records of all the shards are written in one sequence of blocks */
+	for(int shard=0;shard<shards;shard++){
+
+		MyHashTableIterator<Kmer,Vertex> iterator;
+		iterator.constructor(m_subgraph->getHashTable(shard));
+
+		bool lastShard=shard==shards-1;
+
+		while(iterator.hasNext() || (lastShard && recordsInBlock>0)){
+
+			if(iterator.hasNext()){
+				Vertex*vertex=iterator.next();
+				vertex->dump(&(block[0])+recordsInBlock*recordSize,m_subgraph->getCoverage(vertex));
+				recordsInBlock++;
+				records++;
+			}
+
+			if(recordsInBlock==GENOME_GRAPH_RECORDS_PER_BLOCK
+				|| (lastShard && !iterator.hasNext() && recordsInBlock>0)){
+
+				int bytes=recordsInBlock*recordSize;
+
+				checksums.push_back(computeCyclicRedundancyCode32((uint8_t*)&(block[0]),bytes));
+				f.write(&(block[0]),bytes);
+
+				recordsInBlock=0;
+			}
+		}
+	}
+
+	if(checksums.size()>0)
+		f.write((char*)&(checksums[0]),checksums.size()*sizeof(uint32_t));
+
+	setHeader(header,records,checksums.size());
+
+	f.seekp(0);
+	f.write((char*)header,GENOME_GRAPH_HEADER_BYTES);
+
+	bool ok=f.good();
+
+	f.close();
+
+	if(!ok){
+		cout<<"Error: failed to write checkpoint file "<<file<<endl;
+		return false;
+	}
+
+	cout<<"Rank "<<m_parameters->getRank()<<" wrote "<<records<<" vertices in checkpoint GenomeGraph"<<endl;
+
+	return true;
+}
+
+bool GenomeGraphCheckpoint::checkHeader(uint64_t*header,uint64_t fileSize){
+
+	uint32_t checksum=computeCyclicRedundancyCode32((uint8_t*)header,
+		GENOME_GRAPH_HEADER_CHECKSUM*sizeof(uint64_t));
+
+	if(header[GENOME_GRAPH_HEADER_CHECKSUM]!=checksum){
+		cout<<"Error: the header of checkpoint GenomeGraph is corrupted"<<endl;
+		return false;
+	}
+
+	if(header[GENOME_GRAPH_HEADER_VERSION]!=GENOME_GRAPH_CHECKPOINT_VERSION){
+		cout<<"Error: checkpoint GenomeGraph has version "<<header[GENOME_GRAPH_HEADER_VERSION];
+		cout<<", this Ray reads version "<<GENOME_GRAPH_CHECKPOINT_VERSION<<endl;
+		return false;
+	}
+
+	if(header[GENOME_GRAPH_HEADER_WORD_SIZE]!=(uint64_t)m_parameters->getWordSize()
+		|| header[GENOME_GRAPH_HEADER_COLOR_SPACE]!=(uint64_t)m_parameters->getColorSpaceMode()){
+
+		cout<<"Error: checkpoint GenomeGraph was written with k= "<<header[GENOME_GRAPH_HEADER_WORD_SIZE];
+		cout<<", this job uses k= "<<m_parameters->getWordSize()<<endl;
+		return false;
+	}
+
+	if(header[GENOME_GRAPH_HEADER_RANKS]!=(uint64_t)m_parameters->getSize()
+		|| header[GENOME_GRAPH_HEADER_RANK]!=(uint64_t)m_parameters->getRank()){
+
+		cout<<"Error: checkpoint GenomeGraph was written by rank "<<header[GENOME_GRAPH_HEADER_RANK];
+		cout<<" of "<<header[GENOME_GRAPH_HEADER_RANKS]<<" ranks, this is rank "<<m_parameters->getRank();
+		cout<<" of "<<m_parameters->getSize()<<" ranks"<<endl;
+		return false;
+	}
+
+	Vertex prototype;
+	uint64_t recordSize=prototype.getRequiredNumberOfBytes();
+
+	if(header[GENOME_GRAPH_HEADER_KMER_WORDS]!=KMER_U64_ARRAY_SIZE
+		|| header[GENOME_GRAPH_HEADER_COVERAGE_BYTES]!=sizeof(CoverageDepth)
+		|| header[GENOME_GRAPH_HEADER_RECORD_SIZE]!=recordSize){
+
+		cout<<"Error: checkpoint GenomeGraph was written by a Ray compiled with other";
+		cout<<" MAXKMERLENGTH or MAXIMUM_COVERAGE values"<<endl;
+		return false;
+	}
+
+	uint64_t records=header[GENOME_GRAPH_HEADER_RECORDS];
+	uint64_t recordsPerBlock=header[GENOME_GRAPH_HEADER_RECORDS_PER_BLOCK];
+	uint64_t blocks=header[GENOME_GRAPH_HEADER_BLOCKS];
+	uint64_t recordsOffset=header[GENOME_GRAPH_HEADER_RECORDS_OFFSET];
+	uint64_t checksumsOffset=header[GENOME_GRAPH_HEADER_CHECKSUMS_OFFSET];
+
+	if(recordsPerBlock==0
+		|| blocks!=(records+recordsPerBlock-1)/recordsPerBlock
+		|| recordsOffset!=GENOME_GRAPH_HEADER_BYTES
+		|| checksumsOffset!=recordsOffset+records*recordSize
+		|| fileSize!=checksumsOffset+blocks*sizeof(uint32_t)){
+
+		cout<<"Error: checkpoint GenomeGraph is truncated or has an invalid layout"<<endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool GenomeGraphCheckpoint::load(const char*file){
+
+	int descriptor=open(file,O_RDONLY);
+
+	if(descriptor<0){
+		cout<<"Error: can not open checkpoint file "<<file<<endl;
+		return false;
+	}
+
+	struct stat information;
+	fstat(descriptor,&information);
+	uint64_t fileSize=information.st_size;
+
+	char magic[sizeof(uint64_t)];
+	memset(magic,0,sizeof(uint64_t));
+
+	bool isBinary=fileSize>=GENOME_GRAPH_HEADER_BYTES
+		&& pread(descriptor,magic,sizeof(uint64_t),0)==(ssize_t)sizeof(uint64_t)
+		&& memcmp(magic,GENOME_GRAPH_MAGIC,sizeof(uint64_t))==0;
+
+	bool ok=false;
+
+	if(isBinary)
+		ok=loadBinary(descriptor,fileSize);
+
+	close(descriptor);
+
+	if(!isBinary)
+		ok=loadLegacy(file);
+
+	if(!ok)
+		return false;
+
+	/* complete the resizing ... */
+	/* Otherwise, the code will fail later on */
+	m_subgraph->completeResizing();
+
+	cout<<"Rank "<<m_parameters->getRank()<<" loaded "<<m_subgraph->size()<<" vertices from checkpoint GenomeGraph"<<endl;
+
+	return true;
+}
+
+bool GenomeGraphCheckpoint::loadBinary(int descriptor,uint64_t fileSize){
+
+	void*map=mmap(NULL,fileSize,PROT_READ,MAP_PRIVATE,descriptor,0);
+
+	if(map==MAP_FAILED){
+		cout<<"Error: can not map checkpoint GenomeGraph in memory"<<endl;
+		return false;
+	}
+
+	/* records are read once, from the start to the end */
+	madvise(map,fileSize,MADV_SEQUENTIAL);
+
+	uint64_t*header=(uint64_t*)map;
+
+	if(!checkHeader(header,fileSize)){
+		munmap(map,fileSize);
+		return false;
+	}
+
+	const char*data=(const char*)map;
+	m_header=header;
+	m_recordData=data+header[GENOME_GRAPH_HEADER_RECORDS_OFFSET];
+	m_checksumData=data+header[GENOME_GRAPH_HEADER_CHECKSUMS_OFFSET];
+
+	/* a shard is filled by only one thread */
+	m_threads=m_parameters->getNumberOfThreadsPerRank();
+
+	if(m_threads>m_subgraph->getNumberOfShards())
+		m_threads=m_subgraph->getNumberOfShards();
+
+	uint64_t records=header[GENOME_GRAPH_HEADER_RECORDS];
+	uint64_t blocks=header[GENOME_GRAPH_HEADER_BLOCKS];
+
+	m_ownedRecords.clear();
+	m_ownedRecords.resize(blocks*m_threads);
+
+	/* all the blocks are verified before the first insertion */
+	bool ok=runThreads(GENOME_GRAPH_PHASE_CHECK);
+
+	if(ok)
+		ok=runThreads(GENOME_GRAPH_PHASE_INSERT);
+
+	m_ownedRecords.clear();
+
+	munmap(map,fileSize);
+
+	if(!ok)
+		return false;
+
+	cout<<"Rank "<<m_parameters->getRank()<<" loading checkpoint GenomeGraph ["<<records<<"/"<<records<<"]"<<endl;
+
+	return true;
+}
+
+/*
+ * The main thread is thread 0.
+ */
+bool GenomeGraphCheckpoint::runThreads(int phase){
+
+	vector<GenomeGraphLoadingThread> workers(m_threads);
+
+	for(int i=0;i<m_threads;i++){
+		workers[i].m_checkpoint=this;
+		workers[i].m_thread=i;
+		workers[i].m_phase=phase;
+		workers[i].m_ok=false;
+	}
+
+	for(int i=1;i<m_threads;i++){
+		workers[i].m_started=(pthread_create(&(workers[i].m_handle),NULL,startThread,&(workers[i]))==0);
+
+		// the main thread does the work of this thread after its own
+		if(!workers[i].m_started)
+			cout<<"Error: can not start thread "<<i<<" on rank "<<m_parameters->getRank()<<endl;
+	}
+
+	startThread(&(workers[0]));
+
+	bool ok=workers[0].m_ok;
+
+	for(int i=1;i<m_threads;i++){
+		if(workers[i].m_started)
+			pthread_join(workers[i].m_handle,NULL);
+		else
+			startThread(&(workers[i]));
+
+		ok=ok && workers[i].m_ok;
+	}
+
+	return ok;
+}
+
+void*GenomeGraphCheckpoint::startThread(void*argument){
+	GenomeGraphLoadingThread*worker=(GenomeGraphLoadingThread*)argument;
+
+	if(worker->m_phase==GENOME_GRAPH_PHASE_CHECK)
+		worker->m_ok=worker->m_checkpoint->checkBlocks(worker->m_thread);
+	else
+		worker->m_ok=worker->m_checkpoint->loadRecords(worker->m_thread);
+
+	return NULL;
+}
+
+bool GenomeGraphCheckpoint::checkBlocks(int thread){
+
+	uint64_t records=m_header[GENOME_GRAPH_HEADER_RECORDS];
+	uint64_t recordsPerBlock=m_header[GENOME_GRAPH_HEADER_RECORDS_PER_BLOCK];
+	uint64_t blocks=m_header[GENOME_GRAPH_HEADER_BLOCKS];
+	uint64_t recordSize=m_header[GENOME_GRAPH_HEADER_RECORD_SIZE];
+
+	for(uint64_t block=thread;block<blocks;block+=m_threads){
+
+		uint64_t first=block*recordsPerBlock;
+		uint64_t count=records-first;
+
+		if(count>recordsPerBlock)
+			count=recordsPerBlock;
+
+		const char*blockData=m_recordData+first*recordSize;
+
+		uint32_t expected=0;
+		memcpy(&expected,m_checksumData+block*sizeof(uint32_t),sizeof(uint32_t));
+
+		if(computeCyclicRedundancyCode32((uint8_t*)blockData,count*recordSize)!=expected){
+			cout<<"Error: block "<<block<<" of checkpoint GenomeGraph is corrupted"<<endl;
+			return false;
+		}
+
+		/* give each record of the block to the thread that owns its shard */
+		for(uint64_t i=0;i<count;i++){
+			Kmer key;
+			key.load(blockData+i*recordSize);
+
+			int owner=m_subgraph->getShard(&key)%m_threads;
+
+			m_ownedRecords[block*m_threads+owner].push_back(i);
+		}
+	}
+
+	return true;
+}
+
+bool GenomeGraphCheckpoint::loadRecords(int thread){
+
+	uint64_t records=m_header[GENOME_GRAPH_HEADER_RECORDS];
+	uint64_t recordsPerBlock=m_header[GENOME_GRAPH_HEADER_RECORDS_PER_BLOCK];
+	uint64_t blocks=m_header[GENOME_GRAPH_HEADER_BLOCKS];
+	uint64_t recordSize=m_header[GENOME_GRAPH_HEADER_RECORD_SIZE];
+
+	for(uint64_t block=0;block<blocks;block++){
+
+		uint64_t first=block*recordsPerBlock;
+		const char*blockData=m_recordData+first*recordSize;
+
+		if(thread==0 && block%16==0){
+			cout<<"Rank "<<m_parameters->getRank()<<" loading checkpoint GenomeGraph ["<<first<<"/"<<records<<"]"<<endl;
+		}
+
+		vector<uint32_t>*owned=&(m_ownedRecords[block*m_threads+thread]);
+
+		for(int i=0;i<(int)owned->size();i++){
+			const char*recordBuffer=blockData+(uint64_t)owned->at(i)*recordSize;
+
+			/* the record holds the lower key, the coverage and the edges */
+			Kmer key;
+			key.load(recordBuffer);
+
+			int shard=m_subgraph->getShard(&key);
+
+			#ifdef CONFIG_ASSERT
+			assert(shard%m_threads==thread);
+			#endif
+
+			m_subgraph->lockShard(shard);
+
+			bool inserted=false;
+			Vertex*vertex=m_subgraph->insertInShard(shard,&key,&inserted);
+
+			vertex->constructor();
+
+			CoverageDepth coverage=0;
+			vertex->load(recordBuffer,&coverage);
+			m_subgraph->setCoverage(vertex,coverage);
+
+			m_subgraph->unlockShard(shard);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Checkpoints written before the binary layout: a vertex count
+ * and then Vertex::write entries for both k-mers of each pair.
+ */
+bool GenomeGraphCheckpoint::loadLegacy(const char*file){
+
+	ifstream f(file);
+	LargeCount n=0;
+	f.read((char*)&n,sizeof(LargeCount));
+
+	for(LargeIndex i=0;i<n;i++){
+		if(i%100000==0){
+			cout<<"Rank "<<m_parameters->getRank()<<" loading checkpoint GenomeGraph ["<<i<<"/"<<n<<"]"<<endl;
+		}
+		Kmer kmer;
+		kmer.read(&f);
+		int coverage=0;
+		f.read((char*)&coverage,sizeof(int));
+		bool inserted=false;
+		Vertex*tmp=m_subgraph->insert(&kmer,&inserted);
+
+		/* we only want to construct it once. */
+		if(inserted){
+			tmp->constructor();
+
+			/* the coverage is given with the lower k-mer of the pair */
+			if(kmer==tmp->getKey())
+				m_subgraph->setCoverage(tmp,coverage);
+		}
+		int parents=0;
+		f.read((char*)&parents,sizeof(int));
+		for(int j=0;j<parents;j++){
+			Kmer parent;
+			parent.read(&f);
+			tmp->addIngoingEdge(&kmer,&parent,m_parameters->getWordSize());
+		}
+		int children=0;
+		f.read((char*)&children,sizeof(int));
+
+		for(int j=0;j<children;j++){
+			Kmer child;
+			child.read(&f);
+			tmp->addOutgoingEdge(&kmer,&child,m_parameters->getWordSize());
+		}
+
+		#ifdef CONFIG_ASSERT
+		vector<Kmer> parentKmers=tmp->getIngoingEdges(&kmer,m_parameters->getWordSize());
+		vector<Kmer> childKmers=tmp->getOutgoingEdges(&kmer,m_parameters->getWordSize());
+		if((int)parentKmers.size()!=parents){
+			cout<<"Expected: "<<parents<<" Actual: "<<parentKmers.size()<<endl;
+		}
+		assert((int)parentKmers.size()==parents);
+		assert((int)childKmers.size()==children);
+		#endif
+	}
+
+	bool ok=!f.fail();
+
+	f.close();
+
+	if(!ok){
+		cout<<"Error: checkpoint GenomeGraph is truncated"<<endl;
+		return false;
+	}
+
+	#ifdef CONFIG_ASSERT
+	assert(m_subgraph->size()==n);
+	#endif
+
+	cout<<"Rank "<<m_parameters->getRank()<<" loading checkpoint GenomeGraph ["<<n<<"/"<<n<<"]"<<endl;
+
+	return true;
+}
@@ -0,0 +1,152 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _GenomeGraphCheckpoint_h
+#define _GenomeGraphCheckpoint_h
+
+#include "GridTable.h"
+
+#include <code/Mock/Parameters.h>
+
+#include <pthread.h>
+#include <stdint.h>
+#include <fstream>
+#include <vector>
+using namespace std;
+
+#define GENOME_GRAPH_CHECKPOINT_VERSION 1
+
+#define GENOME_GRAPH_MAGIC "RAYGRAPH"
+
+/* first line of RayOutput/Graph/Manifest.txt (-write-graph) */
+#define GRAPH_MANIFEST_HEADER "#Ray graph manifest"
+
+/* positions of the 64-bit fields in the header */
+#define GENOME_GRAPH_HEADER_MAGIC 0
+#define GENOME_GRAPH_HEADER_VERSION 1
+#define GENOME_GRAPH_HEADER_WORD_SIZE 2
+#define GENOME_GRAPH_HEADER_COLOR_SPACE 3
+#define GENOME_GRAPH_HEADER_KMER_WORDS 4
+#define GENOME_GRAPH_HEADER_COVERAGE_BYTES 5
+#define GENOME_GRAPH_HEADER_RECORD_SIZE 6
+#define GENOME_GRAPH_HEADER_RANK 7
+#define GENOME_GRAPH_HEADER_RANKS 8
+#define GENOME_GRAPH_HEADER_BUCKETS 9
+#define GENOME_GRAPH_HEADER_BUCKETS_PER_GROUP 10
+#define GENOME_GRAPH_HEADER_RECORDS 11
+#define GENOME_GRAPH_HEADER_RECORDS_PER_BLOCK 12
+#define GENOME_GRAPH_HEADER_BLOCKS 13
+#define GENOME_GRAPH_HEADER_RECORDS_OFFSET 14
+#define GENOME_GRAPH_HEADER_CHECKSUMS_OFFSET 15
+#define GENOME_GRAPH_HEADER_CHECKSUM 16
+#define GENOME_GRAPH_HEADER_FIELDS 17
+
+/* the records start after this many bytes */
+#define GENOME_GRAPH_HEADER_BYTES 256
+
+#define GENOME_GRAPH_RECORDS_PER_BLOCK 65536
+
+/* the loading threads verify all the blocks before they insert records */
+#define GENOME_GRAPH_PHASE_CHECK 0
+#define GENOME_GRAPH_PHASE_INSERT 1
+
+class GenomeGraphCheckpoint;
+
+class GenomeGraphLoadingThread{
+public:
+	GenomeGraphCheckpoint*m_checkpoint;
+	int m_thread;
+	int m_phase;
+	pthread_t m_handle;
+	bool m_started;
+	bool m_ok;
+};
+
+/**
+ * The GenomeGraph checkpoint of one rank.
+ *
+ * Layout (all integers are stored in the byte order of the machine):
+ *
+ *     header        GENOME_GRAPH_HEADER_BYTES bytes, 64-bit fields,
+ *                   starts with "RAYGRAPH", ends with a CRC32 of the
+ *                   previous fields
+ *     records       one fixed-size record per entry of the GridTable,
+ *                   the format of Vertex::dump (lower k-mer, coverage,
+ *                   edge bitmap)
+ *     checksums     one CRC32 (32 bits) per block of records
+ *
+ * Only the lower k-mer of each pair is stored, so there is one record
+ * per hash table entry. The file is loaded with mmap and each record
+ * is copied with Vertex::load into the slot returned by GridTable::insert,
+ * without parsing edges into Kmer objects.
+ *
+ * The same files are written by -write-graph (RayOutput/Graph/) and
+ * read by the GenomeGraphReader of the Surveyor.
+ *
+ * With -threads-per-rank, the threads first check the checksums of the
+ * blocks and sort the records by owner (the shard modulo the number of
+ * threads). Nothing is inserted if a block is damaged. Then each thread
+ * inserts its own records, in the order of the file.
+ *
+ * Checkpoints written by older versions of Ray (a vertex count followed
+ * by Vertex::write entries) are still read.
+ *
+ * \author agent
+ */
+class GenomeGraphCheckpoint{
+
+	Parameters*m_parameters;
+	GridTable*m_subgraph;
+
+	/* the mapped file, shared by the loading threads */
+	uint64_t*m_header;
+	const char*m_recordData;
+	const char*m_checksumData;
+	int m_threads;
+
+	/* for each block and each thread, the records of the shards of the thread */
+	vector<vector<uint32_t> > m_ownedRecords;
+
+	void setHeader(uint64_t*header,uint64_t records,uint64_t blocks);
+	bool checkHeader(uint64_t*header,uint64_t fileSize);
+
+	bool loadBinary(int file,uint64_t fileSize);
+	bool loadLegacy(const char*file);
+
+	bool runThreads(int phase);
+	static void*startThread(void*argument);
+
+public:
+
+	void constructor(Parameters*parameters,GridTable*subgraph);
+
+	/** verifies the blocks of a thread and finds the owner of their records */
+	bool checkBlocks(int thread);
+
+	/** inserts the records of the shards of a thread, in the order of the file */
+	bool loadRecords(int thread);
+
+	bool write(const char*file);
+
+	/** returns false if the file is damaged or was written for another job */
+	bool load(const char*file);
+};
+
+#endif
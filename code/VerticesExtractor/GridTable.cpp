@@ -31,6 +31,28 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+GridTable::GridTable(){
+	m_shards=NULL;
+	m_shardLocks=NULL;
+	m_numberOfShards=0;
+}
+
+GridTable::~GridTable(){
+	if(m_shards==NULL)
+		return;
+
+	for(int shard=0;shard<m_numberOfShards;shard++){
+		m_shards[shard].destructor();
+		pthread_mutex_destroy(m_shardLocks+shard);
+	}
+
+	delete[] m_shards;
+	m_shards=NULL;
+
+	delete[] m_shardLocks;
+	m_shardLocks=NULL;
+}
+
 void GridTable::constructor(int rank,Parameters*parameters){
 
 	#ifdef CONFIG_ASSERT
@@ -38,29 +60,49 @@ void GridTable::constructor(int rank,Parameters*parameters){
 	#endif
 
 	m_parameters=parameters;
-	m_size=0;
 
 	uint64_t buckets=m_parameters->getNumberOfBuckets();
 	int bucketsPerGroup=m_parameters->getNumberOfBucketsPerGroup();
 	double loadFactorThreshold=m_parameters->getLoadFactorThreshold();
 
-	m_hashTable.constructor(buckets,"RAY_MALLOC_TYPE_GRID_TABLE",
-		m_parameters->showMemoryAllocations(),m_parameters->getRank(),
-		bucketsPerGroup,loadFactorThreshold
-		);
+	m_numberOfShards=m_parameters->getNumberOfHashTableShards();
+	m_shardBits=0;
 
-	if(m_parameters->hasOption("-hash-table-verbosity"))
-		m_hashTable.toggleVerbosity();
+	while((1<<m_shardBits)<m_numberOfShards)
+		m_shardBits++;
 
-	m_inserted=false;
+	/* the initial buckets are split between the shards */
+	uint64_t bucketsPerShard=buckets/m_numberOfShards;
+
+	if(bucketsPerShard<(uint64_t)bucketsPerGroup)
+		bucketsPerShard=bucketsPerGroup;
+
+	m_shards=new MyHashTable<Kmer,Vertex>[m_numberOfShards];
+	m_shardLocks=new pthread_mutex_t[m_numberOfShards];
+
+	for(int shard=0;shard<m_numberOfShards;shard++){
+		m_shards[shard].constructor(bucketsPerShard,"RAY_MALLOC_TYPE_GRID_TABLE",
+			m_parameters->showMemoryAllocations(),m_parameters->getRank(),
+			bucketsPerGroup,loadFactorThreshold
+			);
+
+		if(m_parameters->hasOption("-hash-table-verbosity"))
+			m_shards[shard].toggleVerbosity();
+
+		pthread_mutex_init(m_shardLocks+shard,NULL);
+	}
 
 	if(m_parameters->showMemoryUsage()){
 		showMemoryUsage(rank);
 	}
 
-	m_findOperations=0;
+	m_findOperations.clear();
+	m_findOperations.resize(m_numberOfShards,0);
 
 	m_verbose=false;
+
+	m_coverageOverflow.clear();
+	m_coverageOverflow.resize(m_numberOfShards);
 }
 
 void GridTable::printStatus(){
@@ -71,12 +113,95 @@ void GridTable::printStatus(){
 
 	if(m_parameters->hasOption("-hash-table-verbosity")){
 		cout<<"[GridTable] buckets="<<buckets<<" bucketsPerGroup="<<bucketsPerGroup;
-		cout<<" loadFactorThreshold="<<loadFactorThreshold<<endl;
+		cout<<" loadFactorThreshold="<<loadFactorThreshold<<" shards="<<m_numberOfShards<<endl;
 	}
 }
 
 LargeCount GridTable::size(){
-	return m_size;
+	LargeCount entries=0;
+
+	for(int shard=0;shard<m_numberOfShards;shard++)
+		entries+=m_shards[shard].size();
+
+	/* each entry holds a k-mer and its reverse complement */
+	return 2*entries;
+}
+
+LargeCount GridTable::getNumberOfSaturatedVertices(){
+	LargeCount vertices=0;
+
+	for(int shard=0;shard<m_numberOfShards;shard++)
+		vertices+=m_coverageOverflow[shard].size();
+
+	return vertices;
+}
+
+CoverageDepth GridTable::getCoverage(Vertex*vertex){
+	if(!vertex->isCoverageSaturated())
+		return vertex->getCoverageCounter();
+
+	Kmer key=vertex->getKey();
+	map<Kmer,CoverageDepth>*table=&(m_coverageOverflow[getShard(&key)]);
+	map<Kmer,CoverageDepth>::iterator exact=table->find(key);
+
+	if(exact==table->end())
+		return vertex->getCoverageCounter();
+
+	return exact->second;
+}
+
+void GridTable::setCoverage(Vertex*vertex,CoverageDepth coverage){
+	Kmer key=vertex->getKey();
+	map<Kmer,CoverageDepth>*table=&(m_coverageOverflow[getShard(&key)]);
+
+	if(coverage>=VERTEX_SATURATED_COVERAGE)
+		(*table)[key]=coverage;
+	else if(vertex->isCoverageSaturated())
+		table->erase(key);
+
+	vertex->setCoverageCounter(coverage);
+}
+
+LargeCount GridTable::getFindOperations(){
+	LargeCount operations=0;
+
+	for(int shard=0;shard<m_numberOfShards;shard++)
+		operations+=m_findOperations[shard];
+
+	return operations;
+}
+
+int GridTable::getNumberOfShards(){
+	return m_numberOfShards;
+}
+
+void GridTable::getLowerKey(Kmer*key,Kmer*lowerKey){
+	*lowerKey=key->complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+	if(key->isLower(lowerKey)){
+		*lowerKey=*key;
+	}
+}
+
+int GridTable::getShard(Kmer*lowerKey){
+	if(m_shardBits==0)
+		return 0;
+
+	/* the low bits select the bucket in the shard */
+	return lowerKey->hash_function_1()>>(64-m_shardBits);
+}
+
+int GridTable::getShardOfKmer(Kmer*key){
+	Kmer lowerKey;
+	getLowerKey(key,&lowerKey);
+	return getShard(&lowerKey);
+}
+
+void GridTable::lockShard(int shard){
+	pthread_mutex_lock(m_shardLocks+shard);
+}
+
+void GridTable::unlockShard(int shard){
+	pthread_mutex_unlock(m_shardLocks+shard);
 }
 
 Vertex*GridTable::find(Kmer*key){
@@ -84,29 +209,29 @@ Vertex*GridTable::find(Kmer*key){
 	assert(key!=NULL);
 	#endif
 
-	Kmer lowerKey=key->complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-	if(key->isLower(&lowerKey)){
-		lowerKey=*key;
-	}
+	Kmer lowerKey;
+	getLowerKey(key,&lowerKey);
 
-	m_findOperations++;
+	int shard=getShard(&lowerKey);
+
+	LargeCount operations=++m_findOperations[shard];
 
 	// show some love on screen
-	if(m_verbose && m_findOperations%100000==0){
-		m_hashTable.toggleVerbosity();
+	if(m_verbose && operations%100000==0){
+		m_shards[shard].toggleVerbosity();
 	}
 
-	Vertex*vertex= m_hashTable.find(&lowerKey);
+	Vertex*vertex= m_shards[shard].find(&lowerKey);
 
 	// turns off verbosity
-	if(m_verbose && m_findOperations%100000==0){
-		m_hashTable.toggleVerbosity();
+	if(m_verbose && operations%100000==0){
+		m_shards[shard].toggleVerbosity();
 	}
 
 	return vertex;
 }
 
-Vertex*GridTable::insert(Kmer*key){
+Vertex*GridTable::insert(Kmer*key,bool*inserted){
 	#ifdef CONFIG_ASSERT
 	assert(key!=NULL);
 	#endif
@@ -115,24 +240,27 @@ Vertex*GridTable::insert(Kmer*key){
 	assert(m_parameters!=NULL);
 	#endif
 
-	Kmer lowerKey=key->complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-	if(key->isLower(&lowerKey)){
-		lowerKey=*key;
-	}
-
-	LargeCount sizeBefore=m_hashTable.size();
-	Vertex*entry=m_hashTable.insert(&lowerKey);
-	m_inserted=m_hashTable.size()>sizeBefore;
+	Kmer lowerKey;
+	getLowerKey(key,&lowerKey);
 
-	if(m_inserted){
-		m_size+=2;
-	}
+	int shard=getShard(&lowerKey);
 
-	return entry;
+	return insertInShard(shard,&lowerKey,inserted);
 }
 
-bool GridTable::inserted(){
-	return m_inserted;
+Vertex*GridTable::insertInShard(int shard,Kmer*lowerKey,bool*inserted){
+	#ifdef CONFIG_ASSERT
+	assert(shard>=0 && shard<m_numberOfShards);
+	assert(getShard(lowerKey)==shard);
+	#endif
+
+	MyHashTable<Kmer,Vertex>*table=m_shards+shard;
+
+	LargeCount sizeBefore=table->size();
+	Vertex*entry=table->insert(lowerKey);
+	(*inserted)=table->size()>sizeBefore;
+
+	return entry;
 }
 
 bool GridTable::isAssembledByGreaterRank(Kmer*a,Rank origin){
@@ -232,7 +360,7 @@ vector<Direction> GridTable::getDirections(Kmer*a){
 
 	/* do a copy to track to check for a segmentation fault */
 	Vertex copy=*i;
-	assert(copy.getVertexCoverage() >= 1);
+	assert(copy.getCoverageCounter() >= 1);
 	#endif
 
 	return i->getDirections(a);
@@ -252,14 +380,16 @@ void GridTable::clearDirections(Kmer*a){
 	i->clearDirections(a);
 }
 
-MyHashTable<Kmer,Vertex>*GridTable::getHashTable(){
-	return &m_hashTable;
+MyHashTable<Kmer,Vertex>*GridTable::getHashTable(int shard){
+	return m_shards+shard;
 }
 
 void GridTable::printStatistics(){
-	m_hashTable.printProbeStatistics();
+	for(int shard=0;shard<m_numberOfShards;shard++)
+		m_shards[shard].printProbeStatistics();
 }
 
 void GridTable::completeResizing(){
-	m_hashTable.completeResizing();
+	for(int shard=0;shard<m_numberOfShards;shard++)
+		m_shards[shard].completeResizing();
 }
@@ -30,29 +30,85 @@
 #include <RayPlatform/structures/MyHashTable.h>
 #include <RayPlatform/memory/MyAllocator.h>
 
+#include <pthread.h>
+#include <map>
+#include <vector>
+using namespace std;
+
 /**
  * The GridTable  stores  all the k-mers for the graph.
  * Low-coverage (covered once) are not stored here at all.
  * The underlying data structure is a MyHashTable.
+ *
+ * The k-mers are split between shards (independent MyHashTable objects)
+ * with the high bits of the hash, the low bits select the bucket in
+ * the shard. The number of shards is fixed (-hash-table-shards), so the
+ * iteration order does not depend on -threads-per-rank.
+ *
+ * Everything that changes with a lookup (find counter, coverage overflow)
+ * is kept per shard. The main thread uses the table without locks.
+ * Threads that share the table take the lock of the shard (lockShard)
+ * around their whole update, because an insertion can move the
+ * vertices of its shard.
+ *
  * \author Sébastien Boisvert
  */
 class GridTable{
-	MyHashTable<Kmer,Vertex> m_hashTable;
-	Parameters*m_parameters;
-	LargeCount m_size;
-	bool m_inserted;
+	MyHashTable<Kmer,Vertex>*m_shards;
+	pthread_mutex_t*m_shardLocks;
+	int m_numberOfShards;
+	int m_shardBits;
 
-	LargeCount m_findOperations;
+	/** exact coverage of the vertices with a saturated counter, for each shard */
+	vector<map<Kmer,CoverageDepth> > m_coverageOverflow;
+
+	/** calls to find(), for each shard */
+	vector<LargeCount> m_findOperations;
+
+	Parameters*m_parameters;
 
 	/** verbosity */
 	bool m_verbose;
 
+	void getLowerKey(Kmer*key,Kmer*lowerKey);
+
 public:
+	GridTable();
+	~GridTable();
+
 	void constructor(Rank rank,Parameters*a);
 	LargeCount size();
+	/** number of calls to find() since the construction */
+	LargeCount getFindOperations();
+	/** number of vertices with a coverage that does not fit in the vertex */
+	LargeCount getNumberOfSaturatedVertices();
 	Vertex*find(Kmer*key);
-	Vertex*insert(Kmer*key);
-	bool inserted();
+	/** inserts a k-mer, inserted is true if it was not in the table */
+	Vertex*insert(Kmer*key,bool*inserted);
+
+	int getNumberOfShards();
+	/** the shard of a lower k-mer */
+	int getShard(Kmer*lowerKey);
+	/** the shard of any k-mer */
+	int getShardOfKmer(Kmer*key);
+
+	/**
+	 * Threads that share the table hold the lock of a shard while
+	 * they use its vertices. The main thread alone does not need it.
+	 */
+	void lockShard(int shard);
+	void unlockShard(int shard);
+
+	/** inserts a lower k-mer, see lockShard */
+	Vertex*insertInShard(int shard,Kmer*lowerKey,bool*inserted);
+
+	/**
+	 * The exact coverage of a vertex of this table. The counter of the
+	 * vertex saturates, the exact values are in the overflow table
+	 * of the shard.
+	 */
+	CoverageDepth getCoverage(Vertex*vertex);
+	void setCoverage(Vertex*vertex,CoverageDepth coverage);
 
 	void addRead(Kmer*a,ReadAnnotation*e);
 	ReadAnnotation*getReads(Kmer*a);
@@ -63,7 +119,7 @@ public:
 	bool isAssembled(Kmer*a);
 	bool isAssembledByGreaterRank(Kmer*a,Rank origin);
 
-	MyHashTable<Kmer,Vertex>*getHashTable();
+	MyHashTable<Kmer,Vertex>*getHashTable(int shard);
 	void printStatistics();
 	void completeResizing();
 
@@ -0,0 +1,213 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "GridTableBenchmark.h"
+
+#include <RayPlatform/core/OperatingSystem.h>
+
+#include <iostream>
+#include <set>
+using namespace std;
+
+#include <stdlib.h>
+
+#define GRID_TABLE_BENCHMARK_KMERS 1000000
+#define GRID_TABLE_BENCHMARK_INSERTIONS 4000000
+
+/* the first k-mers are inserted much more often, their coverage saturates */
+#define GRID_TABLE_BENCHMARK_HOT_KMERS 16
+#define GRID_TABLE_BENCHMARK_HOT_INSERTIONS 40000
+
+/* a small table, so that the shards are resized during the runs */
+#define GRID_TABLE_BENCHMARK_BUCKETS "1048576"
+
+void GridTableBenchmark::generateKmers(){
+	int kmerLength=m_parameters.getWordSize();
+
+	srand(kmerLength);
+
+	m_kmers.clear();
+
+	/* a k-mer and its reverse complement are the same vertex */
+	set<Kmer> pairs;
+
+	while((int)m_kmers.size()<GRID_TABLE_BENCHMARK_KMERS){
+		Kmer kmer;
+		for(int position=0;position<kmerLength;position++){
+			uint64_t symbol=rand()%4;
+			int chunk=position/32;
+			kmer.setU64(chunk,kmer.getU64(chunk)|(symbol<<(2*(position%32))));
+		}
+
+		Kmer lowerKey=kmer.complementVertex(kmerLength,false);
+
+		if(kmer.isLower(&lowerKey))
+			lowerKey=kmer;
+
+		if(pairs.count(lowerKey)>0)
+			continue;
+
+		pairs.insert(lowerKey);
+		m_kmers.push_back(kmer);
+	}
+
+	m_stream.clear();
+	m_expected.clear();
+	m_expected.resize(m_kmers.size(),0);
+
+	for(int i=0;i<GRID_TABLE_BENCHMARK_INSERTIONS;i++){
+		uint32_t kmer=0;
+
+		if(i<GRID_TABLE_BENCHMARK_HOT_INSERTIONS)
+			kmer=rand()%GRID_TABLE_BENCHMARK_HOT_KMERS;
+		else
+			kmer=rand()%m_kmers.size();
+
+		m_stream.push_back(kmer);
+		m_expected[kmer]++;
+	}
+
+	/* the hot k-mers are spread in the stream */
+	for(int i=0;i<GRID_TABLE_BENCHMARK_HOT_INSERTIONS;i++){
+		int other=rand()%m_stream.size();
+		uint32_t kmer=m_stream[i];
+		m_stream[i]=m_stream[other];
+		m_stream[other]=kmer;
+	}
+}
+
+void*GridTableBenchmark::startThread(void*argument){
+	GridTableBenchmarkThread*worker=(GridTableBenchmarkThread*)argument;
+	worker->m_benchmark->insertKmers(worker->m_thread);
+	return NULL;
+}
+
+void GridTableBenchmark::insertKmers(int thread){
+
+	for(int i=thread;i<(int)m_stream.size();i+=m_threads){
+		Kmer*kmer=&(m_kmers[m_stream[i]]);
+
+		int shard=m_table->getShardOfKmer(kmer);
+
+		m_table->lockShard(shard);
+
+		bool inserted=false;
+		Vertex*vertex=m_table->insert(kmer,&inserted);
+
+		if(inserted)
+			vertex->constructor();
+
+		m_table->setCoverage(vertex,m_table->getCoverage(vertex)+1);
+
+		m_table->unlockShard(shard);
+	}
+}
+
+bool GridTableBenchmark::check(){
+
+	LargeCount entries=0;
+
+	for(int i=0;i<(int)m_kmers.size();i++){
+		Vertex*vertex=m_table->find(&(m_kmers[i]));
+
+		if(m_expected[i]==0){
+			if(vertex!=NULL)
+				return false;
+			continue;
+		}
+
+		entries++;
+
+		if(vertex==NULL || m_table->getCoverage(vertex)!=m_expected[i])
+			return false;
+	}
+
+	return m_table->size()==2*entries;
+}
+
+bool GridTableBenchmark::runThreads(int threads){
+
+	m_threads=threads;
+
+	m_table=new GridTable;
+	m_table->constructor(0,&m_parameters);
+
+	vector<GridTableBenchmarkThread> workers(m_threads);
+
+	uint64_t start=getMicroseconds();
+
+	for(int i=0;i<m_threads;i++){
+		workers[i].m_benchmark=this;
+		workers[i].m_thread=i;
+		workers[i].m_started=(pthread_create(&(workers[i].m_handle),NULL,startThread,&(workers[i]))==0);
+
+		if(!workers[i].m_started)
+			cout<<"Error: can not start thread "<<i<<endl;
+	}
+
+	for(int i=0;i<m_threads;i++){
+		if(workers[i].m_started)
+			pthread_join(workers[i].m_handle,NULL);
+		else
+			insertKmers(i);
+	}
+
+	uint64_t elapsed=getMicroseconds()-start;
+
+	if(elapsed==0)
+		elapsed=1;
+
+	bool correct=check();
+
+	cout<<"threads= "<<m_threads<<" shards= "<<m_table->getNumberOfShards();
+	cout<<" insertions= "<<m_stream.size()<<" time= "<<elapsed<<" us";
+	cout<<" rate= "<<(uint64_t)(m_stream.size()*1000000.0/elapsed)<<" insertions/s";
+	cout<<" vertices= "<<m_table->size()<<" saturated= "<<m_table->getNumberOfSaturatedVertices();
+	cout<<" results: "<<(correct?"correct":"WRONG")<<endl;
+
+	delete m_table;
+	m_table=NULL;
+
+	return correct;
+}
+
+bool GridTableBenchmark::run(){
+
+	char program[]="Ray";
+	char option[]="-hash-table-buckets";
+	char buckets[]=GRID_TABLE_BENCHMARK_BUCKETS;
+	char*arguments[]={program,option,buckets};
+
+	m_parameters.constructor(3,arguments,0,1,1);
+
+	generateKmers();
+
+	cout<<"GridTableBenchmark: k= "<<m_parameters.getWordSize();
+	cout<<" distinct k-mers= "<<m_kmers.size()<<" buckets= "<<m_parameters.getNumberOfBuckets()<<endl;
+
+	bool correct=true;
+
+	for(int threads=1;threads<=16;threads*=2){
+		if(!runThreads(threads))
+			correct=false;
+	}
+
+	return correct;
+}
@@ -0,0 +1,87 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _GridTableBenchmark_h
+#define _GridTableBenchmark_h
+
+#include "GridTable.h"
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/Mock/Parameters.h>
+
+#include <pthread.h>
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+class GridTableBenchmark;
+
+class GridTableBenchmarkThread{
+public:
+	GridTableBenchmark*m_benchmark;
+	int m_thread;
+	pthread_t m_handle;
+	bool m_started;
+};
+
+/**
+ * Stress test and benchmark for the shards of the GridTable.
+ *
+ * The same stream of k-mers is inserted with 1, 2, 4, 8 and 16 threads.
+ * The k-mers are dealt to the threads one by one, so all the threads
+ * hit all the shards at the same time and only the locks of the shards
+ * keep the table consistent. Some k-mers are repeated thousands of times
+ * to go through the coverage overflow tables.
+ *
+ * After each run, every k-mer is looked up and its coverage is compared
+ * with the number of times it was inserted.
+ * It is started with Ray -grid-table-benchmark.
+ *
+ * \author agent
+ */
+class GridTableBenchmark{
+
+	Parameters m_parameters;
+	GridTable*m_table;
+	int m_threads;
+
+	/** the distinct k-mers */
+	vector<Kmer> m_kmers;
+	/** the stream of insertions, as indexes in m_kmers */
+	vector<uint32_t> m_stream;
+	/** the expected coverage of each distinct k-mer */
+	vector<CoverageDepth> m_expected;
+
+	void generateKmers();
+	bool runThreads(int threads);
+	bool check();
+
+	static void*startThread(void*argument);
+
+public:
+
+	/** inserts the k-mers of the stream given to a thread */
+	void insertKmers(int thread);
+
+	/** returns true if the table was correct after every run */
+	bool run();
+};
+
+#endif
@@ -30,7 +30,17 @@ using namespace std;
 void GridTableIterator::constructor(GridTable*a,int wordSize,Parameters*parameters){
 	m_parameters=parameters;
 	m_mustProcessOtherKey=false;
-	m_iterator.constructor(a->getHashTable());
+	m_table=a;
+	m_shard=0;
+	m_iterator.constructor(m_table->getHashTable(m_shard));
+	skipEmptyShards();
+}
+
+void GridTableIterator::skipEmptyShards(){
+	while(!m_iterator.hasNext() && m_shard+1<m_table->getNumberOfShards()){
+		m_shard++;
+		m_iterator.constructor(m_table->getHashTable(m_shard));
+	}
 }
 
 bool GridTableIterator::hasNext(){
@@ -48,6 +58,7 @@ Vertex*GridTableIterator::next(){
 	assert(hasNext());
 	#endif
 	m_currentEntry=m_iterator.next();
+	skipEmptyShards();
 	m_currentKey=m_currentEntry->getKey();
 	m_mustProcessOtherKey=true;
 	return m_currentEntry;
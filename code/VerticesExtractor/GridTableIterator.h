@@ -33,11 +33,16 @@
  * \author Sébastien Boisvert
  */
 class GridTableIterator{
+	GridTable*m_table;
+	/** the shards are visited in order */
+	int m_shard;
 	MyHashTableIterator<Kmer,Vertex> m_iterator;
 	bool m_mustProcessOtherKey;
 	Kmer m_currentKey;
 	Vertex*m_currentEntry;
 	Parameters*m_parameters;
+
+	void skipEmptyShards();
 public:
 	void constructor(GridTable*a,int wordSize,Parameters*b);
 	bool hasNext();
@@ -22,6 +22,8 @@
 #include "Vertex.h"
 #include <code/Mock/common_functions.h>
 
+#include <RayPlatform/core/types.h> /* for CONFIG_MINI_RANKS */
+
 #include <assert.h>
 #include <vector>
 #include <cstdlib>
@@ -72,31 +74,20 @@ bool Vertex::isAssembledByGreaterRank(Rank origin){
 	return origin<m_assembled;
 }
 
-void Vertex::setCoverageValue(CoverageDepth coverage) {
-
-	m_coverage_lower = coverage;
-}
+void Vertex::setCoverageCounter(CoverageDepth coverage) {
 
-void Vertex::setCoverage(Kmer*a,CoverageDepth coverage){
-	if(*a==m_lowerKey){
-
-		CoverageDepth max=0;
-		max=max-1;// underflow.
-
-		if(m_coverage_lower==max){ // maximum value
-			return;
-		}
+	if(coverage > VERTEX_SATURATED_COVERAGE)
+		coverage = VERTEX_SATURATED_COVERAGE;
 
-		m_coverage_lower=coverage;
-	}
+	m_coverage_lower = coverage;
 }
 
-CoverageDepth Vertex::getVertexCoverage() const{
-	return getCoverage(&m_lowerKey);
+CoverageDepth Vertex::getCoverageCounter() const{
+	return m_coverage_lower;
 }
 
-CoverageDepth Vertex::getCoverage(const Kmer*a) const{
-	return m_coverage_lower;
+bool Vertex::isCoverageSaturated() const{
+	return m_coverage_lower == VERTEX_SATURATED_COVERAGE;
 }
 
 vector<Kmer> Vertex::getIngoingEdges(const Kmer *a,int k) const{
@@ -254,8 +245,8 @@ void Vertex::clearDirections(Kmer*a){
 	m_directions=NULL;
 }
 
-void Vertex::write(Kmer*key, ostream*f,int kmerLength){
-	int coverage=getCoverage(key);
+void Vertex::write(Kmer*key,CoverageDepth exactCoverage,ostream*f,int kmerLength){
+	int coverage=exactCoverage;
 	key->write(f);
 	f->write((char*)&coverage,sizeof(int));
 	vector<Kmer> parents=getIngoingEdges(key,kmerLength);
@@ -419,14 +410,17 @@ Direction*Vertex::getFirstDirection()const{
 	return m_directions;
 }
 
-int Vertex::load(const char * buffer) {
+int Vertex::load(const char * buffer, CoverageDepth * coverage) {
 	int position = 0;
 	position += m_lowerKey.load(buffer);
 
-	int bytes = sizeof(m_coverage_lower);
-	memcpy(&m_coverage_lower, buffer + position, bytes);
+	/* the exact coverage is stored, not the saturated counter */
+	int bytes = sizeof(CoverageDepth);
+	memcpy(coverage, buffer + position, bytes);
 	position += bytes;
 
+	setCoverageCounter(*coverage);
+
 	bytes = sizeof(m_edges_lower);
 	memcpy(&m_edges_lower, buffer + position, bytes);
 	position += bytes;
@@ -435,13 +429,13 @@ int Vertex::load(const char * buffer) {
 
 }
 
-int Vertex::dump(char * buffer) const {
+int Vertex::dump(char * buffer, CoverageDepth coverage) const {
 
 	int position = 0;
 	position += m_lowerKey.dump(buffer);
 
-	int bytes = sizeof(m_coverage_lower);
-	memcpy(buffer + position, &m_coverage_lower, bytes);
+	int bytes = sizeof(coverage);
+	memcpy(buffer + position, &coverage, bytes);
 	position += bytes;
 
 	uint8_t edges = getEdgeSet();
@@ -460,16 +454,14 @@ uint8_t Vertex::getEdgeSet() const {
 
 int Vertex::getRequiredNumberOfBytes() const {
 
-	//cout << "DEBUG sizeof(m_coverage_lower) is " << sizeof(m_coverage_lower) << endl;
-
-	return m_lowerKey.getRequiredNumberOfBytes() + sizeof(m_coverage_lower) + sizeof(m_edges_lower);
+	return m_lowerKey.getRequiredNumberOfBytes() + sizeof(CoverageDepth) + sizeof(m_edges_lower);
 }
 
 void Vertex::print(int kmerLength, bool colorSpaceMode) const {
 
 	cout << " Vertex key= ";
 	cout << m_lowerKey.idToWord(kmerLength, colorSpaceMode);
-	cout << " " << getVertexCoverage();
+	cout << " " << getCoverageCounter();
 	cout << " parents: " << getIngoingEdges(&m_lowerKey, kmerLength).size();
 	cout << " children: " << getOutgoingEdges(&m_lowerKey, kmerLength).size();
 	cout << endl;
@@ -35,6 +35,12 @@
 #include <vector>
 using namespace std;
 
+/*
+ * Most k-mers have a coverage below this value, the counter
+ * in the vertex only needs 8 bits.
+ */
+#define VERTEX_SATURATED_COVERAGE 255
+
 /**
  * The vertex is important in the algorithm.
  * A DNA sequence is simply an ordered array of vertices. 
@@ -131,6 +137,14 @@ private:
  */
 	uint8_t m_edges_lower;
 
+/*
+ *	The coverage of the vertex, saturated at VERTEX_SATURATED_COVERAGE.
+ *	The exact value of a saturated vertex of the graph is in the
+ *	overflow table of its GridTable (see GridTable::getCoverage).
+ *	It is next to m_edges_lower to use the padding before m_assembled.
+ */
+	uint8_t m_coverage_lower;
+
 /** the greatest rank that assembled the k-mer **/
 	Rank m_assembled;
 
@@ -145,11 +159,6 @@ private:
  */
 	ReadAnnotation*m_readsStartingHere;
 
-/*
- *	The coverage of the vertex
- */
-	CoverageDepth m_coverage_lower;
-
 /**
  * TODO: there should be a sister class that does not store
  * the Kmer object since all kmers are in the MyHashTable
@@ -184,10 +193,15 @@ public:
 	void addIngoingEdge_ClassicMethod(Kmer*vertex,Kmer*a,int k);
 
 	void constructor();
-	void setCoverage(Kmer*a,CoverageDepth coverage);
-	void setCoverageValue(CoverageDepth coverage);
-	CoverageDepth getCoverage(const Kmer*p) const;
-	CoverageDepth getVertexCoverage() const;
+
+/**
+ * The coverage counter, saturated at VERTEX_SATURATED_COVERAGE.
+ * Use GridTable::getCoverage and GridTable::setCoverage for
+ * the vertices of the graph.
+ */
+	CoverageDepth getCoverageCounter() const;
+	void setCoverageCounter(CoverageDepth coverage);
+	bool isCoverageSaturated() const;
 
 	// TODO: add methods to add parents and children without
 	// having to provide the base kmer.
@@ -226,7 +240,7 @@ public:
 	bool isAssembled();
 	bool isAssembledByGreaterRank(Rank origin);
 
-	void write(Kmer*key,ostream*f,int kmerLength);
+	void write(Kmer*key,CoverageDepth coverage,ostream*f,int kmerLength);
 	void writeAnnotations(Kmer*key,ostream*f,int kmerLength,bool color);
 
 	VirtualKmerColorHandle getVirtualColor();
@@ -238,8 +252,12 @@ public:
 
 	Direction*getFirstDirection()const;
 
-	int load(const char * buffer);
-	int dump(char * buffer) const;
+/**
+ * The record holds the exact coverage, given by the caller
+ * because the vertex only has the saturated counter.
+ */
+	int load(const char * buffer, CoverageDepth * coverage);
+	int dump(char * buffer, CoverageDepth coverage) const;
 	int getRequiredNumberOfBytes() const;
 
 	void print(int kmerLength, bool colorSpaceMode) const;
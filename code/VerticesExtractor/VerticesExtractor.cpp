@@ -38,6 +38,7 @@ __CreatePlugin(VerticesExtractor);
 __CreateSlaveModeAdapter(VerticesExtractor,RAY_SLAVE_MODE_ADD_EDGES);
 
 void VerticesExtractor::call_RAY_SLAVE_MODE_ADD_EDGES(){
+	SlaveModeProbe probe(m_instrumentation,RAY_SLAVE_MODE_ADD_EDGES);
 
 	MACRO_COLLECT_PROFILING_INFORMATION();
 
@@ -54,13 +55,29 @@ void VerticesExtractor::call_RAY_SLAVE_MODE_ADD_EDGES(){
 
 	if(!m_checkedCheckpoint){
 		m_checkedCheckpoint=true;
-		if(m_parameters->hasCheckpoint("GenomeGraph")){
+
+		if(m_parameters->isIncrementalAssembly()){
+			m_mode_send_vertices_sequence_id=m_parameters->getFirstNewSequence();
+
+			if(m_mode_send_vertices_sequence_id>(int)m_myReads->size())
+				m_mode_send_vertices_sequence_id=m_myReads->size();
+
+			cout<<"Rank "<<m_parameters->getRank()<<": checkpoint GenomeGraph exists, adding edges from sequence reads [";
+			cout<<m_mode_send_vertices_sequence_id+1<<"/"<<m_myReads->size()<<"] and after."<<endl;
+
+		}else if(m_parameters->hasCheckpoint("GenomeGraph")){
 			cout<<"Rank "<<m_parameters->getRank()<<": checkpoint GenomeGraph exists, not extracting vertices."<<endl;
 			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_VERTICES_DISTRIBUTED,m_parameters->getRank());
 			m_outbox->push_back(&aMessage);
 			m_finished=true;
+
+			// this is the last phase with the threads
+			m_extractionPool->destructor();
 			return;
 		}
+
+		if(m_extractionPool->isEnabled())
+			m_extractionPool->startExtraction(KMER_EXTRACTION_EDGES,m_mode_send_vertices_sequence_id);
 	}
 
 	#ifdef CONFIG_ASSERT
@@ -71,20 +88,17 @@ void VerticesExtractor::call_RAY_SLAVE_MODE_ADD_EDGES(){
 	}
 
 	if(m_mode_send_vertices_sequence_id%100000==0 &&m_mode_send_vertices_sequence_id_position==0
-		&&m_mode_send_vertices_sequence_id<(int)m_myReads->size()){
+		&&m_mode_send_vertices_sequence_id<(int)m_myReads->size() && !m_extractionPool->isEnabled()){
 
-		string reverse="";
-		if(m_reverseComplementVertex==true){
-			reverse="(reverse complement) ";
-		}
-		printf("Rank %i is adding edges %s[%i/%i]\n",m_parameters->getRank(),reverse.c_str(),(int)m_mode_send_vertices_sequence_id+1,(int)m_myReads->size());
-
-		m_derivative.addX(m_mode_send_vertices_sequence_id);
-		m_derivative.printStatus(SLAVE_MODES[RAY_SLAVE_MODE_ADD_EDGES],RAY_SLAVE_MODE_ADD_EDGES);
-		m_derivative.printEstimatedTime(m_myReads->size());
+		printProgress(m_mode_send_vertices_sequence_id);
 	}
 
-	if(m_mode_send_vertices_sequence_id==(int)m_myReads->size()){
+	bool completed=m_mode_send_vertices_sequence_id==(int)m_myReads->size();
+
+	if(m_extractionPool->isEnabled())
+		completed=m_extractionPool->isFinished();
+
+	if(completed){
 
 		MACRO_COLLECT_PROFILING_INFORMATION();
 
@@ -100,12 +114,44 @@ void VerticesExtractor::call_RAY_SLAVE_MODE_ADD_EDGES(){
 			Message aMessage(NULL,0, MASTER_RANK, RAY_MPI_TAG_VERTICES_DISTRIBUTED,m_parameters->getRank());
 			m_outbox->push_back(&aMessage);
 			m_finished=true;
+			m_extractionPool->destructor();
 			printf("Rank %i is adding edges [%i/%i] (completed)\n",m_parameters->getRank(),(int)m_mode_send_vertices_sequence_id,(int)m_myReads->size());
 			m_bufferedDataForIngoingEdges.showStatistics(m_parameters->getRank());
 			m_bufferedDataForOutgoingEdges.showStatistics(m_parameters->getRank());
 
 			m_derivative.writeFile(&cout);
 		}
+	}else if(m_extractionPool->isEnabled()){
+
+		MACRO_COLLECT_PROFILING_INFORMATION();
+
+		// the edges of the next reads are computed by the threads
+		if(!m_extractionPool->hasMessage()){
+			if(m_extractionPool->nextBatch()){
+				LargeIndex first=m_extractionPool->getFirstRead();
+				LargeIndex last=first+m_extractionPool->getNumberOfReads();
+
+				// the first multiple of 100000 in the batch
+				LargeIndex read=(first+99999)/100000*100000;
+
+				if(read<last)
+					printProgress(read);
+
+				m_mode_send_vertices_sequence_id=last;
+			}
+			return;
+		}
+
+		MessageTag tags[2];
+		tags[KMER_EXTRACTION_OUTGOING_EDGES]=RAY_MPI_TAG_OUT_EDGES_DATA;
+		tags[KMER_EXTRACTION_INGOING_EDGES]=RAY_MPI_TAG_IN_EDGES_DATA;
+
+		int maximum=CONFIG_KMER_EXTRACTION_MESSAGES;
+
+		if(maximum>m_parameters->getSize())
+			maximum=m_parameters->getSize();
+
+		m_pendingMessages+=m_extractionPool->sendMessages(maximum,tags,m_outboxAllocator,m_outbox);
 	}else{
 
 		MACRO_COLLECT_PROFILING_INFORMATION();
@@ -150,127 +196,132 @@ void VerticesExtractor::call_RAY_SLAVE_MODE_ADD_EDGES(){
 			MACRO_COLLECT_PROFILING_INFORMATION();
 
 			Kmer currentForwardKmer=wordId(memory);
+			Kmer currentReverseKmer=currentForwardKmer.
+				complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 
-			/* TODO: possibly don't flush k-mer that are not lower. not sure it that would work though. -Seb */
-
-/*
- *                   previousForwardKmer   ->   currentForwardKmer
- *                   previousReverseKmer   <-   currentReverseKmer
- */
-
-
-/*
- * Push the kmer
- */
-
+			addEdges(&currentForwardKmer,&currentReverseKmer);
 
 			MACRO_COLLECT_PROFILING_INFORMATION();
+		}else{
+			m_hasPreviousVertex=false;
+		}
 
-			if(m_hasPreviousVertex){
+		MACRO_COLLECT_PROFILING_INFORMATION();
 
-				MACRO_COLLECT_PROFILING_INFORMATION();
+		(m_mode_send_vertices_sequence_id_position++);
+
+		if((m_mode_send_vertices_sequence_id_position)==maximumPosition){
+			m_hasPreviousVertex=false;
+			(m_mode_send_vertices_sequence_id)++;
+			(m_mode_send_vertices_sequence_id_position)=0;
+		}
+	}
+	MACRO_COLLECT_PROFILING_INFORMATION();
+}
 
-				// outgoing edge
-				// PreviousVertex(*) -> CurrentVertex
-				Rank outgoingRank=m_parameters->vertexRank(&m_previousVertex);
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForOutgoingEdges.addAt(outgoingRank,m_previousVertex.getU64(i));
-				}
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForOutgoingEdges.addAt(outgoingRank,currentForwardKmer.getU64(i));
-				}
+void VerticesExtractor::printProgress(int read){
 
+	string reverse="";
+	if(m_reverseComplementVertex==true){
+		reverse="(reverse complement) ";
+	}
+	printf("Rank %i is adding edges %s[%i/%i]\n",m_parameters->getRank(),reverse.c_str(),(int)read+1,(int)m_myReads->size());
 
-				if(m_bufferedDataForOutgoingEdges.flush(outgoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_OUT_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
-					m_pendingMessages++;
-				}
+	m_derivative.addX(read);
+	m_derivative.printStatus(SLAVE_MODES[RAY_SLAVE_MODE_ADD_EDGES],RAY_SLAVE_MODE_ADD_EDGES);
+	m_derivative.printEstimatedTime(m_myReads->size());
+}
 
-				// ingoing edge
-				// PreviousVertex -> CurrentVertex(*)
-				Rank ingoingRank=m_parameters->vertexRank(&currentForwardKmer);
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForIngoingEdges.addAt(ingoingRank,m_previousVertex.getU64(i));
-				}
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForIngoingEdges.addAt(ingoingRank,currentForwardKmer.getU64(i));
-				}
+/*
+ *                   previousForwardKmer   ->   currentForwardKmer
+ *                   previousReverseKmer   <-   currentReverseKmer
+ */
+void VerticesExtractor::addEdges(Kmer*currentForwardKmer,Kmer*currentReverseKmer){
 
+	if(m_hasPreviousVertex){
 
-				if(m_bufferedDataForIngoingEdges.flush(ingoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_IN_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
-					m_pendingMessages++;
-				}
+		MACRO_COLLECT_PROFILING_INFORMATION();
 
-				MACRO_COLLECT_PROFILING_INFORMATION();
-			}
+		// outgoing edge
+		// PreviousVertex(*) -> CurrentVertex
+		Rank outgoingRank=m_parameters->vertexRank(&m_previousVertex);
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForOutgoingEdges.addAt(outgoingRank,m_previousVertex.getU64(i));
+		}
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForOutgoingEdges.addAt(outgoingRank,currentForwardKmer->getU64(i));
+		}
 
-			// reverse complement
-			//
-			Kmer currentReverseKmer=currentForwardKmer.
-				complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 
+		if(m_bufferedDataForOutgoingEdges.flush(outgoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_OUT_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
+			m_pendingMessages++;
+		}
 
-			if(m_hasPreviousVertex){
-				MACRO_COLLECT_PROFILING_INFORMATION();
+		// ingoing edge
+		// PreviousVertex -> CurrentVertex(*)
+		Rank ingoingRank=m_parameters->vertexRank(currentForwardKmer);
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForIngoingEdges.addAt(ingoingRank,m_previousVertex.getU64(i));
+		}
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForIngoingEdges.addAt(ingoingRank,currentForwardKmer->getU64(i));
+		}
 
-				// outgoing edge
-				// 
-				Rank outgoingRank=m_parameters->vertexRank(&currentReverseKmer);
 
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForOutgoingEdges.addAt(outgoingRank,currentReverseKmer.getU64(i));
-				}
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForOutgoingEdges.addAt(outgoingRank,m_previousVertexRC.getU64(i));
-				}
+		if(m_bufferedDataForIngoingEdges.flush(ingoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_IN_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
+			m_pendingMessages++;
+		}
 
-				MACRO_COLLECT_PROFILING_INFORMATION();
+		MACRO_COLLECT_PROFILING_INFORMATION();
+	}
 
+	if(m_hasPreviousVertex){
+		MACRO_COLLECT_PROFILING_INFORMATION();
 
-				if(m_bufferedDataForOutgoingEdges.flush(outgoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_OUT_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
+		// outgoing edge
+		// 
+		Rank outgoingRank=m_parameters->vertexRank(currentReverseKmer);
 
-					m_pendingMessages++;
-				}
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForOutgoingEdges.addAt(outgoingRank,currentReverseKmer->getU64(i));
+		}
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForOutgoingEdges.addAt(outgoingRank,m_previousVertexRC.getU64(i));
+		}
 
-				MACRO_COLLECT_PROFILING_INFORMATION();
+		MACRO_COLLECT_PROFILING_INFORMATION();
 
-				// ingoing edge
-				Rank ingoingRank=m_parameters->vertexRank(&m_previousVertexRC);
 
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForIngoingEdges.addAt(ingoingRank,currentReverseKmer.getU64(i));
-				}
-				for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
-					m_bufferedDataForIngoingEdges.addAt(ingoingRank,m_previousVertexRC.getU64(i));
-				}
+		if(m_bufferedDataForOutgoingEdges.flush(outgoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_OUT_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
 
-				MACRO_COLLECT_PROFILING_INFORMATION();
+			m_pendingMessages++;
+		}
 
+		MACRO_COLLECT_PROFILING_INFORMATION();
 
-				if(m_bufferedDataForIngoingEdges.flush(ingoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_IN_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
-					m_pendingMessages++;
-				}
-				MACRO_COLLECT_PROFILING_INFORMATION();
-			}
+		// ingoing edge
+		Rank ingoingRank=m_parameters->vertexRank(&m_previousVertexRC);
 
-			// there is a previous vertex.
-			m_hasPreviousVertex=true;
-			m_previousVertex=currentForwardKmer;
-			m_previousVertexRC=currentReverseKmer;
-		}else{
-			m_hasPreviousVertex=false;
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForIngoingEdges.addAt(ingoingRank,currentReverseKmer->getU64(i));
+		}
+		for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
+			m_bufferedDataForIngoingEdges.addAt(ingoingRank,m_previousVertexRC.getU64(i));
 		}
 
 		MACRO_COLLECT_PROFILING_INFORMATION();
 
-		(m_mode_send_vertices_sequence_id_position++);
 
-		if((m_mode_send_vertices_sequence_id_position)==maximumPosition){
-			m_hasPreviousVertex=false;
-			(m_mode_send_vertices_sequence_id)++;
-			(m_mode_send_vertices_sequence_id_position)=0;
+		if(m_bufferedDataForIngoingEdges.flush(ingoingRank,2*KMER_U64_ARRAY_SIZE,RAY_MPI_TAG_IN_EDGES_DATA,m_outboxAllocator,m_outbox,m_parameters->getRank(),false)){
+			m_pendingMessages++;
 		}
+		MACRO_COLLECT_PROFILING_INFORMATION();
 	}
-	MACRO_COLLECT_PROFILING_INFORMATION();
+
+	// there is a previous vertex.
+	m_hasPreviousVertex=true;
+	m_previousVertex=*currentForwardKmer;
+	m_previousVertexRC=*currentReverseKmer;
 }
 
 LargeCount VerticesExtractor::getDefaultNumberOfBitsForBloomFilter(){
@@ -330,6 +381,7 @@ void VerticesExtractor::constructor(int size,Parameters*parameters,GridTable*gra
 	m_distributionIsCompleted=false;
 	m_outbox=outbox;
 	m_outboxAllocator=outboxAllocator;
+	m_mode_send_vertices_sequence_id=0;
 	m_mode_send_vertices_sequence_id_position=0;
 	m_hasPreviousVertex=false;
 
@@ -399,6 +451,10 @@ void VerticesExtractor::setProfiler(Profiler*profiler){
 	m_profiler = profiler;
 }
 
+void VerticesExtractor::setExtractionPool(KmerExtractionPool*pool){
+	m_extractionPool=pool;
+}
+
 void VerticesExtractor::registerPlugin(ComputeCore*core){
 	m_plugin=core->allocatePluginHandle();
 
@@ -429,6 +485,8 @@ void VerticesExtractor::registerPlugin(ComputeCore*core){
 }
 
 void VerticesExtractor::resolveSymbols(ComputeCore*core){
+	m_instrumentation=(Instrumentation*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Instrumentation.ray");
+
 	RAY_SLAVE_MODE_ADD_EDGES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_ADD_EDGES");
 	RAY_SLAVE_MODE_WRITE_KMERS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_WRITE_KMERS");
 
@@ -28,6 +28,8 @@
 #include <code/Mock/common_functions.h>
 #include <code/SequencesLoader/ArrayOfReads.h>
 #include <code/SequencesLoader/Read.h>
+#include <code/KmerAcademyBuilder/KmerExtractionPool.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 #include <RayPlatform/profiling/Derivative.h>
 #include <RayPlatform/profiling/Profiler.h>
@@ -107,6 +109,15 @@ class VerticesExtractor: public CorePlugin{
 	bool m_reverseComplementVertex;
 
 	bool m_finished;
+
+	KmerExtractionPool*m_extractionPool;
+
+	/** prints the progress when a multiple of 100000 reads is reached */
+	void printProgress(int read);
+
+	void addEdges(Kmer*currentForwardKmer,Kmer*currentReverseKmer);
+	Instrumentation*m_instrumentation;
+
 public:
 
 	void constructor(int size,Parameters*parameters,GridTable*graph,
@@ -131,6 +142,7 @@ StaticVector*outbox,RingAllocator*outboxAllocator,ArrayOfReads*myReads
 	void setDistributionAsCompleted();
 
 	void setProfiler(Profiler*profiler);
+	void setExtractionPool(KmerExtractionPool*pool);
 
 	void registerPlugin(ComputeCore*core);
 	void resolveSymbols(ComputeCore*core);
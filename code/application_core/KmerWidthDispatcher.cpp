@@ -0,0 +1,107 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include "KmerWidthDispatcher.h"
+
+#include <code/KmerAcademyBuilder/Kmer.h>
+#include <code/Mock/Parameters.h>
+
+#include <sstream>
+#include <iostream>
+using namespace std;
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/** the environment variable to disable the dispatcher */
+#define KMER_WIDTH_DISABLE "RAY_NO_KMER_DISPATCH"
+
+/*
+ * The commands are loaded like in Parameters, from the command line
+ * or from a file (Ray Ray.conf), with the same rules for -k.
+ */
+int KmerWidthDispatcher::getKmerLength(int argc,char**argv){
+	Parameters parameters;
+	parameters.loadCommands(argc,argv);
+
+	return parameters.getRequestedWordSize();
+}
+
+string KmerWidthDispatcher::getExecutableDirectory(char*argv0){
+	char path[4096];
+	ssize_t bytes=readlink("/proc/self/exe",path,sizeof(path)-1);
+
+	string executable=argv0;
+
+	if(bytes>0){
+		path[bytes]='\0';
+		executable=path;
+	}
+
+	size_t separator=executable.rfind('/');
+
+	if(separator==string::npos)
+		return "";
+
+	return executable.substr(0,separator+1);
+}
+
+bool KmerWidthDispatcher::dispatch(int argc,char**argv){
+	if(argc<2 || getenv(KMER_WIDTH_DISABLE)!=NULL)
+		return true;
+
+	int kmerLength=getKmerLength(argc,argv);
+	int words=(2*kmerLength+63)/64;
+
+	if(words==KMER_U64_ARRAY_SIZE)
+		return true;
+
+	ostringstream executable;
+	executable<<getExecutableDirectory(argv[0])<<"Ray-"<<32*words;
+	string file=executable.str();
+
+/*
+ * A wider executable gives the same assembly with more memory,
+ * a narrower one would silently assemble with a shorter k.
+ */
+	if(access(file.c_str(),X_OK)!=0){
+		if(words<KMER_U64_ARRAY_SIZE)
+			return true;
+
+		cout<<"Error: -k "<<kmerLength<<" needs "<<words<<" 64-bit words per k-mer, but "<<argv[0];
+		cout<<" has "<<KMER_U64_ARRAY_SIZE<<" (MAXKMERLENGTH="<<CONFIG_MAXKMERLENGTH<<") and "<<file<<" is not available."<<endl;
+		cout<<"Build it with \"make kmer-widths\" or build Ray with MAXKMERLENGTH="<<32*words<<"."<<endl;
+		return false;
+	}
+
+	// the other executable must not dispatch again
+	setenv(KMER_WIDTH_DISABLE,"1",1);
+
+	execv(file.c_str(),argv);
+
+	// only reached if execv failed
+	unsetenv(KMER_WIDTH_DISABLE);
+
+	cout<<"Error: can not start "<<file<<": "<<strerror(errno)<<endl;
+
+	return words<KMER_U64_ARRAY_SIZE;
+}
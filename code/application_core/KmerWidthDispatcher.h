@@ -0,0 +1,55 @@
+/*
+ 	Ray
+    Copyright (C) 2026 agent
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _KmerWidthDispatcher_h
+#define _KmerWidthDispatcher_h
+
+#include <string>
+using namespace std;
+
+/**
+ * The number of 64-bit words in a Kmer is fixed at compilation
+ * with MAXKMERLENGTH. A binary built for long k-mers pays for the
+ * unused words with every k-mer in memory and in messages.
+ *
+ * "make kmer-widths" builds Ray-32, Ray-64, Ray-96 and Ray-128
+ * next to Ray. Before MPI is started, the dispatcher reads -k (on the
+ * command line or in the configuration file) and replaces the process
+ * with the executable that has just enough words for this k.
+ * Without these executables, a k that fits in this executable runs
+ * here; a k that needs more words is an error.
+ *
+ * \author agent
+ */
+class KmerWidthDispatcher{
+
+	int getKmerLength(int argc,char**argv);
+	string getExecutableDirectory(char*argv0);
+
+public:
+
+	/**
+	 * does not return if another executable is started,
+	 * returns false if this executable can not run this k
+	 */
+	bool dispatch(int argc,char**argv);
+};
+
+#endif
@@ -27,6 +27,8 @@
 #include <code/VerticesExtractor/VerticesExtractor.h>
 #include <code/SeedExtender/TipWatchdog.h>
 #include <code/SeedExtender/BubbleTool.h>
+#include <code/KmerAcademyBuilder/KmerBenchmark.h>
+#include <code/VerticesExtractor/GridTableBenchmark.h>
 #include <code/Mock/common_functions.h>
 #include <code/Mock/constants.h>
 #include <code/CoverageGatherer/CoverageDistribution.h>
@@ -113,6 +115,22 @@ void Machine::init(int argc,char**argv){
 			if(isMaster())
 				showRayVersionShort();
 
+			m_computeCore.destructor();
+			m_aborted=true;
+		}else if(param=="-kmer-benchmark"){
+			if(isMaster()){
+				KmerBenchmark benchmark;
+				benchmark.run();
+			}
+
+			m_computeCore.destructor();
+			m_aborted=true;
+		}else if(param=="-grid-table-benchmark"){
+			if(isMaster()){
+				GridTableBenchmark benchmark;
+				benchmark.run();
+			}
+
 			m_computeCore.destructor();
 			m_aborted=true;
 		}
@@ -250,7 +268,7 @@ void Machine::start(){
 	m_virtualCommunicator,&m_subgraph,m_virtualProcessor);
 
 	m_coverageGatherer.constructor(&m_parameters,m_inbox,m_outbox,m_switchMan->getSlaveModePointer(),&m_subgraph,
-		m_outboxAllocator);
+		m_outboxAllocator,&m_coverageDistribution);
 
 	m_fusionTaskCreator.constructor(m_virtualProcessor,m_outbox,
 		m_outboxAllocator,m_switchMan->getSlaveModePointer(),&m_parameters,&(m_ed->m_EXTENSION_contigs),
@@ -440,7 +458,7 @@ void Machine::start(){
 		&m_myReads,m_inbox,m_outbox,m_switchMan->getSlaveModePointer(),m_outboxAllocator);
 
 	m_si.constructor(&m_parameters,m_outboxAllocator,m_inbox,m_outbox,m_virtualCommunicator,
-		m_switchMan->getSlaveModePointer(),&m_myReads);
+		m_switchMan->getSlaveModePointer(),&m_myReads,&m_subgraph);
 
 	m_profiler = m_computeCore.getProfiler();
 	m_profiler->constructor(m_parameters.runProfiler());
@@ -458,6 +476,9 @@ void Machine::start(){
 	m_diskAllocator.constructor(chunkSize,"RAY_MALLOC_TYPE_DATA_ALLOCATOR",
 		m_parameters.showMemoryAllocations());
 
+	m_instrumentation.addAllocator(&m_diskAllocator);
+	m_instrumentation.addAllocator(&m_persistentAllocator);
+
 	m_sl.constructor(m_size,&m_diskAllocator,&m_myReads,&m_parameters,m_outbox,
 		m_switchMan->getSlaveModePointer());
 
@@ -533,6 +554,12 @@ m_seedingData,
 	&m_numberOfRanksWithCoverageData,&m_seedExtender,
 	m_switchMan->getMasterModePointer(),&m_isFinalFusion,&m_si);
 
+	m_kmerExtractionPool.constructor(&m_parameters,&m_myReads);
+	m_kmerExtractionPool.setInserter(&m_mp);
+	m_kmerAcademyBuilder.setExtractionPool(&m_kmerExtractionPool);
+	m_verticesExtractor.setExtractionPool(&m_kmerExtractionPool);
+	m_mp.setExtractionPool(&m_kmerExtractionPool);
+
 	bool mustWriteSchedulingInformation = m_parameters.hasOption("-write-scheduling-data");
 
 /*
@@ -816,6 +843,7 @@ void Machine::registerPlugins(){
 	m_computeCore.registerPlugin(&m_coverageGatherer);
 	m_computeCore.registerPlugin(&m_verticesExtractor);
 	m_computeCore.registerPlugin(&m_edgePurger);
+	m_computeCore.registerPlugin(&m_unitigCompactor);
 	m_computeCore.registerPlugin(&m_si);
 	m_computeCore.registerPlugin(m_seedingData);
 	m_computeCore.registerPlugin(&m_library);
@@ -833,6 +861,7 @@ void Machine::registerPlugins(){
 	m_computeCore.registerPlugin(&m_example);
 	m_computeCore.registerPlugin(&m_pathEvaluator);
 	m_computeCore.registerPlugin(&m_spuriousSeedAnnihilator);
+	m_computeCore.registerPlugin(&m_instrumentation);
 
 	// resolve the symbols
 	// this is done here because we want to write a summary for
@@ -53,7 +53,9 @@
 #include <code/VerticesExtractor/VerticesExtractor.h>
 #include <code/Amos/Amos.h>
 #include <code/KmerAcademyBuilder/KmerAcademyBuilder.h>
+#include <code/KmerAcademyBuilder/KmerExtractionPool.h>
 #include <code/EdgePurger/EdgePurger.h>
+#include <code/UnitigCompactor/UnitigCompactor.h>
 #include <code/NetworkTest/NetworkTest.h>
 #include <code/FusionTaskCreator/FusionTaskCreator.h>
 #include <code/JoinerTaskCreator/JoinerTaskCreator.h>
@@ -67,6 +69,7 @@
 #include <code/Example/Example.h>
 #include <code/PathEvaluator/PathEvaluator.h>
 #include <code/SpuriousSeedAnnihilator/SpuriousSeedAnnihilator.h>
+#include <code/Instrumentation/Instrumentation.h>
 
 /** Chapter I. stuff pulled from RayPlatform, called The Platform hereafter */
 
@@ -140,6 +143,9 @@ class Machine : public MiniRank{
 	PathEvaluator m_pathEvaluator;
 	SpuriousSeedAnnihilator m_spuriousSeedAnnihilator;
 
+/** phase-aligned counters (-write-instrumentation-data) */
+	Instrumentation m_instrumentation;
+
 	Searcher m_searcher;
 
 	SwitchMan*m_switchMan;
@@ -160,6 +166,7 @@ class Machine : public MiniRank{
 	Partitioner m_partitioner;
 	NetworkTest m_networkTest;
 	EdgePurger m_edgePurger;
+	UnitigCompactor m_unitigCompactor;
 	TaxonomyViewer m_phylogeny;
 	GeneOntology m_ontologyPlugin;
 	Example m_example;
@@ -177,6 +184,10 @@ class Machine : public MiniRank{
 	TimePrinter m_timePrinter;
 	VerticesExtractor m_verticesExtractor;
 	MessageProcessor m_mp;
+
+	/** threads of -threads-per-rank, destroyed before m_mp */
+	KmerExtractionPool m_kmerExtractionPool;
+
 	int m_argc;
 	char**m_argv;
 	int m_last_value;
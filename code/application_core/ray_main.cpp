@@ -20,6 +20,7 @@
 */
 
 #include "Machine.h"
+#include "KmerWidthDispatcher.h"
 
 #include <RayPlatform/core/RankProcess.h>
 
@@ -27,6 +28,11 @@ using namespace std;
 
 int main(int argc,char**argv){
 
+	// must be done before MPI is started
+	KmerWidthDispatcher dispatcher;
+	if(!dispatcher.dispatch(argc,argv))
+		return EXIT_FAILURE;
+
 	RankProcess<Machine> applicationContainer;
 	applicationContainer.constructor(&argc,&argv);
 	applicationContainer.run();
@@ -0,0 +1,79 @@
+#!/bin/bash
+# Assembles the same reads with several k-mer lengths.
+#
+# This script runs one MPI job for each k, one after the other. Ray does
+# not sweep several k-mer lengths within one job: the reads are not kept in
+# memory between two k-mer lengths.
+#
+# What is shared is the parsing of the sequence files: the first run writes
+# the checkpoints Partition and Sequences (which do not depend on -k) with
+# -sequence-checkpoints, and the other runs load the packed reads from them.
+# Each run still reads these checkpoints and builds its own graph.
+#
+# The number of ranks must be the same for all the runs.
+#
+# usage:
+#
+# Ray-k-sweep.sh "mpiexec -n 64 Ray" "21 31 41" SweepDirectory -p r1.fastq r2.fastq ...
+#
+# Output:
+#
+# SweepDirectory/k<k>/                   the output directory of each run (-o)
+# SweepDirectory/SequenceCheckpoints/    the shared checkpoints
+# SweepDirectory/Summary.tsv             the contig N50 and scaffold N50 for each k
+#
+# Do not provide -k or -o, they are set for each run.
+
+if test $# -lt 4
+then
+	echo "usage: $0 \"mpiexec -n 64 Ray\" \"21 31 41\" SweepDirectory RayOptions..."
+	exit 1
+fi
+
+command=$1
+kmerLengths=$2
+directory=$3
+shift 3
+
+for option in "$@"
+do
+	if test "$option" = "-k" -o "$option" = "-o" -o "$option" = "-sequence-checkpoints"
+	then
+		echo "Error: $option is set by $0 for each run"
+		exit 1
+	fi
+done
+
+if test -d $directory
+then
+	echo "Error: $directory already exists"
+	exit 1
+fi
+
+mkdir -p $directory
+
+summary=$directory/Summary.tsv
+
+echo -e "#k\tContigN50\tScaffoldN50" > $summary
+
+for k in $kmerLengths
+do
+	output=$directory/k$k
+
+	$command -k $k -o $output -sequence-checkpoints $directory/SequenceCheckpoints "$@" > $directory/k$k.log 2>&1
+
+	if test $? -ne 0
+	then
+		echo "Error: the run with k=$k failed, see $directory/k$k.log"
+		exit 1
+	fi
+
+	# OutputNumbers.txt starts with the contigs, then the scaffolds,
+	# each one with 2 length thresholds
+	contigN50=$(grep N50: $output/OutputNumbers.txt | sed -n 1p | awk '{print $2}')
+	scaffoldN50=$(grep N50: $output/OutputNumbers.txt | sed -n 3p | awk '{print $2}')
+
+	echo -e "$k\t$contigN50\t$scaffoldN50" >> $summary
+done
+
+cat $summary